@@ -0,0 +1,866 @@
+//
+//  INTUGroupedArrayBenchmarks.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#ifdef __APPLE__
+#import <mach/mach_time.h>
+#else
+#import <time.h>
+#endif
+#import "INTUGroupedArrayImports.h"
+
+/*
+ A command line tool that measures the public operations of INTUGroupedArray & INTUMutableGroupedArray across a range of sizes, and writes
+ the results as JSON to standard output (or to the file passed as -output), so that they can be compared between revisions.
+ 
+ Each size is a total number of objects (a power of 10 from -minObjects to -maxObjects), which is measured in up to three shapes:
+ a single section, 10 sections, and 10 objects per section.
+ 
+ Arguments (e.g. -maxObjects 10000000 -filter removeObject):
+    -minObjects   The smallest total number of objects to measure. Default: 10
+    -maxObjects   The largest total number of objects to measure. Default: 1000000 (pass 10000000 for the full range)
+    -iterations   The number of times to run each benchmark; the minimum, median & mean durations are reported. Default: 5
+    -filter       Only run the benchmarks whose name contains this string.
+    -output       The path of a file to write the JSON results to, instead of standard output.
+ 
+ Progress is logged to standard error. When the library is built with INTU_GROUPED_ARRAY_INSTRUMENTATION=1, each result also includes the
+ instrumentation counters recorded by the last iteration of the benchmark (e.g. the number of section containers allocated).
+ */
+
+// The maximum number of times each benchmark of a single lookup or mutation repeats the operation
+static const NSUInteger INTUBenchmarkMaxOperationCount = 1000;
+
+// The maximum total number of objects visited by each benchmark of a single lookup or mutation that is O(n) on its own (e.g. -containsObject:),
+// so that these benchmarks repeat the operation fewer times as the grouped array grows
+static const NSUInteger INTUBenchmarkMaxLinearWorkCount = 10000000;
+
+// Objects are folded into this variable, so that the compiler cannot optimize away the work being measured
+static volatile uintptr_t INTUBenchmarkSink;
+
+static inline void INTUBenchmarkConsume(id object)
+{
+    INTUBenchmarkSink ^= (uintptr_t)(__bridge void *)object;
+}
+
+/** Returns the current time of a monotonic clock in nanoseconds (using mach_absolute_time() on Apple platforms, since clock_gettime()
+    requires iOS 10 / OS X 10.12, and clock_gettime() elsewhere). */
+static uint64_t INTUBenchmarkNanoseconds(void)
+{
+#ifdef __APPLE__
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    uint64_t time = mach_absolute_time();
+    // Split the conversion so that multiplying by the numerator can't overflow
+    return time / timebase.denom * timebase.numer + time % timebase.denom * timebase.numer / timebase.denom;
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+}
+
+
+/**
+ Runs the benchmarks for each shape of grouped array, and collects the results.
+ */
+@interface INTUGroupedArrayBenchmarks : NSObject
+
+// The number of times to run each benchmark
+@property (nonatomic, assign) NSUInteger iterations;
+// If set, only the benchmarks whose name contains this string are run
+@property (nonatomic, copy) NSString *filter;
+// An array of dictionaries, one for each benchmark that was run
+@property (nonatomic, strong) NSMutableArray *results;
+
+// The shape of the grouped arrays currently being measured
+@property (nonatomic, assign) NSUInteger sectionCount;
+@property (nonatomic, assign) NSUInteger objectsPerSection;
+
+// Fixtures for the current shape, which are created before its benchmarks run. The objects are the NSNumbers 0..n-1 in order, and the
+// sections are the NSNumbers 0..sectionCount-1 in order, so the object at index path (s, i) is s * objectsPerSection + i.
+@property (nonatomic, strong) NSArray *literal;
+@property (nonatomic, strong) NSArray *flatArray;
+@property (nonatomic, strong) INTUGroupedArray *groupedArray;
+// Evenly spaced samples of the index paths in the grouped array (with the object at each one), and of the sections in the grouped array
+@property (nonatomic, strong) NSArray *sampleIndexPaths;
+@property (nonatomic, strong) NSArray *sampleObjects;
+@property (nonatomic, strong) NSArray *sampleSections;
+
+- (void)runWithMinObjectCount:(NSUInteger)minObjectCount maxObjectCount:(NSUInteger)maxObjectCount;
+- (NSDictionary *)report;
+
+@end
+
+@implementation INTUGroupedArrayBenchmarks
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _iterations = 5;
+        _results = [NSMutableArray new];
+    }
+    return self;
+}
+
+/**
+ Runs every benchmark for each shape of each size of grouped array, from the minimum to the maximum total number of objects.
+ */
+- (void)runWithMinObjectCount:(NSUInteger)minObjectCount maxObjectCount:(NSUInteger)maxObjectCount
+{
+    for (NSUInteger objectCount = 10; objectCount <= maxObjectCount; objectCount *= 10) {
+        if (objectCount < minObjectCount) {
+            continue;
+        }
+        NSMutableSet *measuredSectionCounts = [NSMutableSet new];
+        for (NSNumber *sectionCount in @[@1, @10, @(objectCount / 10)]) {
+            if ([measuredSectionCounts containsObject:sectionCount]) {
+                continue;
+            }
+            [measuredSectionCounts addObject:sectionCount];
+            @autoreleasepool {
+                [self _prepareFixturesWithSectionCount:[sectionCount unsignedIntegerValue] objectsPerSection:objectCount / [sectionCount unsignedIntegerValue]];
+                [self _measureConstruction];
+                [self _measureLookups];
+                [self _measureEnumeration];
+                [self _measureFilteringAndSorting];
+                [self _measureCopying];
+                [self _measureCoding];
+                [self _measureMutations];
+                [self _measureScalarReductions];
+            }
+        }
+    }
+}
+
+/**
+ Returns the results of the benchmarks that have been run, along with a description of the environment they were run in.
+ */
+- (NSDictionary *)report
+{
+    NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+    return @{@"date": [[NSDate date] description],
+             @"operatingSystem": [processInfo operatingSystemVersionString],
+             @"processorCount": @([processInfo activeProcessorCount]),
+             @"iterations": @(self.iterations),
+             @"results": self.results};
+}
+
+#pragma mark Measuring
+
+/**
+ Runs the block the configured number of times, and records how long it took.
+ 
+ @param name The name of the benchmark, which is usually the name of the method being measured.
+ @param operationCount The number of operations performed by the block, used to report the duration of each operation. For example,
+                       the number of lookups, the number of mutations, or the number of objects for methods that visit every object.
+ @param setup An optional block that is run (but not timed) before each iteration, which returns a fixture for the block to operate on.
+ @param block The block to measure, which is passed the fixture returned by the setup block.
+ */
+- (void)_measure:(NSString *)name operations:(NSUInteger)operationCount setup:(id (^)(void))setup block:(void (^)(id fixture))block
+{
+    if ([self.filter length] > 0 && [name rangeOfString:self.filter].location == NSNotFound) {
+        return;
+    }
+    
+    NSUInteger objectCount = self.sectionCount * self.objectsPerSection;
+    fprintf(stderr, "%s (%lu sections x %lu objects)\n", [name UTF8String], (unsigned long)self.sectionCount, (unsigned long)self.objectsPerSection);
+    
+    uint64_t *durations = malloc(sizeof(uint64_t) * self.iterations);
+    uint64_t totalDuration = 0;
+    NSDictionary *counters = nil;
+    for (NSUInteger iteration = 0; iteration < self.iterations; iteration++) {
+        // The fixture (and anything autoreleased by the block) is deallocated after the block has been timed
+        @autoreleasepool {
+            id fixture = setup ? setup() : nil;
+            [INTUGroupedArrayInstrumentation reset];
+            uint64_t startTime = INTUBenchmarkNanoseconds();
+            block(fixture);
+            durations[iteration] = INTUBenchmarkNanoseconds() - startTime;
+            totalDuration += durations[iteration];
+            counters = [INTUGroupedArrayInstrumentation snapshot][INTUGroupedArrayInstrumentationCountersKey];
+        }
+    }
+    
+    // Sort the durations (there are only a few of them) to find the minimum & median
+    for (NSUInteger i = 1; i < self.iterations; i++) {
+        for (NSUInteger j = i; j > 0 && durations[j - 1] > durations[j]; j--) {
+            uint64_t duration = durations[j];
+            durations[j] = durations[j - 1];
+            durations[j - 1] = duration;
+        }
+    }
+    uint64_t medianDuration = durations[self.iterations / 2];
+    NSMutableDictionary *result = [@{@"name": name,
+                                     @"sections": @(self.sectionCount),
+                                     @"objectsPerSection": @(self.objectsPerSection),
+                                     @"objects": @(objectCount),
+                                     @"operations": @(operationCount),
+                                     @"minNanoseconds": @(durations[0]),
+                                     @"medianNanoseconds": @(medianDuration),
+                                     @"meanNanoseconds": @(totalDuration / self.iterations),
+                                     @"medianNanosecondsPerOperation": @((double)medianDuration / MAX(operationCount, 1))} mutableCopy];
+    if ([counters count] > 0) {
+        result[@"counters"] = counters;
+    }
+    [self.results addObject:result];
+    free(durations);
+}
+
+/**
+ Creates the fixtures for a shape of grouped array, which are shared by all of its benchmarks.
+ */
+- (void)_prepareFixturesWithSectionCount:(NSUInteger)sectionCount objectsPerSection:(NSUInteger)objectsPerSection
+{
+    self.sectionCount = sectionCount;
+    self.objectsPerSection = objectsPerSection;
+    NSUInteger objectCount = sectionCount * objectsPerSection;
+    
+    NSMutableArray *literal = [NSMutableArray arrayWithCapacity:sectionCount * 2];
+    NSMutableArray *flatArray = [NSMutableArray arrayWithCapacity:objectCount];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        NSMutableArray *objects = [NSMutableArray arrayWithCapacity:objectsPerSection];
+        for (NSUInteger objectIndex = 0; objectIndex < objectsPerSection; objectIndex++) {
+            [objects addObject:@(sectionIndex * objectsPerSection + objectIndex)];
+        }
+        [literal addObject:@(sectionIndex)];
+        [literal addObject:objects];
+        [flatArray addObjectsFromArray:objects];
+    }
+    self.literal = literal;
+    self.flatArray = flatArray;
+    self.groupedArray = [INTUGroupedArray literal:literal];
+    
+    NSUInteger sampleCount = MIN(objectCount, INTUBenchmarkMaxOperationCount);
+    NSMutableArray *sampleIndexPaths = [NSMutableArray arrayWithCapacity:sampleCount];
+    NSMutableArray *sampleObjects = [NSMutableArray arrayWithCapacity:sampleCount];
+    for (NSUInteger i = 0; i < sampleCount; i++) {
+        NSUInteger flatIndex = i * objectCount / sampleCount;
+        [sampleIndexPaths addObject:[INTUGroupedArray indexPathForRow:flatIndex % objectsPerSection inSection:flatIndex / objectsPerSection]];
+        [sampleObjects addObject:flatArray[flatIndex]];
+    }
+    self.sampleIndexPaths = sampleIndexPaths;
+    self.sampleObjects = sampleObjects;
+    
+    NSUInteger sampleSectionCount = MIN(sectionCount, INTUBenchmarkMaxOperationCount);
+    NSMutableArray *sampleSections = [NSMutableArray arrayWithCapacity:sampleSectionCount];
+    for (NSUInteger i = 0; i < sampleSectionCount; i++) {
+        [sampleSections addObject:@(i * sectionCount / sampleSectionCount)];
+    }
+    self.sampleSections = sampleSections;
+}
+
+/**
+ Returns a new mutable grouped array with the same contents as the grouped array fixture, which owns all of its section containers
+ (so that mutating it doesn't first copy the section containers it modifies).
+ */
+- (INTUMutableGroupedArray *)_newMutableGroupedArray
+{
+    NSUInteger objectsPerSection = self.objectsPerSection;
+    return [INTUMutableGroupedArray groupedArrayByGroupingArray:self.flatArray sectionKeyBlock:^id(NSNumber *object) {
+        return @([object unsignedIntegerValue] / objectsPerSection);
+    }];
+}
+
+/**
+ Returns a new grouped array with the options set and the same contents as the grouped array fixture.
+ */
+- (INTUGroupedArray *)_newGroupedArrayWithOptions:(INTUGroupedArrayOptions)options
+{
+    INTUGroupedArrayBuilder *builder = [[INTUGroupedArrayBuilder alloc] initWithOptions:options];
+    for (NSUInteger i = 0; i < [self.literal count]; i += 2) {
+        [builder addObjectsFromArray:self.literal[i + 1] toSection:self.literal[i]];
+    }
+    return [builder build];
+}
+
+/**
+ Returns the number of times to repeat an operation that is O(n) on its own, so that the benchmark finishes in a reasonable amount of time.
+ */
+- (NSUInteger)_linearOperationCount
+{
+    NSUInteger objectCount = self.sectionCount * self.objectsPerSection;
+    return MAX(1, MIN([self.sampleObjects count], INTUBenchmarkMaxLinearWorkCount / objectCount));
+}
+
+#pragma mark Benchmarks
+
+- (void)_measureConstruction
+{
+    NSUInteger objectCount = [self.flatArray count];
+    NSUInteger objectsPerSection = self.objectsPerSection;
+    NSArray *literal = self.literal;
+    NSArray *flatArray = self.flatArray;
+    
+    [self _measure:@"literal:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArray literal:literal]);
+    }];
+    [self _measure:@"groupedArrayWithArray:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArray groupedArrayWithArray:flatArray]);
+    }];
+    [self _measure:@"groupedArrayByGroupingArray:sectionKeyBlock:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArray groupedArrayByGroupingArray:flatArray sectionKeyBlock:^id(NSNumber *object) {
+            return @([object unsignedIntegerValue] / objectsPerSection);
+        }]);
+    }];
+    [self _measure:@"groupedArrayByGroupingArray:sectionKeyBlock: (concurrent)" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArray groupedArrayByGroupingArray:flatArray withOptions:NSEnumerationConcurrent sectionKeyBlock:^id(NSNumber *object) {
+            return @([object unsignedIntegerValue] / objectsPerSection);
+        } sectionComparator:nil]);
+    }];
+    [self _measure:@"INTUGroupedArrayBuilder build" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([self _newGroupedArrayWithOptions:INTUGroupedArrayOptionNone]);
+    }];
+    [self _measure:@"addObject:toSection: (construction)" operations:objectCount setup:nil block:^(id fixture) {
+        INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+        for (NSNumber *object in flatArray) {
+            [groupedArray addObject:object toSection:@([object unsignedIntegerValue] / objectsPerSection)];
+        }
+        INTUBenchmarkConsume(groupedArray);
+    }];
+}
+
+- (void)_measureLookups
+{
+    INTUGroupedArray *groupedArray = self.groupedArray;
+    NSArray *sampleIndexPaths = self.sampleIndexPaths;
+    NSArray *sampleObjects = self.sampleObjects;
+    NSArray *sampleSections = self.sampleSections;
+    NSUInteger objectsPerSection = self.objectsPerSection;
+    NSUInteger sampleCount = [sampleIndexPaths count];
+    NSUInteger sampleSectionCount = [sampleSections count];
+    NSUInteger linearOperationCount = [self _linearOperationCount];
+    
+    [self _measure:@"sectionAtIndex:" operations:sampleSectionCount setup:nil block:^(id fixture) {
+        for (NSNumber *section in sampleSections) {
+            INTUBenchmarkConsume([groupedArray sectionAtIndex:[section unsignedIntegerValue]]);
+        }
+    }];
+    [self _measure:@"indexOfSection:" operations:sampleSectionCount setup:nil block:^(id fixture) {
+        for (NSNumber *section in sampleSections) {
+            INTUBenchmarkSink ^= [groupedArray indexOfSection:section];
+        }
+    }];
+    [self _measure:@"containsSection:" operations:sampleSectionCount setup:nil block:^(id fixture) {
+        for (NSNumber *section in sampleSections) {
+            INTUBenchmarkSink ^= [groupedArray containsSection:section];
+        }
+    }];
+    [self _measure:@"objectAtIndexPath:" operations:sampleCount setup:nil block:^(id fixture) {
+        for (NSIndexPath *indexPath in sampleIndexPaths) {
+            INTUBenchmarkConsume([groupedArray objectAtIndexPath:indexPath]);
+        }
+    }];
+    [self _measure:@"objectAtIndex:inSection:" operations:sampleCount setup:nil block:^(id fixture) {
+        for (NSIndexPath *indexPath in sampleIndexPaths) {
+            INTUBenchmarkConsume([groupedArray objectAtIndex:[indexPath indexAtPosition:1] inSection:@([indexPath indexAtPosition:0])]);
+        }
+    }];
+    [self _measure:@"objectAtFlatIndex:" operations:sampleCount setup:nil block:^(id fixture) {
+        for (NSNumber *object in sampleObjects) {
+            INTUBenchmarkConsume([groupedArray objectAtFlatIndex:[object unsignedIntegerValue]]);
+        }
+    }];
+    [self _measure:@"countObjectsInSection:" operations:sampleSectionCount setup:nil block:^(id fixture) {
+        for (NSNumber *section in sampleSections) {
+            INTUBenchmarkSink ^= [groupedArray countObjectsInSection:section];
+        }
+    }];
+    [self _measure:@"objectsInSectionAtIndex:" operations:sampleSectionCount setup:nil block:^(id fixture) {
+        for (NSNumber *section in sampleSections) {
+            INTUBenchmarkConsume([groupedArray objectsInSectionAtIndex:[section unsignedIntegerValue]]);
+        }
+    }];
+    [self _measure:@"countAllObjects" operations:1 setup:nil block:^(id fixture) {
+        INTUBenchmarkSink ^= [groupedArray countAllObjects];
+    }];
+    [self _measure:@"allSections" operations:[groupedArray countAllSections] setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray allSections]);
+    }];
+    [self _measure:@"allObjects" operations:[groupedArray countAllObjects] setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray allObjects]);
+    }];
+    [self _measure:@"containsObject:" operations:linearOperationCount setup:nil block:^(id fixture) {
+        for (NSUInteger i = 0; i < linearOperationCount; i++) {
+            INTUBenchmarkSink ^= [groupedArray containsObject:sampleObjects[i]];
+        }
+    }];
+    [self _measure:@"indexPathOfObject:" operations:linearOperationCount setup:nil block:^(id fixture) {
+        for (NSUInteger i = 0; i < linearOperationCount; i++) {
+            INTUBenchmarkConsume([groupedArray indexPathOfObject:sampleObjects[i]]);
+        }
+    }];
+    [self _measure:@"indexOfObject:inSection:" operations:sampleCount setup:nil block:^(id fixture) {
+        for (NSNumber *object in sampleObjects) {
+            INTUBenchmarkSink ^= [groupedArray indexOfObject:object inSection:@([object unsignedIntegerValue] / objectsPerSection)];
+        }
+    }];
+    [self _measure:@"indexPathOfObjectPassingTest:" operations:linearOperationCount setup:nil block:^(id fixture) {
+        for (NSUInteger i = 0; i < linearOperationCount; i++) {
+            NSNumber *object = sampleObjects[i];
+            INTUBenchmarkConsume([groupedArray indexPathOfObjectPassingTest:^BOOL(id obj, NSIndexPath *indexPath, BOOL *stop) {
+                return [obj isEqual:object];
+            }]);
+        }
+    }];
+    
+    // The same lookups with the options that maintain hash tables (the object index is skipped for the largest sizes, since it needs
+    // a hash table entry for every object)
+    INTUGroupedArray *hashedSectionIndexGroupedArray = [self _newGroupedArrayWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [self _measure:@"indexOfSection: (hashed section index)" operations:sampleSectionCount setup:nil block:^(id fixture) {
+        for (NSNumber *section in sampleSections) {
+            INTUBenchmarkSink ^= [hashedSectionIndexGroupedArray indexOfSection:section];
+        }
+    }];
+    if ([groupedArray countAllObjects] > INTUBenchmarkMaxLinearWorkCount / 10) {
+        return;
+    }
+    INTUGroupedArray *hashedObjectIndexGroupedArray = [self _newGroupedArrayWithOptions:INTUGroupedArrayOptionHashedObjectIndex];
+    [self _measure:@"containsObject: (hashed object index)" operations:sampleCount setup:nil block:^(id fixture) {
+        for (NSNumber *object in sampleObjects) {
+            INTUBenchmarkSink ^= [hashedObjectIndexGroupedArray containsObject:object];
+        }
+    }];
+    [self _measure:@"indexPathOfObject: (hashed object index)" operations:sampleCount setup:nil block:^(id fixture) {
+        for (NSNumber *object in sampleObjects) {
+            INTUBenchmarkConsume([hashedObjectIndexGroupedArray indexPathOfObject:object]);
+        }
+    }];
+}
+
+- (void)_measureEnumeration
+{
+    INTUGroupedArray *groupedArray = self.groupedArray;
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    NSUInteger sectionCount = [groupedArray countAllSections];
+    
+    [self _measure:@"fast enumeration" operations:objectCount setup:nil block:^(id fixture) {
+        for (id object in groupedArray) {
+            INTUBenchmarkConsume(object);
+        }
+    }];
+    [self _measure:@"objectEnumerator" operations:objectCount setup:nil block:^(id fixture) {
+        NSEnumerator *enumerator = [groupedArray objectEnumerator];
+        id object;
+        while ((object = [enumerator nextObject])) {
+            INTUBenchmarkConsume(object);
+        }
+    }];
+    [self _measure:@"reverseObjectEnumerator" operations:objectCount setup:nil block:^(id fixture) {
+        NSEnumerator *enumerator = [groupedArray reverseObjectEnumerator];
+        id object;
+        while ((object = [enumerator nextObject])) {
+            INTUBenchmarkConsume(object);
+        }
+    }];
+    [self _measure:@"sectionEnumerator" operations:sectionCount setup:nil block:^(id fixture) {
+        NSEnumerator *enumerator = [groupedArray sectionEnumerator];
+        id section;
+        while ((section = [enumerator nextObject])) {
+            INTUBenchmarkConsume(section);
+        }
+    }];
+    [self _measure:@"reverseSectionEnumerator" operations:sectionCount setup:nil block:^(id fixture) {
+        NSEnumerator *enumerator = [groupedArray reverseSectionEnumerator];
+        id section;
+        while ((section = [enumerator nextObject])) {
+            INTUBenchmarkConsume(section);
+        }
+    }];
+    [self _measure:@"enumerateSectionsUsingBlock:" operations:sectionCount setup:nil block:^(id fixture) {
+        [groupedArray enumerateSectionsUsingBlock:^(id section, NSUInteger index, BOOL *stop) {
+            INTUBenchmarkConsume(section);
+        }];
+    }];
+    [self _measure:@"enumerateObjectsUsingBlock:" operations:objectCount setup:nil block:^(id fixture) {
+        [groupedArray enumerateObjectsUsingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+            INTUBenchmarkConsume(object);
+        }];
+    }];
+    [self _measure:@"enumerateObjectsWithOptions:usingBlock: (concurrent)" operations:objectCount setup:nil block:^(id fixture) {
+        [groupedArray enumerateObjectsWithOptions:NSEnumerationConcurrent usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+            INTUBenchmarkConsume(object);
+        }];
+    }];
+    [self _measure:@"enumerateObjectsUsingIndexPairBlock:" operations:objectCount setup:nil block:^(id fixture) {
+        [groupedArray enumerateObjectsUsingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            INTUBenchmarkConsume(object);
+        }];
+    }];
+    [self _measure:@"enumerateObjectsWithOptions:usingIndexPairBlock: (concurrent)" operations:objectCount setup:nil block:^(id fixture) {
+        [groupedArray enumerateObjectsWithOptions:NSEnumerationConcurrent usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            INTUBenchmarkConsume(object);
+        }];
+    }];
+    [self _measure:@"enumerateObjectsInSectionAtIndex:usingIndexPairBlock:" operations:objectCount setup:nil block:^(id fixture) {
+        for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+            [groupedArray enumerateObjectsInSectionAtIndex:sectionIndex usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+                INTUBenchmarkConsume(object);
+            }];
+        }
+    }];
+}
+
+- (void)_measureFilteringAndSorting
+{
+    INTUGroupedArray *groupedArray = self.groupedArray;
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    NSPredicate *objectPredicate = [NSPredicate predicateWithBlock:^BOOL(NSNumber *object, NSDictionary *bindings) {
+        return [object unsignedIntegerValue] % 2 == 0;
+    }];
+    // Sort in descending order, so that every section and object has to move
+    NSComparator descendingComparator = ^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+        return [obj2 compare:obj1];
+    };
+    
+    [self _measure:@"filteredGroupedArrayUsingSectionPredicate:objectPredicate:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray filteredGroupedArrayUsingSectionPredicate:nil objectPredicate:objectPredicate]);
+    }];
+    [self _measure:@"filteredGroupedArrayWithOptions:usingSectionPredicate:objectPredicate: (concurrent)" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray filteredGroupedArrayWithOptions:NSEnumerationConcurrent usingSectionPredicate:nil objectPredicate:objectPredicate]);
+    }];
+    [self _measure:@"sortedGroupedArrayUsingSectionComparator:objectComparator:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray sortedGroupedArrayUsingSectionComparator:descendingComparator objectComparator:descendingComparator]);
+    }];
+    [self _measure:@"sortedGroupedArrayWithOptions:usingSectionComparator:objectComparator: (concurrent)" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray sortedGroupedArrayWithOptions:NSSortConcurrent usingSectionComparator:descendingComparator objectComparator:descendingComparator]);
+    }];
+    [self _measure:@"filterUsingSectionPredicate:objectPredicate:" operations:objectCount setup:^id{
+        return [self _newMutableGroupedArray];
+    } block:^(INTUMutableGroupedArray *mutableGroupedArray) {
+        [mutableGroupedArray filterUsingSectionPredicate:nil objectPredicate:objectPredicate];
+    }];
+    [self _measure:@"sortUsingSectionComparator:objectComparator:" operations:objectCount setup:^id{
+        return [self _newMutableGroupedArray];
+    } block:^(INTUMutableGroupedArray *mutableGroupedArray) {
+        [mutableGroupedArray sortUsingSectionComparator:descendingComparator objectComparator:descendingComparator];
+    }];
+    [self _measure:@"isEqualToGroupedArray:" operations:objectCount setup:^id{
+        return [INTUGroupedArray literal:self.literal];
+    } block:^(INTUGroupedArray *otherGroupedArray) {
+        INTUBenchmarkSink ^= [groupedArray isEqualToGroupedArray:otherGroupedArray];
+    }];
+}
+
+- (void)_measureCopying
+{
+    INTUGroupedArray *groupedArray = self.groupedArray;
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    NSIndexPath *firstIndexPath = [INTUGroupedArray indexPathForRow:0 inSection:0];
+    
+    [self _measure:@"copy" operations:1 setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray copy]);
+    }];
+    [self _measure:@"mutableCopy" operations:1 setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([groupedArray mutableCopy]);
+    }];
+    [self _measure:@"copy (mutable)" operations:1 setup:^id{
+        return [self _newMutableGroupedArray];
+    } block:^(INTUMutableGroupedArray *mutableGroupedArray) {
+        INTUBenchmarkConsume([mutableGroupedArray copy]);
+    }];
+    [self _measure:@"initWithGroupedArray:copyItems:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([[INTUGroupedArray alloc] initWithGroupedArray:groupedArray copyItems:YES]);
+    }];
+    // The first mutation of a section after a copy has to copy the section (copy-on-write)
+    [self _measure:@"replaceObjectAtIndexPath:withObject: (after copy)" operations:1 setup:^id{
+        return [groupedArray mutableCopy];
+    } block:^(INTUMutableGroupedArray *mutableGroupedArray) {
+        [mutableGroupedArray replaceObjectAtIndexPath:firstIndexPath withObject:@(-1)];
+    }];
+}
+
+- (void)_measureCoding
+{
+    INTUGroupedArray *groupedArray = self.groupedArray;
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    NSData *archivedData = [NSKeyedArchiver archivedDataWithRootObject:groupedArray];
+    NSData *serializedData = [INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:NULL];
+    
+    [self _measure:@"encodeWithCoder:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([NSKeyedArchiver archivedDataWithRootObject:groupedArray]);
+    }];
+    [self _measure:@"initWithCoder:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([NSKeyedUnarchiver unarchiveObjectWithData:archivedData]);
+    }];
+    [self _measure:@"INTUGroupedArraySerialization dataWithGroupedArray:error:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:NULL]);
+    }];
+    [self _measure:@"INTUGroupedArraySerialization groupedArrayWithData:error:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArraySerialization groupedArrayWithData:serializedData error:NULL]);
+    }];
+    [self _measure:@"INTUGroupedArraySerialization lazyGroupedArrayWithData:error:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUGroupedArraySerialization lazyGroupedArrayWithData:serializedData error:NULL]);
+    }];
+}
+
+- (void)_measureMutations
+{
+    NSUInteger sectionCount = self.sectionCount;
+    NSUInteger objectsPerSection = self.objectsPerSection;
+    NSUInteger objectCount = sectionCount * objectsPerSection;
+    NSArray *sampleIndexPaths = self.sampleIndexPaths;
+    NSArray *sampleObjects = self.sampleObjects;
+    NSArray *sampleSections = self.sampleSections;
+    NSUInteger sampleCount = [sampleIndexPaths count];
+    NSUInteger sampleSectionCount = [sampleSections count];
+    NSUInteger linearOperationCount = [self _linearOperationCount];
+    id (^setup)(void) = ^id{
+        return [self _newMutableGroupedArray];
+    };
+    // The same grouped array, with every section in chunked storage regardless of its size
+    id (^chunkedSetup)(void) = ^id{
+        INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionChunkedSectionStorage];
+        [groupedArray performBatchUpdates:^{
+            for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+                [groupedArray addObjectsFromArray:[self.flatArray subarrayWithRange:NSMakeRange(sectionIndex * objectsPerSection, objectsPerSection)] toSection:@(sectionIndex)];
+            }
+        }];
+        return groupedArray;
+    };
+    
+    // Adding & inserting
+    [self _measure:@"addObject:toSection:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray addObject:@(objectCount + i) toSection:@(i % sectionCount)];
+        }
+    }];
+    [self _measure:@"addObject:toSection:withSectionIndexHint:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray addObject:@(objectCount + i) toSection:@(i % sectionCount) withSectionIndexHint:i % sectionCount];
+        }
+    }];
+    [self _measure:@"addObject:toSectionAtIndex:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray addObject:@(objectCount + i) toSectionAtIndex:i % sectionCount];
+        }
+    }];
+    [self _measure:@"addObjectsFromArray:toSection:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray addObjectsFromArray:sampleObjects toSection:@0];
+    }];
+    [self _measure:@"addObject:toSection: (new sections)" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray addObject:@(objectCount + i) toSection:@(sectionCount + i)];
+        }
+    }];
+    [self _measure:@"addObject:toSection: (section churn)" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        // Each new section is removed again right away, so that sections keep coming and going
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray addObject:@(objectCount + i) toSection:@(sectionCount + i)];
+            [groupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:sectionCount]];
+        }
+    }];
+    [self _measure:@"insertObject:atIndex:inSection:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray insertObject:@(objectCount + i) atIndex:0 inSection:@(i % sectionCount)];
+        }
+    }];
+    [self _measure:@"insertObject:atIndexPath:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSIndexPath *indexPath in sampleIndexPaths) {
+            [groupedArray insertObject:@(-1) atIndexPath:indexPath];
+        }
+    }];
+    [self _measure:@"insertObject:atIndexPath: (chunked storage)" operations:sampleCount setup:chunkedSetup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSIndexPath *indexPath in sampleIndexPaths) {
+            [groupedArray insertObject:@(-1) atIndexPath:indexPath];
+        }
+    }];
+    
+    // Replacing, moving & exchanging
+    [self _measure:@"replaceSectionAtIndex:withSection:" operations:sampleSectionCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSNumber *section in sampleSections) {
+            [groupedArray replaceSectionAtIndex:[section unsignedIntegerValue] withSection:@(sectionCount + [section unsignedIntegerValue])];
+        }
+    }];
+    [self _measure:@"replaceObjectAtIndexPath:withObject:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSIndexPath *indexPath in sampleIndexPaths) {
+            [groupedArray replaceObjectAtIndexPath:indexPath withObject:@(-1)];
+        }
+    }];
+    [self _measure:@"moveSectionAtIndex:toIndex:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray moveSectionAtIndex:0 toIndex:sectionCount - 1];
+        }
+    }];
+    [self _measure:@"moveObjectAtIndexPath:toIndexPath:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        // Move objects from the front to the back of each section, so that no section is left empty
+        for (NSIndexPath *indexPath in sampleIndexPaths) {
+            NSUInteger sectionIndex = [indexPath indexAtPosition:0];
+            [groupedArray moveObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:sectionIndex]
+                                    toIndexPath:[INTUGroupedArray indexPathForRow:objectsPerSection - 1 inSection:sectionIndex]];
+        }
+    }];
+    [self _measure:@"exchangeSectionAtIndex:withSectionAtIndex:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray exchangeSectionAtIndex:i % sectionCount withSectionAtIndex:sectionCount - 1 - (i % sectionCount)];
+        }
+    }];
+    [self _measure:@"exchangeObjectAtIndexPath:withObjectAtIndexPath:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray exchangeObjectAtIndexPath:sampleIndexPaths[i] withObjectAtIndexPath:sampleIndexPaths[sampleCount - 1 - i]];
+        }
+    }];
+    
+    // Removing
+    [self _measure:@"removeObjectAtIndexPath:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        // Remove objects from the front of the first section, which has to shift all the objects after them
+        NSIndexPath *firstIndexPath = [INTUGroupedArray indexPathForRow:0 inSection:0];
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray removeObjectAtIndexPath:firstIndexPath];
+        }
+    }];
+    [self _measure:@"removeObjectAtIndexPath: (chunked storage)" operations:sampleCount setup:chunkedSetup block:^(INTUMutableGroupedArray *groupedArray) {
+        NSIndexPath *firstIndexPath = [INTUGroupedArray indexPathForRow:0 inSection:0];
+        for (NSUInteger i = 0; i < sampleCount; i++) {
+            [groupedArray removeObjectAtIndexPath:firstIndexPath];
+        }
+    }];
+    [self _measure:@"removeObjectAtIndex:fromSection:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSNumber *object in sampleObjects) {
+            [groupedArray removeObjectAtIndex:0 fromSection:@([object unsignedIntegerValue] / objectsPerSection)];
+        }
+    }];
+    [self _measure:@"removeObject:" operations:linearOperationCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < linearOperationCount; i++) {
+            [groupedArray removeObject:sampleObjects[i]];
+        }
+    }];
+    [self _measure:@"removeObject:fromSection:" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSNumber *object in sampleObjects) {
+            [groupedArray removeObject:object fromSection:@([object unsignedIntegerValue] / objectsPerSection)];
+        }
+    }];
+    [self _measure:@"removeSection:" operations:sampleSectionCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSNumber *section in sampleSections) {
+            [groupedArray removeSection:section];
+        }
+    }];
+    [self _measure:@"removeSectionAtIndex:" operations:sampleSectionCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < sampleSectionCount; i++) {
+            [groupedArray removeSectionAtIndex:0];
+        }
+    }];
+    [self _measure:@"removeAllObjects" operations:objectCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray removeAllObjects];
+    }];
+    [self _measure:@"performBatchUpdates: (removeObjectAtIndexPath:)" operations:sampleCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray performBatchUpdates:^{
+            // Remove objects from the back of each section, so that no section is left empty until the batch ends
+            for (NSIndexPath *indexPath in [sampleIndexPaths reverseObjectEnumerator]) {
+                [groupedArray removeObjectAtIndexPath:indexPath];
+            }
+        }];
+    }];
+    
+    // Keeping the objects sorted
+    [self _measure:@"maintainSortOrderUsingSectionComparator:objectComparator:" operations:objectCount setup:setup block:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray maintainSortOrderUsingSectionComparator:^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+            return [obj1 compare:obj2];
+        } objectComparator:^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+            return [obj1 compare:obj2];
+        }];
+    }];
+}
+
+- (void)_measureScalarReductions
+{
+    INTUGroupedArray *groupedArray = self.groupedArray;
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    INTUDoubleGroupedArray *doubleGroupedArray = [INTUDoubleGroupedArray groupedArrayWithGroupedArray:groupedArray];
+    INTUInt64GroupedArray *int64GroupedArray = [INTUInt64GroupedArray groupedArrayWithGroupedArray:groupedArray];
+    
+    [self _measure:@"INTUDoubleGroupedArray groupedArrayWithGroupedArray:" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkConsume([INTUDoubleGroupedArray groupedArrayWithGroupedArray:groupedArray]);
+    }];
+    // The boxed baseline that the unboxed reductions below are compared against
+    [self _measure:@"sum of NSNumber doubleValue (boxed)" operations:objectCount setup:nil block:^(id fixture) {
+        double sum = 0.0;
+        for (NSNumber *object in groupedArray) {
+            sum += [object doubleValue];
+        }
+        INTUBenchmarkSink ^= (uintptr_t)sum;
+    }];
+    [self _measure:@"INTUDoubleGroupedArray sumOfAllValues" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkSink ^= (uintptr_t)[doubleGroupedArray sumOfAllValues];
+    }];
+    [self _measure:@"INTUDoubleGroupedArray maximumOfAllValues" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkSink ^= (uintptr_t)[doubleGroupedArray maximumOfAllValues];
+    }];
+    [self _measure:@"INTUDoubleGroupedArray enumerateValuesUsingBlock:" operations:objectCount setup:nil block:^(id fixture) {
+        __block double sum = 0.0;
+        [doubleGroupedArray enumerateValuesUsingBlock:^(double value, INTUIndexPair indexPair, BOOL *stop) {
+            sum += value;
+        }];
+        INTUBenchmarkSink ^= (uintptr_t)sum;
+    }];
+    [self _measure:@"INTUInt64GroupedArray sumOfAllValues" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkSink ^= (uintptr_t)[int64GroupedArray sumOfAllValues];
+    }];
+    [self _measure:@"INTUInt64GroupedArray minimumOfAllValues" operations:objectCount setup:nil block:^(id fixture) {
+        INTUBenchmarkSink ^= (uintptr_t)[int64GroupedArray minimumOfAllValues];
+    }];
+}
+
+@end
+
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool {
+        // Arguments such as -maxObjects 10000000 are available from the argument domain of the user defaults
+        NSUserDefaults *arguments = [NSUserDefaults standardUserDefaults];
+        NSInteger minObjectCount = [arguments integerForKey:@"minObjects"];
+        NSInteger maxObjectCount = [arguments integerForKey:@"maxObjects"];
+        NSInteger iterations = [arguments integerForKey:@"iterations"];
+        
+        INTUGroupedArrayBenchmarks *benchmarks = [INTUGroupedArrayBenchmarks new];
+        benchmarks.filter = [arguments stringForKey:@"filter"];
+        if (iterations > 0) {
+            benchmarks.iterations = (NSUInteger)iterations;
+        }
+        [benchmarks runWithMinObjectCount:minObjectCount > 0 ? (NSUInteger)minObjectCount : 10
+                           maxObjectCount:maxObjectCount > 0 ? (NSUInteger)maxObjectCount : 1000000];
+        
+        NSError *error = nil;
+        NSData *json = [NSJSONSerialization dataWithJSONObject:[benchmarks report] options:NSJSONWritingPrettyPrinted error:&error];
+        if (!json) {
+            fprintf(stderr, "Failed to write the results: %s\n", [[error localizedDescription] UTF8String]);
+            return 1;
+        }
+        NSString *outputPath = [arguments stringForKey:@"output"];
+        if (outputPath) {
+            if (![json writeToFile:outputPath options:NSDataWritingAtomic error:&error]) {
+                fprintf(stderr, "Failed to write the results to %s: %s\n", [outputPath UTF8String], [[error localizedDescription] UTF8String]);
+                return 1;
+            }
+        } else {
+            [[NSFileHandle fileHandleWithStandardOutput] writeData:json];
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+//
+//  INTUConcurrentMutableGroupedArray.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+#import "INTUGroupedArray.h"
+#import "INTUMutableGroupedArray.h"
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+
+/**
+ A mutable grouped array that is safe to access from any number of threads at once.
+ 
+ Reads are served from an immutable snapshot of the grouped array, which writers replace atomically after each update
+ (read-copy-update), so reads never wait for a writer, readers never contend with each other, and every read sees a
+ consistent state of the grouped array. Writers are serialized among themselves: each update is applied to a private
+ mutable grouped array, and then a new snapshot is published. Since section containers are copied on write, publishing
+ a snapshot is O(n), where n is the number of sections, and each update only copies the sections it modifies.
+ 
+ Each read method reads the latest snapshot on its own, so consecutive reads may observe different snapshots if a writer
+ publishes in between. To perform several related reads (such as counting the objects and then accessing them by index
+ path), read them from the same -snapshot. Fast enumeration always enumerates the snapshot that was current when the
+ enumeration began, so the grouped array may be updated during the enumeration (even by the enumerating thread).
+ 
+ Note that publishing a snapshot of a grouped array with the INTUGroupedArrayOptionHashedObjectIndex option set is O(n),
+ where n is the total number of objects, so batching updates with -performUpdates: is especially important in that case.
+ */
+@interface GA__INTU_GENERICS(INTUConcurrentMutableGroupedArray, SectionType, ObjectType) : NSObject <NSFastEnumeration>
+
+/** The options of the grouped array, which each snapshot has as well. */
+@property (nonatomic, readonly) INTUGroupedArrayOptions options;
+
+/** The latest published immutable snapshot of the grouped array. Never blocks. */
+@property (atomic, readonly, strong) GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *snapshot;
+
+/** Creates and returns a new empty concurrent grouped array with no options. */
+- (instancetype)init;
+/** Creates and returns a new empty concurrent grouped array with the options. */
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options;
+/** Creates and returns a new concurrent grouped array with the contents and options of a given grouped array. */
+- (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray;
+
+#pragma mark Reading
+
+/** Returns the number of sections in the latest snapshot. */
+- (NSUInteger)countAllSections;
+/** Returns the number of objects in the latest snapshot. */
+- (NSUInteger)countAllObjects;
+/** Returns the section at the index in the latest snapshot. */
+- (GA__INTU_GENERICS_TYPE(SectionType))sectionAtIndex:(NSUInteger)index;
+/** Returns YES if the section exists in the latest snapshot. */
+- (BOOL)containsSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Returns the index of the section in the latest snapshot, or NSNotFound if it does not exist. */
+- (NSUInteger)indexOfSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Returns the number of objects in the section at the index in the latest snapshot. */
+- (NSUInteger)countObjectsInSectionAtIndex:(NSUInteger)index;
+/** Returns the objects in the section at the index in the latest snapshot. */
+- (GA__INTU_GENERICS(NSArray, ObjectType) *)objectsInSectionAtIndex:(NSUInteger)index;
+/** Returns a read-only view of all objects in the latest snapshot, without copying them. */
+- (GA__INTU_GENERICS(NSArray, ObjectType) *)allObjectsView;
+/** Returns the object at the index path in the latest snapshot. */
+- (GA__INTU_GENERICS_TYPE(ObjectType))objectAtIndexPath:(NSIndexPath *)indexPath;
+/** Returns YES if the object exists in the latest snapshot. */
+- (BOOL)containsObject:(GA__INTU_GENERICS_TYPE(ObjectType))object;
+/** Returns the index path of the first occurrence of the object in the latest snapshot, or nil if it does not exist. */
+- (NSIndexPath *)indexPathOfObject:(GA__INTU_GENERICS_TYPE(ObjectType))object;
+/** Executes the block for each object in the latest snapshot. The grouped array may be updated while the block runs. */
+- (void)enumerateObjectsUsingBlock:(void (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, NSIndexPath *indexPath, BOOL *stop))block;
+
+#pragma mark Writing
+
+/** Adds an object to the section, and publishes a new snapshot. If the section does not exist, it will be created. */
+- (void)addObject:(GA__INTU_GENERICS_TYPE(ObjectType))object toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Inserts the object at the index path, and publishes a new snapshot. The index path must correspond to an existing section. */
+- (void)insertObject:(GA__INTU_GENERICS_TYPE(ObjectType))object atIndexPath:(NSIndexPath *)indexPath;
+/** Replaces the object at the index path with another object, and publishes a new snapshot. */
+- (void)replaceObjectAtIndexPath:(NSIndexPath *)indexPath withObject:(GA__INTU_GENERICS_TYPE(ObjectType))object;
+/** Removes the object at the index path, and publishes a new snapshot. Empty sections will be removed. */
+- (void)removeObjectAtIndexPath:(NSIndexPath *)indexPath;
+/** Removes all occurrences of the object across all sections, and publishes a new snapshot. Empty sections will be removed. */
+- (void)removeObject:(GA__INTU_GENERICS_TYPE(ObjectType))object;
+/** Removes the section and all objects in it, and publishes a new snapshot. */
+- (void)removeSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Removes all objects and sections, and publishes a new snapshot. */
+- (void)removeAllObjects;
+
+/** Performs the mutations in the block as a single batch of updates to the mutable grouped array passed to it, and then publishes a single
+    new snapshot if it was mutated. Other writers wait until the block returns, while readers keep reading the previous snapshot. The mutable
+    grouped array must only be accessed inside the block. */
+- (void)performUpdates:(void (^)(GA__INTU_GENERICS(INTUMutableGroupedArray, SectionType, ObjectType) *groupedArray))updates;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
@@ -0,0 +1,381 @@
+//
+//  INTUConcurrentMutableGroupedArray.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUConcurrentMutableGroupedArray.h"
+#import "INTUGroupedArrayInternal.h"
+
+@interface GA__INTU_GENERICS(INTUConcurrentMutableGroupedArray, SectionType, ObjectType) ()
+{
+@private
+    /** The grouped array that writers apply updates to, which is never shared outside of this class. Only accessed while synchronized on it. */
+    INTUMutableGroupedArray *_mutableGroupedArray;
+    /** The number of calls to -performUpdates: in progress, which may be nested. Only accessed while synchronized on _mutableGroupedArray. */
+    NSUInteger _updateDepth;
+}
+
+// Redeclare the snapshot as readwrite, and keep it atomic so that it can be published on one thread while it is read on others.
+@property (atomic, readwrite, strong) GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *snapshot;
+
+@end
+
+@implementation INTUConcurrentMutableGroupedArray
+
+/**
+ Creates and returns a new empty concurrent grouped array with no options.
+ */
+- (instancetype)init
+{
+    return [self initWithOptions:INTUGroupedArrayOptionNone];
+}
+
+/**
+ Designated initializer.
+ Creates and returns a new empty concurrent grouped array with the specified options.
+ 
+ @param options The options of the grouped array.
+ @return A new concurrent grouped array with no sections or objects.
+ */
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options
+{
+    self = [super init];
+    if (self) {
+        _options = options;
+        _mutableGroupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:options];
+        _snapshot = [_mutableGroupedArray copy];
+    }
+    return self;
+}
+
+/**
+ Creates and returns a new concurrent grouped array with the contents and options of a given grouped array.
+ Performance: O(n), where n is the number of sections
+ 
+ @param groupedArray The grouped array to copy the contents of. Later changes to it will not affect the concurrent grouped array.
+ @return A new concurrent grouped array with the same sections & objects as the grouped array.
+ */
+- (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    self = [self initWithOptions:groupedArray.options];
+    if (self) {
+        if (groupedArray) {
+            // Both copies share the section containers with the grouped array, and copy each one before modifying it (copy-on-write)
+            _mutableGroupedArray = [groupedArray mutableCopy];
+            _snapshot = [_mutableGroupedArray copy];
+        }
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ (snapshot: %@)", [super description], self.snapshot];
+}
+
+#pragma mark Reading
+
+/**
+ Returns the number of sections in the latest snapshot.
+ Performance: O(1)
+ */
+- (NSUInteger)countAllSections
+{
+    return [self.snapshot countAllSections];
+}
+
+/**
+ Returns the number of objects in the latest snapshot.
+ Performance: O(1)
+ */
+- (NSUInteger)countAllObjects
+{
+    return [self.snapshot countAllObjects];
+}
+
+/**
+ Returns the section at the index in the latest snapshot.
+ Performance: O(1)
+ */
+- (id)sectionAtIndex:(NSUInteger)index
+{
+    return [self.snapshot sectionAtIndex:index];
+}
+
+/**
+ Returns YES if the section exists in the latest snapshot.
+ Performance: O(n), where n is the number of sections (O(1) if INTUGroupedArrayOptionHashedSectionIndex is set)
+ */
+- (BOOL)containsSection:(id)section
+{
+    return [self.snapshot containsSection:section];
+}
+
+/**
+ Returns the index of the section in the latest snapshot, or NSNotFound if it does not exist.
+ Performance: O(n), where n is the number of sections (O(1) if INTUGroupedArrayOptionHashedSectionIndex is set)
+ */
+- (NSUInteger)indexOfSection:(id)section
+{
+    return [self.snapshot indexOfSection:section];
+}
+
+/**
+ Returns the number of objects in the section at the index in the latest snapshot.
+ Performance: O(1)
+ */
+- (NSUInteger)countObjectsInSectionAtIndex:(NSUInteger)index
+{
+    return [self.snapshot countObjectsInSectionAtIndex:index];
+}
+
+/**
+ Returns the objects in the section at the index in the latest snapshot.
+ Performance: O(n), where n is the number of objects in the section
+ */
+- (NSArray *)objectsInSectionAtIndex:(NSUInteger)index
+{
+    return [self.snapshot objectsInSectionAtIndex:index];
+}
+
+/**
+ Returns a read-only view of all objects in the latest snapshot, without copying them. The view is unaffected by later updates.
+ Performance: O(1)
+ */
+- (NSArray *)allObjectsView
+{
+    return [self.snapshot allObjectsView];
+}
+
+/**
+ Returns the object at the index path in the latest snapshot.
+ Performance: O(1)
+ */
+- (id)objectAtIndexPath:(NSIndexPath *)indexPath
+{
+    return [self.snapshot objectAtIndexPath:indexPath];
+}
+
+/**
+ Returns YES if the object exists in the latest snapshot.
+ Performance: O(n), where n is the total number of objects (O(1) if INTUGroupedArrayOptionHashedObjectIndex is set)
+ */
+- (BOOL)containsObject:(id)object
+{
+    return [self.snapshot containsObject:object];
+}
+
+/**
+ Returns the index path of the first occurrence of the object in the latest snapshot, or nil if it does not exist.
+ Performance: O(n), where n is the total number of objects
+ */
+- (NSIndexPath *)indexPathOfObject:(id)object
+{
+    return [self.snapshot indexPathOfObject:object];
+}
+
+/**
+ Executes the block for each object in the latest snapshot. Since the snapshot never changes, the grouped array may be updated
+ while the block runs (even from inside the block), without affecting the enumeration.
+ Performance: O(n), where n is the total number of objects
+ */
+- (void)enumerateObjectsUsingBlock:(void (^)(id object, NSIndexPath *indexPath, BOOL *stop))block
+{
+    [self.snapshot enumerateObjectsUsingBlock:block];
+}
+
+#pragma mark Writing
+
+/**
+ Adds an object to the section, and publishes a new snapshot.
+ Performance: O(n), where n is the number of sections, plus O(m) if the section was not modified since the last snapshot, where m is the number of objects in the section
+ */
+- (void)addObject:(id)object toSection:(id)section
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray addObject:object toSection:section];
+    }];
+}
+
+/**
+ Inserts the object at the index path, and publishes a new snapshot.
+ Performance: O(n), where n is the number of sections, plus O(m), where m is the number of objects in the section
+ */
+- (void)insertObject:(id)object atIndexPath:(NSIndexPath *)indexPath
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray insertObject:object atIndexPath:indexPath];
+    }];
+}
+
+/**
+ Replaces the object at the index path with another object, and publishes a new snapshot.
+ Performance: O(n), where n is the number of sections, plus O(m) if the section was not modified since the last snapshot, where m is the number of objects in the section
+ */
+- (void)replaceObjectAtIndexPath:(NSIndexPath *)indexPath withObject:(id)object
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray replaceObjectAtIndexPath:indexPath withObject:object];
+    }];
+}
+
+/**
+ Removes the object at the index path, and publishes a new snapshot.
+ Performance: O(n), where n is the number of sections, plus O(m), where m is the number of objects in the section
+ */
+- (void)removeObjectAtIndexPath:(NSIndexPath *)indexPath
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray removeObjectAtIndexPath:indexPath];
+    }];
+}
+
+/**
+ Removes all occurrences of the object across all sections, and publishes a new snapshot.
+ Performance: O(n), where n is the total number of objects
+ */
+- (void)removeObject:(id)object
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray removeObject:object];
+    }];
+}
+
+/**
+ Removes the section and all objects in it, and publishes a new snapshot.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)removeSection:(id)section
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray removeSection:section];
+    }];
+}
+
+/**
+ Removes all objects and sections, and publishes a new snapshot.
+ Performance: O(n), where n is the total number of objects (see -[INTUMutableGroupedArray removeAllObjects])
+ */
+- (void)removeAllObjects
+{
+    [self performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray removeAllObjects];
+    }];
+}
+
+/**
+ Performs the mutations in the block as a single batch of updates, and then publishes a single new snapshot if the grouped array was mutated.
+ Writers are serialized, so other writers wait until the block returns, while readers keep reading the previous snapshot. Publishing the new
+ snapshot shares the section containers with it, so the next update will copy each section it modifies (copy-on-write).
+ Performance: O(n) to publish the snapshot, where n is the number of sections, plus the cost of the mutations in the block
+ 
+ If the block raises an exception, the mutations it made before raising are published, and the exception is raised again.
+ 
+ @param updates A block that mutates the grouped array passed to it. The grouped array must not be used outside of the block.
+ */
+- (void)performUpdates:(void (^)(INTUMutableGroupedArray *groupedArray))updates
+{
+    if (!updates) {
+        NSAssert(updates, @"Updates block should not be nil.");
+        return;
+    }
+    
+    INTUMutableGroupedArray *mutableGroupedArray = _mutableGroupedArray;
+    @synchronized(mutableGroupedArray) {
+        unsigned long mutations = *[mutableGroupedArray _mutationsPtr];
+        _updateDepth++;
+        @try {
+            [mutableGroupedArray performBatchUpdates:^{
+                updates(mutableGroupedArray);
+            }];
+        } @finally {
+            // Even if the block raised an exception, end the updates and publish any mutations it made before raising, so that later
+            // updates are still published and readers never miss mutations that were made
+            _updateDepth--;
+            // Nested updates (e.g. a write made from inside the block) are published along with the outermost updates, once the batch has ended
+            if (_updateDepth == 0 && *[mutableGroupedArray _mutationsPtr] != mutations) {
+                // Publish the new snapshot with a single atomic store; readers holding the previous snapshot keep it alive until they are done with it
+                self.snapshot = [mutableGroupedArray copy];
+            }
+        }
+    }
+}
+
+#pragma mark NSFastEnumeration Protocol Method
+
+/**
+ Implement to support fast enumeration. Enumerates the snapshot that was current when the enumeration began.
+ */
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+    /* NSFastEnumerationState struct fields (the below constants are used when accessing the values in extra[] for readability) */
+    //                                      state->state     0 the first call, 1 for all subsequent calls
+    const int kSnapshot             = 0; // state->extra[0]  The snapshot being enumerated (not retained)
+    const int kCurrentSectionIndex  = 1; // state->extra[1]  The index of the section to return objects from next
+    const int kCurrentObjectIndex   = 2; // state->extra[2]  The index of the next object to return (within its section)
+    const int kNoMutations          = 3; // state->extra[3]  A mutations token that never changes, since the snapshot is immutable
+    
+    if (state->state == 0) {
+        // It's the first call, do initial configuration of the state
+        state->state = 1;
+        // Storing the snapshot in an autoreleasing variable retains & autoreleases it, which keeps it alive until the autorelease pool that
+        // the enumeration began in is drained, even if a new snapshot is published (and the old one released) during the enumeration.
+        __autoreleasing INTUGroupedArray *snapshot = self.snapshot;
+        state->extra[kSnapshot] = (unsigned long)(__bridge void *)snapshot;
+        state->extra[kCurrentSectionIndex] = 0;
+        state->extra[kCurrentObjectIndex] = 0;
+        state->extra[kNoMutations] = 0;
+        state->mutationsPtr = &state->extra[kNoMutations];
+    }
+    
+    INTUGroupedArray *snapshot = (__bridge INTUGroupedArray *)(void *)state->extra[kSnapshot];
+    NSArray *sectionContainers = snapshot.sectionContainers;
+    NSUInteger sectionCount = [sectionContainers count];
+    NSUInteger currentSectionIndex = state->extra[kCurrentSectionIndex];
+    NSUInteger currentObjectIndex = state->extra[kCurrentObjectIndex];
+    if (currentSectionIndex >= sectionCount) {
+        return 0;
+    }
+    
+    // Return as many objects as will fit in the buffer OR have not yet been returned from the current section, whichever is less
+    // (sections are never empty, so this always returns at least one object)
+    INTUGroupedArraySectionContainer *sectionContainer = sectionContainers[currentSectionIndex];
+    NSArray *objects = sectionContainer.objects;
+    NSUInteger numberOfObjectsInSection = [objects count];
+    NSUInteger numberOfObjectsToReturn = MIN(len, numberOfObjectsInSection - currentObjectIndex);
+    [objects getObjects:buffer range:NSMakeRange(currentObjectIndex, numberOfObjectsToReturn)];
+    state->itemsPtr = &buffer[0];
+    
+    // Advance to the next object, moving on to the next section once all objects in this one have been returned
+    currentObjectIndex += numberOfObjectsToReturn;
+    if (currentObjectIndex == numberOfObjectsInSection) {
+        currentSectionIndex++;
+        currentObjectIndex = 0;
+    }
+    state->extra[kCurrentSectionIndex] = currentSectionIndex;
+    state->extra[kCurrentObjectIndex] = currentObjectIndex;
+    return numberOfObjectsToReturn;
+}
+
+@end
@@ -26,6 +26,7 @@
 
 #import <Foundation/Foundation.h>
 #import "INTUGroupedArrayDefines.h"
+#import "INTUIndexPair.h"
 
 GA__INTU_ASSUME_NONNULL_BEGIN
 
@@ -44,6 +45,31 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - INTUGroupedArrayOptions
+
+/** Options that enable additional internal data structures to accelerate certain operations on a grouped array. */
+typedef NS_OPTIONS(NSUInteger, INTUGroupedArrayOptions) {
+    /** No options; the grouped array only stores its sections & objects. */
+    INTUGroupedArrayOptionNone                  = 0,
+    /** Maintains a hash table that maps each section to its index, so that looking up a section (e.g. -indexOfSection:,
+        -containsSection:, -addObject:toSection:) is O(1) instead of O(n). Sections must implement -hash and -isEqual:
+        consistently, and the hash of a section must not change while the section is in the grouped array. */
+    INTUGroupedArrayOptionHashedSectionIndex    = 1 << 0,
+    /** Maintains a hash table that maps each object to the sections containing it (and how many times), so that testing whether an object
+        exists (e.g. -containsObject:, -containsObject:inSection:) is O(1) instead of O(n), and locating or removing an object by value
+        (e.g. -indexPathOfObject:, -removeObject:) only searches the sections that contain it (which are located in a single pass over
+        the sections, or in O(1) time each if INTUGroupedArrayOptionHashedSectionIndex is also set). Sections & objects must implement -hash
+        and -isEqual: consistently, and their hashes must not change while they are in the grouped array. This uses additional memory
+        for each distinct object, and makes copying the grouped array O(n), where n is the total number of objects. */
+    INTUGroupedArrayOptionHashedObjectIndex     = 1 << 1,
+    /** Stores the objects in each section of a mutable grouped array in fixed-size chunks instead of one contiguous array, so that inserting,
+        removing or moving an object at any position in a section is O(log m) instead of O(m), where m is the number of objects in the section.
+        Looking up an object by index costs a little more. Without this option, only sections that grow past 16,384 objects switch to chunked
+        storage. Immutable grouped arrays ignore this option. */
+    INTUGroupedArrayOptionChunkedSectionStorage = 1 << 2
+};
+
+
 #pragma mark - INTUGroupedArray
 
 /**
@@ -57,6 +83,11 @@ GA__INTU_ASSUME_NONNULL_BEGIN
  Instances of INTUGroupedArray are thread safe, however subclasses may not be (for instance, 
  INTUMutableGroupedArray is NOT thread safe).
  
+ Instances of INTUGroupedArray created with the class factory methods, an INTUGroupedArrayBuilder, or -initWithGroupedArray: store all their
+ objects in a single contiguous buffer (and all their sections in another), so accessing & enumerating the objects reads
+ memory sequentially, and no per-section objects are allocated. Copying a mutable grouped array (-copy) instead shares its
+ sections with the copy, which is faster to create, so use -initWithGroupedArray: for immutable grouped arrays that are long lived.
+ 
  Regular INTUGroupedArray instances act like standard collections and will raise exceptions if assertions are
  enabled when attempting to access sections or objects that don't exist in the grouped array. However, if
  assertions are disabled, INTUGroupedArray will fail gracefully.
@@ -83,10 +114,20 @@ GA__INTU_ASSUME_NONNULL_BEGIN
     Syntax: @[section1, @[object1A, object1B, ...], section2, @[object2A, object2B, ...], ...] */
 + (instancetype)literal:(NSArray *)groupedArrayLiteral;
 
+/** Creates and returns a new grouped array with the objects in the array grouped into sections by the section key block, keeping the
+    order of the objects within each section. Sections are ordered by the first object in each one. */
++ (instancetype)groupedArrayByGroupingArray:(GA__INTU_NULLABLE NSArray *)array sectionKeyBlock:(id (^)(id object))sectionKeyBlock;
+/** Creates and returns a new grouped array with the objects in the array grouped into sections by the section key block, keeping the
+    order of the objects within each section. Sections are sorted by the comparator, if any. If the NSEnumerationConcurrent option is set,
+    the section key block is evaluated concurrently. */
++ (instancetype)groupedArrayByGroupingArray:(GA__INTU_NULLABLE NSArray *)array withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr;
+
 
 #pragma mark Initializers
 
-/** Creates and returns a new grouped array with the contents of a given grouped array. */
+/** Creates and returns a new empty grouped array with the specified options. */
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options;
+/** Creates and returns a new grouped array with the contents of a given grouped array. New immutable grouped arrays store the contents contiguously. */
 - (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray;
 /** Creates and returns a new grouped array with the contents of a given grouped array, optionally copying the sections & objects. */
 - (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray copyItems:(BOOL)copyItems;
@@ -94,6 +135,9 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 
 #pragma mark Access Methods
 
+/** The options the grouped array was created with. Copies of the grouped array have the same options. */
+@property (nonatomic, readonly) INTUGroupedArrayOptions options;
+
 /** Returns the section at the index. */
 - (GA__INTU_GENERICS_TYPE(SectionType))sectionAtIndex:(NSUInteger)index;
 /** Returns the number of sections. */
@@ -134,6 +178,22 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 /** Returns an array of all objects in all sections. */
 - (GA__INTU_GENERICS(NSArray, ObjectType) *)allObjects;
 
+/** Returns the object at the flat index, which counts objects across all sections in order (as if the sections were concatenated). */
+- (GA__INTU_GENERICS_TYPE(ObjectType))objectAtFlatIndex:(NSUInteger)flatIndex;
+/** Returns the index pair of the object at the flat index. */
+- (INTUIndexPair)indexPairForFlatIndex:(NSUInteger)flatIndex;
+/** Returns the flat index of the object at the index pair. */
+- (NSUInteger)flatIndexForIndexPair:(INTUIndexPair)indexPair;
+
+/** Returns a read-only view of the objects in the section at the index, without copying them. The view does not change when the grouped array is mutated. */
+- (GA__INTU_GENERICS(NSArray, ObjectType) *)objectsViewInSectionAtIndex:(NSUInteger)index;
+/** Returns a read-only view of the objects in the section, without copying them. The view does not change when the grouped array is mutated. */
+- (GA__INTU_GENERICS(NSArray, ObjectType) *)objectsViewInSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Returns a read-only view of all objects in all sections, without copying them. The view does not change when the grouped array is mutated. */
+- (GA__INTU_GENERICS(NSArray, ObjectType) *)allObjectsView;
+/** Returns a read-only grouped array of the objects from one index pair to another (inclusive), without copying them. */
+- (GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *)groupedArrayViewFromIndexPair:(INTUIndexPair)fromIndexPair toIndexPair:(INTUIndexPair)toIndexPair;
+
 /** Executes the block for each section in the grouped array. */
 - (void)enumerateSectionsUsingBlock:(void (^)(GA__INTU_GENERICS_TYPE(SectionType) section, NSUInteger index, BOOL *stop))block;
 /** Executes the block for each section in the grouped array with the specified enumeration options. */
@@ -147,6 +207,15 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 /** Executes the block for each object in the section at the index with the specified enumeration options. */
 - (void)enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex withOptions:(NSEnumerationOptions)options usingBlock:(void (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, NSIndexPath *indexPath, BOOL *stop))block;
 
+/** Executes the block for each object in the grouped array, passing the index pair of each object (avoids allocating an NSIndexPath per object). */
+- (void)enumerateObjectsUsingIndexPairBlock:(void (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, INTUIndexPair indexPair, BOOL *stop))block;
+/** Executes the block for each object in the grouped array with the specified enumeration options, passing the index pair of each object. */
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)options usingIndexPairBlock:(void (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, INTUIndexPair indexPair, BOOL *stop))block;
+/** Executes the block for each object in the section at the index, passing the index pair of each object. */
+- (void)enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex usingIndexPairBlock:(void (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, INTUIndexPair indexPair, BOOL *stop))block;
+/** Executes the block for each object in the section at the index with the specified enumeration options, passing the index pair of each object. */
+- (void)enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex withOptions:(NSEnumerationOptions)options usingIndexPairBlock:(void (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, INTUIndexPair indexPair, BOOL *stop))block;
+
 /** Returns an enumerator that will access each section in the grouped array, starting with the first section. */
 - (NSEnumerator<INTUGroupedArraySectionEnumerator> *)sectionEnumerator;
 /** Returns an enumerator that will access each section in the grouped array, starting with the last section. */
@@ -160,15 +229,21 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 - (NSUInteger)indexOfSectionPassingTest:(BOOL (^)(GA__INTU_GENERICS_TYPE(SectionType) section, NSUInteger index, BOOL *stop))block;
 /** Returns the index path of the first object in the grouped array that passes the test. */
 - (NSIndexPath *)indexPathOfObjectPassingTest:(BOOL (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, NSIndexPath *indexPath, BOOL *stop))block;
+/** Returns the index pair of the first object in the grouped array that passes the test, passing the index pair of each object to the test. */
+- (INTUIndexPair)indexPairOfObjectPassingTest:(BOOL (^)(GA__INTU_GENERICS_TYPE(ObjectType) object, INTUIndexPair indexPair, BOOL *stop))block;
 
 /** Returns whether the contents of this grouped array are equal to the contents of another grouped array. */
 - (BOOL)isEqualToGroupedArray:(GA__INTU_NULLABLE INTUGroupedArray *)otherGroupedArray;
 
 /** Returns a new grouped array filtered by evaluating the section & object predicates against all sections & objects and removing those that do not match. Empty sections will be removed. */
 - (GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *)filteredGroupedArrayUsingSectionPredicate:(GA__INTU_NULLABLE NSPredicate *)sectionPredicate objectPredicate:(GA__INTU_NULLABLE NSPredicate *)objectPredicate;
+/** Returns a new grouped array filtered using the section & object predicates with the specified enumeration options. When NSEnumerationConcurrent is set, sections are filtered in parallel (the predicates must be safe to evaluate concurrently). */
+- (GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *)filteredGroupedArrayWithOptions:(NSEnumerationOptions)options usingSectionPredicate:(GA__INTU_NULLABLE NSPredicate *)sectionPredicate objectPredicate:(GA__INTU_NULLABLE NSPredicate *)objectPredicate;
 
 /** Returns a new grouped array with the sections sorted using the section comparator, and the objects in each section sorted using the object comparator. */
 - (GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *)sortedGroupedArrayUsingSectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr objectComparator:(GA__INTU_NULLABLE NSComparator)objectCmptr;
+/** Returns a new sorted grouped array using the section & object comparators with the specified sort options. When NSSortConcurrent is set, the objects in different sections are sorted in parallel (the object comparator must be safe to call concurrently). */
+- (GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *)sortedGroupedArrayWithOptions:(NSSortOptions)options usingSectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr objectComparator:(GA__INTU_NULLABLE NSComparator)objectCmptr;
 
 @end
 
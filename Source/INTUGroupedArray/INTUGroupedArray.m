@@ -30,6 +30,10 @@
 #import "INTUIndexPair.h"
 #import "INTUGroupedArrayInternal.h"
 #import "INTUMutableGroupedArrayInternal.h"
+#import "INTUGroupedArrayContiguousStorage.h"
+#import "INTUGroupedArrayViews.h"
+#import "INTUGroupedArrayInstrumentationInternal.h"
+#import <dispatch/dispatch.h>
 
 #pragma mark - INTUGroupedArraySectionEnumerator
 
@@ -379,15 +383,102 @@
 
 #pragma mark - INTUGroupedArray
 
+/** The maximum number of elements processed by one chunk during concurrent enumeration, which keeps the working set of each chunk cache-sized. */
+static const NSUInteger kINTUGroupedArrayMaxConcurrentChunkSize = 1024;
+/** The number of chunks to aim for per active processor during concurrent enumeration, so that uneven work is balanced across workers. */
+static const NSUInteger kINTUGroupedArrayConcurrentChunksPerProcessor = 8;
+
+/**
+ Returns the index of the section containing the object at the flat index, using a binary search of the table of cumulative object counts.
+ The flat index must be less than the total number of objects (sectionOffsets[sectionCount]).
+ */
+static inline NSUInteger INTUSectionIndexForFlatIndex(const NSUInteger *sectionOffsets, NSUInteger sectionCount, NSUInteger flatIndex)
+{
+    // Maintain sectionOffsets[low] <= flatIndex < sectionOffsets[high]
+    NSUInteger low = 0;
+    NSUInteger high = sectionCount;
+    while (high - low > 1) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (sectionOffsets[mid] <= flatIndex) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ Takes ownership of the section containers in the C array of retained pointers, returning them in order in a mutable array
+ (skipping any NULL entries), and frees the C array.
+ */
+static NSMutableArray *INTUCollectSectionContainers(void **sectionContainers, NSUInteger count)
+{
+    NSMutableArray *collectedSectionContainers = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (sectionContainers[i]) {
+            [collectedSectionContainers addObject:(__bridge_transfer INTUGroupedArraySectionContainer *)sectionContainers[i]];
+        }
+    }
+    free(sectionContainers);
+    return collectedSectionContainers;
+}
+
+/**
+ Records one more instance of the object in the section in the object index map.
+ */
+static void INTUObjectIndexMapAddObject(NSMapTable *objectIndexMap, id object, id section)
+{
+    NSCountedSet *sections = [objectIndexMap objectForKey:object];
+    if (!sections) {
+        sections = [[NSCountedSet alloc] initWithCapacity:1];
+        [objectIndexMap setObject:sections forKey:object];
+    }
+    [sections addObject:section];
+}
+
 @interface GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) ()
+{
+@private
+    /** A table of cumulative object counts with one more entry than there are sections. Entry i is the total number of objects in all
+        sections before section i, and the last entry is the total number of objects in the grouped array. Lazily rebuilt after mutations. */
+    NSUInteger *_sectionOffsets;
+    /** The value of the _mutations instance variable when the table of cumulative object counts was last built. */
+    unsigned long _sectionOffsetsMutations;
+    /** Whether the section index is maintained even though the INTUGroupedArrayOptionHashedSectionIndex option is not set. */
+    BOOL _usesTemporarySectionIndex;
+    /** The contiguous storage of the sections & objects, which immutable grouped arrays use instead of section containers when they are
+        created from a literal, a builder, or another grouped array. nil if the grouped array uses section containers. */
+    INTUGroupedArrayContiguousStorage *_contiguousStorage;
+    /** Whether the object index is built the first time it is used, instead of whenever the section containers are set. Only set for
+        immutable grouped arrays whose objects are decoded lazily, before they are shared. */
+    BOOL _defersObjectIndex;
+}
 
 // An array of INTUGroupedArraySectionContainer objects, which serves as the backing store for the grouped array.
 @property (nonatomic, strong) GA__INTU_GENERICS(NSArray, GA__INTU_GENERICS(INTUGroupedArraySectionContainer, SectionType, ObjectType) *) *sectionContainers;
 
+// Section containers that read their objects from the contiguous storage, which are created the first time that an operation needs
+// section containers (e.g. -mutableCopy). Only used when the grouped array has contiguous storage.
+@property (atomic, strong) NSArray *materializedSectionContainers;
+
+// A map table from each section to its index (boxed in an NSNumber). Only used when the INTUGroupedArrayOptionHashedSectionIndex option is set.
+@property (nonatomic, strong) NSMapTable *sectionIndexMap;
+
+// A map table from each object to a counted set of the sections containing it, where the count of each section is the number of instances
+// of the object in that section. Only used when the INTUGroupedArrayOptionHashedObjectIndex option is set.
+@property (nonatomic, strong) NSMapTable *objectIndexMap;
+
+// The object index of a grouped array that defers building it, which is built the first time that it is used. Only used when the
+// INTUGroupedArrayOptionHashedObjectIndex option is set.
+@property (atomic, strong) NSMapTable *deferredObjectIndexMap;
+
 @end
 
 @implementation INTUGroupedArray
 
+@synthesize sectionContainers = _sectionContainers;
+
 /**
  Helper method to create an index path when the UIKit category on NSIndexPath is not available.
  
@@ -397,6 +488,7 @@
  */
 + (NSIndexPath *)indexPathForRow:(NSUInteger)row inSection:(NSUInteger)section
 {
+    INTU_INSTRUMENT_COUNT(IndexPathsCreated, 1);
     NSUInteger indexArr[] = {section, row};
     return [NSIndexPath indexPathWithIndexes:indexArr length:2];
 }
@@ -409,6 +501,348 @@
     return &_mutations;
 }
 
+/**
+ Sets the array of section containers, and rebuilds the section index and cumulative object counts for them.
+ */
+- (void)setSectionContainers:(NSArray *)sectionContainers
+{
+    _contiguousStorage = nil;
+    self.materializedSectionContainers = nil;
+    _sectionContainers = sectionContainers;
+    [self _rebuildSectionIndex];
+    [self _rebuildObjectIndex];
+    // Build the cumulative object counts right away, so that immutable instances never need to lazily build them (which is not thread safe)
+    [self _rebuildSectionOffsets];
+}
+
+/**
+ Sets the section containers of a newly created immutable grouped array without accessing their objects, so that objects which are
+ decoded lazily stay undecoded. The object index (if the INTUGroupedArrayOptionHashedObjectIndex option is set) is built the first
+ time it is used instead.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)_setSectionContainersDeferringObjectIndex:(NSArray *)sectionContainers
+{
+    NSAssert([self isMemberOfClass:[INTUGroupedArray class]], @"Only immutable grouped arrays can defer building their object index.");
+    _defersObjectIndex = YES;
+    self.sectionContainers = sectionContainers;
+}
+
+/**
+ Returns the array of section containers. If the grouped array has contiguous storage, section containers that read their objects directly
+ from it are created the first time this is called, which is thread safe since immutable grouped arrays may be accessed from multiple threads.
+ Performance: O(1), except for the first call on a grouped array with contiguous storage, which is O(n), where n is the number of sections
+ */
+- (NSArray *)sectionContainers
+{
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (!contiguousStorage) {
+        return _sectionContainers;
+    }
+    NSArray *sectionContainers = self.materializedSectionContainers;
+    if (sectionContainers) {
+        return sectionContainers;
+    }
+    @synchronized(self) {
+        sectionContainers = self.materializedSectionContainers;
+        if (!sectionContainers) {
+            sectionContainers = [contiguousStorage sectionContainers];
+            self.materializedSectionContainers = sectionContainers;
+        }
+    }
+    return sectionContainers;
+}
+
+/**
+ Sets the sections & objects of a newly created grouped array, where each section has the objects in the array at the same index. Instances
+ of this immutable class read the objects straight into contiguous storage; instances of subclasses create a section container for each
+ section with a mutable copy of its array of objects.
+ Performance: O(n), where n is the total number of objects across all sections
+ */
+- (void)_setInitialSections:(NSArray *)sections objectArrays:(NSArray *)objectArrays
+{
+    if ([self isMemberOfClass:[INTUGroupedArray class]]) {
+        [self _setContiguousStorage:[[INTUGroupedArrayContiguousStorage alloc] initWithSections:sections objectArrays:objectArrays copyItems:NO]];
+    } else {
+        NSUInteger sectionCount = [sections count];
+        NSMutableArray *sectionContainers = [NSMutableArray arrayWithCapacity:sectionCount];
+        for (NSUInteger i = 0; i < sectionCount; i++) {
+            INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer sectionContainerWithSection:sections[i]];
+            sectionContainer.objects = [objectArrays[i] mutableCopy];
+            [sectionContainers addObject:sectionContainer];
+        }
+        self.sectionContainers = sectionContainers;
+    }
+}
+
+/**
+ Replaces the contents of the grouped array with the contiguous storage, and rebuilds the section index & object index for it.
+ Must only be called on instances of this immutable class, before they are shared.
+ */
+- (void)_setContiguousStorage:(INTUGroupedArrayContiguousStorage *)contiguousStorage
+{
+    NSAssert([self isMemberOfClass:[INTUGroupedArray class]], @"Only immutable grouped arrays can use contiguous storage.");
+    _sectionContainers = nil;
+    self.materializedSectionContainers = nil;
+    _contiguousStorage = contiguousStorage;
+    [self _rebuildSectionIndex];
+    [self _rebuildObjectIndex];
+}
+
+/**
+ Immutable grouped arrays never modify their section containers, so there is no ownership to give up.
+ */
+- (void)_relinquishSectionContainerOwnership
+{
+    // Nothing to do
+}
+
+/**
+ Immutable grouped arrays never modify their section containers, so there is no ownership to give up.
+ */
+- (void)_relinquishOwnershipOfSectionContainersInRange:(NSRange)range
+{
+    // Nothing to do
+}
+
+/**
+ Returns the table of cumulative object counts, first rebuilding it if the grouped array has been mutated since it was last built.
+ The table has one more entry than there are sections: entry i is the total number of objects in all sections before section i,
+ and the last entry is the total number of objects in the grouped array.
+ Performance: O(1) if the grouped array has not been mutated since the table was last built; otherwise O(n), where n is the number of sections
+ */
+- (const NSUInteger *)_sectionOffsetTable
+{
+    if (_contiguousStorage) {
+        return _contiguousStorage.sectionOffsets;
+    }
+    if (!_sectionOffsets || _sectionOffsetsMutations != _mutations) {
+        [self _rebuildSectionOffsets];
+    }
+    return _sectionOffsets;
+}
+
+/**
+ Marks the table of cumulative object counts as out of date, so that it will be rebuilt the next time it is needed.
+ Only needed for mutations that do not increment _mutations right away (e.g. inside a batch of updates).
+ Performance: O(1)
+ */
+- (void)_invalidateSectionOffsetTable
+{
+    // Any value other than the current value of _mutations will cause the table to be rebuilt
+    _sectionOffsetsMutations = _mutations - 1;
+}
+
+/**
+ Rebuilds the table of cumulative object counts.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)_rebuildSectionOffsets
+{
+    NSArray *sectionContainers = self.sectionContainers;
+    NSUInteger sectionCount = [sectionContainers count];
+    NSUInteger *sectionOffsets = realloc(_sectionOffsets, (sectionCount + 1) * sizeof(NSUInteger));
+    if (!sectionOffsets) {
+        [NSException raise:NSMallocException format:@"Failed to allocate the section offsets for <%@: %p>.", NSStringFromClass([self class]), self];
+    }
+    NSUInteger offset = 0;
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        sectionOffsets[i] = offset;
+        INTUGroupedArraySectionContainer *sectionContainer = sectionContainers[i];
+        offset += [sectionContainer countObjects];
+    }
+    sectionOffsets[sectionCount] = offset;
+    _sectionOffsets = sectionOffsets;
+    _sectionOffsetsMutations = _mutations;
+}
+
+/**
+ Discards and rebuilds the section index from scratch.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)_rebuildSectionIndex
+{
+    if ((_options & INTUGroupedArrayOptionHashedSectionIndex) == 0 && !_usesTemporarySectionIndex) {
+        return;
+    }
+    self.sectionIndexMap = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory valueOptions:NSPointerFunctionsStrongMemory capacity:0];
+    [self _updateSectionIndexInRange:NSMakeRange(0, [self countAllSections])];
+}
+
+/**
+ Updates the section index for the sections currently located in the range of section indices.
+ Performance: O(n), where n is the length of the range
+ */
+- (void)_updateSectionIndexInRange:(NSRange)range
+{
+    NSMapTable *sectionIndexMap = self.sectionIndexMap;
+    if (!sectionIndexMap) {
+        return;
+    }
+    for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+        [sectionIndexMap setObject:@(i) forKey:[self sectionAtIndex:i]];
+    }
+}
+
+/**
+ Starts or stops maintaining a section index when the INTUGroupedArrayOptionHashedSectionIndex option is not set.
+ Performance: O(n) to start, where n is the number of sections; O(1) to stop
+ */
+- (void)_setUsesTemporarySectionIndex:(BOOL)usesTemporarySectionIndex
+{
+    _usesTemporarySectionIndex = usesTemporarySectionIndex;
+    if (usesTemporarySectionIndex) {
+        [self _rebuildSectionIndex];
+    } else if ((_options & INTUGroupedArrayOptionHashedSectionIndex) == 0) {
+        self.sectionIndexMap = nil;
+    }
+}
+
+/**
+ Removes the section from the section index.
+ Performance: O(1)
+ */
+- (void)_removeSectionFromSectionIndex:(id)section
+{
+    if (section) {
+        [self.sectionIndexMap removeObjectForKey:section];
+    }
+}
+
+/**
+ Discards and rebuilds the object index from scratch.
+ Performance: O(n), where n is the total number of objects across all sections
+ */
+- (void)_rebuildObjectIndex
+{
+    if ((_options & INTUGroupedArrayOptionHashedObjectIndex) == 0) {
+        return;
+    }
+    if (_defersObjectIndex) {
+        // Built the next time it is used (see -[objectIndexMap])
+        self.deferredObjectIndexMap = nil;
+        return;
+    }
+    self.objectIndexMap = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory valueOptions:NSPointerFunctionsStrongMemory capacity:0];
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        const NSUInteger *sectionOffsets = contiguousStorage.sectionOffsets;
+        for (NSUInteger sectionIndex = 0; sectionIndex < contiguousStorage.sectionCount; sectionIndex++) {
+            id section = contiguousStorage.sections[sectionIndex];
+            for (NSUInteger flatIndex = sectionOffsets[sectionIndex]; flatIndex < sectionOffsets[sectionIndex + 1]; flatIndex++) {
+                [self _addObject:contiguousStorage.objects[flatIndex] toObjectIndexInSection:section];
+            }
+        }
+        return;
+    }
+    for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
+        [self _addObjects:sectionContainer.objects toObjectIndexInSection:sectionContainer.section];
+    }
+}
+
+/**
+ Returns the object index, or nil if the INTUGroupedArrayOptionHashedObjectIndex option is not set. If the grouped array defers building
+ the object index, it is built the first time this is called, which is thread safe since immutable grouped arrays may be accessed from
+ multiple threads.
+ Performance: O(1), except for the first call on a grouped array that defers building its object index, which is O(n), where n is the
+              total number of objects across all sections
+ */
+- (NSMapTable *)objectIndexMap
+{
+    if (!_defersObjectIndex) {
+        return _objectIndexMap;
+    }
+    if ((_options & INTUGroupedArrayOptionHashedObjectIndex) == 0) {
+        return nil;
+    }
+    NSMapTable *objectIndexMap = self.deferredObjectIndexMap;
+    if (objectIndexMap) {
+        return objectIndexMap;
+    }
+    @synchronized(self) {
+        objectIndexMap = self.deferredObjectIndexMap;
+        if (!objectIndexMap) {
+            objectIndexMap = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory valueOptions:NSPointerFunctionsStrongMemory capacity:0];
+            for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
+                id section = sectionContainer.section;
+                for (id object in sectionContainer.objects) {
+                    INTUObjectIndexMapAddObject(objectIndexMap, object, section);
+                }
+            }
+            self.deferredObjectIndexMap = objectIndexMap;
+        }
+    }
+    return objectIndexMap;
+}
+
+/**
+ Records one more instance of the object in the section in the object index.
+ Performance: O(1)
+ */
+- (void)_addObject:(id)object toObjectIndexInSection:(id)section
+{
+    NSMapTable *objectIndexMap = self.objectIndexMap;
+    if (!objectIndexMap) {
+        return;
+    }
+    INTUObjectIndexMapAddObject(objectIndexMap, object, section);
+}
+
+/**
+ Records one less instance of the object in the section in the object index.
+ Performance: O(1)
+ */
+- (void)_removeObject:(id)object fromObjectIndexInSection:(id)section
+{
+    NSMapTable *objectIndexMap = self.objectIndexMap;
+    if (!objectIndexMap) {
+        return;
+    }
+    NSCountedSet *sections = [objectIndexMap objectForKey:object];
+    [sections removeObject:section];
+    if ([sections count] == 0) {
+        [objectIndexMap removeObjectForKey:object];
+    }
+}
+
+/**
+ Records every object in the array as added to the section in the object index.
+ Performance: O(m), where m is the number of objects in the array
+ */
+- (void)_addObjects:(NSArray *)objects toObjectIndexInSection:(id)section
+{
+    if (!self.objectIndexMap) {
+        return;
+    }
+    for (id object in objects) {
+        [self _addObject:object toObjectIndexInSection:section];
+    }
+}
+
+/**
+ Records every object in the array as removed from the section in the object index.
+ Performance: O(m), where m is the number of objects in the array
+ */
+- (void)_removeObjects:(NSArray *)objects fromObjectIndexInSection:(id)section
+{
+    if (!self.objectIndexMap) {
+        return;
+    }
+    for (id object in objects) {
+        [self _removeObject:object fromObjectIndexInSection:section];
+    }
+}
+
+/**
+ Returns the sections that contain the object, counted by the number of instances of the object in each section.
+ Performance: O(1)
+ */
+- (NSCountedSet *)_sectionsContainingObjectInObjectIndex:(id)object
+{
+    NSAssert(self.objectIndexMap, @"The object index is only available when the INTUGroupedArrayOptionHashedObjectIndex option is set.");
+    return [self.objectIndexMap objectForKey:object];
+}
+
 #pragma mark Class Factory Methods
 
 /**
@@ -433,9 +867,7 @@
 {
     INTUGroupedArray *groupedArray = [self new];
     if ([array count] > 0) {
-        INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer sectionContainerWithSection:[NSObject new]];
-        sectionContainer.objects = [array copy];
-        groupedArray.sectionContainers = @[sectionContainer];
+        [groupedArray _setInitialSections:@[[NSObject new]] objectArrays:@[array]];
     }
     return groupedArray;
 }
@@ -458,6 +890,7 @@
  */
 + (instancetype)literal:(NSArray *)groupedArrayLiteral
 {
+    INTU_INSTRUMENT_TIMING();
     if (!groupedArrayLiteral) {
         NSAssert(groupedArrayLiteral, @"Grouped array literal cannot be nil.");
         return nil;
@@ -468,17 +901,18 @@
         return nil;
     }
     INTUGroupedArray *groupedArray = [self new];
-    NSMutableArray *sectionContainers = [NSMutableArray new];
+    NSUInteger sectionCount = [groupedArrayLiteral count] / 2;
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:sectionCount];
+    NSMutableArray *objectArrays = [NSMutableArray arrayWithCapacity:sectionCount];
     BOOL expectingObjectsArray = NO;
     for (id element in groupedArrayLiteral) {
         if (expectingObjectsArray) {
             if ([element isKindOfClass:[NSArray class]]) {
                 NSArray *objectsArray = element;
-                INTUGroupedArraySectionContainer *sectionContainer = [sectionContainers lastObject];
                 if ([objectsArray count] > 0) {
-                    sectionContainer.objects = [[NSMutableArray alloc] initWithArray:element copyItems:NO];
+                    [objectArrays addObject:objectsArray];
                 } else {
-                    NSAssert([objectsArray count] > 0, @"Grouped array literal is invalid. The array of objects in a section must not be empty. Section: %@", sectionContainer.section);
+                    NSAssert([objectsArray count] > 0, @"Grouped array literal is invalid. The array of objects in a section must not be empty. Section: %@", [sections lastObject]);
                     return nil;
                 }
             } else {
@@ -486,31 +920,278 @@
                 return nil;
             }
         } else {
-            [sectionContainers addObject:[INTUGroupedArraySectionContainer sectionContainerWithSection:element]];
+            [sections addObject:element];
         }
         expectingObjectsArray = !expectingObjectsArray;
     }
-    groupedArray.sectionContainers = sectionContainers;
+    [groupedArray _setInitialSections:sections objectArrays:objectArrays];
+    return groupedArray;
+}
+
+/**
+ Creates and returns a new grouped array with the objects in the array grouped into sections by their section keys.
+ See +[groupedArrayByGroupingArray:withOptions:sectionKeyBlock:sectionComparator:].
+ Performance: O(n), where n is the number of objects
+ */
++ (instancetype)groupedArrayByGroupingArray:(NSArray *)array sectionKeyBlock:(id (^)(id object))sectionKeyBlock
+{
+    return [self groupedArrayByGroupingArray:array withOptions:0 sectionKeyBlock:sectionKeyBlock sectionComparator:nil];
+}
+
+/**
+ Creates and returns a new grouped array with the objects in the array grouped into sections by their section keys, in one pass.
+ The section key block is called once for each object, and returns the section that the object belongs in. Objects keep their order
+ from the array within each section. Objects are bucketed using a hash table, so sections must implement -hash consistently with
+ -isEqual:. This is much faster than adding each object to a mutable grouped array, which has to search for the section every time.
+ Performance: O(n), where n is the number of objects, plus O(m*log(m)), where m is the number of sections, to sort the sections
+ 
+ @param array The array of objects to group.
+ @param options If the NSEnumerationConcurrent option is set, the section key block is called concurrently from multiple threads.
+ @param sectionKeyBlock A block that returns the section for an object. Must not return nil.
+ @param sectionCmptr A comparator used to sort the sections, or nil to order the sections by the first object in each one.
+ @return A new grouped array containing the objects in the array grouped into sections.
+ */
++ (instancetype)groupedArrayByGroupingArray:(NSArray *)array withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(NSComparator)sectionCmptr
+{
+    INTU_INSTRUMENT_TIMING();
+    INTUGroupedArray *groupedArray = [self new];
+    if ([groupedArray isMemberOfClass:[INTUGroupedArray class]]) {
+        [groupedArray _setContiguousStorage:[self _contiguousStorageByGroupingArray:array withOptions:options sectionKeyBlock:sectionKeyBlock sectionComparator:sectionCmptr]];
+    } else {
+        groupedArray.sectionContainers = [self _sectionContainersOfClass:[INTUGroupedArraySectionContainer class] byGroupingArray:array withOptions:options sectionKeyBlock:sectionKeyBlock sectionComparator:sectionCmptr];
+    }
     return groupedArray;
 }
 
+/**
+ Assigns each object in the buffer to a section by its section key, in one pass, without storing the objects anywhere else. Returns the
+ sections in their final order (sorted by the section comparator, if there is one), sets the entry of each object in objectSectionIndexes
+ (which must have room for count entries) to the index of its section in the returned array (or NSNotFound if its section key was nil),
+ and appends the number of objects in each section to sectionObjectCounts (as NSUInteger values).
+ Performance: O(n), where n is the number of objects, plus O(m*log(m)), where m is the number of sections, to sort the sections
+ */
++ (NSArray *)_sectionsByGroupingObjects:(__unsafe_unretained id const *)objects count:(NSUInteger)count withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(NSComparator)sectionCmptr objectSectionIndexes:(NSUInteger *)objectSectionIndexes sectionObjectCounts:(NSMutableData *)sectionObjectCounts
+{
+    sectionCmptr = INTU_INSTRUMENT_COMPARATOR(sectionCmptr);
+    
+    // When the section keys are computed concurrently, store them retained in a C array until they have all been bucketed
+    void **sectionKeys = NULL;
+    if (options & NSEnumerationConcurrent) {
+        sectionKeys = calloc(count, sizeof(void *));
+        [INTUGroupedArray _concurrentlyEnumerateChunksOfCount:count reverse:NO usingBlock:^(NSRange chunkRange, volatile BOOL *stop) {
+            @autoreleasepool {
+                for (NSUInteger index = chunkRange.location; index < NSMaxRange(chunkRange); index++) {
+                    sectionKeys[index] = (void *)CFBridgingRetain(sectionKeyBlock(objects[index]));
+                }
+            }
+        }];
+    }
+    
+    // Map each section to its index in sections. Values are stored as index + 1, since NULL means that there is no value.
+    NSMutableArray *sections = [NSMutableArray new];
+    CFMutableDictionaryRef sectionIndexes = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    id lastSection = nil;
+    NSUInteger lastSectionIndex = NSNotFound;
+    for (NSUInteger index = 0; index < count; index++) {
+        id sectionKey = sectionKeys ? (__bridge id)sectionKeys[index] : sectionKeyBlock(objects[index]);
+        if (!sectionKey) {
+            NSAssert(sectionKey, @"Section key block should not return nil. Object: %@", objects[index]);
+            objectSectionIndexes[index] = NSNotFound;
+            continue;
+        }
+        // Consecutive objects often belong to the same section, so check the last section before doing a hash lookup
+        if (lastSection == nil || (lastSection != sectionKey && [lastSection isEqual:sectionKey] == NO)) {
+            lastSectionIndex = (NSUInteger)CFDictionaryGetValue(sectionIndexes, (__bridge const void *)sectionKey);
+            if (lastSectionIndex > 0) {
+                lastSectionIndex--;
+            } else {
+                lastSectionIndex = [sections count];
+                [sections addObject:sectionKey];
+                [sectionObjectCounts increaseLengthBy:sizeof(NSUInteger)];
+                CFDictionarySetValue(sectionIndexes, (__bridge const void *)sectionKey, (const void *)[sections count]);
+            }
+            lastSection = sections[lastSectionIndex];
+        }
+        objectSectionIndexes[index] = lastSectionIndex;
+        ((NSUInteger *)[sectionObjectCounts mutableBytes])[lastSectionIndex]++;
+    }
+    CFRelease(sectionIndexes);
+    
+    if (sectionKeys) {
+        for (NSUInteger index = 0; index < count; index++) {
+            if (sectionKeys[index]) {
+                CFRelease(sectionKeys[index]);
+            }
+        }
+        free(sectionKeys);
+    }
+    
+    if (sectionCmptr && [sections count] > 1) {
+        // Sort the indexes of the sections, and then renumber the sections of the objects & the counts in the sorted order
+        NSUInteger sectionCount = [sections count];
+        NSMutableArray *sortedSectionIndexes = [NSMutableArray arrayWithCapacity:sectionCount];
+        for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+            [sortedSectionIndexes addObject:@(sectionIndex)];
+        }
+        [sortedSectionIndexes sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSNumber *sectionIndex1, NSNumber *sectionIndex2) {
+            return sectionCmptr(sections[[sectionIndex1 unsignedIntegerValue]], sections[[sectionIndex2 unsignedIntegerValue]]);
+        }];
+        NSMutableData *newSectionIndexes = [NSMutableData dataWithLength:sectionCount * sizeof(NSUInteger)];
+        NSUInteger *newSectionIndexOfSection = [newSectionIndexes mutableBytes];
+        NSMutableArray *sortedSections = [NSMutableArray arrayWithCapacity:sectionCount];
+        NSData *unsortedCounts = [sectionObjectCounts copy];
+        const NSUInteger *unsortedCountOfSection = [unsortedCounts bytes];
+        NSUInteger *countOfSection = [sectionObjectCounts mutableBytes];
+        for (NSUInteger newSectionIndex = 0; newSectionIndex < sectionCount; newSectionIndex++) {
+            NSUInteger sectionIndex = [sortedSectionIndexes[newSectionIndex] unsignedIntegerValue];
+            newSectionIndexOfSection[sectionIndex] = newSectionIndex;
+            [sortedSections addObject:sections[sectionIndex]];
+            countOfSection[newSectionIndex] = unsortedCountOfSection[sectionIndex];
+        }
+        for (NSUInteger index = 0; index < count; index++) {
+            if (objectSectionIndexes[index] != NSNotFound) {
+                objectSectionIndexes[index] = newSectionIndexOfSection[objectSectionIndexes[index]];
+            }
+        }
+        sections = sortedSections;
+    }
+    return sections;
+}
+
+/**
+ Groups the objects in the array into new section containers of the class, each with a mutable array of objects, by their section keys.
+ */
++ (NSMutableArray *)_sectionContainersOfClass:(Class)sectionContainerClass byGroupingArray:(NSArray *)array withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(NSComparator)sectionCmptr
+{
+    if (!sectionKeyBlock) {
+        NSAssert(sectionKeyBlock, @"Section key block should not be nil.");
+        return [NSMutableArray new];
+    }
+    NSUInteger count = [array count];
+    if (count == 0) {
+        return [NSMutableArray new];
+    }
+    
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    [array getObjects:objects range:NSMakeRange(0, count)];
+    NSMutableData *objectSectionIndexesData = [NSMutableData dataWithLength:count * sizeof(NSUInteger)];
+    const NSUInteger *objectSectionIndexes = [objectSectionIndexesData mutableBytes];
+    NSMutableData *sectionObjectCountsData = [NSMutableData data];
+    NSArray *sections = [self _sectionsByGroupingObjects:objects count:count withOptions:options sectionKeyBlock:sectionKeyBlock sectionComparator:sectionCmptr
+                                    objectSectionIndexes:[objectSectionIndexesData mutableBytes] sectionObjectCounts:sectionObjectCountsData];
+    const NSUInteger *sectionObjectCounts = [sectionObjectCountsData bytes];
+    
+    NSUInteger sectionCount = [sections count];
+    NSMutableArray *sectionContainers = [NSMutableArray arrayWithCapacity:sectionCount];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        INTUGroupedArraySectionContainer *sectionContainer = [sectionContainerClass sectionContainerWithSection:sections[sectionIndex]];
+        sectionContainer.objects = [NSMutableArray arrayWithCapacity:sectionObjectCounts[sectionIndex]];
+        [sectionContainers addObject:sectionContainer];
+    }
+    for (NSUInteger index = 0; index < count; index++) {
+        if (objectSectionIndexes[index] != NSNotFound) {
+            INTUGroupedArraySectionContainer *sectionContainer = sectionContainers[objectSectionIndexes[index]];
+            [(NSMutableArray *)sectionContainer.objects addObject:objects[index]];
+        }
+    }
+    free(objects);
+    return sectionContainers;
+}
+
+/**
+ Groups the objects in the array by their section keys straight into new contiguous storage, without creating a section container or
+ an array of objects for each section first: the objects are counted per section, and then each one is placed directly in its slot.
+ Performance: O(n), where n is the number of objects, plus O(m*log(m)), where m is the number of sections, to sort the sections
+ */
++ (INTUGroupedArrayContiguousStorage *)_contiguousStorageByGroupingArray:(NSArray *)array withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(NSComparator)sectionCmptr
+{
+    NSUInteger count = [array count];
+    if (!sectionKeyBlock || count == 0) {
+        NSAssert(sectionKeyBlock, @"Section key block should not be nil.");
+        return [[INTUGroupedArrayContiguousStorage alloc] initWithSections:@[] objectArrays:@[] copyItems:NO];
+    }
+    
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    [array getObjects:objects range:NSMakeRange(0, count)];
+    NSMutableData *objectSectionIndexesData = [NSMutableData dataWithLength:count * sizeof(NSUInteger)];
+    const NSUInteger *objectSectionIndexes = [objectSectionIndexesData mutableBytes];
+    NSMutableData *sectionObjectCountsData = [NSMutableData data];
+    NSArray *sections = [self _sectionsByGroupingObjects:objects count:count withOptions:options sectionKeyBlock:sectionKeyBlock sectionComparator:sectionCmptr
+                                    objectSectionIndexes:[objectSectionIndexesData mutableBytes] sectionObjectCounts:sectionObjectCountsData];
+    const NSUInteger *sectionObjectCounts = [sectionObjectCountsData bytes];
+    
+    NSUInteger sectionCount = [sections count];
+    NSUInteger *sectionOffsets = malloc((sectionCount + 1) * sizeof(NSUInteger));
+    // Allocate at least one entry for each buffer, so that a failed allocation can be told apart from an empty one
+    void **sectionsBuffer = malloc(MAX(sectionCount, (NSUInteger)1) * sizeof(void *));
+    void **objectsBuffer = malloc(count * sizeof(void *));
+    // The next free slot of each section in the buffer of objects
+    NSMutableData *nextObjectIndexesData = [NSMutableData dataWithLength:MAX(sectionCount, (NSUInteger)1) * sizeof(NSUInteger)];
+    NSUInteger *nextObjectIndexes = [nextObjectIndexesData mutableBytes];
+    if (!sectionOffsets || !sectionsBuffer || !objectsBuffer) {
+        free(sectionOffsets);
+        free(sectionsBuffer);
+        free(objectsBuffer);
+        free(objects);
+        [NSException raise:NSMallocException format:@"Failed to allocate contiguous storage for %lu sections and %lu objects.", (unsigned long)sectionCount, (unsigned long)count];
+    }
+    sectionOffsets[0] = 0;
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        sectionsBuffer[sectionIndex] = (__bridge_retained void *)sections[sectionIndex];
+        nextObjectIndexes[sectionIndex] = sectionOffsets[sectionIndex];
+        sectionOffsets[sectionIndex + 1] = sectionOffsets[sectionIndex] + sectionObjectCounts[sectionIndex];
+    }
+    // The buffers hold a strong reference (+1 retain count) to each section & object, which the contiguous storage takes over
+    for (NSUInteger index = 0; index < count; index++) {
+        NSUInteger sectionIndex = objectSectionIndexes[index];
+        if (sectionIndex != NSNotFound) {
+            objectsBuffer[nextObjectIndexes[sectionIndex]] = (__bridge_retained void *)objects[index];
+            nextObjectIndexes[sectionIndex]++;
+        }
+    }
+    free(objects);
+    return [[INTUGroupedArrayContiguousStorage alloc] initByAdoptingSections:sectionsBuffer
+                                                                       count:sectionCount
+                                                                     objects:objectsBuffer
+                                                                       count:sectionOffsets[sectionCount]
+                                                              sectionOffsets:sectionOffsets];
+}
+
 #pragma mark Initializers
 
+- (void)dealloc
+{
+    free(_sectionOffsets);
+}
+
 /**
- Designated initializer.
+ Creates and returns a new empty grouped array.
  */
 - (instancetype)init
+{
+    return [self initWithOptions:INTUGroupedArrayOptionNone];
+}
+
+/**
+ Designated initializer.
+ Creates and returns a new empty grouped array with the specified options.
+ 
+ @param options The options for the grouped array, which will also apply to all copies of it.
+ @return A new empty grouped array with the specified options.
+ */
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options
 {
     self = [super init];
     if (self) {
-        _sectionContainers = [NSArray new];
+        _options = options;
+        self.sectionContainers = [NSArray new];
     }
     return self;
 }
 
 /**
  Creates and returns a new grouped array with the contents of a given grouped array.
- The sections and objects will not be copied.
+ The sections and objects will not be copied. Unlike -copy, this stores the sections & objects of a new immutable grouped array contiguously.
  
  @param groupedArray A grouped array containing the sections & objects with which to initialize the new grouped array.
  @return A new grouped array with the contents of the given grouped array.
@@ -522,6 +1203,9 @@
 
 /**
  Creates and returns a new grouped array with the contents of a given grouped array, optionally copying the sections & objects.
+ A new immutable grouped array stores the sections & objects contiguously, sharing the contiguous storage of the given grouped array (if it
+ has any) when the sections & objects are not copied.
+ Performance: O(n), where n is the total number of objects across all sections (O(1) if the contiguous storage is shared)
  
  @param groupedArray A grouped array containing the sections & objects with which to initialize the new grouped array.
  @param copyItems Whether the sections & objects in the grouped array should be copied.
@@ -529,19 +1213,33 @@
  */
 - (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray copyItems:(BOOL)copyItems
 {
-    __typeof(self) newGroupedArray = [[[self class] alloc] init];
-    if (copyItems) {
+    INTU_INSTRUMENT_TIMING();
+    __typeof(self) newGroupedArray = [[[self class] alloc] initWithOptions:groupedArray.options];
+    if ([newGroupedArray isMemberOfClass:[INTUGroupedArray class]]) {
+        // Contiguous storage is never modified, so it can be shared by both grouped arrays
+        INTUGroupedArrayContiguousStorage *contiguousStorage = (groupedArray && !copyItems) ? groupedArray->_contiguousStorage : nil;
+        if (!contiguousStorage) {
+            contiguousStorage = [[INTUGroupedArrayContiguousStorage alloc] initWithSectionContainers:groupedArray.sectionContainers copyItems:copyItems];
+            if (copyItems) {
+                INTU_INSTRUMENT_COUNT(ObjectsCopied, contiguousStorage.objectCount);
+            }
+        }
+        [newGroupedArray _setContiguousStorage:contiguousStorage];
+    } else if (copyItems) {
         // Copy the sections & objects in the grouped array into the new one
         NSMutableArray *newSectionContainers = [NSMutableArray array];
         for (INTUGroupedArraySectionContainer *sectionContainer in groupedArray.sectionContainers) {
             [newSectionContainers addObject:[[INTUGroupedArraySectionContainer alloc] initWithSectionContainer:sectionContainer copyItems:YES]];
+            INTU_INSTRUMENT_COUNT(SectionContainersCopied, 1);
+            INTU_INSTRUMENT_COUNT(ObjectsCopied, [sectionContainer countObjects]);
         }
         newGroupedArray.sectionContainers = newSectionContainers;
     } else {
         // Perform a shallow copy of the grouped array, without copying the sections & objects
-        // The array of sectionContainers is has its INTUGroupedArraySectionContainer objects copied, but this is only a one-level-deep copy,
-        // so the sections & objects in the grouped array will NOT be copied!
-        newGroupedArray.sectionContainers = [[NSMutableArray alloc] initWithArray:groupedArray.sectionContainers copyItems:YES];
+        // The INTUGroupedArraySectionContainer objects are shared between the two grouped arrays, and will be copied before either one
+        // modifies them (copy-on-write), so the sections & objects in the grouped array will NOT be copied!
+        newGroupedArray.sectionContainers = [[NSMutableArray alloc] initWithArray:groupedArray.sectionContainers];
+        [groupedArray _relinquishSectionContainerOwnership];
     }
     return newGroupedArray;
 }
@@ -553,9 +1251,13 @@
  */
 - (id)initWithCoder:(NSCoder *)aDecoder
 {
-    self = [self init];
+    INTU_INSTRUMENT_TIMING();
+    self = [self initWithOptions:(INTUGroupedArrayOptions)[aDecoder decodeIntegerForKey:@"options"]];
     if (self) {
-        _sectionContainers = [aDecoder decodeObjectForKey:@"sectionContainers"];
+        NSArray *sectionContainers = [aDecoder decodeObjectForKey:@"sectionContainers"];
+        if (sectionContainers) {
+            self.sectionContainers = sectionContainers;
+        }
     }
     return self;
 }
@@ -565,8 +1267,14 @@
  */
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
-    if (_sectionContainers) {
-        [aCoder encodeObject:_sectionContainers forKey:@"sectionContainers"];
+    INTU_INSTRUMENT_TIMING();
+    // Use the accessor, since grouped arrays with contiguous storage create their section containers on demand
+    NSArray *sectionContainers = self.sectionContainers;
+    if (sectionContainers) {
+        [aCoder encodeObject:sectionContainers forKey:@"sectionContainers"];
+    }
+    if (_options != INTUGroupedArrayOptionNone) {
+        [aCoder encodeInteger:(NSInteger)_options forKey:@"options"];
     }
 }
 
@@ -587,10 +1295,11 @@
  */
 - (id)mutableCopyWithZone:(NSZone *)zone
 {
-    INTUMutableGroupedArray *copy = [[INTUMutableGroupedArray allocWithZone:zone] init];
-    for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-        [copy.mutableSectionContainers addObject:[sectionContainer mutableCopy]];
-    }
+    INTU_INSTRUMENT_TIMING();
+    INTUMutableGroupedArray *copy = [[INTUMutableGroupedArray allocWithZone:zone] initWithOptions:self.options];
+    // The section containers are shared with the mutable copy, which will copy each one before modifying it (copy-on-write),
+    // so this only needs to copy the array of section containers.
+    copy.mutableSectionContainers = [[NSMutableArray allocWithZone:zone] initWithArray:self.sectionContainers];
     return copy;
 }
 
@@ -653,6 +1362,18 @@
     unsigned long currentObjectIndex;
     unsigned long numberOfObjectsInSection;
     
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        // All objects are stored contiguously in order, so return them all at once, pointing directly into the storage
+        if (state->state != 0) {
+            return 0;
+        }
+        state->state = 1;
+        state->mutationsPtr = &_mutations;
+        state->itemsPtr = (__unsafe_unretained id *)(void *)contiguousStorage.objects;
+        return contiguousStorage.objectCount;
+    }
+    
     if (state->state == 0) {
         // It's the first call, do initial configuration of the state
         state->state = 1;
@@ -728,6 +1449,14 @@
  */
 - (id)sectionAtIndex:(NSUInteger)index
 {
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        if (index >= contiguousStorage.sectionCount) {
+            NSAssert(index < contiguousStorage.sectionCount, @"Index out of bounds!");
+            return nil;
+        }
+        return contiguousStorage.sections[index];
+    }
     if (index >= [self.sectionContainers count]) {
         NSAssert(index < [self.sectionContainers count], @"Index out of bounds!");
         return nil;
@@ -744,6 +1473,10 @@
  */
 - (NSUInteger)countAllSections
 {
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        return contiguousStorage.sectionCount;
+    }
     return [self.sectionContainers count];
 }
 
@@ -755,6 +1488,10 @@
  */
 - (NSArray *)allSections
 {
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        return [NSMutableArray arrayWithObjects:contiguousStorage.sections count:contiguousStorage.sectionCount];
+    }
     NSMutableArray *allSections = [NSMutableArray array];
     NSUInteger sectionCount = [self countAllSections];
     for (NSUInteger i = 0; i < sectionCount; i++) {
@@ -765,7 +1502,7 @@
 
 /**
  Returns whether the section exists.
- Performance: O(n), where n is the number of sections
+ Performance: O(1) if the INTUGroupedArrayOptionHashedSectionIndex option is set; otherwise O(n), where n is the number of sections
  
  @param section The section to test for.
  @return Whether or not the section exists in the grouped array.
@@ -777,25 +1514,37 @@
 
 /**
  Returns the index for the section.
- Performance: O(n), where n is the number of sections
+ Performance: O(1) if the INTUGroupedArrayOptionHashedSectionIndex option is set; otherwise O(n), where n is the number of sections
  
  @param section The section to locate.
  @return The index of the section in the grouped array, or NSNotFound if the section does not exist.
  */
 - (NSUInteger)indexOfSection:(id)section
 {
+    INTU_INSTRUMENT_TIMING();
     if (!section) {
         NSAssert(section, @"Section should not be nil.");
         return NSNotFound;
     }
     
+    INTU_INSTRUMENT_COUNT(SectionLookups, 1);
+    NSMapTable *sectionIndexMap = self.sectionIndexMap;
+    if (sectionIndexMap) {
+        // Look up the section in the section index
+        NSNumber *sectionIndex = [sectionIndexMap objectForKey:section];
+        return sectionIndex ? [sectionIndex unsignedIntegerValue] : NSNotFound;
+    }
+    
     // Scan the array of sections to find the one we need
+    INTU_INSTRUMENT_COUNT(SectionLookupScans, 1);
     NSUInteger sectionCount = [self countAllSections];
     for (NSUInteger i = 0; i < sectionCount; i++) {
         if ([section isEqual:[self sectionAtIndex:i]]) {
+            INTU_INSTRUMENT_COUNT(SectionsScanned, i + 1);
             return i;
         }
     }
+    INTU_INSTRUMENT_COUNT(SectionsScanned, sectionCount);
     return NSNotFound;
 }
 
@@ -804,7 +1553,7 @@
 /**
  Returns the object at the index in the section.
  An exception will be raised if the index is out of bounds.
- Performance: O(n), where n is the number of sections
+ Performance: O(1) if the INTUGroupedArrayOptionHashedSectionIndex option is set; otherwise O(n), where n is the number of sections
  
  @param index The index of the desired object in its section.
  @param section The section of the desired object.
@@ -851,6 +1600,19 @@
  */
 - (id)_objectAtIndexPair:(INTUIndexPair)indexPair
 {
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        if (indexPair.sectionIndex >= contiguousStorage.sectionCount) {
+            NSAssert(indexPair.sectionIndex < contiguousStorage.sectionCount, @"Index out of bounds!");
+            return nil;
+        }
+        const NSUInteger *sectionOffsets = contiguousStorage.sectionOffsets;
+        if (indexPair.objectIndex >= sectionOffsets[indexPair.sectionIndex + 1] - sectionOffsets[indexPair.sectionIndex]) {
+            NSAssert(indexPair.objectIndex < sectionOffsets[indexPair.sectionIndex + 1] - sectionOffsets[indexPair.sectionIndex], @"Index out of bounds!");
+            return nil;
+        }
+        return contiguousStorage.objects[sectionOffsets[indexPair.sectionIndex] + indexPair.objectIndex];
+    }
     if (indexPair.sectionIndex >= [self.sectionContainers count]) {
         NSAssert(indexPair.sectionIndex < [self.sectionContainers count], @"Index out of bounds!");
         return nil;
@@ -864,6 +1626,21 @@
     return objectsInSection[indexPair.objectIndex];
 }
 
+/**
+ Returns the array of objects in the section at the index without copying it, reading the objects directly from the contiguous storage
+ if the grouped array has any. The index must be in bounds.
+ Performance: O(1)
+ */
+- (NSArray *)_objectsArrayInSectionAtIndex:(NSUInteger)index
+{
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        const NSUInteger *sectionOffsets = contiguousStorage.sectionOffsets;
+        return [contiguousStorage objectsInRange:NSMakeRange(sectionOffsets[index], sectionOffsets[index + 1] - sectionOffsets[index])];
+    }
+    return ((INTUGroupedArraySectionContainer *)self.sectionContainers[index]).objects;
+}
+
 /**
  Returns the first object in the first section.
  Performance: O(1)
@@ -896,30 +1673,76 @@
 
 /**
  Returns whether the object exists in any section.
- Performance: O(n), where n is the total number of objects across all sections
+ Performance: O(1) if the INTUGroupedArrayOptionHashedObjectIndex option is set; otherwise O(n), where n is the total number of objects across all sections
  
  @param object The object to test for.
  @return Whether or not the object exists in the grouped array.
  */
 - (BOOL)containsObject:(id)object
 {
+    INTU_INSTRUMENT_TIMING();
+    if (object && self.objectIndexMap) {
+        return [self.objectIndexMap objectForKey:object] != nil;
+    }
     return [self indexPathOfObject:object] != nil;
 }
 
 /**
  Returns the index path of the first instance of the object across all sections.
- Performance: O(n), where n is the total number of objects across all sections
+ Performance: O(n), where n is the total number of objects across all sections. If the INTUGroupedArrayOptionHashedObjectIndex option is set,
+              only the first section containing the object is searched: O(k+m), where k is the number of sections containing the object,
+              and m is the number of objects in the first one, if the INTUGroupedArrayOptionHashedSectionIndex option is also set (so each
+              section is located in O(1) time); otherwise O(s+m), where s is the number of sections (to locate the first one)
  
  @param object The object to locate.
  @return The index path of the first instance of the object, or nil if the object does not exist.
  */
 - (NSIndexPath *)indexPathOfObject:(id)object
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object) {
         NSAssert(object, @"Object should not be nil.");
         return nil;
     }
     
+    if (self.objectIndexMap) {
+        // Only search the first of the sections that contain the object
+        NSCountedSet *sectionsContainingObject = [self.objectIndexMap objectForKey:object];
+        NSUInteger firstSectionIdx = NSNotFound;
+        if (self.sectionIndexMap || [sectionsContainingObject count] <= 1) {
+            // Each section is located in O(1) time using the section index (or there is at most one to locate)
+            for (id section in sectionsContainingObject) {
+                firstSectionIdx = MIN(firstSectionIdx, [self indexOfSection:section]);
+            }
+        } else {
+            // Find the first section containing the object in a single pass, instead of searching for each one
+            NSUInteger sectionCount = [self countAllSections];
+            for (NSUInteger sectionIdx = 0; sectionIdx < sectionCount; sectionIdx++) {
+                if ([sectionsContainingObject member:[self sectionAtIndex:sectionIdx]]) {
+                    firstSectionIdx = sectionIdx;
+                    break;
+                }
+            }
+        }
+        if (firstSectionIdx == NSNotFound) {
+            return nil;
+        }
+        NSArray *objectsInSection = [self _objectsArrayInSectionAtIndex:firstSectionIdx];
+        return [INTUGroupedArray indexPathForRow:[objectsInSection indexOfObject:object] inSection:firstSectionIdx];
+    }
+    
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        // Scan the objects in order, then find the section containing the object
+        for (NSUInteger flatIndex = 0; flatIndex < contiguousStorage.objectCount; flatIndex++) {
+            if ([object isEqual:contiguousStorage.objects[flatIndex]]) {
+                NSUInteger sectionIdx = INTUSectionIndexForFlatIndex(contiguousStorage.sectionOffsets, contiguousStorage.sectionCount, flatIndex);
+                return [INTUGroupedArray indexPathForRow:flatIndex - contiguousStorage.sectionOffsets[sectionIdx] inSection:sectionIdx];
+            }
+        }
+        return nil;
+    }
+    
     // Scan the grouped array to find the object
     NSUInteger sectionCount = [self countAllSections];
     for (NSUInteger sectionIdx = 0; sectionIdx < sectionCount; sectionIdx++) {
@@ -935,7 +1758,8 @@
 
 /**
  Returns whether the object exists in the section.
- Performance: O(n+m), where n is the number of sections, and m is the number of objects in the section
+ Performance: O(1) if the INTUGroupedArrayOptionHashedObjectIndex option is set; otherwise O(n+m), where n is the number of sections,
+              and m is the number of objects in the section
  
  @param object The object to test for.
  @param section The section to test for the object in.
@@ -943,12 +1767,16 @@
  */
 - (BOOL)containsObject:(id)object inSection:(id)section
 {
+    if (object && section && self.objectIndexMap) {
+        return [[self.objectIndexMap objectForKey:object] countForObject:section] > 0;
+    }
     return [self indexOfObject:object inSection:section] != NSNotFound;
 }
 
 /**
  Returns the index of the first instance of the object in the section.
  Performance: O(n+m), where n is the number of sections, and m is the number of objects in the section
+              (O(1) if the INTUGroupedArrayOptionHashedObjectIndex option is set and the object is not in the section)
  
  @param object The object to locate.
  @param section The section to locate the object in.
@@ -956,12 +1784,18 @@
  */
 - (NSUInteger)indexOfObject:(id)object inSection:(id)section
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object || !section) {
         NSAssert(object, @"Object should not be nil.");
         NSAssert(section, @"Section should not be nil.");
         return NSNotFound;
     }
     
+    if (self.objectIndexMap && [[self.objectIndexMap objectForKey:object] countForObject:section] == 0) {
+        // The object is not in the section, so there is no need to search for it
+        return NSNotFound;
+    }
+    
     NSUInteger sectionIndex = [self indexOfSection:section];
     if (sectionIndex == NSNotFound) {
         return NSNotFound;
@@ -978,7 +1812,7 @@
 
 /**
  Returns the number of objects in the section.
- Performance: O(n), where n is the number of sections
+ Performance: O(1) if the INTUGroupedArrayOptionHashedSectionIndex option is set; otherwise O(n), where n is the number of sections
  
  @param section The section to count the number of objects in.
  @return The number of objects in the section, or zero if the section does not exist.
@@ -1006,12 +1840,20 @@
  */
 - (NSUInteger)countObjectsInSectionAtIndex:(NSUInteger)index
 {
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        if (index >= contiguousStorage.sectionCount) {
+            NSAssert(index < contiguousStorage.sectionCount, @"Index out of bounds!");
+            return 0;
+        }
+        return contiguousStorage.sectionOffsets[index + 1] - contiguousStorage.sectionOffsets[index];
+    }
     if (index >= [self.sectionContainers count]) {
         NSAssert(index < [self.sectionContainers count], @"Index out of bounds!");
         return 0;
     }
     INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[index];
-    return [sectionContainer.objects count];
+    return [sectionContainer countObjects];
 }
 
 /**
@@ -1040,57 +1882,240 @@
  An exception will be raised if the index is out of bounds.
  Performance: O(n), where n is the number of objects in the section
  
- @param index The index of the section to get the objects of.
- @return A new array of all the objects in the section, or nil if the index is out of bounds.
+ @param index The index of the section to get the objects of.
+ @return A new array of all the objects in the section, or nil if the index is out of bounds.
+ */
+- (NSArray *)objectsInSectionAtIndex:(NSUInteger)index
+{
+    if (index >= [self countAllSections]) {
+        NSAssert(index < [self countAllSections], @"Index out of bounds!");
+        return nil;
+    }
+    
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        const NSUInteger *sectionOffsets = contiguousStorage.sectionOffsets;
+        return [NSMutableArray arrayWithObjects:contiguousStorage.objects + sectionOffsets[index] count:sectionOffsets[index + 1] - sectionOffsets[index]];
+    }
+    NSUInteger objectCount = [self countObjectsInSectionAtIndex:index];
+    NSMutableArray *objectsInSection = [NSMutableArray arrayWithCapacity:objectCount];
+    for (NSUInteger objectIdx = 0; objectIdx < objectCount; objectIdx++) {
+        [objectsInSection addObject:[self _objectAtIndexPair:INTUIndexPairMake(index, objectIdx)]];
+    }
+    return objectsInSection;
+}
+
+/**
+ Returns the total number of objects in all sections.
+ Performance: O(1), except for the first call after the grouped array is mutated, which is O(n), where n is the number of sections
+ 
+ @return The number of objects in all sections of the grouped array.
+ */
+- (NSUInteger)countAllObjects
+{
+    return [self _sectionOffsetTable][[self countAllSections]];
+}
+
+/**
+ Returns an array of all objects in all sections.
+ Performance: O(n), where n is the total number of objects across all sections
+ 
+ @return A new array of all objects in all sections of the grouped array.
+ */
+- (NSArray *)allObjects
+{
+    INTU_INSTRUMENT_TIMING();
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        return [NSMutableArray arrayWithObjects:contiguousStorage.objects count:contiguousStorage.objectCount];
+    }
+    NSMutableArray *allObjects = [NSMutableArray array];
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIdx = 0; sectionIdx < sectionCount; sectionIdx++) {
+        NSUInteger objectCount = [self countObjectsInSectionAtIndex:sectionIdx];
+        for (NSUInteger objectIdx = 0; objectIdx < objectCount; objectIdx++) {
+            [allObjects addObject:[self _objectAtIndexPair:INTUIndexPairMake(sectionIdx, objectIdx)]];
+        }
+    }
+    return allObjects;
+}
+
+/**
+ Returns the object at the flat index, which counts objects across all sections in order (as if the sections were concatenated).
+ An exception will be raised if the flat index is out of bounds.
+ Performance: O(log n), where n is the number of sections
+ 
+ @param flatIndex The flat index of the object.
+ @return The object at the flat index, or nil if the flat index is out of bounds.
+ */
+- (id)objectAtFlatIndex:(NSUInteger)flatIndex
+{
+    INTUIndexPair indexPair = [self indexPairForFlatIndex:flatIndex];
+    if (indexPair.sectionIndex == NSNotFound) {
+        return nil;
+    }
+    return [self _objectAtIndexPair:indexPair];
+}
+
+/**
+ Returns the index pair of the object at the flat index, which counts objects across all sections in order.
+ An exception will be raised if the flat index is out of bounds.
+ Performance: O(log n), where n is the number of sections
+ 
+ @param flatIndex The flat index of the object.
+ @return The index pair of the object at the flat index, or an index pair with both indices set to NSNotFound if the flat index is out of bounds.
+ */
+- (INTUIndexPair)indexPairForFlatIndex:(NSUInteger)flatIndex
+{
+    const NSUInteger *sectionOffsets = [self _sectionOffsetTable];
+    NSUInteger sectionCount = [self countAllSections];
+    if (flatIndex >= sectionOffsets[sectionCount]) {
+        NSAssert(flatIndex < sectionOffsets[sectionCount], @"Index out of bounds!");
+        return INTUIndexPairMake(NSNotFound, NSNotFound);
+    }
+    
+    NSUInteger sectionIndex = INTUSectionIndexForFlatIndex(sectionOffsets, sectionCount, flatIndex);
+    return INTUIndexPairMake(sectionIndex, flatIndex - sectionOffsets[sectionIndex]);
+}
+
+/**
+ Returns the flat index of the object at the index pair, which counts objects across all sections in order.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(1), except for the first call after the grouped array is mutated, which is O(n), where n is the number of sections
+ 
+ @param indexPair The index pair of the object.
+ @return The flat index of the object at the index pair, or NSNotFound if the index pair is out of bounds.
+ */
+- (NSUInteger)flatIndexForIndexPair:(INTUIndexPair)indexPair
+{
+    if (indexPair.sectionIndex >= [self countAllSections]) {
+        NSAssert(indexPair.sectionIndex < [self countAllSections], @"Section index out of bounds!");
+        return NSNotFound;
+    }
+    if (indexPair.objectIndex >= [self countObjectsInSectionAtIndex:indexPair.sectionIndex]) {
+        NSAssert(indexPair.objectIndex < [self countObjectsInSectionAtIndex:indexPair.sectionIndex], @"Object index out of bounds!");
+        return NSNotFound;
+    }
+    return [self _sectionOffsetTable][indexPair.sectionIndex] + indexPair.objectIndex;
+}
+
+/**
+ Returns a read-only view of the objects in the section at the index, which reads the objects from the grouped array instead of copying them.
+ An exception will be raised if the index is out of bounds.
+ The view does not change when the grouped array is mutated: a mutable grouped array gives up ownership of the section's container, so
+ it will copy the section before modifying it again (copy-on-write). Other sections can still be modified without copying them.
+ Performance: O(1)
+ 
+ @param index The index of the section to get the objects of.
+ @return An immutable array of all the objects in the section, or nil if the index is out of bounds.
+ */
+- (NSArray *)objectsViewInSectionAtIndex:(NSUInteger)index
+{
+    if (index >= [self countAllSections]) {
+        NSAssert(index < [self countAllSections], @"Index out of bounds!");
+        return nil;
+    }
+    [self _relinquishOwnershipOfSectionContainersInRange:NSMakeRange(index, 1)];
+    return [self _objectsArrayInSectionAtIndex:index];
+}
+
+/**
+ Returns a read-only view of the objects in the section, which reads the objects from the grouped array instead of copying them.
+ See -[objectsViewInSectionAtIndex:].
+ Performance: O(n), where n is the number of sections (O(1) with the INTUGroupedArrayOptionHashedSectionIndex option)
+ 
+ @param section The section to get the objects of.
+ @return An immutable array of all the objects in the section, or nil if the section does not exist.
  */
-- (NSArray *)objectsInSectionAtIndex:(NSUInteger)index
+- (NSArray *)objectsViewInSection:(id)section
 {
-    if (index >= [self countAllSections]) {
-        NSAssert(index < [self countAllSections], @"Index out of bounds!");
+    if (!section) {
+        NSAssert(section, @"Section should not be nil.");
         return nil;
     }
     
-    NSUInteger objectCount = [self countObjectsInSectionAtIndex:index];
-    NSMutableArray *objectsInSection = [NSMutableArray arrayWithCapacity:objectCount];
-    for (NSUInteger objectIdx = 0; objectIdx < objectCount; objectIdx++) {
-        [objectsInSection addObject:[self _objectAtIndexPair:INTUIndexPairMake(index, objectIdx)]];
+    NSUInteger sectionIndex = [self indexOfSection:section];
+    if (sectionIndex == NSNotFound) {
+        return nil;
     }
-    return objectsInSection;
+    return [self objectsViewInSectionAtIndex:sectionIndex];
 }
 
 /**
- Returns the total number of objects in all sections.
- Performance: O(n), where n is the number of sections
+ Returns a read-only view of all objects in all sections, in order (as if the sections were concatenated), which reads the objects from
+ the grouped array instead of copying them. Accessing an object in the view by index is O(1) if the grouped array has contiguous storage,
+ and O(log n) otherwise, where n is the number of sections. The view does not change when the grouped array is mutated.
+ Performance: O(1) for immutable grouped arrays, O(n) for mutable grouped arrays (see -[INTUMutableGroupedArray copy])
  
- @return The number of objects in all sections of the grouped array.
+ @return An immutable array of all objects in all sections.
  */
-- (NSUInteger)countAllObjects
+- (NSArray *)allObjectsView
 {
-    NSUInteger count = 0;
-    NSUInteger sectionCount = [self countAllSections];
-    for (NSUInteger i = 0; i < sectionCount; i++) {
-        count += [self countObjectsInSectionAtIndex:i];
+    INTU_INSTRUMENT_TIMING();
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    if (contiguousStorage) {
+        return [contiguousStorage objectsInRange:NSMakeRange(0, contiguousStorage.objectCount)];
     }
-    return count;
+    // Immutable grouped arrays return themselves; mutable ones return an immutable copy that shares their section containers
+    return [[INTUGroupedArrayFlattenedArray alloc] initWithGroupedArray:[self copy]];
 }
 
 /**
- Returns an array of all objects in all sections.
- Performance: O(n), where n is the total number of objects across all sections
+ Returns a read-only grouped array of the objects from one index pair to another (inclusive), which may span several sections, and reads
+ the objects from this grouped array instead of copying them. Every section from the first index pair's section to the last index pair's
+ section is included. The view has the same options as this grouped array, and does not change when this grouped array is mutated.
+ Performance: O(n), where n is the number of sections in the range (plus the number of objects in the range, if the view has a hashed
+ object index)
  
- @return A new array of all objects in all sections of the grouped array.
+ @param fromIndexPair The index pair of the first object in the view.
+ @param toIndexPair The index pair of the last object in the view, which must not come before the first object.
+ @return An immutable grouped array of the objects in the range, or nil if either index pair is out of bounds.
  */
-- (NSArray *)allObjects
+- (INTUGroupedArray *)groupedArrayViewFromIndexPair:(INTUIndexPair)fromIndexPair toIndexPair:(INTUIndexPair)toIndexPair
 {
-    NSMutableArray *allObjects = [NSMutableArray array];
-    NSUInteger sectionCount = [self countAllSections];
-    for (NSUInteger sectionIdx = 0; sectionIdx < sectionCount; sectionIdx++) {
-        NSUInteger objectCount = [self countObjectsInSectionAtIndex:sectionIdx];
-        for (NSUInteger objectIdx = 0; objectIdx < objectCount; objectIdx++) {
-            [allObjects addObject:[self _objectAtIndexPair:INTUIndexPairMake(sectionIdx, objectIdx)]];
+    INTU_INSTRUMENT_TIMING();
+    NSUInteger fromFlatIndex = [self flatIndexForIndexPair:fromIndexPair];
+    NSUInteger toFlatIndex = [self flatIndexForIndexPair:toIndexPair];
+    if (fromFlatIndex == NSNotFound || toFlatIndex == NSNotFound) {
+        return nil;
+    }
+    if (fromFlatIndex > toFlatIndex) {
+        NSAssert(fromFlatIndex <= toFlatIndex, @"The first index pair must not come after the last index pair.");
+        return nil;
+    }
+    
+    // The section containers in the range are shared (entirely, or through a subarray of their objects), so give up ownership of them,
+    // but not of the section containers outside the range (see -[objectsViewInSectionAtIndex:])
+    [self _relinquishOwnershipOfSectionContainersInRange:NSMakeRange(fromIndexPair.sectionIndex, toIndexPair.sectionIndex - fromIndexPair.sectionIndex + 1)];
+    INTUGroupedArrayContiguousStorage *contiguousStorage = _contiguousStorage;
+    NSArray *sectionContainers = contiguousStorage ? nil : self.sectionContainers;
+    NSMutableArray *viewSectionContainers = [NSMutableArray arrayWithCapacity:toIndexPair.sectionIndex - fromIndexPair.sectionIndex + 1];
+    for (NSUInteger sectionIndex = fromIndexPair.sectionIndex; sectionIndex <= toIndexPair.sectionIndex; sectionIndex++) {
+        NSUInteger objectCount = [self countObjectsInSectionAtIndex:sectionIndex];
+        NSUInteger firstObjectIndex = (sectionIndex == fromIndexPair.sectionIndex) ? fromIndexPair.objectIndex : 0;
+        NSUInteger endObjectIndex = (sectionIndex == toIndexPair.sectionIndex) ? toIndexPair.objectIndex + 1 : objectCount;
+        NSRange objectsRange = NSMakeRange(firstObjectIndex, endObjectIndex - firstObjectIndex);
+        if (contiguousStorage) {
+            INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer new];
+            sectionContainer.section = contiguousStorage.sections[sectionIndex];
+            objectsRange.location += contiguousStorage.sectionOffsets[sectionIndex];
+            sectionContainer.objects = [contiguousStorage objectsInRange:objectsRange];
+            [viewSectionContainers addObject:sectionContainer];
+        } else if (objectsRange.length == objectCount) {
+            [viewSectionContainers addObject:sectionContainers[sectionIndex]];
+        } else {
+            INTUGroupedArraySectionContainer *sectionContainer = sectionContainers[sectionIndex];
+            INTUGroupedArraySectionContainer *viewSectionContainer = [INTUGroupedArraySectionContainer new];
+            viewSectionContainer.section = sectionContainer.section;
+            viewSectionContainer.objects = [[INTUGroupedArraySubarray alloc] initWithArray:sectionContainer.objects range:objectsRange];
+            [viewSectionContainers addObject:viewSectionContainer];
         }
     }
-    return allObjects;
+    
+    // Set the section containers directly, since the view must not copy the objects into contiguous storage
+    INTUGroupedArray *groupedArrayView = [[INTUGroupedArray alloc] initWithOptions:self.options];
+    groupedArrayView.sectionContainers = viewSectionContainers;
+    return groupedArrayView;
 }
 
 /**
@@ -1115,7 +2140,8 @@
                 NSUInteger index: the index of the section
                 BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
  
- @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will have no effect.
+ @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will prevent any further
+             executions of the block from starting, but executions already in progress on other threads will still finish.
  */
 - (void)enumerateSectionsWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(id section, NSUInteger index, BOOL *stop))block
 {
@@ -1127,33 +2153,51 @@
     BOOL concurrent = (options & NSEnumerationConcurrent);
     BOOL reverse = (options & NSEnumerationReverse);
     
-    NSOperationQueue *concurrentQueue = nil;
+    unsigned long mutationValue = _mutations;
+    // Read the sections directly from the contiguous storage if there is any, otherwise from the section containers
+    __unsafe_unretained id const *contiguousSections = _contiguousStorage.sections;
+    NSArray *sectionContainers = contiguousSections ? nil : self.sectionContainers;
+    NSUInteger sectionCount = [self countAllSections];
+    
     if (concurrent) {
-        concurrentQueue = [[NSOperationQueue alloc] init];
+        __block volatile BOOL mutated = NO;
+        [INTUGroupedArray _concurrentlyEnumerateChunksOfCount:sectionCount reverse:reverse usingBlock:^(NSRange chunkRange, volatile BOOL *stop) {
+            for (NSUInteger i = 0; i < chunkRange.length; i++) {
+                if (*stop) {
+                    return;
+                }
+                if (mutationValue != self->_mutations) {
+                    mutated = YES;
+                    *stop = YES;
+                    return;
+                }
+                NSUInteger sectionIndex = reverse ? NSMaxRange(chunkRange) - 1 - i : chunkRange.location + i;
+                id section = contiguousSections ? contiguousSections[sectionIndex] : ((INTUGroupedArraySectionContainer *)sectionContainers[sectionIndex]).section;
+                BOOL sectionStop = NO;
+                block(section, sectionIndex, &sectionStop);
+                if (sectionStop) {
+                    *stop = YES;
+                    return;
+                }
+            }
+        }];
+        NSAssert(!mutated, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
+        return;
     }
     
-    unsigned long mutationValue = _mutations;
-    NSUInteger sectionCount = [self countAllSections];
     for (NSUInteger i = 0; i < sectionCount; i++) {
         if (mutationValue != _mutations) {
             NSAssert(mutationValue == _mutations, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
             return;
         }
-        __block BOOL stop = NO;
+        BOOL stop = NO;
         NSUInteger sectionIndex = reverse ? sectionCount - 1 - i : i;
-        id section = [self sectionAtIndex:sectionIndex];
-        if (concurrent) {
-            [concurrentQueue addOperation:[NSBlockOperation blockOperationWithBlock:^{
-                block(section, sectionIndex, &stop);
-            }]];
-        } else {
-            block(section, sectionIndex, &stop);
-            if (stop) {
-                return;
-            }
+        id section = contiguousSections ? contiguousSections[sectionIndex] : ((INTUGroupedArraySectionContainer *)sectionContainers[sectionIndex]).section;
+        block(section, sectionIndex, &stop);
+        if (stop) {
+            return;
         }
     }
-    [concurrentQueue waitUntilAllOperationsAreFinished];
 }
 
 /**
@@ -1178,50 +2222,20 @@
                 NSIndexPath *indexPath: the index path of the object
                 BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
  
- @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will have no effect.
+ @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will prevent any further
+             executions of the block from starting, but executions already in progress on other threads will still finish.
  */
 - (void)enumerateObjectsWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(id object, NSIndexPath *indexPath, BOOL *stop))block
 {
+    INTU_INSTRUMENT_TIMING();
     if (!block) {
         NSAssert(block, @"Block cannot be nil.");
         return;
     }
     
-    BOOL concurrent = (options & NSEnumerationConcurrent);
-    BOOL reverse = (options & NSEnumerationReverse);
-    
-    NSOperationQueue *concurrentQueue = nil;
-    if (concurrent) {
-        concurrentQueue = [[NSOperationQueue alloc] init];
-    }
-    
-    unsigned long mutationValue = _mutations;
-    NSUInteger sectionCount = [self countAllSections];
-    for (NSUInteger i = 0; i < sectionCount; i++) {
-        NSUInteger sectionIndex = reverse ? sectionCount - 1 - i : i;
-        NSUInteger objectCount = [self countObjectsInSectionAtIndex:sectionIndex];
-        for (NSUInteger j = 0; j < objectCount; j++) {
-            if (mutationValue != _mutations) {
-                NSAssert(mutationValue == _mutations, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
-                return;
-            }
-            __block BOOL stop = NO;
-            NSUInteger objectIndex = reverse ? objectCount - 1 - j : j;
-            NSIndexPath *indexPath = [INTUGroupedArray indexPathForRow:objectIndex inSection:sectionIndex];
-            id object = [self objectAtIndexPath:indexPath];
-            if (concurrent) {
-                [concurrentQueue addOperation:[NSBlockOperation blockOperationWithBlock:^{
-                    block(object, indexPath, &stop);
-                }]];
-            } else {
-                block(object, indexPath, &stop);
-                if (stop) {
-                    return;
-                }
-            }
-        }
-    }
-    [concurrentQueue waitUntilAllOperationsAreFinished];
+    [self enumerateObjectsWithOptions:options usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+        block(object, [INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex], stop);
+    }];
 }
 
 /**
@@ -1246,7 +2260,8 @@
                 NSIndexPath *indexPath: the index path of the object
                 BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
  
- @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will have no effect.
+ @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will prevent any further
+             executions of the block from starting, but executions already in progress on other threads will still finish.
  */
 - (void)enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex withOptions:(NSEnumerationOptions)options usingBlock:(void (^)(id object, NSIndexPath *indexPath, BOOL *stop))block
 {
@@ -1255,43 +2270,249 @@
         return;
     }
     
+    [self enumerateObjectsInSectionAtIndex:sectionIndex withOptions:options usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+        block(object, [INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex], stop);
+    }];
+}
+
+/**
+ Executes the block for each object in the grouped array, passing the index pair of each object.
+ This avoids the overhead of allocating an NSIndexPath object for every object that is enumerated.
+ 
+ @param block A block taking three parameters:
+                id object: The object
+                INTUIndexPair indexPair: the index pair of the object
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ */
+- (void)enumerateObjectsUsingIndexPairBlock:(void (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    [self enumerateObjectsWithOptions:0 usingIndexPairBlock:block];
+}
+
+/**
+ Executes the block for each object in the grouped array with the specified enumeration options, passing the index pair of each object.
+ This avoids the overhead of allocating an NSIndexPath object for every object that is enumerated.
+ 
+ @param options The enumeration options to use.
+ @param block A block taking three parameters:
+                id object: The object
+                INTUIndexPair indexPair: the index pair of the object
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ 
+ @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will prevent any further
+             executions of the block from starting, but executions already in progress on other threads will still finish.
+ */
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)options usingIndexPairBlock:(void (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    INTU_INSTRUMENT_TIMING();
+    if (!block) {
+        NSAssert(block, @"Block cannot be nil.");
+        return;
+    }
+    
     BOOL concurrent = (options & NSEnumerationConcurrent);
     BOOL reverse = (options & NSEnumerationReverse);
     
-    NSOperationQueue *concurrentQueue = nil;
+    NSUInteger sectionCount = [self countAllSections];
     if (concurrent) {
-        concurrentQueue = [[NSOperationQueue alloc] init];
+        [self _concurrentlyEnumerateObjectsInSectionRange:NSMakeRange(0, sectionCount) reverse:reverse usingIndexPairBlock:block];
+        return;
     }
     
     unsigned long mutationValue = _mutations;
-    NSUInteger sectionCount = [self countAllSections];
-    if (sectionIndex >= sectionCount) {
-        NSAssert(sectionIndex < sectionCount, @"Section index out of bounds!");
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        NSUInteger sectionIndex = reverse ? sectionCount - 1 - i : i;
+        BOOL shouldContinue = [self _enumerateObjectsInSectionAtIndex:sectionIndex
+                                                              reverse:reverse
+                                                        mutationValue:mutationValue
+                                                                block:block];
+        if (!shouldContinue) {
+            return;
+        }
+    }
+}
+
+/**
+ Executes the block for each object in the section at the index, passing the index pair of each object.
+ This avoids the overhead of allocating an NSIndexPath object for every object that is enumerated.
+ 
+ @param block A block taking three parameters:
+                id object: The object
+                INTUIndexPair indexPair: the index pair of the object
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ */
+- (void)enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex usingIndexPairBlock:(void (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    [self enumerateObjectsInSectionAtIndex:sectionIndex withOptions:0 usingIndexPairBlock:block];
+}
+
+/**
+ Executes the block for each object in the section at the index with the specified enumeration options, passing the index pair of each object.
+ This avoids the overhead of allocating an NSIndexPath object for every object that is enumerated.
+ 
+ @param options The enumeration options to use.
+ @param block A block taking three parameters:
+                id object: The object
+                INTUIndexPair indexPair: the index pair of the object
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ 
+ @discussion When NSEnumerationConcurrent is used, setting the stop BOOL reference passed into the block to YES will prevent any further
+             executions of the block from starting, but executions already in progress on other threads will still finish.
+ */
+- (void)enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex withOptions:(NSEnumerationOptions)options usingIndexPairBlock:(void (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block cannot be nil.");
         return;
     }
     
-    NSUInteger objectCount = [self countObjectsInSectionAtIndex:sectionIndex];
+    BOOL concurrent = (options & NSEnumerationConcurrent);
+    BOOL reverse = (options & NSEnumerationReverse);
+    
+    if (sectionIndex >= [self countAllSections]) {
+        NSAssert(sectionIndex < [self countAllSections], @"Section index out of bounds!");
+        return;
+    }
+    
+    if (concurrent) {
+        [self _concurrentlyEnumerateObjectsInSectionRange:NSMakeRange(sectionIndex, 1) reverse:reverse usingIndexPairBlock:block];
+    } else {
+        [self _enumerateObjectsInSectionAtIndex:sectionIndex
+                                        reverse:reverse
+                                  mutationValue:_mutations
+                                          block:block];
+    }
+}
+
+/**
+ Executes the block for each object in the section at the index, reading the objects directly from the section container or contiguous storage.
+ Returns NO if enumeration should not continue, because the block set stop to YES or the grouped array was mutated.
+ */
+- (BOOL)_enumerateObjectsInSectionAtIndex:(NSUInteger)sectionIndex
+                                  reverse:(BOOL)reverse
+                            mutationValue:(unsigned long)mutationValue
+                                    block:(void (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    NSArray *objects = [self _objectsArrayInSectionAtIndex:sectionIndex];
+    NSUInteger objectCount = [objects count];
     for (NSUInteger j = 0; j < objectCount; j++) {
         if (mutationValue != _mutations) {
             NSAssert(mutationValue == _mutations, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
-            return;
+            return NO;
         }
-        __block BOOL stop = NO;
+        BOOL stop = NO;
         NSUInteger objectIndex = reverse ? objectCount - 1 - j : j;
-        NSIndexPath *indexPath = [INTUGroupedArray indexPathForRow:objectIndex inSection:sectionIndex];
-        id object = [self objectAtIndexPath:indexPath];
-        if (concurrent) {
-            [concurrentQueue addOperation:[NSBlockOperation blockOperationWithBlock:^{
-                block(object, indexPath, &stop);
-            }]];
-        } else {
-            block(object, indexPath, &stop);
-            if (stop) {
+        block(objects[objectIndex], INTUIndexPairMake(sectionIndex, objectIndex), &stop);
+        if (stop) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/**
+ Executes the block concurrently for each object in the range of sections. The objects are treated as one flat range (using the table of
+ cumulative object counts) which is split into chunks, so the work is balanced across workers regardless of how objects are distributed
+ between sections. Setting stop to YES from any invocation of the block prevents further invocations from starting.
+ */
+- (void)_concurrentlyEnumerateObjectsInSectionRange:(NSRange)sectionRange reverse:(BOOL)reverse usingIndexPairBlock:(void (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    unsigned long mutationValue = _mutations;
+    // Read the objects directly from the contiguous storage if there is any, otherwise from the section containers
+    __unsafe_unretained id const *contiguousObjects = _contiguousStorage.objects;
+    NSArray *sectionContainers = contiguousObjects ? nil : self.sectionContainers;
+    NSUInteger sectionCount = [self countAllSections];
+    const NSUInteger *sectionOffsets = [self _sectionOffsetTable];
+    NSUInteger firstFlatIndex = sectionOffsets[sectionRange.location];
+    NSUInteger objectCount = sectionOffsets[NSMaxRange(sectionRange)] - firstFlatIndex;
+    
+    __block volatile BOOL mutated = NO;
+    [INTUGroupedArray _concurrentlyEnumerateChunksOfCount:objectCount reverse:reverse usingBlock:^(NSRange chunkRange, volatile BOOL *stop) {
+        // Locate the section containing the first object of the chunk once, then walk across section boundaries from there
+        NSUInteger flatIndex = firstFlatIndex + (reverse ? NSMaxRange(chunkRange) - 1 : chunkRange.location);
+        NSUInteger sectionIndex = INTUSectionIndexForFlatIndex(sectionOffsets, sectionCount, flatIndex);
+        for (NSUInteger i = 0; i < chunkRange.length; i++) {
+            if (*stop) {
+                return;
+            }
+            if (mutationValue != self->_mutations) {
+                mutated = YES;
+                *stop = YES;
+                return;
+            }
+            if (i > 0) {
+                if (reverse) {
+                    flatIndex--;
+                    while (flatIndex < sectionOffsets[sectionIndex]) {
+                        sectionIndex--;
+                    }
+                } else {
+                    flatIndex++;
+                    while (flatIndex >= sectionOffsets[sectionIndex + 1]) {
+                        sectionIndex++;
+                    }
+                }
+            }
+            NSUInteger objectIndex = flatIndex - sectionOffsets[sectionIndex];
+            id object = contiguousObjects ? contiguousObjects[flatIndex] : ((INTUGroupedArraySectionContainer *)sectionContainers[sectionIndex]).objects[objectIndex];
+            BOOL objectStop = NO;
+            block(object, INTUIndexPairMake(sectionIndex, objectIndex), &objectStop);
+            if (objectStop) {
+                *stop = YES;
                 return;
             }
         }
+    }];
+    NSAssert(!mutated, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
+}
+
+/**
+ Splits the range [0, count) into chunks and executes the block once for each chunk, concurrently on the global concurrent dispatch queue,
+ returning once all chunks have finished. The stop pointer passed to the block is shared by all chunks: a chunk should set it to YES to
+ stop the enumeration, and should check it before processing each element. Chunks that have not started by then will not run at all.
+ When reverse is YES, the chunks at the end of the range are started first.
+ */
++ (void)_concurrentlyEnumerateChunksOfCount:(NSUInteger)count reverse:(BOOL)reverse usingBlock:(void (^)(NSRange chunkRange, volatile BOOL *stop))block
+{
+    if (count == 0) {
+        return;
+    }
+    
+    NSUInteger processorCount = MAX([[NSProcessInfo processInfo] activeProcessorCount], (NSUInteger)1);
+    NSUInteger chunkSize = count / (processorCount * kINTUGroupedArrayConcurrentChunksPerProcessor);
+    chunkSize = MIN(MAX(chunkSize, (NSUInteger)1), kINTUGroupedArrayMaxConcurrentChunkSize);
+    NSUInteger chunkCount = (count + chunkSize - 1) / chunkSize;
+    
+    __block volatile BOOL stop = NO;
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        if (stop) {
+            return;
+        }
+        NSUInteger chunkIndex = reverse ? chunkCount - 1 - iteration : iteration;
+        NSUInteger location = chunkIndex * chunkSize;
+        block(NSMakeRange(location, MIN(chunkSize, count - location)), &stop);
+    });
+}
+
+/**
+ Executes the block once for each section container, concurrently across sections if the NSEnumerationConcurrent option is set.
+ Since the block may run on several threads at once, it must only modify state that belongs to the section container or its index.
+ */
+- (void)_enumerateSectionContainersWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(INTUGroupedArraySectionContainer *sectionContainer, NSUInteger index))block
+{
+    NSArray *sectionContainers = self.sectionContainers;
+    NSUInteger sectionCount = [sectionContainers count];
+    if (options & NSEnumerationConcurrent) {
+        [INTUGroupedArray _concurrentlyEnumerateChunksOfCount:sectionCount reverse:NO usingBlock:^(NSRange chunkRange, volatile BOOL *stop) {
+            for (NSUInteger index = chunkRange.location; index < NSMaxRange(chunkRange); index++) {
+                block(sectionContainers[index], index);
+            }
+        }];
+    } else {
+        for (NSUInteger index = 0; index < sectionCount; index++) {
+            block(sectionContainers[index], index);
+        }
     }
-    [concurrentQueue waitUntilAllOperationsAreFinished];
 }
 
 /**
@@ -1379,27 +2600,57 @@
         return nil;
     }
     
+    INTUIndexPair indexPair = [self indexPairOfObjectPassingTest:^BOOL(id object, INTUIndexPair indexPair, BOOL *stop) {
+        return block(object, [INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex], stop);
+    }];
+    if (indexPair.sectionIndex == NSNotFound) {
+        return nil;
+    }
+    return [INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex];
+}
+
+/**
+ Returns the index pair of the first object in the grouped array that passes the test (causing the block to return YES),
+ or an index pair with both indices set to NSNotFound if no object causes the test to pass or if enumeration is stopped
+ early before an object passes the test.
+ This avoids the overhead of allocating an NSIndexPath object for every object that is tested.
+ 
+ @param block A block taking three parameters:
+        id object: The object
+        INTUIndexPair indexPair: the index pair of the object
+        BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+        The block should return YES if the object passes the test, otherwise it should return NO.
+ */
+- (INTUIndexPair)indexPairOfObjectPassingTest:(BOOL (^)(id object, INTUIndexPair indexPair, BOOL *stop))block
+{
+    INTUIndexPair notFound = INTUIndexPairMake(NSNotFound, NSNotFound);
+    if (!block) {
+        NSAssert(block, @"Block cannot be nil.");
+        return notFound;
+    }
+    
     unsigned long mutationValue = _mutations;
     NSUInteger sectionCount = [self countAllSections];
     for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
-        NSUInteger objectCount = [self countObjectsInSectionAtIndex:sectionIndex];
+        NSArray *objects = [self _objectsArrayInSectionAtIndex:sectionIndex];
+        NSUInteger objectCount = [objects count];
         for (NSUInteger objectIndex = 0; objectIndex < objectCount; objectIndex++) {
             if (mutationValue != _mutations) {
                 NSAssert(mutationValue == _mutations, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
-                return nil;
+                return notFound;
             }
             BOOL stop = NO;
-            NSIndexPath *indexPath = [INTUGroupedArray indexPathForRow:objectIndex inSection:sectionIndex];
-            BOOL testPassed = block([self objectAtIndexPath:indexPath], indexPath, &stop);
+            INTUIndexPair indexPair = INTUIndexPairMake(sectionIndex, objectIndex);
+            BOOL testPassed = block(objects[objectIndex], indexPair, &stop);
             if (testPassed) {
-                return indexPath;
+                return indexPair;
             } else if (stop) {
-                return nil;
+                return notFound;
             }
         }
     }
     
-    return nil;
+    return notFound;
 }
 
 /**
@@ -1426,6 +2677,7 @@
  */
 - (BOOL)isEqualToGroupedArray:(INTUGroupedArray *)otherGroupedArray
 {
+    INTU_INSTRUMENT_TIMING();
     if (!otherGroupedArray) {
         return NO;
     }
@@ -1469,31 +2721,48 @@
  */
 - (INTUGroupedArray *)filteredGroupedArrayUsingSectionPredicate:(NSPredicate *)sectionPredicate objectPredicate:(NSPredicate *)objectPredicate
 {
-    INTUGroupedArray *copy = [[INTUGroupedArray alloc] init];
-    NSMutableArray *sectionContainersForCopy = [NSMutableArray new];
-    if (sectionPredicate || objectPredicate) {
-        for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-            INTUMutableGroupedArraySectionContainer *sectionContainerCopy = [sectionContainer mutableCopy];
-            if (sectionPredicate) {
-                if ([sectionPredicate evaluateWithObject:sectionContainerCopy.section]) {
-                    NSMutableArray *objectsArray = sectionContainerCopy.mutableObjects;
-                    if (objectPredicate) {
-                        [objectsArray filterUsingPredicate:objectPredicate];
-                    }
-                    if ([objectsArray count] > 0) {
-                        [sectionContainersForCopy addObject:sectionContainerCopy];
-                    }
-                }
-            } else if (objectPredicate) {
-                NSMutableArray *objectsArray = sectionContainerCopy.mutableObjects;
-                [objectsArray filterUsingPredicate:objectPredicate];
-                if ([objectsArray count] > 0) {
-                    [sectionContainersForCopy addObject:sectionContainerCopy];
-                }
-            }
-        }
+    return [self filteredGroupedArrayWithOptions:0 usingSectionPredicate:sectionPredicate objectPredicate:objectPredicate];
+}
+
+/**
+ Returns a new grouped array filtered by evaluating the section & object predicates against all sections & objects and removing those that do not match,
+ using the specified enumeration options. Empty sections will be removed.
+ 
+ @param options The enumeration options to use. When NSEnumerationConcurrent is set, sections are filtered in parallel, so the predicates must be safe
+                to evaluate concurrently. The result is identical either way.
+ @param sectionPredicate A predicate used to filter sections, or nil if no section filtering is desired.
+ @param objectPredicate A predicate used to filter objects in each section, or nil if no object filtering is desired.
+ @return A new filtered grouped array.
+ */
+- (INTUGroupedArray *)filteredGroupedArrayWithOptions:(NSEnumerationOptions)options usingSectionPredicate:(NSPredicate *)sectionPredicate objectPredicate:(NSPredicate *)objectPredicate
+{
+    INTU_INSTRUMENT_TIMING();
+    INTUGroupedArray *copy = [[INTUGroupedArray alloc] initWithOptions:self.options];
+    if (!sectionPredicate && !objectPredicate) {
+        copy.sectionContainers = [NSArray new];
+        return copy;
+    }
+    
+    // Each section writes its filtered section container (or NULL if the section is filtered out) into its own slot, so the sections can be
+    // filtered in parallel without sharing any state, and the results are then collected in the original section order.
+    NSUInteger sectionCount = [self countAllSections];
+    void **filteredSectionContainers = calloc(MAX(sectionCount, (NSUInteger)1), sizeof(void *));
+    if (!filteredSectionContainers) {
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu filtered sections.", (unsigned long)sectionCount];
     }
-    copy.sectionContainers = sectionContainersForCopy;
+    [self _enumerateSectionContainersWithOptions:options usingBlock:^(INTUGroupedArraySectionContainer *sectionContainer, NSUInteger index) {
+        if (sectionPredicate && [sectionPredicate evaluateWithObject:sectionContainer.section] == NO) {
+            // The section is rejected, so there is no need to copy any of its objects
+            return;
+        }
+        NSArray *objects = objectPredicate ? [sectionContainer.objects filteredArrayUsingPredicate:objectPredicate] : [sectionContainer.objects copy];
+        if ([objects count] > 0) {
+            INTUGroupedArraySectionContainer *filteredSectionContainer = [INTUGroupedArraySectionContainer sectionContainerWithSection:sectionContainer.section];
+            filteredSectionContainer.objects = objects;
+            filteredSectionContainers[index] = (__bridge_retained void *)filteredSectionContainer;
+        }
+    }];
+    copy.sectionContainers = INTUCollectSectionContainers(filteredSectionContainers, sectionCount);
     return copy;
 }
 
@@ -1506,21 +2775,51 @@
  */
 - (INTUGroupedArray *)sortedGroupedArrayUsingSectionComparator:(NSComparator)sectionCmptr objectComparator:(NSComparator)objectCmptr
 {
-    INTUGroupedArray *copy = [[INTUGroupedArray alloc] init];
-    NSMutableArray *sectionContainers = [NSMutableArray new];
-    for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-        [sectionContainers addObject:[sectionContainer mutableCopy]];
-    }
+    return [self sortedGroupedArrayWithOptions:0 usingSectionComparator:sectionCmptr objectComparator:objectCmptr];
+}
+
+/**
+ Returns a new grouped array with the sections sorted using the section comparator, and the objects in each section sorted using the object comparator,
+ using the specified sort options.
+ 
+ @param options The sort options to use. When NSSortConcurrent is set, the objects in different sections are sorted in parallel, so the object comparator
+                must be safe to call concurrently. Each section is still sorted on a single thread, so the result is identical either way.
+ @param sectionCmptr A comparator block used to sort sections, or nil if no section sorting is desired.
+ @param objectCmptr A comparator block used to sort objects in each section, or nil if no object sorting is desired.
+ @return A new sorted grouped array.
+ */
+- (INTUGroupedArray *)sortedGroupedArrayWithOptions:(NSSortOptions)options usingSectionComparator:(NSComparator)sectionCmptr objectComparator:(NSComparator)objectCmptr
+{
+    INTU_INSTRUMENT_TIMING();
+    sectionCmptr = INTU_INSTRUMENT_COMPARATOR(sectionCmptr);
+    objectCmptr = INTU_INSTRUMENT_COMPARATOR(objectCmptr);
+    NSSortOptions sortOptions = options & NSSortStable;
+    NSEnumerationOptions enumerationOptions = (options & NSSortConcurrent) ? NSEnumerationConcurrent : 0;
+    
+    // Each section writes its sorted section container into its own slot (see filteredGroupedArrayWithOptions:usingSectionPredicate:objectPredicate:)
+    NSUInteger sectionCount = [self countAllSections];
+    void **sortedSectionContainers = calloc(MAX(sectionCount, (NSUInteger)1), sizeof(void *));
+    if (!sortedSectionContainers) {
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu sorted sections.", (unsigned long)sectionCount];
+    }
+    [self _enumerateSectionContainersWithOptions:enumerationOptions usingBlock:^(INTUGroupedArraySectionContainer *sectionContainer, NSUInteger index) {
+        INTUGroupedArraySectionContainer *sortedSectionContainer = [INTUGroupedArraySectionContainer sectionContainerWithSection:sectionContainer.section];
+        if (objectCmptr) {
+            sortedSectionContainer.objects = [sectionContainer.objects sortedArrayWithOptions:sortOptions usingComparator:objectCmptr];
+        } else {
+            sortedSectionContainer.objects = [sectionContainer.objects copy];
+        }
+        sortedSectionContainers[index] = (__bridge_retained void *)sortedSectionContainer;
+    }];
+    
+    NSMutableArray *sectionContainers = INTUCollectSectionContainers(sortedSectionContainers, sectionCount);
     if (sectionCmptr) {
-        [sectionContainers sortUsingComparator:^NSComparisonResult(INTUMutableGroupedArraySectionContainer *sectionContainer1, INTUMutableGroupedArraySectionContainer *sectionContainer2) {
+        [sectionContainers sortWithOptions:sortOptions usingComparator:^NSComparisonResult(INTUGroupedArraySectionContainer *sectionContainer1, INTUGroupedArraySectionContainer *sectionContainer2) {
             return sectionCmptr(sectionContainer1.section, sectionContainer2.section);
         }];
     }
-    if (objectCmptr) {
-        for (INTUMutableGroupedArraySectionContainer *sectionContainer in sectionContainers) {
-            [sectionContainer.mutableObjects sortUsingComparator:objectCmptr];
-        }
-    }
+    
+    INTUGroupedArray *copy = [[INTUGroupedArray alloc] initWithOptions:self.options];
     copy.sectionContainers = sectionContainers;
     return copy;
 }
@@ -0,0 +1,78 @@
+//
+//  INTUGroupedArrayBuilder.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+#import "INTUGroupedArray.h"
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+
+/**
+ Builds an immutable grouped array incrementally, from a stream of objects and the sections they belong to.
+ 
+ Objects are appended to the end of their section, and sections are created in the order they are first encountered.
+ Runs of objects in the same section (such as the rows of a query sorted by section) are appended in O(1) time per object,
+ and objects for any other existing section are located by section hash in O(1) time, so sections must implement -hash
+ consistently with -isEqual:. While the objects of each section are added together (every object is added to the most
+ recently created section), they are appended to a single buffer that becomes the contiguous storage of the grouped array
+ when it is built, so nothing is copied. Adding an object to an earlier section moves the objects added so far into a
+ mutable array for each section (a one-time O(m) pass), which the grouped array then keeps when it is built.
+ 
+ A builder is not thread safe.
+ */
+@interface GA__INTU_GENERICS(INTUGroupedArrayBuilder, SectionType, ObjectType) : NSObject
+
+/** The options for the grouped arrays that are built. */
+@property (nonatomic, readonly) INTUGroupedArrayOptions options;
+
+/** Creates and returns a new builder of grouped arrays with no options. */
+- (instancetype)init;
+/** Creates and returns a new builder of grouped arrays with the options. */
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options;
+
+/** Reserves space for the number of sections, and for the number of objects in each new section. */
+- (void)reserveCapacityForSections:(NSUInteger)sectionCapacity objectsPerSection:(NSUInteger)objectCapacity;
+
+/** Appends the object to the section, creating the section if it has not been added yet. */
+- (void)addObject:(GA__INTU_GENERICS_TYPE(ObjectType))object toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Appends the objects in the array to the section, creating the section if it has not been added yet. Does nothing if the array is nil or empty. */
+- (void)addObjectsFromArray:(GA__INTU_NULLABLE GA__INTU_GENERICS(NSArray, ObjectType) *)array toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Appends the count objects in the C array to the section, creating the section if it has not been added yet. Does nothing if count is 0. */
+- (void)addObjects:(const GA__INTU_GENERICS_TYPE(ObjectType) [])objects count:(NSUInteger)count toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+/** Returns the number of sections added since the last grouped array was built. */
+- (NSUInteger)countAllSections;
+/** Returns the number of objects added since the last grouped array was built. */
+- (NSUInteger)countAllObjects;
+
+/** Returns an immutable grouped array containing the sections & objects that were added, and resets the builder to be empty.
+    The grouped array takes over the builder's storage, so neither the objects nor the references to them are copied. */
+- (GA__INTU_GENERICS(INTUGroupedArray, SectionType, ObjectType) *)build;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
@@ -0,0 +1,482 @@
+//
+//  INTUGroupedArrayBuilder.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+#import "INTUGroupedArrayBuilder.h"
+#import "INTUGroupedArraySectionContainer.h"
+#import "INTUGroupedArrayContiguousStorage.h"
+#import "INTUGroupedArrayInternal.h"
+
+@interface GA__INTU_GENERICS(INTUGroupedArrayBuilder, SectionType, ObjectType) ()
+{
+@private
+    /** The sections that have been added, in order, each with a strong reference (+1 retain count). Allocated with malloc. */
+    void **_sections;
+    /** The number of objects that have been added to each section. Has room for as many entries as _sections. */
+    NSUInteger *_sectionObjectCounts;
+    /** The number of sections, and the number that the _sections & _sectionObjectCounts buffers have room for. */
+    NSUInteger _sectionCount;
+    NSUInteger _sectionsCapacity;
+    /** A map from each section to its index in _sections. Values are stored as index + 1, since NULL means that there is no value. */
+    CFMutableDictionaryRef _sectionIndexes;
+    /** While objects are only ever appended to the most recently added section, they are appended to this buffer, each with a strong
+        reference (+1 retain count), so that the objects of each section directly follow the objects of the section before it. The buffer
+        is handed over to the contiguous storage of the grouped array that is built, without copying it. Allocated with malloc. */
+    void **_objects;
+    /** The number of objects in the _objects buffer, and the number that it has room for. */
+    NSUInteger _objectCount;
+    NSUInteger _objectsCapacity;
+    /** Once an object is added to a section other than the most recently added one, the objects can no longer be kept in section order
+        in a single buffer, so they are moved into a section container for each section, which has a mutable array of objects. The section
+        containers are then handed over to the grouped array that is built as they are. Nil until then. */
+    NSMutableArray *_sectionContainers;
+    /** The index of the section that an object was most recently added to, which is checked first so that runs of objects in the same
+        section don't need a hash lookup, or NSNotFound. */
+    NSUInteger _lastSectionIndex;
+    /** The number of objects expected in each new section, which is reserved in the buffer of objects when the section is added. */
+    NSUInteger _objectCapacity;
+    /** The total number of objects that have been added (in the buffer or the section containers). */
+    NSUInteger _totalObjectCount;
+}
+
+@end
+
+@implementation INTUGroupedArrayBuilder
+
+/**
+ Creates and returns a new builder of grouped arrays with no options.
+ */
+- (instancetype)init
+{
+    return [self initWithOptions:INTUGroupedArrayOptionNone];
+}
+
+/**
+ Designated initializer.
+ Creates and returns a new builder of grouped arrays with the specified options.
+ 
+ @param options The options for the grouped arrays that are built.
+ @return A new builder with no sections or objects.
+ */
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options
+{
+    self = [super init];
+    if (self) {
+        _options = options;
+        [self _resetWithSectionCapacity:0];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self _releaseBuffers];
+    if (_sectionIndexes) {
+        CFRelease(_sectionIndexes);
+    }
+}
+
+/**
+ Releases the sections & objects in the buffers, and frees the buffers.
+ */
+- (void)_releaseBuffers
+{
+    for (NSUInteger i = 0; i < _sectionCount; i++) {
+        CFRelease(_sections[i]);
+    }
+    for (NSUInteger i = 0; i < _objectCount; i++) {
+        CFRelease(_objects[i]);
+    }
+    free(_sections);
+    free(_sectionObjectCounts);
+    free(_objects);
+}
+
+/**
+ Starts over with no sections or objects and space reserved for the number of sections. Any buffers must have been released or handed
+ over to a grouped array first, since they are forgotten.
+ */
+- (void)_resetWithSectionCapacity:(NSUInteger)sectionCapacity
+{
+    if (_sectionIndexes) {
+        CFRelease(_sectionIndexes);
+    }
+    _sectionIndexes = CFDictionaryCreateMutable(kCFAllocatorDefault, (CFIndex)sectionCapacity, &kCFTypeDictionaryKeyCallBacks, NULL);
+    _sections = NULL;
+    _sectionObjectCounts = NULL;
+    _sectionCount = 0;
+    _sectionsCapacity = 0;
+    _objects = NULL;
+    _objectCount = 0;
+    _objectsCapacity = 0;
+    _sectionContainers = nil;
+    _lastSectionIndex = NSNotFound;
+    _totalObjectCount = 0;
+    [self _reserveSectionCapacity:sectionCapacity];
+}
+
+/**
+ Grows the buffers of sections to have room for at least the number of sections.
+ Performance: O(n), where n is the number of sections already added
+ */
+- (void)_reserveSectionCapacity:(NSUInteger)sectionCapacity
+{
+    if (sectionCapacity <= _sectionsCapacity) {
+        return;
+    }
+    // Allocate at least one entry for each buffer, so that a failed allocation can be told apart from an empty one
+    sectionCapacity = MAX(sectionCapacity, (NSUInteger)1);
+    // Allocate both new buffers before replacing either, so that the buffers and _sectionsCapacity are left unchanged if either fails
+    void **sections = (sectionCapacity <= NSUIntegerMax / sizeof(void *)) ? malloc(sectionCapacity * sizeof(void *)) : NULL;
+    NSUInteger *sectionObjectCounts = (sectionCapacity <= NSUIntegerMax / sizeof(NSUInteger)) ? malloc(sectionCapacity * sizeof(NSUInteger)) : NULL;
+    if (!sections || !sectionObjectCounts) {
+        free(sections);
+        free(sectionObjectCounts);
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu sections.", (unsigned long)sectionCapacity];
+    }
+    if (_sectionCount > 0) {
+        memcpy(sections, _sections, _sectionCount * sizeof(void *));
+        memcpy(sectionObjectCounts, _sectionObjectCounts, _sectionCount * sizeof(NSUInteger));
+    }
+    free(_sections);
+    free(_sectionObjectCounts);
+    _sections = sections;
+    _sectionObjectCounts = sectionObjectCounts;
+    _sectionsCapacity = sectionCapacity;
+}
+
+/**
+ Grows the buffer of objects to have room for at least the number of objects.
+ Performance: O(m), where m is the number of objects already in the buffer
+ */
+- (void)_reserveObjectCapacity:(NSUInteger)objectCapacity
+{
+    if (objectCapacity <= _objectsCapacity) {
+        return;
+    }
+    objectCapacity = MAX(objectCapacity, (NSUInteger)1);
+    void **objects = realloc(_objects, objectCapacity * sizeof(void *));
+    if (!objects) {
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu objects.", (unsigned long)objectCapacity];
+    }
+    _objects = objects;
+    _objectsCapacity = objectCapacity;
+}
+
+/**
+ Grows the buffer of objects, if it does not already have room to append the number of objects, to at least double its current capacity.
+ Growing geometrically (and only when needed) keeps appending runs of objects to many sections amortized O(1) per object.
+ Performance: O(1) if the buffer has room; otherwise O(m), where m is the number of objects already in the buffer
+ */
+- (void)_reserveObjectCapacityForAppendingCount:(NSUInteger)count
+{
+    if (count <= _objectsCapacity - _objectCount) {
+        return;
+    }
+    if (count > NSUIntegerMax / sizeof(void *) - _objectCount) {
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu more objects.", (unsigned long)count];
+    }
+    NSUInteger objectCapacity = MAX(_objectCount + count, MAX(_objectsCapacity * 2, (NSUInteger)16));
+    [self _reserveObjectCapacity:MIN(objectCapacity, NSUIntegerMax / sizeof(void *))];
+}
+
+/**
+ Reserves space for the number of sections, and for the number of objects in each section that is added after this call.
+ This avoids repeatedly growing the storage when the approximate size of the grouped array is known up front.
+ Performance: O(n), where n is the number of sections already added
+ 
+ @param sectionCapacity The total number of sections expected.
+ @param objectCapacity The number of objects expected in each new section.
+ */
+- (void)reserveCapacityForSections:(NSUInteger)sectionCapacity objectsPerSection:(NSUInteger)objectCapacity
+{
+    _objectCapacity = objectCapacity;
+    [self _reserveSectionCapacity:sectionCapacity];
+    if (!_sectionContainers && sectionCapacity > _sectionCount) {
+        [self _reserveObjectCapacity:_objectCount + (sectionCapacity - _sectionCount) * objectCapacity];
+    }
+}
+
+/**
+ Returns the index of the section, adding the section after all existing sections if it has not been added yet.
+ Performance: O(1) if objects were most recently added to the same section; otherwise O(1) on average, using the section's hash
+ */
+- (NSUInteger)_indexOfSection:(id)section
+{
+    NSUInteger sectionIndex = _lastSectionIndex;
+    if (sectionIndex != NSNotFound) {
+        id lastSection = (__bridge id)_sections[sectionIndex];
+        if (lastSection == section || [lastSection isEqual:section]) {
+            return sectionIndex;
+        }
+    }
+    sectionIndex = (NSUInteger)CFDictionaryGetValue(_sectionIndexes, (__bridge const void *)section);
+    if (sectionIndex > 0) {
+        sectionIndex--;
+    } else {
+        if (_sectionCount == _sectionsCapacity) {
+            [self _reserveSectionCapacity:_sectionsCapacity * 2];
+        }
+        sectionIndex = _sectionCount;
+        _sections[sectionIndex] = (__bridge_retained void *)section;
+        _sectionObjectCounts[sectionIndex] = 0;
+        _sectionCount++;
+        CFDictionarySetValue(_sectionIndexes, (__bridge const void *)section, (const void *)_sectionCount);
+        if (_sectionContainers) {
+            INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer new];
+            sectionContainer.section = section;
+            sectionContainer.objects = [NSMutableArray arrayWithCapacity:_objectCapacity];
+            [_sectionContainers addObject:sectionContainer];
+        } else if (_objectCapacity > 0) {
+            [self _reserveObjectCapacity:_objectCount + _objectCapacity];
+        }
+    }
+    _lastSectionIndex = sectionIndex;
+    return sectionIndex;
+}
+
+/**
+ Moves the objects in the buffer into a section container for each section, since objects are about to be added to a section other than
+ the most recently added one. This happens at most once, and later objects are added directly to the section containers.
+ Performance: O(m), where m is the number of objects in the buffer
+ */
+- (void)_moveObjectsIntoSectionContainers
+{
+    NSMutableArray *sectionContainers = [NSMutableArray arrayWithCapacity:_sectionsCapacity];
+    NSUInteger offset = 0;
+    for (NSUInteger i = 0; i < _sectionCount; i++) {
+        NSUInteger count = _sectionObjectCounts[i];
+        INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer new];
+        sectionContainer.section = (__bridge id)_sections[i];
+        sectionContainer.objects = [[NSMutableArray alloc] initWithObjects:(__unsafe_unretained id const *)(void *)(_objects + offset) count:count];
+        [sectionContainers addObject:sectionContainer];
+        offset += count;
+    }
+    for (NSUInteger i = 0; i < _objectCount; i++) {
+        CFRelease(_objects[i]);
+    }
+    free(_objects);
+    _objects = NULL;
+    _objectCount = 0;
+    _objectsCapacity = 0;
+    _sectionContainers = sectionContainers;
+}
+
+/**
+ Returns the mutable array of objects in the section container at the index. Must only be called once the objects have been moved into
+ section containers.
+ */
+- (NSMutableArray *)_objectsInSectionContainerAtIndex:(NSUInteger)sectionIndex
+{
+    return (NSMutableArray *)((INTUGroupedArraySectionContainer *)_sectionContainers[sectionIndex]).objects;
+}
+
+/**
+ Returns YES if objects for the section at the index can be appended to the buffer of objects, or NO if they must be added to the section
+ containers (moving the objects into section containers first, if this section is not the most recently added one).
+ */
+- (BOOL)_canAppendToBufferForSectionAtIndex:(NSUInteger)sectionIndex
+{
+    if (_sectionContainers) {
+        return NO;
+    }
+    if (sectionIndex + 1 == _sectionCount) {
+        return YES;
+    }
+    [self _moveObjectsIntoSectionContainers];
+    return NO;
+}
+
+/**
+ Appends the object to the end of the section, adding the section after all existing sections if it has not been added yet.
+ Performance: O(1) on average (see -[_indexOfSection:])
+ 
+ @param object The object to add.
+ @param section The section to add the object to.
+ */
+- (void)addObject:(id)object toSection:(id)section
+{
+    if (!object || !section) {
+        NSAssert(object && section, @"Object and section should not be nil.");
+        return;
+    }
+    NSUInteger sectionIndex = [self _indexOfSection:section];
+    if ([self _canAppendToBufferForSectionAtIndex:sectionIndex]) {
+        [self _reserveObjectCapacityForAppendingCount:1];
+        _objects[_objectCount] = (__bridge_retained void *)object;
+        _objectCount++;
+    } else {
+        [[self _objectsInSectionContainerAtIndex:sectionIndex] addObject:object];
+    }
+    _sectionObjectCounts[sectionIndex]++;
+    _totalObjectCount++;
+}
+
+/**
+ Appends the objects in the array to the end of the section, adding the section after all existing sections if it has not been added yet.
+ Performance: O(m), where m is the number of objects in the array
+ 
+ @param array The array of objects to add.
+ @param section The section to add the objects to.
+ */
+- (void)addObjectsFromArray:(NSArray *)array toSection:(id)section
+{
+    if (!section) {
+        NSAssert(section, @"Section should not be nil.");
+        return;
+    }
+    NSUInteger count = [array count];
+    if (count == 0) {
+        // Don't add an empty section
+        return;
+    }
+    NSUInteger sectionIndex = [self _indexOfSection:section];
+    if ([self _canAppendToBufferForSectionAtIndex:sectionIndex]) {
+        [self _reserveObjectCapacityForAppendingCount:count];
+        __unsafe_unretained id *objectsBuffer = (__unsafe_unretained id *)(void *)(_objects + _objectCount);
+        [array getObjects:objectsBuffer range:NSMakeRange(0, count)];
+        for (NSUInteger i = 0; i < count; i++) {
+            CFRetain((__bridge CFTypeRef)objectsBuffer[i]);
+        }
+        _objectCount += count;
+    } else {
+        [[self _objectsInSectionContainerAtIndex:sectionIndex] addObjectsFromArray:array];
+    }
+    _sectionObjectCounts[sectionIndex] += count;
+    _totalObjectCount += count;
+}
+
+/**
+ Appends the objects in the C array to the end of the section, adding the section after all existing sections if it has not been added yet.
+ Performance: O(m), where m is the number of objects in the C array
+ 
+ @param objects A C array of objects to add. None of the objects may be nil.
+ @param count The number of objects in the C array.
+ @param section The section to add the objects to.
+ */
+- (void)addObjects:(const id [])objects count:(NSUInteger)count toSection:(id)section
+{
+    if (!section || (!objects && count > 0)) {
+        NSAssert(section && (objects || count == 0), @"Objects and section should not be nil.");
+        return;
+    }
+    if (count == 0) {
+        // Don't add an empty section
+        return;
+    }
+    NSUInteger sectionIndex = [self _indexOfSection:section];
+    BOOL appendToBuffer = [self _canAppendToBufferForSectionAtIndex:sectionIndex];
+    if (appendToBuffer) {
+        [self _reserveObjectCapacityForAppendingCount:count];
+    }
+    NSMutableArray *objectsInSection = appendToBuffer ? nil : [self _objectsInSectionContainerAtIndex:sectionIndex];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (!objects[i]) {
+            NSAssert(objects[i], @"Object at index %lu should not be nil.", (unsigned long)i);
+            continue;
+        }
+        if (appendToBuffer) {
+            _objects[_objectCount] = (__bridge_retained void *)objects[i];
+            _objectCount++;
+        } else {
+            [objectsInSection addObject:objects[i]];
+        }
+        _sectionObjectCounts[sectionIndex]++;
+        _totalObjectCount++;
+    }
+    if (_sectionObjectCounts[sectionIndex] == 0) {
+        // Every object was nil, so don't leave behind an empty section (which can only be the section that was just added)
+        CFDictionaryRemoveValue(_sectionIndexes, (__bridge const void *)section);
+        _sectionCount--;
+        CFRelease(_sections[_sectionCount]);
+        [_sectionContainers removeLastObject];
+        _lastSectionIndex = NSNotFound;
+    }
+}
+
+/**
+ Returns the number of sections added since the last grouped array was built.
+ Performance: O(1)
+ */
+- (NSUInteger)countAllSections
+{
+    return _sectionCount;
+}
+
+/**
+ Returns the number of objects added since the last grouped array was built.
+ Performance: O(1)
+ */
+- (NSUInteger)countAllObjects
+{
+    return _totalObjectCount;
+}
+
+/**
+ Returns an immutable grouped array containing the sections & objects that were added, in the order the sections were first added,
+ and resets the builder so that it can be used to build another grouped array. Nothing is copied: if the objects of each section were
+ added together (so they are still in a single buffer in section order), the grouped array's contiguous storage takes over the buffers;
+ otherwise the grouped array takes over the section containers.
+ Performance: O(n), where n is the number of sections
+ 
+ @return A new immutable grouped array with the sections & objects that were added.
+ */
+- (INTUGroupedArray *)build
+{
+    INTUGroupedArray *groupedArray = [[INTUGroupedArray alloc] initWithOptions:_options];
+    if (_sectionContainers) {
+        groupedArray.sectionContainers = _sectionContainers;
+        [self _releaseBuffers];
+    } else {
+        NSUInteger *sectionOffsets = malloc((_sectionCount + 1) * sizeof(NSUInteger));
+        if (!sectionOffsets) {
+            [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu sections.", (unsigned long)_sectionCount];
+        }
+        sectionOffsets[0] = 0;
+        for (NSUInteger i = 0; i < _sectionCount; i++) {
+            sectionOffsets[i + 1] = sectionOffsets[i] + _sectionObjectCounts[i];
+        }
+        [self _reserveSectionCapacity:1];
+        [self _reserveObjectCapacity:1];
+        if (_objectsCapacity > MAX(_objectCount, (NSUInteger)1)) {
+            // Give back the unused capacity, which normally doesn't move the buffer (and if it can't be shrunk, the larger buffer still works)
+            void **objects = realloc(_objects, MAX(_objectCount, (NSUInteger)1) * sizeof(void *));
+            if (objects) {
+                _objects = objects;
+            }
+        }
+        free(_sectionObjectCounts);
+        INTUGroupedArrayContiguousStorage *contiguousStorage = [[INTUGroupedArrayContiguousStorage alloc] initByAdoptingSections:_sections
+                                                                                                                         count:_sectionCount
+                                                                                                                       objects:_objects
+                                                                                                                         count:_objectCount
+                                                                                                                sectionOffsets:sectionOffsets];
+        [groupedArray _setContiguousStorage:contiguousStorage];
+    }
+    // Start over with new storage, since the grouped array now owns the existing storage
+    [self _resetWithSectionCapacity:0];
+    return groupedArray;
+}
+
+@end
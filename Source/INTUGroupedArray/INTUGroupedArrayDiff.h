@@ -0,0 +1,99 @@
+//
+//  INTUGroupedArrayDiff.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+#import "INTUIndexPair.h"
+
+@class INTUGroupedArray;
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+
+/**
+ The changes that turn one grouped array into another: the sections & objects that were deleted, inserted, and moved.
+ 
+ The changes follow the same conventions as batch updates to a UITableView, so they can be applied directly to a table view
+ that displays the grouped array:
+    - Deleted sections & objects are identified by their indices in the old grouped array.
+    - Inserted sections & objects are identified by their indices in the new grouped array.
+    - Moves are from an index in the old grouped array to an index in the new grouped array.
+    - Objects in deleted sections are not reported as deleted, and objects in inserted sections are not reported as inserted.
+ 
+ Sections & objects are matched using -hash and -isEqual:, which must be implemented consistently. The diff is computed using
+ Paul Heckel's algorithm, which is O(n+m), where n and m are the number of sections & objects in the two grouped arrays.
+ Objects may be moved between sections. Like other linear time diffing algorithms, the diff is not always minimal: some objects
+ (for example, duplicate objects) may be reported as deleted & inserted, or as moved, when fewer changes would be possible.
+ */
+@interface INTUGroupedArrayDiff : NSObject
+
+/** Creates and returns the diff that turns the old grouped array into the new grouped array. */
++ (instancetype)diffFromGroupedArray:(INTUGroupedArray *)fromGroupedArray toGroupedArray:(INTUGroupedArray *)toGroupedArray;
+
+
+#pragma mark Sections
+
+/** The indices of the sections in the old grouped array that were deleted. */
+@property (nonatomic, readonly) NSIndexSet *deletedSections;
+/** The indices of the sections in the new grouped array that were inserted. */
+@property (nonatomic, readonly) NSIndexSet *insertedSections;
+/** Returns the number of sections that were moved. */
+- (NSUInteger)countMovedSections;
+/** Executes the block for each section that was moved, from its index in the old grouped array to its index in the new grouped array. */
+- (void)enumerateMovedSectionsUsingBlock:(void (^)(NSUInteger fromIndex, NSUInteger toIndex, BOOL *stop))block;
+
+
+#pragma mark Objects
+
+/** The index paths of the objects in the old grouped array that were deleted. */
+@property (nonatomic, readonly) NSArray *deletedIndexPaths;
+/** The index paths of the objects in the new grouped array that were inserted. */
+@property (nonatomic, readonly) NSArray *insertedIndexPaths;
+/** Returns the number of objects that were moved. */
+- (NSUInteger)countMovedObjects;
+/** Executes the block for each object that was moved, from its index path in the old grouped array to its index path in the new grouped array. */
+- (void)enumerateMovedObjectsUsingBlock:(void (^)(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop))block;
+
+/** Returns the number of objects that were deleted. */
+- (NSUInteger)countDeletedObjects;
+/** Executes the block for the index pair in the old grouped array of each object that was deleted. */
+- (void)enumerateDeletedObjectsUsingIndexPairBlock:(void (^)(INTUIndexPair indexPair, BOOL *stop))block;
+/** Returns the number of objects that were inserted. */
+- (NSUInteger)countInsertedObjects;
+/** Executes the block for the index pair in the new grouped array of each object that was inserted. */
+- (void)enumerateInsertedObjectsUsingIndexPairBlock:(void (^)(INTUIndexPair indexPair, BOOL *stop))block;
+/** Executes the block for each object that was moved, from its index pair in the old grouped array to its index pair in the new grouped array. */
+- (void)enumerateMovedObjectsUsingIndexPairBlock:(void (^)(INTUIndexPair fromIndexPair, INTUIndexPair toIndexPair, BOOL *stop))block;
+
+
+#pragma mark Comparing
+
+/** Returns whether there are any changes. If not, the two grouped arrays are equal. */
+- (BOOL)hasChanges;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
@@ -0,0 +1,601 @@
+//
+//  INTUGroupedArrayDiff.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArrayDiff.h"
+#import "INTUGroupedArray.h"
+#import "INTUGroupedArraySectionContainer.h"
+#import "INTUGroupedArrayInternal.h"
+
+/** A section that was moved from an index in the old grouped array to an index in the new grouped array. */
+typedef struct {
+    NSUInteger fromIndex;
+    NSUInteger toIndex;
+} INTUGroupedArrayDiffSectionMove;
+
+/** An object that was moved from an index pair in the old grouped array to an index pair in the new grouped array. */
+typedef struct {
+    INTUIndexPair fromIndexPair;
+    INTUIndexPair toIndexPair;
+} INTUGroupedArrayDiffObjectMove;
+
+/** An entry in the symbol table used by Heckel's algorithm, which counts the occurrences of an object in each grouped array. */
+typedef struct {
+    NSUInteger oldCount;
+    NSUInteger newCount;
+    /** The flat index of the last occurrence of the object in the old grouped array. */
+    NSUInteger oldFlatIndex;
+} INTUGroupedArrayDiffSymbol;
+
+/** All the objects in one of the two grouped arrays being compared, flattened into arrays indexed by flat index. */
+typedef struct {
+    NSUInteger count;
+    __unsafe_unretained id *objects;
+    /** The index pair of each object. */
+    INTUIndexPair *indexPairs;
+    /** The symbol table entry of each object, or NSNotFound if the object's section was deleted or inserted. */
+    NSUInteger *symbols;
+    /** The flat index of the matching object in the other grouped array, or NSNotFound if the object has not been matched. */
+    NSUInteger *matches;
+} INTUGroupedArrayDiffObjects;
+
+/**
+ Returns a buffer for count elements of the size, raising an exception if the memory cannot be allocated.
+ */
+static void *INTUGroupedArrayDiffAllocate(NSUInteger count, size_t size)
+{
+    void *buffer = malloc(MAX(count, (NSUInteger)1) * size);
+    if (!buffer) {
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for a diff of %lu elements.", (unsigned long)count];
+    }
+    return buffer;
+}
+
+/**
+ Flattens all the objects in the grouped array, which must stay alive while the flattened objects are in use (they are not retained).
+ Performance: O(n), where n is the total number of objects across all sections
+ */
+static INTUGroupedArrayDiffObjects INTUGroupedArrayDiffObjectsCreate(INTUGroupedArray *groupedArray)
+{
+    INTUGroupedArrayDiffObjects objects;
+    NSUInteger count = [groupedArray countAllObjects];
+    objects.count = count;
+    objects.objects = (__unsafe_unretained id *)INTUGroupedArrayDiffAllocate(count, sizeof(id));
+    objects.indexPairs = INTUGroupedArrayDiffAllocate(count, sizeof(INTUIndexPair));
+    objects.symbols = INTUGroupedArrayDiffAllocate(count, sizeof(NSUInteger));
+    objects.matches = INTUGroupedArrayDiffAllocate(count, sizeof(NSUInteger));
+    
+    NSArray *sectionContainers = groupedArray.sectionContainers;
+    NSUInteger sectionCount = [sectionContainers count];
+    NSUInteger flatIndex = 0;
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        NSArray *sectionObjects = ((INTUGroupedArraySectionContainer *)sectionContainers[sectionIndex]).objects;
+        NSUInteger objectCount = [sectionObjects count];
+        [sectionObjects getObjects:objects.objects + flatIndex range:NSMakeRange(0, objectCount)];
+        for (NSUInteger objectIndex = 0; objectIndex < objectCount; objectIndex++) {
+            objects.indexPairs[flatIndex] = INTUIndexPairMake(sectionIndex, objectIndex);
+            objects.matches[flatIndex] = NSNotFound;
+            flatIndex++;
+        }
+    }
+    return objects;
+}
+
+/**
+ Frees the memory used by the flattened objects.
+ */
+static void INTUGroupedArrayDiffObjectsFree(INTUGroupedArrayDiffObjects objects)
+{
+    free(objects.objects);
+    free(objects.indexPairs);
+    free(objects.symbols);
+    free(objects.matches);
+}
+
+/**
+ Returns whether the objects at the flat indices in the two grouped arrays can be matched to each other: neither has been matched yet,
+ they are equal (have the same symbol), and each one is in the same section as its neighbor that was already matched.
+ */
+static inline BOOL INTUGroupedArrayDiffCanMatchNeighbors(INTUGroupedArrayDiffObjects *oldObjects, NSUInteger oldIndex, NSUInteger oldNeighborIndex,
+                                                         INTUGroupedArrayDiffObjects *newObjects, NSUInteger newIndex, NSUInteger newNeighborIndex)
+{
+    return oldObjects->matches[oldIndex] == NSNotFound && newObjects->matches[newIndex] == NSNotFound
+        && newObjects->symbols[newIndex] != NSNotFound && oldObjects->symbols[oldIndex] == newObjects->symbols[newIndex]
+        && oldObjects->indexPairs[oldIndex].sectionIndex == oldObjects->indexPairs[oldNeighborIndex].sectionIndex
+        && newObjects->indexPairs[newIndex].sectionIndex == newObjects->indexPairs[newNeighborIndex].sectionIndex;
+}
+
+
+@interface INTUGroupedArrayDiff ()
+
+@property (nonatomic, strong) NSIndexSet *deletedSections;
+@property (nonatomic, strong) NSIndexSet *insertedSections;
+// An array of INTUGroupedArrayDiffSectionMove structs, in order of the index the section was moved to.
+@property (nonatomic, strong) NSData *movedSections;
+// An array of INTUIndexPair structs, in order of index pair in the old grouped array.
+@property (nonatomic, strong) NSData *deletedObjects;
+// An array of INTUIndexPair structs, in order of index pair in the new grouped array.
+@property (nonatomic, strong) NSData *insertedObjects;
+// An array of INTUGroupedArrayDiffObjectMove structs, in order of the index pair the object was moved to.
+@property (nonatomic, strong) NSData *movedObjects;
+
+@end
+
+@implementation INTUGroupedArrayDiff
+
+/**
+ Creates and returns the diff that turns the old grouped array into the new grouped array.
+ Performance: O(n+m), where n and m are the total number of sections & objects in the old & new grouped arrays
+ 
+ @param fromGroupedArray The old grouped array.
+ @param toGroupedArray The new grouped array.
+ @return The diff between the two grouped arrays, or nil if either grouped array is nil.
+ */
++ (instancetype)diffFromGroupedArray:(INTUGroupedArray *)fromGroupedArray toGroupedArray:(INTUGroupedArray *)toGroupedArray
+{
+    if (!fromGroupedArray || !toGroupedArray) {
+        NSAssert(fromGroupedArray, @"Grouped array to diff from should not be nil.");
+        NSAssert(toGroupedArray, @"Grouped array to diff to should not be nil.");
+        return nil;
+    }
+    INTUGroupedArrayDiff *diff = [self new];
+    NSUInteger *oldSectionMatches = [diff _diffSectionsFromGroupedArray:fromGroupedArray toGroupedArray:toGroupedArray];
+    [diff _diffObjectsFromGroupedArray:fromGroupedArray toGroupedArray:toGroupedArray withSectionMatches:oldSectionMatches];
+    free(oldSectionMatches);
+    return diff;
+}
+
+/**
+ Matches the sections in the two grouped arrays, and records the deleted, inserted, and moved sections.
+ Since sections are unique, each section can be matched using a single hash table lookup.
+ Performance: O(n+m), where n and m are the number of sections in the old & new grouped arrays
+ 
+ @return A buffer (which the caller must free) containing the index in the new grouped array of each section in the old grouped array,
+         or NSNotFound for sections that were deleted.
+ */
+- (NSUInteger *)_diffSectionsFromGroupedArray:(INTUGroupedArray *)fromGroupedArray toGroupedArray:(INTUGroupedArray *)toGroupedArray
+{
+    NSUInteger oldSectionCount = [fromGroupedArray countAllSections];
+    NSUInteger newSectionCount = [toGroupedArray countAllSections];
+    
+    // Map each new section to its index. Values are stored as index + 1, since NULL means that there is no value.
+    CFMutableDictionaryRef newSectionIndexes = CFDictionaryCreateMutable(kCFAllocatorDefault, (CFIndex)newSectionCount, &kCFTypeDictionaryKeyCallBacks, NULL);
+    for (NSUInteger newIndex = 0; newIndex < newSectionCount; newIndex++) {
+        CFDictionarySetValue(newSectionIndexes, (__bridge const void *)[toGroupedArray sectionAtIndex:newIndex], (const void *)(newIndex + 1));
+    }
+    
+    NSUInteger *oldSectionMatches = INTUGroupedArrayDiffAllocate(oldSectionCount, sizeof(NSUInteger));
+    NSUInteger *newSectionMatches = INTUGroupedArrayDiffAllocate(newSectionCount, sizeof(NSUInteger));
+    for (NSUInteger newIndex = 0; newIndex < newSectionCount; newIndex++) {
+        newSectionMatches[newIndex] = NSNotFound;
+    }
+    // The number of deleted sections before each old section
+    NSUInteger *deleteOffsets = INTUGroupedArrayDiffAllocate(oldSectionCount, sizeof(NSUInteger));
+    NSMutableIndexSet *deletedSections = [NSMutableIndexSet new];
+    for (NSUInteger oldIndex = 0; oldIndex < oldSectionCount; oldIndex++) {
+        deleteOffsets[oldIndex] = [deletedSections count];
+        const void *value = CFDictionaryGetValue(newSectionIndexes, (__bridge const void *)[fromGroupedArray sectionAtIndex:oldIndex]);
+        if (value) {
+            NSUInteger newIndex = (NSUInteger)value - 1;
+            oldSectionMatches[oldIndex] = newIndex;
+            newSectionMatches[newIndex] = oldIndex;
+        } else {
+            oldSectionMatches[oldIndex] = NSNotFound;
+            [deletedSections addIndex:oldIndex];
+        }
+    }
+    CFRelease(newSectionIndexes);
+    
+    NSMutableIndexSet *insertedSections = [NSMutableIndexSet new];
+    NSMutableData *movedSections = [NSMutableData data];
+    for (NSUInteger newIndex = 0; newIndex < newSectionCount; newIndex++) {
+        NSUInteger oldIndex = newSectionMatches[newIndex];
+        if (oldIndex == NSNotFound) {
+            [insertedSections addIndex:newIndex];
+        } else if (oldIndex - deleteOffsets[oldIndex] + [insertedSections count] != newIndex) {
+            // The section is not where it would end up from the deletes & inserts alone
+            INTUGroupedArrayDiffSectionMove move = { oldIndex, newIndex };
+            [movedSections appendBytes:&move length:sizeof(move)];
+        }
+    }
+    free(deleteOffsets);
+    free(newSectionMatches);
+    
+    self.deletedSections = deletedSections;
+    self.insertedSections = insertedSections;
+    self.movedSections = movedSections;
+    return oldSectionMatches;
+}
+
+/**
+ Matches the objects in the sections that exist in both grouped arrays using Heckel's algorithm, and records the deleted, inserted, and
+ moved objects. Objects in deleted & inserted sections are ignored, since they are deleted or inserted along with their section.
+ Performance: O(n+m), where n and m are the total number of objects in the old & new grouped arrays
+ */
+- (void)_diffObjectsFromGroupedArray:(INTUGroupedArray *)fromGroupedArray toGroupedArray:(INTUGroupedArray *)toGroupedArray withSectionMatches:(NSUInteger *)oldSectionMatches
+{
+    INTUGroupedArrayDiffObjects oldObjects = INTUGroupedArrayDiffObjectsCreate(fromGroupedArray);
+    INTUGroupedArrayDiffObjects newObjects = INTUGroupedArrayDiffObjectsCreate(toGroupedArray);
+    
+    // Passes 1 & 2: Count the occurrences of each object in each grouped array in a symbol table, which maps each object to the index
+    // of its entry (stored as index + 1, since NULL means that there is no value)
+    INTUGroupedArrayDiffSymbol *symbols = INTUGroupedArrayDiffAllocate(oldObjects.count + newObjects.count, sizeof(INTUGroupedArrayDiffSymbol));
+    NSUInteger symbolCount = 0;
+    CFMutableDictionaryRef symbolTable = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    NSUInteger oldSectionCount = [fromGroupedArray countAllSections];
+    NSUInteger newSectionCount = [toGroupedArray countAllSections];
+    BOOL *newSectionIsMatched = calloc(MAX(newSectionCount, (NSUInteger)1), sizeof(BOOL));
+    if (!newSectionIsMatched) {
+        [NSException raise:NSMallocException format:@"Failed to allocate memory for a diff of %lu sections.", (unsigned long)newSectionCount];
+    }
+    for (NSUInteger oldSectionIndex = 0; oldSectionIndex < oldSectionCount; oldSectionIndex++) {
+        if (oldSectionMatches[oldSectionIndex] != NSNotFound) {
+            newSectionIsMatched[oldSectionMatches[oldSectionIndex]] = YES;
+        }
+    }
+    for (NSUInteger newIndex = 0; newIndex < newObjects.count; newIndex++) {
+        if (!newSectionIsMatched[newObjects.indexPairs[newIndex].sectionIndex]) {
+            newObjects.symbols[newIndex] = NSNotFound;
+            continue;
+        }
+        const void *key = (__bridge const void *)newObjects.objects[newIndex];
+        NSUInteger symbol = (NSUInteger)CFDictionaryGetValue(symbolTable, key);
+        if (symbol == 0) {
+            symbols[symbolCount] = (INTUGroupedArrayDiffSymbol){ 0, 0, NSNotFound };
+            symbol = ++symbolCount;
+            CFDictionarySetValue(symbolTable, key, (const void *)symbol);
+        }
+        symbols[symbol - 1].newCount++;
+        newObjects.symbols[newIndex] = symbol - 1;
+    }
+    for (NSUInteger oldIndex = 0; oldIndex < oldObjects.count; oldIndex++) {
+        if (oldSectionMatches[oldObjects.indexPairs[oldIndex].sectionIndex] == NSNotFound) {
+            oldObjects.symbols[oldIndex] = NSNotFound;
+            continue;
+        }
+        const void *key = (__bridge const void *)oldObjects.objects[oldIndex];
+        NSUInteger symbol = (NSUInteger)CFDictionaryGetValue(symbolTable, key);
+        if (symbol == 0) {
+            symbols[symbolCount] = (INTUGroupedArrayDiffSymbol){ 0, 0, NSNotFound };
+            symbol = ++symbolCount;
+            CFDictionarySetValue(symbolTable, key, (const void *)symbol);
+        }
+        symbols[symbol - 1].oldCount++;
+        symbols[symbol - 1].oldFlatIndex = oldIndex;
+        oldObjects.symbols[oldIndex] = symbol - 1;
+    }
+    CFRelease(symbolTable);
+    free(newSectionIsMatched);
+    
+    // Match the common prefix & suffix of each section that exists in both grouped arrays, which anchors sections that contain
+    // duplicate objects (which Heckel's algorithm alone cannot match), and handles the common case of few changes cheaply
+    const NSUInteger *oldSectionOffsets = [fromGroupedArray _sectionOffsetTable];
+    const NSUInteger *newSectionOffsets = [toGroupedArray _sectionOffsetTable];
+    for (NSUInteger oldSectionIndex = 0; oldSectionIndex < oldSectionCount; oldSectionIndex++) {
+        NSUInteger newSectionIndex = oldSectionMatches[oldSectionIndex];
+        if (newSectionIndex == NSNotFound) {
+            continue;
+        }
+        NSUInteger oldStart = oldSectionOffsets[oldSectionIndex], oldEnd = oldSectionOffsets[oldSectionIndex + 1];
+        NSUInteger newStart = newSectionOffsets[newSectionIndex], newEnd = newSectionOffsets[newSectionIndex + 1];
+        while (oldStart < oldEnd && newStart < newEnd && oldObjects.symbols[oldStart] == newObjects.symbols[newStart]) {
+            oldObjects.matches[oldStart] = newStart;
+            newObjects.matches[newStart] = oldStart;
+            oldStart++;
+            newStart++;
+        }
+        while (oldStart < oldEnd && newStart < newEnd && oldObjects.symbols[oldEnd - 1] == newObjects.symbols[newEnd - 1]) {
+            oldObjects.matches[oldEnd - 1] = newEnd - 1;
+            newObjects.matches[newEnd - 1] = oldEnd - 1;
+            oldEnd--;
+            newEnd--;
+        }
+    }
+    
+    // Pass 3: Match the objects that occur exactly once in each grouped array
+    for (NSUInteger newIndex = 0; newIndex < newObjects.count; newIndex++) {
+        NSUInteger symbol = newObjects.symbols[newIndex];
+        if (symbol != NSNotFound && symbols[symbol].oldCount == 1 && symbols[symbol].newCount == 1
+            && newObjects.matches[newIndex] == NSNotFound && oldObjects.matches[symbols[symbol].oldFlatIndex] == NSNotFound) {
+            NSUInteger oldIndex = symbols[symbol].oldFlatIndex;
+            newObjects.matches[newIndex] = oldIndex;
+            oldObjects.matches[oldIndex] = newIndex;
+        }
+    }
+    free(symbols);
+    
+    // Pass 4: Match equal objects that directly follow matched objects in both grouped arrays
+    for (NSUInteger newIndex = 0; newIndex + 1 < newObjects.count; newIndex++) {
+        NSUInteger oldIndex = newObjects.matches[newIndex];
+        if (oldIndex != NSNotFound && oldIndex + 1 < oldObjects.count
+            && INTUGroupedArrayDiffCanMatchNeighbors(&oldObjects, oldIndex + 1, oldIndex, &newObjects, newIndex + 1, newIndex)) {
+            newObjects.matches[newIndex + 1] = oldIndex + 1;
+            oldObjects.matches[oldIndex + 1] = newIndex + 1;
+        }
+    }
+    
+    // Pass 5: Match equal objects that directly precede matched objects in both grouped arrays
+    for (NSUInteger newIndex = newObjects.count; newIndex > 1; newIndex--) {
+        NSUInteger oldIndex = newObjects.matches[newIndex - 1];
+        if (oldIndex != NSNotFound && oldIndex > 0
+            && INTUGroupedArrayDiffCanMatchNeighbors(&oldObjects, oldIndex - 1, oldIndex, &newObjects, newIndex - 2, newIndex - 1)) {
+            newObjects.matches[newIndex - 2] = oldIndex - 1;
+            oldObjects.matches[oldIndex - 1] = newIndex - 2;
+        }
+    }
+    
+    // Record the deleted objects, and the number of objects before each old object in its section that were deleted or moved to
+    // another section (reusing the symbols buffer, which is no longer needed)
+    NSUInteger *deleteOffsets = oldObjects.symbols;
+    NSMutableData *deletedObjects = [NSMutableData data];
+    NSUInteger deleteOffset = 0;
+    for (NSUInteger oldIndex = 0; oldIndex < oldObjects.count; oldIndex++) {
+        INTUIndexPair indexPair = oldObjects.indexPairs[oldIndex];
+        if (indexPair.objectIndex == 0) {
+            deleteOffset = 0;
+        }
+        NSUInteger sectionMatch = oldSectionMatches[indexPair.sectionIndex];
+        deleteOffsets[oldIndex] = deleteOffset;
+        if (sectionMatch == NSNotFound) {
+            continue;
+        }
+        NSUInteger newIndex = oldObjects.matches[oldIndex];
+        if (newIndex == NSNotFound) {
+            [deletedObjects appendBytes:&indexPair length:sizeof(indexPair)];
+            deleteOffset++;
+        } else if (newObjects.indexPairs[newIndex].sectionIndex != sectionMatch) {
+            deleteOffset++;
+        }
+    }
+    
+    // Record the inserted & moved objects
+    NSMutableData *insertedObjects = [NSMutableData data];
+    NSMutableData *movedObjects = [NSMutableData data];
+    NSUInteger insertOffset = 0;
+    for (NSUInteger newIndex = 0; newIndex < newObjects.count; newIndex++) {
+        INTUIndexPair indexPair = newObjects.indexPairs[newIndex];
+        if (indexPair.objectIndex == 0) {
+            insertOffset = 0;
+        }
+        if (newObjects.symbols[newIndex] == NSNotFound) {
+            // The section was inserted
+            continue;
+        }
+        NSUInteger oldIndex = newObjects.matches[newIndex];
+        if (oldIndex == NSNotFound) {
+            [insertedObjects appendBytes:&indexPair length:sizeof(indexPair)];
+            insertOffset++;
+            continue;
+        }
+        INTUIndexPair oldIndexPair = oldObjects.indexPairs[oldIndex];
+        BOOL movedFromAnotherSection = (oldSectionMatches[oldIndexPair.sectionIndex] != indexPair.sectionIndex);
+        if (movedFromAnotherSection) {
+            insertOffset++;
+        }
+        if (movedFromAnotherSection || oldIndexPair.objectIndex - deleteOffsets[oldIndex] + insertOffset != indexPair.objectIndex) {
+            // The object is not where it would end up from the deletes & inserts alone
+            INTUGroupedArrayDiffObjectMove move = { oldIndexPair, indexPair };
+            [movedObjects appendBytes:&move length:sizeof(move)];
+        }
+    }
+    
+    INTUGroupedArrayDiffObjectsFree(oldObjects);
+    INTUGroupedArrayDiffObjectsFree(newObjects);
+    self.deletedObjects = deletedObjects;
+    self.insertedObjects = insertedObjects;
+    self.movedObjects = movedObjects;
+}
+
+#pragma mark Sections
+
+/**
+ Returns the number of sections that were moved.
+ Performance: O(1)
+ */
+- (NSUInteger)countMovedSections
+{
+    return [self.movedSections length] / sizeof(INTUGroupedArrayDiffSectionMove);
+}
+
+/**
+ Executes the block for each section that was moved, in order of the index in the new grouped array that it was moved to.
+ Performance: O(n), where n is the number of sections that were moved
+ 
+ @param block The block to execute for each moved section, with its index in the old grouped array and its index in the new grouped array.
+ */
+- (void)enumerateMovedSectionsUsingBlock:(void (^)(NSUInteger fromIndex, NSUInteger toIndex, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    const INTUGroupedArrayDiffSectionMove *moves = [self.movedSections bytes];
+    NSUInteger count = [self countMovedSections];
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < count && !stop; i++) {
+        block(moves[i].fromIndex, moves[i].toIndex, &stop);
+    }
+}
+
+#pragma mark Objects
+
+/**
+ Returns an array of the index paths of the objects in the old grouped array that were deleted, in order.
+ Performance: O(n), where n is the number of objects that were deleted
+ */
+- (NSArray *)deletedIndexPaths
+{
+    NSMutableArray *deletedIndexPaths = [NSMutableArray arrayWithCapacity:[self countDeletedObjects]];
+    [self enumerateDeletedObjectsUsingIndexPairBlock:^(INTUIndexPair indexPair, BOOL *stop) {
+        [deletedIndexPaths addObject:[INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex]];
+    }];
+    return deletedIndexPaths;
+}
+
+/**
+ Returns an array of the index paths of the objects in the new grouped array that were inserted, in order.
+ Performance: O(n), where n is the number of objects that were inserted
+ */
+- (NSArray *)insertedIndexPaths
+{
+    NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:[self countInsertedObjects]];
+    [self enumerateInsertedObjectsUsingIndexPairBlock:^(INTUIndexPair indexPair, BOOL *stop) {
+        [insertedIndexPaths addObject:[INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex]];
+    }];
+    return insertedIndexPaths;
+}
+
+/**
+ Returns the number of objects that were moved.
+ Performance: O(1)
+ */
+- (NSUInteger)countMovedObjects
+{
+    return [self.movedObjects length] / sizeof(INTUGroupedArrayDiffObjectMove);
+}
+
+/**
+ Executes the block for each object that was moved, in order of the index path in the new grouped array that it was moved to.
+ Performance: O(n), where n is the number of objects that were moved
+ 
+ @param block The block to execute for each moved object, with its index path in the old grouped array and its index path in the new grouped array.
+ */
+- (void)enumerateMovedObjectsUsingBlock:(void (^)(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    [self enumerateMovedObjectsUsingIndexPairBlock:^(INTUIndexPair fromIndexPair, INTUIndexPair toIndexPair, BOOL *stop) {
+        block([INTUGroupedArray indexPathForRow:fromIndexPair.objectIndex inSection:fromIndexPair.sectionIndex],
+              [INTUGroupedArray indexPathForRow:toIndexPair.objectIndex inSection:toIndexPair.sectionIndex],
+              stop);
+    }];
+}
+
+/**
+ Returns the number of objects that were deleted.
+ Performance: O(1)
+ */
+- (NSUInteger)countDeletedObjects
+{
+    return [self.deletedObjects length] / sizeof(INTUIndexPair);
+}
+
+/**
+ Executes the block for each object that was deleted, in order of its index pair in the old grouped array.
+ Performance: O(n), where n is the number of objects that were deleted
+ 
+ @param block The block to execute for each deleted object, with its index pair in the old grouped array.
+ */
+- (void)enumerateDeletedObjectsUsingIndexPairBlock:(void (^)(INTUIndexPair indexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    const INTUIndexPair *indexPairs = [self.deletedObjects bytes];
+    NSUInteger count = [self countDeletedObjects];
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < count && !stop; i++) {
+        block(indexPairs[i], &stop);
+    }
+}
+
+/**
+ Returns the number of objects that were inserted.
+ Performance: O(1)
+ */
+- (NSUInteger)countInsertedObjects
+{
+    return [self.insertedObjects length] / sizeof(INTUIndexPair);
+}
+
+/**
+ Executes the block for each object that was inserted, in order of its index pair in the new grouped array.
+ Performance: O(n), where n is the number of objects that were inserted
+ 
+ @param block The block to execute for each inserted object, with its index pair in the new grouped array.
+ */
+- (void)enumerateInsertedObjectsUsingIndexPairBlock:(void (^)(INTUIndexPair indexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    const INTUIndexPair *indexPairs = [self.insertedObjects bytes];
+    NSUInteger count = [self countInsertedObjects];
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < count && !stop; i++) {
+        block(indexPairs[i], &stop);
+    }
+}
+
+/**
+ Executes the block for each object that was moved, in order of the index pair in the new grouped array that it was moved to.
+ Performance: O(n), where n is the number of objects that were moved
+ 
+ @param block The block to execute for each moved object, with its index pair in the old grouped array and its index pair in the new grouped array.
+ */
+- (void)enumerateMovedObjectsUsingIndexPairBlock:(void (^)(INTUIndexPair fromIndexPair, INTUIndexPair toIndexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    const INTUGroupedArrayDiffObjectMove *moves = [self.movedObjects bytes];
+    NSUInteger count = [self countMovedObjects];
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < count && !stop; i++) {
+        block(moves[i].fromIndexPair, moves[i].toIndexPair, &stop);
+    }
+}
+
+#pragma mark Comparing
+
+/**
+ Returns whether there are any changes. If not, the two grouped arrays are equal.
+ Performance: O(1)
+ */
+- (BOOL)hasChanges
+{
+    return [self.deletedSections count] > 0 || [self.insertedSections count] > 0 || [self countMovedSections] > 0
+        || [self countDeletedObjects] > 0 || [self countInsertedObjects] > 0 || [self countMovedObjects] > 0;
+}
+
+#pragma mark NSObject Method Overrides
+
+/**
+ Returns a description of the changes.
+ */
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> Sections: %lu deleted, %lu inserted, %lu moved; Objects: %lu deleted, %lu inserted, %lu moved",
+            NSStringFromClass([self class]), self,
+            (unsigned long)[self.deletedSections count], (unsigned long)[self.insertedSections count], (unsigned long)[self countMovedSections],
+            (unsigned long)[self countDeletedObjects], (unsigned long)[self countInsertedObjects], (unsigned long)[self countMovedObjects]];
+}
+
+@end
@@ -33,5 +33,11 @@
 
 #import "INTUGroupedArray.h"
 #import "INTUMutableGroupedArray.h"
+#import "INTUConcurrentMutableGroupedArray.h"
+#import "INTUScalarGroupedArray.h"
+#import "INTUGroupedArrayBuilder.h"
+#import "INTUGroupedArrayDiff.h"
+#import "INTUGroupedArraySerialization.h"
+#import "INTUGroupedArrayInstrumentation.h"
 
 #endif /* INTUGroupedArrayImports_h */
@@ -0,0 +1,94 @@
+//
+//  INTUGroupedArrayInstrumentation.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+/** The key in the snapshot for the dictionary of counters, which maps the name of each counter (see below) to its value (an NSNumber). */
+extern NSString * const INTUGroupedArrayInstrumentationCountersKey;
+/** The key in the snapshot for the dictionary of timings, which maps the name of each measured method (e.g. "indexPathOfObject:") to a dictionary
+    with the number of calls and the cumulative time spent in them, for the keys below. */
+extern NSString * const INTUGroupedArrayInstrumentationTimingsKey;
+/** The key in each timing for the number of calls to the method (an NSNumber). */
+extern NSString * const INTUGroupedArrayInstrumentationCallsKey;
+/** The key in each timing for the cumulative time spent in the method in nanoseconds (an NSNumber), including the time spent in any
+    nested calls to other measured methods. */
+extern NSString * const INTUGroupedArrayInstrumentationNanosecondsKey;
+
+/** The number of times a section was located by value (e.g. by -indexOfSection:, or when adding an object to a section). */
+extern NSString * const INTUGroupedArrayInstrumentationSectionLookupsCounter;
+/** The number of section lookups that had to scan the sections linearly, because INTUGroupedArrayOptionHashedSectionIndex was not set. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionLookupScansCounter;
+/** The total number of sections compared against the section being looked up during linear scans. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionsScannedCounter;
+/** The number of section index hints (e.g. passed to -addObject:toSection:withSectionIndexHint:) that correctly located the section. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionIndexHintHitsCounter;
+/** The number of section index hints that did not locate the section, so that the section had to be looked up. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionIndexHintMissesCounter;
+/** The number of times a section or object comparator was called (when sorting, or locating sections & objects that are kept sorted). */
+extern NSString * const INTUGroupedArrayInstrumentationComparisonsCounter;
+/** The number of NSIndexPath objects created (e.g. for each object visited by -enumerateObjectsUsingBlock:). */
+extern NSString * const INTUGroupedArrayInstrumentationIndexPathsCreatedCounter;
+/** The number of section containers copied, either because a mutable grouped array modified a section it shared with a copy (copy-on-write),
+    or because the grouped array was copied with its items. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionContainersCopiedCounter;
+/** The total number of objects in the section containers that were copied. */
+extern NSString * const INTUGroupedArrayInstrumentationObjectsCopiedCounter;
+/** The number of section containers (each with its own mutable array of objects) allocated for sections added to mutable grouped arrays. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionContainersCreatedCounter;
+/** The number of sections added to mutable grouped arrays that reused the section container of a section removed earlier, instead of
+    allocating a new one. */
+extern NSString * const INTUGroupedArrayInstrumentationSectionContainersReusedCounter;
+/** The number of times a mutable grouped array was mutated. */
+extern NSString * const INTUGroupedArrayInstrumentationMutationsCounter;
+
+
+/**
+ Reports counters of the internal operations performed by all grouped arrays, and the number of calls and cumulative time spent in
+ the most significant methods, to help diagnose where time goes in production.
+ 
+ The instrumentation is compiled out unless the library is built with INTU_GROUPED_ARRAY_INSTRUMENTATION=1, in which case it records
+ operations from every grouped array in the process (on all threads) until it is reset. When it is compiled out, it costs nothing,
+ and snapshots are empty.
+ */
+@interface INTUGroupedArrayInstrumentation : NSObject
+
+/** Returns whether the instrumentation was compiled in. */
++ (BOOL)isEnabled;
+
+/** Returns a snapshot of the counters and timings recorded since the process started or the instrumentation was last reset.
+    The snapshot contains a dictionary of counters for INTUGroupedArrayInstrumentationCountersKey, and a dictionary of timings for
+    INTUGroupedArrayInstrumentationTimingsKey, which are both empty if the instrumentation was compiled out. */
++ (NSDictionary *)snapshot;
+
+/** Resets all counters and timings to zero. */
++ (void)reset;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
@@ -0,0 +1,235 @@
+//
+//  INTUGroupedArrayInstrumentation.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArrayInstrumentation.h"
+#import "INTUGroupedArrayInstrumentationInternal.h"
+#import <pthread.h>
+
+NSString * const INTUGroupedArrayInstrumentationCountersKey = @"counters";
+NSString * const INTUGroupedArrayInstrumentationTimingsKey = @"timings";
+NSString * const INTUGroupedArrayInstrumentationCallsKey = @"calls";
+NSString * const INTUGroupedArrayInstrumentationNanosecondsKey = @"nanoseconds";
+
+NSString * const INTUGroupedArrayInstrumentationSectionLookupsCounter = @"sectionLookups";
+NSString * const INTUGroupedArrayInstrumentationSectionLookupScansCounter = @"sectionLookupScans";
+NSString * const INTUGroupedArrayInstrumentationSectionsScannedCounter = @"sectionsScanned";
+NSString * const INTUGroupedArrayInstrumentationSectionIndexHintHitsCounter = @"sectionIndexHintHits";
+NSString * const INTUGroupedArrayInstrumentationSectionIndexHintMissesCounter = @"sectionIndexHintMisses";
+NSString * const INTUGroupedArrayInstrumentationComparisonsCounter = @"comparisons";
+NSString * const INTUGroupedArrayInstrumentationIndexPathsCreatedCounter = @"indexPathsCreated";
+NSString * const INTUGroupedArrayInstrumentationSectionContainersCopiedCounter = @"sectionContainersCopied";
+NSString * const INTUGroupedArrayInstrumentationObjectsCopiedCounter = @"objectsCopied";
+NSString * const INTUGroupedArrayInstrumentationSectionContainersCreatedCounter = @"sectionContainersCreated";
+NSString * const INTUGroupedArrayInstrumentationSectionContainersReusedCounter = @"sectionContainersReused";
+NSString * const INTUGroupedArrayInstrumentationMutationsCounter = @"mutations";
+
+#if INTU_GROUPED_ARRAY_INSTRUMENTATION
+
+// mach_absolute_time() is used on Apple platforms, since clock_gettime() requires iOS 10 / OS X 10.12
+#ifdef __APPLE__
+#import <mach/mach_time.h>
+#else
+#import <time.h>
+#endif
+
+uint64_t INTUGroupedArrayInstrumentationCounters[INTUGroupedArrayInstrumentationCounterCount];
+
+/** The number of calls to a method, and the cumulative time spent in them. There is one for each place that a method is measured, which is
+    allocated the first time the method is called and never freed, so that timing a call only needs two atomic additions and no lock. */
+struct INTUGroupedArrayInstrumentationMethodTiming {
+    SEL selector;
+    // Only modified atomically
+    uint64_t calls;
+    // In the units of INTUGroupedArrayInstrumentationTicks(). Only modified atomically
+    uint64_t ticks;
+    // The method timing that was created before this one, or NULL
+    INTUGroupedArrayInstrumentationMethodTiming *next;
+};
+
+// The most recently created method timing, which links to all of the others. Only modified while holding the lock, and read atomically.
+static INTUGroupedArrayInstrumentationMethodTiming *INTUGroupedArrayInstrumentationMethodTimings;
+// Serializes creating method timings, which happens once for each measured method.
+static pthread_mutex_t INTUGroupedArrayInstrumentationLock = PTHREAD_MUTEX_INITIALIZER;
+
+/** Returns the names of the counters, in the same order as the INTUGroupedArrayInstrumentationCounter values. */
+static NSArray *INTUGroupedArrayInstrumentationCounterNames(void)
+{
+    return @[INTUGroupedArrayInstrumentationSectionLookupsCounter,
+             INTUGroupedArrayInstrumentationSectionLookupScansCounter,
+             INTUGroupedArrayInstrumentationSectionsScannedCounter,
+             INTUGroupedArrayInstrumentationSectionIndexHintHitsCounter,
+             INTUGroupedArrayInstrumentationSectionIndexHintMissesCounter,
+             INTUGroupedArrayInstrumentationComparisonsCounter,
+             INTUGroupedArrayInstrumentationIndexPathsCreatedCounter,
+             INTUGroupedArrayInstrumentationSectionContainersCopiedCounter,
+             INTUGroupedArrayInstrumentationObjectsCopiedCounter,
+             INTUGroupedArrayInstrumentationSectionContainersCreatedCounter,
+             INTUGroupedArrayInstrumentationSectionContainersReusedCounter,
+             INTUGroupedArrayInstrumentationMutationsCounter];
+}
+
+/** Returns the current time of a monotonic clock, in mach_absolute_time() units on Apple platforms, or in nanoseconds elsewhere. */
+static inline uint64_t INTUGroupedArrayInstrumentationTicks(void)
+{
+#ifdef __APPLE__
+    return mach_absolute_time();
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+}
+
+/** Converts a duration in the units of INTUGroupedArrayInstrumentationTicks() to nanoseconds. */
+static uint64_t INTUGroupedArrayInstrumentationNanosecondsFromTicks(uint64_t ticks)
+{
+#ifdef __APPLE__
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    // Split the conversion so that multiplying by the numerator can't overflow
+    return ticks / timebase.denom * timebase.numer + ticks % timebase.denom * timebase.numer / timebase.denom;
+#else
+    return ticks;
+#endif
+}
+
+/** Creates the method timing for a place that the method is measured, and stores it in the cache for that place (if another thread has
+    not already done so). */
+static INTUGroupedArrayInstrumentationMethodTiming *INTUGroupedArrayInstrumentationCreateMethodTiming(SEL selector, INTUGroupedArrayInstrumentationMethodTiming **cache)
+{
+    pthread_mutex_lock(&INTUGroupedArrayInstrumentationLock);
+    INTUGroupedArrayInstrumentationMethodTiming *methodTiming = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+    if (!methodTiming) {
+        methodTiming = calloc(1, sizeof(INTUGroupedArrayInstrumentationMethodTiming));
+        if (methodTiming) {
+            methodTiming->selector = selector;
+            methodTiming->next = INTUGroupedArrayInstrumentationMethodTimings;
+            __atomic_store_n(&INTUGroupedArrayInstrumentationMethodTimings, methodTiming, __ATOMIC_RELEASE);
+            __atomic_store_n(cache, methodTiming, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&INTUGroupedArrayInstrumentationLock);
+    return methodTiming;
+}
+
+INTUGroupedArrayInstrumentationTiming INTUGroupedArrayInstrumentationTimingStart(SEL selector, INTUGroupedArrayInstrumentationMethodTiming **cache)
+{
+    INTUGroupedArrayInstrumentationMethodTiming *methodTiming = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+    if (!methodTiming) {
+        methodTiming = INTUGroupedArrayInstrumentationCreateMethodTiming(selector, cache);
+    }
+    INTUGroupedArrayInstrumentationTiming timing = {methodTiming, INTUGroupedArrayInstrumentationTicks()};
+    return timing;
+}
+
+void INTUGroupedArrayInstrumentationTimingStop(INTUGroupedArrayInstrumentationTiming *timing)
+{
+    uint64_t duration = INTUGroupedArrayInstrumentationTicks() - timing->startTime;
+    INTUGroupedArrayInstrumentationMethodTiming *methodTiming = timing->methodTiming;
+    if (methodTiming) {
+        __atomic_fetch_add(&methodTiming->calls, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&methodTiming->ticks, duration, __ATOMIC_RELAXED);
+    }
+}
+
+NSComparator INTUGroupedArrayInstrumentationCountingComparator(NSComparator cmptr)
+{
+    if (!cmptr) {
+        return nil;
+    }
+    return ^NSComparisonResult(id obj1, id obj2) {
+        INTU_INSTRUMENT_COUNT(Comparisons, 1);
+        return cmptr(obj1, obj2);
+    };
+}
+
+#endif /* INTU_GROUPED_ARRAY_INSTRUMENTATION */
+
+
+@implementation INTUGroupedArrayInstrumentation
+
++ (BOOL)isEnabled
+{
+    return INTU_GROUPED_ARRAY_INSTRUMENTATION ? YES : NO;
+}
+
+/**
+ Returns a snapshot of the counters and timings. The counters & timings are each read atomically, but not all at the same instant, so a snapshot
+ taken while grouped arrays are being used on other threads may be slightly inconsistent.
+ */
++ (NSDictionary *)snapshot
+{
+#if INTU_GROUPED_ARRAY_INSTRUMENTATION
+    NSArray *counterNames = INTUGroupedArrayInstrumentationCounterNames();
+    NSMutableDictionary *counters = [NSMutableDictionary dictionaryWithCapacity:INTUGroupedArrayInstrumentationCounterCount];
+    for (NSUInteger counter = 0; counter < INTUGroupedArrayInstrumentationCounterCount; counter++) {
+        counters[counterNames[counter]] = @(__atomic_load_n(&INTUGroupedArrayInstrumentationCounters[counter], __ATOMIC_RELAXED));
+    }
+    
+    // Combine the method timings of every place that each method is measured (e.g. the same selector in different classes)
+    NSMutableDictionary *callsBySelector = [NSMutableDictionary dictionary];
+    NSMutableDictionary *ticksBySelector = [NSMutableDictionary dictionary];
+    INTUGroupedArrayInstrumentationMethodTiming *methodTiming = __atomic_load_n(&INTUGroupedArrayInstrumentationMethodTimings, __ATOMIC_ACQUIRE);
+    for (; methodTiming; methodTiming = methodTiming->next) {
+        NSString *selector = NSStringFromSelector(methodTiming->selector);
+        callsBySelector[selector] = @([callsBySelector[selector] unsignedLongLongValue] + __atomic_load_n(&methodTiming->calls, __ATOMIC_RELAXED));
+        ticksBySelector[selector] = @([ticksBySelector[selector] unsignedLongLongValue] + __atomic_load_n(&methodTiming->ticks, __ATOMIC_RELAXED));
+    }
+    NSMutableDictionary *timings = [NSMutableDictionary dictionaryWithCapacity:[callsBySelector count]];
+    for (NSString *selector in callsBySelector) {
+        if ([callsBySelector[selector] unsignedLongLongValue] == 0) {
+            // Not called since the last reset
+            continue;
+        }
+        uint64_t nanoseconds = INTUGroupedArrayInstrumentationNanosecondsFromTicks([ticksBySelector[selector] unsignedLongLongValue]);
+        timings[selector] = @{INTUGroupedArrayInstrumentationCallsKey: callsBySelector[selector],
+                              INTUGroupedArrayInstrumentationNanosecondsKey: @(nanoseconds)};
+    }
+    
+    return @{INTUGroupedArrayInstrumentationCountersKey: counters, INTUGroupedArrayInstrumentationTimingsKey: timings};
+#else
+    return @{INTUGroupedArrayInstrumentationCountersKey: @{}, INTUGroupedArrayInstrumentationTimingsKey: @{}};
+#endif
+}
+
++ (void)reset
+{
+#if INTU_GROUPED_ARRAY_INSTRUMENTATION
+    for (NSUInteger counter = 0; counter < INTUGroupedArrayInstrumentationCounterCount; counter++) {
+        __atomic_store_n(&INTUGroupedArrayInstrumentationCounters[counter], 0, __ATOMIC_RELAXED);
+    }
+    INTUGroupedArrayInstrumentationMethodTiming *methodTiming = __atomic_load_n(&INTUGroupedArrayInstrumentationMethodTimings, __ATOMIC_ACQUIRE);
+    for (; methodTiming; methodTiming = methodTiming->next) {
+        __atomic_store_n(&methodTiming->calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&methodTiming->ticks, 0, __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+@end
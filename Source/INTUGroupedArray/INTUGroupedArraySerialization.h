@@ -0,0 +1,81 @@
+//
+//  INTUGroupedArraySerialization.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+
+@class INTUGroupedArray;
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+/** The error domain for errors from INTUGroupedArraySerialization. */
+extern NSString * const INTUGroupedArraySerializationErrorDomain;
+
+/** The error codes for errors from INTUGroupedArraySerialization. */
+typedef NS_ENUM(NSInteger, INTUGroupedArraySerializationError) {
+    /** A section or object in the grouped array is not an NSString, NSNumber, or NSData, so the grouped array cannot be serialized. */
+    INTUGroupedArraySerializationErrorUnsupportedType   = 1,
+    /** The data is not a serialized grouped array, is from an unsupported version of the format, or is truncated or corrupt. */
+    INTUGroupedArraySerializationErrorInvalidData       = 2
+};
+
+
+#pragma mark - INTUGroupedArraySerialization
+
+/**
+ Converts grouped arrays to and from a compact binary format, which is much faster to encode & decode and much smaller than an archive
+ created with NSKeyedArchiver. Only grouped arrays whose sections & objects are all NSString, NSNumber, or NSData objects are supported.
+ (Use NSKeyedArchiver for grouped arrays containing other types of objects.)
+ 
+ The format consists of a fixed size header, followed by a table with the cumulative object count and byte offset of each section,
+ followed by the packed section & objects of each section. All integers are little endian. Because the section table locates each
+ section's objects, a grouped array can be decoded lazily, one section at a time, such as from a memory mapped file.
+ */
+@interface INTUGroupedArraySerialization : NSObject
+
+/** Returns whether the grouped array can be serialized (whether all its sections & objects are NSString, NSNumber, or NSData objects). */
++ (BOOL)isValidGroupedArray:(INTUGroupedArray *)groupedArray;
+
+/** Returns the grouped array serialized in the binary format, or nil (and sets the error) if it contains an unsupported type of object. */
++ (GA__INTU_NULLABLE NSData *)dataWithGroupedArray:(INTUGroupedArray *)groupedArray error:(NSError * __autoreleasing *)error;
+
+/** Returns an immutable grouped array deserialized from the binary format, or nil (and sets the error) if the data is invalid. */
++ (GA__INTU_NULLABLE INTUGroupedArray *)groupedArrayWithData:(NSData *)data error:(NSError * __autoreleasing *)error;
+
+/** Returns an immutable grouped array deserialized from the binary format, or nil (and sets the error) if the sections in the data are invalid.
+    Only the sections are decoded up front; the objects in each section are decoded the first time they are accessed, and an exception
+    is raised at that point if they are invalid. With the INTUGroupedArrayOptionHashedObjectIndex option, the object index is built (which
+    decodes every section) the first time an object is looked up. The data must not be modified while the grouped array is in use. */
++ (GA__INTU_NULLABLE INTUGroupedArray *)lazyGroupedArrayWithData:(NSData *)data error:(NSError * __autoreleasing *)error;
+
+/** Returns an immutable grouped array lazily deserialized (see +[lazyGroupedArrayWithData:error:]) from a memory mapped file containing
+    the binary format, or nil (and sets the error) if the file cannot be read or the sections in it are invalid. Only the pages of the file
+    that are accessed are read into memory. The file must not be modified or truncated while the grouped array is in use. */
++ (GA__INTU_NULLABLE INTUGroupedArray *)groupedArrayWithContentsOfFile:(NSString *)path error:(NSError * __autoreleasing *)error;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
@@ -0,0 +1,569 @@
+//
+//  INTUGroupedArraySerialization.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArraySerialization.h"
+#import "INTUGroupedArray.h"
+#import "INTUGroupedArraySectionContainer.h"
+#import "INTUGroupedArrayInternal.h"
+
+NSString * const INTUGroupedArraySerializationErrorDomain = @"INTUGroupedArraySerializationErrorDomain";
+
+/** The magic number at the start of serialized data, which is "IGAB" in ASCII. */
+static const uint32_t kINTUGroupedArraySerializationMagic = 0x42414749;
+/** The version of the format written by this implementation. */
+static const uint32_t kINTUGroupedArraySerializationVersion = 1;
+/**
+ The size of the header in bytes. The header contains (all little endian):
+    uint32_t magic, uint32_t version, uint64_t options, uint64_t sectionCount, uint64_t objectCount, uint64_t dataLength
+ */
+static const NSUInteger kINTUGroupedArraySerializationHeaderSize = 40;
+/**
+ The size of each entry in the section table in bytes. The section table follows the header, and has one more entry than there are sections.
+ Each entry contains (all little endian): uint64_t objectOffset, uint64_t byteOffset
+ where objectOffset is the total number of objects in all earlier sections, and byteOffset is the offset of the section's payload
+ from the start of the data. The last entry contains the total number of objects and the length of the data.
+ The payload of each section contains the section followed by each of its objects, encoded as values.
+ */
+static const NSUInteger kINTUGroupedArraySerializationSectionTableEntrySize = 16;
+
+/**
+ The type tag that precedes each encoded value. The tag is followed by:
+    String:     uint32_t length, followed by length bytes of UTF-8
+    Data:       uint32_t length, followed by length bytes
+    Integer:    int64_t value
+    Unsigned:   uint64_t value (only used for values that do not fit in int64_t)
+    Double:     the 8 bytes of the IEEE 754 double value, as a uint64_t
+    Boolean:    uint8_t value
+ */
+typedef NS_ENUM(uint8_t, INTUGroupedArraySerializationTag) {
+    INTUGroupedArraySerializationTagString      = 1,
+    INTUGroupedArraySerializationTagData        = 2,
+    INTUGroupedArraySerializationTagInteger     = 3,
+    INTUGroupedArraySerializationTagUnsigned    = 4,
+    INTUGroupedArraySerializationTagDouble      = 5,
+    INTUGroupedArraySerializationTagBoolean     = 6
+};
+
+#pragma mark Writing
+
+static inline void INTUGroupedArraySerializationWriteUInt64(uint8_t *bytes, uint64_t value)
+{
+    value = CFSwapInt64HostToLittle(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+static inline void INTUGroupedArraySerializationAppendUInt64(NSMutableData *data, uint64_t value)
+{
+    value = CFSwapInt64HostToLittle(value);
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static inline void INTUGroupedArraySerializationAppendUInt32(NSMutableData *data, uint32_t value)
+{
+    value = CFSwapInt32HostToLittle(value);
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static inline void INTUGroupedArraySerializationAppendTag(NSMutableData *data, INTUGroupedArraySerializationTag tag)
+{
+    [data appendBytes:&tag length:sizeof(tag)];
+}
+
+/**
+ Appends the encoded value to the data. Returns NO if the value is of an unsupported type (or is too large to encode).
+ */
+static BOOL INTUGroupedArraySerializationAppendValue(NSMutableData *data, id value)
+{
+    if ([value isKindOfClass:[NSString class]]) {
+        NSString *string = value;
+        NSUInteger length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        if (length > UINT32_MAX) {
+            return NO;
+        }
+        INTUGroupedArraySerializationAppendTag(data, INTUGroupedArraySerializationTagString);
+        INTUGroupedArraySerializationAppendUInt32(data, (uint32_t)length);
+        NSUInteger offset = [data length];
+        [data increaseLengthBy:length];
+        [string getBytes:(uint8_t *)[data mutableBytes] + offset maxLength:length usedLength:NULL encoding:NSUTF8StringEncoding
+                 options:0 range:NSMakeRange(0, [string length]) remainingRange:NULL];
+    } else if ([value isKindOfClass:[NSData class]]) {
+        NSData *dataValue = value;
+        if ([dataValue length] > UINT32_MAX) {
+            return NO;
+        }
+        INTUGroupedArraySerializationAppendTag(data, INTUGroupedArraySerializationTagData);
+        INTUGroupedArraySerializationAppendUInt32(data, (uint32_t)[dataValue length]);
+        [data appendData:dataValue];
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        NSNumber *number = value;
+        // Compare the type rather than the instance, as a boolean NSNumber is not guaranteed to be one of the kCFBoolean constants
+        if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+            INTUGroupedArraySerializationAppendTag(data, INTUGroupedArraySerializationTagBoolean);
+            uint8_t boolValue = [number boolValue] ? 1 : 0;
+            [data appendBytes:&boolValue length:sizeof(boolValue)];
+        } else if (CFNumberIsFloatType((__bridge CFNumberRef)number)) {
+            INTUGroupedArraySerializationAppendTag(data, INTUGroupedArraySerializationTagDouble);
+            double doubleValue = [number doubleValue];
+            uint64_t bits;
+            memcpy(&bits, &doubleValue, sizeof(bits));
+            INTUGroupedArraySerializationAppendUInt64(data, bits);
+        } else if (strcmp([number objCType], @encode(unsigned long long)) == 0 && [number unsignedLongLongValue] > INT64_MAX) {
+            INTUGroupedArraySerializationAppendTag(data, INTUGroupedArraySerializationTagUnsigned);
+            INTUGroupedArraySerializationAppendUInt64(data, [number unsignedLongLongValue]);
+        } else {
+            INTUGroupedArraySerializationAppendTag(data, INTUGroupedArraySerializationTagInteger);
+            INTUGroupedArraySerializationAppendUInt64(data, (uint64_t)[number longLongValue]);
+        }
+    } else {
+        return NO;
+    }
+    return YES;
+}
+
+#pragma mark Reading
+
+static inline BOOL INTUGroupedArraySerializationReadUInt64(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, uint64_t *value)
+{
+    if (*offset > length || length - *offset < sizeof(uint64_t)) {
+        return NO;
+    }
+    memcpy(value, bytes + *offset, sizeof(uint64_t));
+    *value = CFSwapInt64LittleToHost(*value);
+    *offset += sizeof(uint64_t);
+    return YES;
+}
+
+static inline BOOL INTUGroupedArraySerializationReadUInt32(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, uint32_t *value)
+{
+    if (*offset > length || length - *offset < sizeof(uint32_t)) {
+        return NO;
+    }
+    memcpy(value, bytes + *offset, sizeof(uint32_t));
+    *value = CFSwapInt32LittleToHost(*value);
+    *offset += sizeof(uint32_t);
+    return YES;
+}
+
+/**
+ Reads the encoded value at the offset, and advances the offset past it. Returns nil if the value is invalid or extends past the length.
+ */
+static id INTUGroupedArraySerializationReadValue(const uint8_t *bytes, NSUInteger length, NSUInteger *offset)
+{
+    if (*offset >= length) {
+        return nil;
+    }
+    INTUGroupedArraySerializationTag tag = bytes[*offset];
+    *offset += 1;
+    switch (tag) {
+        case INTUGroupedArraySerializationTagString:
+        case INTUGroupedArraySerializationTagData: {
+            uint32_t valueLength;
+            if (!INTUGroupedArraySerializationReadUInt32(bytes, length, offset, &valueLength) || length - *offset < valueLength) {
+                return nil;
+            }
+            const uint8_t *valueBytes = bytes + *offset;
+            *offset += valueLength;
+            if (tag == INTUGroupedArraySerializationTagString) {
+                return [[NSString alloc] initWithBytes:valueBytes length:valueLength encoding:NSUTF8StringEncoding];
+            }
+            return [NSData dataWithBytes:valueBytes length:valueLength];
+        }
+        case INTUGroupedArraySerializationTagInteger:
+        case INTUGroupedArraySerializationTagUnsigned:
+        case INTUGroupedArraySerializationTagDouble: {
+            uint64_t value;
+            if (!INTUGroupedArraySerializationReadUInt64(bytes, length, offset, &value)) {
+                return nil;
+            }
+            if (tag == INTUGroupedArraySerializationTagInteger) {
+                return @((int64_t)value);
+            } else if (tag == INTUGroupedArraySerializationTagUnsigned) {
+                return @(value);
+            }
+            double doubleValue;
+            memcpy(&doubleValue, &value, sizeof(doubleValue));
+            return @(doubleValue);
+        }
+        case INTUGroupedArraySerializationTagBoolean: {
+            if (*offset >= length) {
+                return nil;
+            }
+            BOOL boolValue = bytes[*offset] != 0;
+            *offset += 1;
+            return boolValue ? @YES : @NO;
+        }
+    }
+    return nil;
+}
+
+/**
+ Reads the number of encoded values from the range of bytes, which they must exactly fill. Returns nil if any value is invalid.
+ */
+static NSArray *INTUGroupedArraySerializationReadValues(const uint8_t *bytes, NSUInteger offset, NSUInteger end, NSUInteger count)
+{
+    // Each value is at least 2 bytes, so don't trust a count that could not possibly fit in the range
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:MIN(count, (end - offset) / 2)];
+    for (NSUInteger i = 0; i < count; i++) {
+        id value = INTUGroupedArraySerializationReadValue(bytes, end, &offset);
+        if (!value) {
+            return nil;
+        }
+        [values addObject:value];
+    }
+    return (offset == end) ? values : nil;
+}
+
+/**
+ Returns an error in the INTUGroupedArraySerializationErrorDomain with the code & description.
+ */
+static NSError *INTUGroupedArraySerializationError(INTUGroupedArraySerializationError code, NSString *description)
+{
+    return [NSError errorWithDomain:INTUGroupedArraySerializationErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey : description}];
+}
+
+#pragma mark - INTUSerializedGroupedArraySectionContainer
+
+/**
+ A section container whose objects are decoded from serialized data (such as a memory mapped file) the first time they are accessed.
+ The section is decoded up front. Decoding the objects is thread safe, since immutable grouped arrays may be accessed from multiple threads.
+ */
+@interface INTUSerializedGroupedArraySectionContainer : INTUGroupedArraySectionContainer
+{
+@private
+    /** The serialized data, which is released once the objects have been decoded. Only accessed while synchronized on self. */
+    NSData *_data;
+    /** The range of bytes in the data containing the encoded objects. */
+    NSRange _objectsRange;
+    /** The number of objects in the section. */
+    NSUInteger _objectCount;
+}
+
+// The decoded objects, or nil if they have not been decoded yet.
+@property (atomic, strong) NSArray *decodedObjects;
+
+@end
+
+@implementation INTUSerializedGroupedArraySectionContainer
+
+/**
+ Creates a section container for the section, whose objects will be decoded from the range of bytes in the data when first accessed.
+ */
+- (instancetype)initWithSection:(id)section objectCount:(NSUInteger)objectCount inRange:(NSRange)objectsRange ofData:(NSData *)data
+{
+    self = [super init];
+    if (self) {
+        self.section = section;
+        _data = data;
+        _objectsRange = objectsRange;
+        _objectCount = objectCount;
+    }
+    return self;
+}
+
+/**
+ Returns the objects, decoding them first if this is the first time they have been accessed.
+ An exception will be raised if the encoded objects are invalid.
+ Performance: O(1) once the objects have been decoded; otherwise O(m), where m is the number of objects in the section
+ */
+- (NSArray *)objects
+{
+    NSArray *objects = self.decodedObjects;
+    if (objects) {
+        return objects;
+    }
+    @synchronized(self) {
+        objects = self.decodedObjects;
+        if (!objects) {
+            objects = INTUGroupedArraySerializationReadValues([_data bytes], _objectsRange.location, NSMaxRange(_objectsRange), _objectCount);
+            if (!objects) {
+                [NSException raise:NSInternalInconsistencyException format:@"The serialized objects in section %@ are invalid.", self.section];
+            }
+            self.decodedObjects = objects;
+            _data = nil;
+        }
+    }
+    return objects;
+}
+
+- (void)setObjects:(NSArray *)objects
+{
+    self.decodedObjects = objects;
+}
+
+/**
+ Returns the number of objects, without decoding them.
+ */
+- (NSUInteger)countObjects
+{
+    NSArray *objects = self.decodedObjects;
+    return objects ? [objects count] : _objectCount;
+}
+
+/**
+ Archive as a regular section container, since the objects are always decoded before being archived.
+ */
+- (Class)classForCoder
+{
+    return [INTUGroupedArraySectionContainer class];
+}
+
+@end
+
+#pragma mark - INTUGroupedArraySerialization
+
+@implementation INTUGroupedArraySerialization
+
+/**
+ Returns whether the grouped array can be serialized: whether all its sections & objects are NSString, NSNumber, or NSData objects.
+ Performance: O(n), where n is the total number of sections & objects
+ 
+ @param groupedArray The grouped array to test.
+ @return Whether the grouped array can be serialized.
+ */
++ (BOOL)isValidGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    if (!groupedArray) {
+        return NO;
+    }
+    BOOL (^isValidValue)(id) = ^BOOL(id value) {
+        return [value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSData class]];
+    };
+    for (INTUGroupedArraySectionContainer *sectionContainer in groupedArray.sectionContainers) {
+        if (!isValidValue(sectionContainer.section)) {
+            return NO;
+        }
+        for (id object in sectionContainer.objects) {
+            if (!isValidValue(object)) {
+                return NO;
+            }
+        }
+    }
+    return YES;
+}
+
+/**
+ Serializes the grouped array into the binary format.
+ Performance: O(n), where n is the total number of sections & objects
+ 
+ @param groupedArray The grouped array to serialize.
+ @param error If the grouped array cannot be serialized, upon return contains an error that describes the problem.
+ @return The serialized grouped array, or nil if the grouped array contains a section or object that is not an NSString, NSNumber, or NSData.
+ */
++ (NSData *)dataWithGroupedArray:(INTUGroupedArray *)groupedArray error:(NSError * __autoreleasing *)error
+{
+    if (!groupedArray) {
+        NSAssert(groupedArray, @"Grouped array should not be nil.");
+        return nil;
+    }
+    
+    NSArray *sectionContainers = groupedArray.sectionContainers;
+    NSUInteger sectionCount = [sectionContainers count];
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    NSUInteger sectionTableSize = (sectionCount + 1) * kINTUGroupedArraySerializationSectionTableEntrySize;
+    // Reserve space for the header & section table, which are filled in after the payloads have been written
+    NSMutableData *data = [NSMutableData dataWithCapacity:kINTUGroupedArraySerializationHeaderSize + sectionTableSize + objectCount * 16];
+    [data setLength:kINTUGroupedArraySerializationHeaderSize + sectionTableSize];
+    uint64_t *sectionTable = malloc(sectionTableSize);
+    if (!sectionTable) {
+        [NSException raise:NSMallocException format:@"Failed to allocate the section table for %lu sections.", (unsigned long)sectionCount];
+    }
+    
+    NSUInteger objectOffset = 0;
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        INTUGroupedArraySectionContainer *sectionContainer = sectionContainers[sectionIndex];
+        sectionTable[sectionIndex * 2] = objectOffset;
+        sectionTable[sectionIndex * 2 + 1] = [data length];
+        BOOL success = INTUGroupedArraySerializationAppendValue(data, sectionContainer.section);
+        for (id object in sectionContainer.objects) {
+            success = success && INTUGroupedArraySerializationAppendValue(data, object);
+        }
+        if (!success) {
+            free(sectionTable);
+            if (error) {
+                NSString *description = [NSString stringWithFormat:@"Section %lu contains a section or object that is not an NSString, NSNumber, or NSData, or is too large.", (unsigned long)sectionIndex];
+                *error = INTUGroupedArraySerializationError(INTUGroupedArraySerializationErrorUnsupportedType, description);
+            }
+            return nil;
+        }
+        objectOffset += [sectionContainer countObjects];
+    }
+    sectionTable[sectionCount * 2] = objectOffset;
+    sectionTable[sectionCount * 2 + 1] = [data length];
+    
+    uint8_t *bytes = [data mutableBytes];
+    uint32_t magic = CFSwapInt32HostToLittle(kINTUGroupedArraySerializationMagic);
+    uint32_t version = CFSwapInt32HostToLittle(kINTUGroupedArraySerializationVersion);
+    memcpy(bytes, &magic, sizeof(magic));
+    memcpy(bytes + 4, &version, sizeof(version));
+    INTUGroupedArraySerializationWriteUInt64(bytes + 8, groupedArray.options);
+    INTUGroupedArraySerializationWriteUInt64(bytes + 16, sectionCount);
+    INTUGroupedArraySerializationWriteUInt64(bytes + 24, objectOffset);
+    INTUGroupedArraySerializationWriteUInt64(bytes + 32, [data length]);
+    for (NSUInteger i = 0; i < (sectionCount + 1) * 2; i++) {
+        INTUGroupedArraySerializationWriteUInt64(bytes + kINTUGroupedArraySerializationHeaderSize + i * sizeof(uint64_t), sectionTable[i]);
+    }
+    free(sectionTable);
+    return data;
+}
+
+/**
+ Deserializes a grouped array from the binary format.
+ Performance: O(n), where n is the total number of sections & objects
+ 
+ @param data The data containing the serialized grouped array.
+ @param error If the data is invalid, upon return contains an error that describes the problem.
+ @return A new immutable grouped array, or nil if the data is invalid.
+ */
++ (INTUGroupedArray *)groupedArrayWithData:(NSData *)data error:(NSError * __autoreleasing *)error
+{
+    if (!data) {
+        NSAssert(data, @"Data should not be nil.");
+        return nil;
+    }
+    return [self _groupedArrayWithData:data lazily:NO error:error];
+}
+
+/**
+ Deserializes a grouped array from the binary format, decoding only the sections up front. The objects in each section are decoded
+ the first time they are accessed, and an exception will be raised at that point if they are invalid. The grouped array keeps a
+ reference to the data until all objects have been decoded.
+ Performance: O(n), where n is the number of sections
+ 
+ @param data The data containing the serialized grouped array. Must not be modified.
+ @param error If the sections in the data are invalid, upon return contains an error that describes the problem.
+ @return A new immutable grouped array, or nil if the sections in the data are invalid.
+ */
++ (INTUGroupedArray *)lazyGroupedArrayWithData:(NSData *)data error:(NSError * __autoreleasing *)error
+{
+    if (!data) {
+        NSAssert(data, @"Data should not be nil.");
+        return nil;
+    }
+    return [self _groupedArrayWithData:data lazily:YES error:error];
+}
+
+/**
+ Memory maps the file, and deserializes a grouped array from it lazily (see +[lazyGroupedArrayWithData:error:]), so that only the
+ pages of the file containing the sections & the objects that are accessed are read into memory.
+ Performance: O(n), where n is the number of sections
+ 
+ @param path The path of a file containing a serialized grouped array. Must not be modified or truncated while the grouped array is in use.
+ @param error If the file cannot be read or the sections in it are invalid, upon return contains an error that describes the problem.
+ @return A new immutable grouped array, or nil if the file cannot be read or the sections in it are invalid.
+ */
++ (INTUGroupedArray *)groupedArrayWithContentsOfFile:(NSString *)path error:(NSError * __autoreleasing *)error
+{
+    if (!path) {
+        NSAssert(path, @"Path should not be nil.");
+        return nil;
+    }
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:error];
+    if (!data) {
+        return nil;
+    }
+    return [self _groupedArrayWithData:data lazily:YES error:error];
+}
+
+/**
+ Deserializes a grouped array from the binary format, optionally deferring decoding the objects in each section until they are first accessed.
+ */
++ (INTUGroupedArray *)_groupedArrayWithData:(NSData *)data lazily:(BOOL)lazily error:(NSError * __autoreleasing *)error
+{
+    const uint8_t *bytes = [data bytes];
+    NSUInteger length = [data length];
+    uint32_t magic = 0, version = 0;
+    uint64_t options = 0, sectionCount = 0, objectCount = 0, dataLength = 0;
+    NSUInteger offset = 0;
+    BOOL valid = INTUGroupedArraySerializationReadUInt32(bytes, length, &offset, &magic)
+              && INTUGroupedArraySerializationReadUInt32(bytes, length, &offset, &version)
+              && INTUGroupedArraySerializationReadUInt64(bytes, length, &offset, &options)
+              && INTUGroupedArraySerializationReadUInt64(bytes, length, &offset, &sectionCount)
+              && INTUGroupedArraySerializationReadUInt64(bytes, length, &offset, &objectCount)
+              && INTUGroupedArraySerializationReadUInt64(bytes, length, &offset, &dataLength)
+              && magic == kINTUGroupedArraySerializationMagic
+              && version == kINTUGroupedArraySerializationVersion
+              && dataLength == length
+              && sectionCount < (length - kINTUGroupedArraySerializationHeaderSize) / kINTUGroupedArraySerializationSectionTableEntrySize;
+    
+    NSMutableArray *sectionContainers = valid ? [NSMutableArray arrayWithCapacity:(NSUInteger)sectionCount] : nil;
+    NSMutableSet *sections = valid ? [NSMutableSet setWithCapacity:(NSUInteger)sectionCount] : nil;
+    NSUInteger sectionTableOffset = kINTUGroupedArraySerializationHeaderSize;
+    uint64_t objectOffset = 0, byteOffset = 0, nextObjectOffset = 0, nextByteOffset = 0;
+    valid = valid && INTUGroupedArraySerializationReadUInt64(bytes, length, &sectionTableOffset, &objectOffset)
+                  && INTUGroupedArraySerializationReadUInt64(bytes, length, &sectionTableOffset, &byteOffset)
+                  && objectOffset == 0
+                  && byteOffset == kINTUGroupedArraySerializationHeaderSize + (sectionCount + 1) * kINTUGroupedArraySerializationSectionTableEntrySize;
+    for (uint64_t sectionIndex = 0; valid && sectionIndex < sectionCount; sectionIndex++) {
+        valid = INTUGroupedArraySerializationReadUInt64(bytes, length, &sectionTableOffset, &nextObjectOffset)
+             && INTUGroupedArraySerializationReadUInt64(bytes, length, &sectionTableOffset, &nextByteOffset)
+             && nextObjectOffset > objectOffset && nextByteOffset <= length && byteOffset < nextByteOffset;
+        if (!valid) {
+            break;
+        }
+        // Decode the section & its objects, which must exactly fill the section's payload
+        NSUInteger payloadOffset = (NSUInteger)byteOffset;
+        NSUInteger payloadEnd = (NSUInteger)nextByteOffset;
+        NSUInteger sectionObjectCount = (NSUInteger)(nextObjectOffset - objectOffset);
+        id section = INTUGroupedArraySerializationReadValue(bytes, payloadEnd, &payloadOffset);
+        valid = section && payloadOffset < payloadEnd && ![sections containsObject:section];
+        if (valid && lazily) {
+            // Defer decoding the objects until they are accessed, at which point they will be validated
+            NSRange objectsRange = NSMakeRange(payloadOffset, payloadEnd - payloadOffset);
+            [sectionContainers addObject:[[INTUSerializedGroupedArraySectionContainer alloc] initWithSection:section objectCount:sectionObjectCount inRange:objectsRange ofData:data]];
+        } else if (valid) {
+            NSArray *objects = INTUGroupedArraySerializationReadValues(bytes, payloadOffset, payloadEnd, sectionObjectCount);
+            valid = (objects != nil);
+            if (valid) {
+                INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer sectionContainerWithSection:section];
+                sectionContainer.objects = objects;
+                [sectionContainers addObject:sectionContainer];
+            }
+        }
+        if (valid) {
+            [sections addObject:section];
+        }
+        objectOffset = nextObjectOffset;
+        byteOffset = nextByteOffset;
+    }
+    valid = valid && objectOffset == objectCount && byteOffset == length;
+    
+    if (!valid) {
+        if (error) {
+            *error = INTUGroupedArraySerializationError(INTUGroupedArraySerializationErrorInvalidData, @"The data is not a valid serialized grouped array.");
+        }
+        return nil;
+    }
+    INTUGroupedArray *groupedArray = [[INTUGroupedArray alloc] initWithOptions:(INTUGroupedArrayOptions)options];
+    if (lazily) {
+        // Building the object index now would decode every section
+        [groupedArray _setSectionContainersDeferringObjectIndex:sectionContainers];
+    } else {
+        groupedArray.sectionContainers = sectionContainers;
+    }
+    return groupedArray;
+}
+
+@end
@@ -28,6 +28,20 @@
 
 GA__INTU_ASSUME_NONNULL_BEGIN
 
+/**
+ The functions that an aggregate registered on a mutable grouped array can use to combine the values of the objects in each section.
+ */
+typedef NS_ENUM(NSInteger, INTUGroupedArrayAggregateFunction) {
+    /** The number of objects whose value is not nil, as an NSNumber. */
+    INTUGroupedArrayAggregateFunctionCount,
+    /** The sum of the -doubleValue of each value, as an NSNumber. */
+    INTUGroupedArrayAggregateFunctionSum,
+    /** The smallest value according to -compare:, or nil if there are no values. */
+    INTUGroupedArrayAggregateFunctionMinimum,
+    /** The largest value according to -compare:, or nil if there are no values. */
+    INTUGroupedArrayAggregateFunctionMaximum
+};
+
 
 /**
  A mutable subclass of INTUGroupedArray.
@@ -98,11 +112,52 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 
 /** Evaluates the section & object predicates against all sections & objects and removes those that do not match. Empty sections will be removed. */
 - (void)filterUsingSectionPredicate:(GA__INTU_NULLABLE NSPredicate *)sectionPredicate objectPredicate:(GA__INTU_NULLABLE NSPredicate *)objectPredicate;
+/** Evaluates the section & object predicates with the specified enumeration options. When NSEnumerationConcurrent is set, sections are filtered in parallel (the predicates must be safe to evaluate concurrently). */
+- (void)filterWithOptions:(NSEnumerationOptions)options usingSectionPredicate:(GA__INTU_NULLABLE NSPredicate *)sectionPredicate objectPredicate:(GA__INTU_NULLABLE NSPredicate *)objectPredicate;
 
 #pragma mark Sorting
 
 /** Sorts the sections using the section comparator, and the objects in each section using the object comparator. */
 - (void)sortUsingSectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr objectComparator:(GA__INTU_NULLABLE NSComparator)objectCmptr;
+/** Sorts the sections & objects with the specified sort options. When NSSortConcurrent is set, the objects in different sections are sorted in parallel (the object comparator must be safe to call concurrently). */
+- (void)sortWithOptions:(NSSortOptions)options usingSectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr objectComparator:(GA__INTU_NULLABLE NSComparator)objectCmptr;
+
+#pragma mark Sorted Mode
+
+/** The comparator that the sections are kept sorted by, or nil if the order of the sections is not maintained. */
+@property (nonatomic, readonly, copy, GA__INTU_NULLABLE) NSComparator sectionComparator;
+/** The comparator that the objects in each section are kept sorted by, or nil if the order of the objects is not maintained. */
+@property (nonatomic, readonly, copy, GA__INTU_NULLABLE) NSComparator objectComparator;
+/** Sorts the sections and/or objects once, and from then on keeps them sorted: new sections & objects are inserted at their sorted positions,
+    and sections & objects are located by binary search in O(log n) time. Pass nil for a comparator to stop maintaining that order. */
+- (void)maintainSortOrderUsingSectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr objectComparator:(GA__INTU_NULLABLE NSComparator)objectCmptr;
+
+#pragma mark Aggregates
+
+/** Registers an aggregate of the value at the key path of each object (or each object itself, if the key path is nil), which is computed for
+    every section once and from then on kept up to date as objects are added, replaced, moved & removed, so that reading it is O(1).
+    Replaces any aggregate already registered with the name. Registered aggregates are kept by mutable copies, but not by immutable copies.
+    The value at the key path of an object is read again when the object is removed, so it must not change while the object is in the
+    grouped array, unless -[recomputeAggregates] is called after it changes. */
+- (void)registerAggregateWithName:(NSString *)name function:(INTUGroupedArrayAggregateFunction)function keyPath:(GA__INTU_NULLABLE NSString *)keyPath;
+/** Stops maintaining the aggregate registered with the name. */
+- (void)unregisterAggregateWithName:(NSString *)name;
+/** Computes the registered aggregates again from the current values of all objects, which is needed after the value at the key path of
+    an aggregate changes for any object in the grouped array. */
+- (void)recomputeAggregates;
+/** The names of the registered aggregates. */
+@property (nonatomic, readonly) GA__INTU_GENERICS(NSArray, NSString *) *registeredAggregateNames;
+/** Returns the value of the aggregate registered with the name for the section at the index. */
+- (GA__INTU_NULLABLE id)aggregateWithName:(NSString *)name inSectionAtIndex:(NSUInteger)index;
+/** Returns the value of the aggregate registered with the name for the section (the same as for an empty section, if it does not exist). */
+- (GA__INTU_NULLABLE id)aggregateWithName:(NSString *)name inSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+#pragma mark Batch Updates
+
+/** Performs the mutations in the block as a single batch of updates. Sections are located in O(1) time during the batch, sections left empty are removed when the batch ends, and the grouped array counts as mutated only once.
+    If the objects are kept sorted, objects added during the batch are appended to their section, and each section is sorted once when the batch ends.
+    Copies made during the batch have the contents that the batch would leave if it ended then. */
+- (void)performBatchUpdates:(void (^)(void))updates;
 
 @end
 
@@ -27,8 +27,93 @@
 #import "INTUMutableGroupedArray.h"
 #import "INTUGroupedArraySectionContainer.h"
 #import "INTUGroupedArrayInternal.h"
+#import "INTUGroupedArrayInstrumentationInternal.h"
+#import "INTUGroupedArrayAggregate.h"
+#import "INTUGroupedArrayChunkedArray.h"
+
+/** The number of objects past which a section switches to chunked storage, even if the INTUGroupedArrayOptionChunkedSectionStorage option
+    is not set. Below this size, shifting the objects in a contiguous array is faster than locating them in chunks. */
+static const NSUInteger INTUMutableGroupedArrayChunkedStorageThreshold = 16384;
+
+/** The maximum number of section containers of removed sections that each mutable grouped array keeps for reuse by sections added later. */
+static const NSUInteger INTUMutableGroupedArrayMaxReusableSectionContainers = 32;
+
+/** The number of objects past which the section container of a removed section is not kept for reuse, so that the grouped array does not
+    hold on to the storage of a large section that it may never need again. */
+static const NSUInteger INTUMutableGroupedArrayMaxReusableSectionContainerObjects = 1024;
+
+/** The most recently assigned section container owner ID. Owner IDs are never reused, and 0 is reserved to mean "not owned". */
+static volatile NSUInteger INTUMutableGroupedArrayLastOwnerID = 0;
+
+/**
+ Returns a new section container owner ID that has never been returned before. Thread safe.
+ */
+static NSUInteger INTUMutableGroupedArrayNextOwnerID(void)
+{
+    return __sync_add_and_fetch(&INTUMutableGroupedArrayLastOwnerID, 1);
+}
+
+/**
+ Returns the index of the section in the section containers, which must be sorted by their sections using the comparator, or NSNotFound if
+ the section does not exist. If insertionIndex is not NULL, it is set to the index at which the section should be inserted to keep the
+ sections sorted (after any sections that compare equal to it).
+ Performance: O(log n), where n is the number of sections
+ */
+static NSUInteger INTUIndexOfSectionInSortedSectionContainers(NSArray *sectionContainers, id section, NSComparator sectionCmptr, NSUInteger *insertionIndex)
+{
+    INTU_INSTRUMENT_COUNT(SectionLookups, 1);
+    sectionCmptr = INTU_INSTRUMENT_COMPARATOR(sectionCmptr);
+    // Find the first section that is not ordered before the section
+    NSUInteger sectionCount = [sectionContainers count];
+    NSUInteger low = 0;
+    NSUInteger high = sectionCount;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (sectionCmptr(((INTUGroupedArraySectionContainer *)sectionContainers[mid]).section, section) == NSOrderedAscending) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    // The comparator may consider sections that are not equal to be the same, so check all of them
+    NSUInteger sectionIndex = NSNotFound;
+    for (; low < sectionCount; low++) {
+        id sectionAtIndex = ((INTUGroupedArraySectionContainer *)sectionContainers[low]).section;
+        if (sectionCmptr(sectionAtIndex, section) != NSOrderedSame) {
+            break;
+        }
+        if (sectionIndex == NSNotFound && [sectionAtIndex isEqual:section]) {
+            sectionIndex = low;
+        }
+    }
+    if (insertionIndex) {
+        *insertionIndex = low;
+    }
+    return sectionIndex;
+}
 
 @interface GA__INTU_GENERICS(INTUMutableGroupedArray, SectionType, ObjectType) ()
+{
+@private
+    /** The ID of this grouped array as an owner of section containers. Only section containers with this owner ID may be modified in place;
+        all others may be shared with other grouped arrays, and are copied before being modified (copy-on-write). This changes every time
+        the section containers are shared with another grouped array, which gives up ownership of all current section containers at once. */
+    NSUInteger _ownerID;
+    /** The number of calls to -[performBatchUpdates:] that are currently in progress (they may be nested). */
+    NSUInteger _batchUpdateDepth;
+    /** Whether the grouped array has been mutated during the current batch of updates. */
+    BOOL _batchUpdatesDidMutate;
+    /** Whether any sections were left empty during the current batch of updates, and need to be removed when it ends. */
+    BOOL _batchUpdatesLeftEmptySections;
+    /** Whether objects were appended to sections whose objects are kept sorted during the current batch of updates (instead of being inserted
+        at their sorted positions), so those sections need to be sorted when it ends. */
+    BOOL _batchUpdatesLeftUnsortedObjects;
+    /** A dictionary from the name of each registered aggregate to its INTUGroupedArrayAggregate, or nil if none have been registered. */
+    NSMutableDictionary *_aggregates;
+    /** The empty section containers of removed sections, which are reused by sections added later instead of allocating new ones,
+        or nil if no sections have been removed. They are not owned by any grouped array (ownerID 0), and are never shared. */
+    NSMutableArray *_reusableSectionContainers;
+}
 
 // A mutable array of INTUMutableGroupedArraySectionContainer objects, which serves as the backing store for the grouped array.
 // Note that this property does not have its own backing instance variable; it uses the superclass sectionContainers property for storage.
@@ -47,15 +132,30 @@
     if ([array count] > 0) {
         INTUMutableGroupedArraySectionContainer *sectionContainer = [INTUMutableGroupedArraySectionContainer sectionContainerWithSection:[NSObject new]];
         sectionContainer.mutableObjects = [array mutableCopy];
+        sectionContainer.ownerID = groupedArray->_ownerID;
+        [groupedArray _useChunkedStorageIfNeededForSectionContainer:sectionContainer];
         groupedArray.mutableSectionContainers = [NSMutableArray arrayWithObject:sectionContainer];
     }
     return groupedArray;
 }
 
-- (instancetype)init
++ (instancetype)groupedArrayByGroupingArray:(NSArray *)array withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(NSComparator)sectionCmptr
 {
-    self = [super init];
+    INTUMutableGroupedArray *groupedArray = [self new];
+    NSMutableArray *sectionContainers = [self _sectionContainersOfClass:[INTUMutableGroupedArraySectionContainer class] byGroupingArray:array withOptions:options sectionKeyBlock:sectionKeyBlock sectionComparator:sectionCmptr];
+    for (INTUMutableGroupedArraySectionContainer *sectionContainer in sectionContainers) {
+        sectionContainer.ownerID = groupedArray->_ownerID;
+        [groupedArray _useChunkedStorageIfNeededForSectionContainer:sectionContainer];
+    }
+    groupedArray.mutableSectionContainers = sectionContainers;
+    return groupedArray;
+}
+
+- (instancetype)initWithOptions:(INTUGroupedArrayOptions)options
+{
+    self = [super initWithOptions:options];
     if (self) {
+        _ownerID = INTUMutableGroupedArrayNextOwnerID();
         self.mutableSectionContainers = [NSMutableArray new];
     }
     return self;
@@ -63,22 +163,180 @@
 
 - (id)copyWithZone:(NSZone *)zone
 {
-    INTUGroupedArray *copy = [[INTUGroupedArray allocWithZone:zone] init];
-    // The array of sectionContainers is deep copied so that the INTUGroupedArraySectionContainer objects it holds are also copied,
-    // but since this is only a one level deep copy, the sections & objects in the grouped array will NOT be deep copied!
-    copy.sectionContainers = [[NSMutableArray allocWithZone:zone] initWithArray:self.sectionContainers copyItems:YES];
+    INTU_INSTRUMENT_TIMING();
+    if (_batchUpdateDepth > 0) {
+        // Settle the batch of updates in progress in a mutable copy first (see -[mutableCopyWithZone:])
+        return [[self mutableCopyWithZone:zone] copyWithZone:zone];
+    }
+    INTUGroupedArray *copy = [[INTUGroupedArray allocWithZone:zone] initWithOptions:self.options];
+    // The INTUGroupedArraySectionContainer objects are shared with the copy, and this grouped array gives up ownership of them so that
+    // it will copy each one before modifying it again (copy-on-write). This makes the copy O(n), where n is the number of sections.
+    // Since this is only a one level deep copy, the sections & objects in the grouped array will NOT be deep copied!
+    copy.sectionContainers = [[NSArray allocWithZone:zone] initWithArray:self.sectionContainers];
+    [self _relinquishSectionContainerOwnership];
     return copy;
 }
 
 - (id)mutableCopyWithZone:(NSZone *)zone
 {
-    __typeof(self) copy = [[[self class] allocWithZone:zone] init];
-    for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-        [copy.mutableSectionContainers addObject:[sectionContainer mutableCopy]];
+    INTU_INSTRUMENT_TIMING();
+    __typeof(self) copy = [[[self class] allocWithZone:zone] initWithOptions:self.options];
+    // Both grouped arrays will copy each shared section container before modifying it (copy-on-write)
+    copy.mutableSectionContainers = [[NSMutableArray allocWithZone:zone] initWithArray:self.sectionContainers];
+    // The mutable copy is sorted the same way, so it keeps maintaining the same order
+    copy->_sectionComparator = _sectionComparator;
+    copy->_objectComparator = _objectComparator;
+    // The mutable copy keeps maintaining the same aggregates, which start out the same since it has the same sections & objects
+    if (_aggregates) {
+        copy->_aggregates = [[NSMutableDictionary alloc] initWithDictionary:_aggregates copyItems:YES];
+    }
+    // A copy made during a batch of updates has the contents that the batch would leave if it ended now, while the batch carries on here
+    if (_batchUpdatesLeftUnsortedObjects) {
+        [copy _sortUnsortedObjects];
+    }
+    if (_batchUpdatesLeftEmptySections) {
+        [copy _removeEmptySections];
     }
+    [self _relinquishSectionContainerOwnership];
     return copy;
 }
 
+/**
+ Gives up ownership of all current section containers at once by taking a new owner ID, so that each one will be copied before it is
+ modified again (copy-on-write).
+ */
+- (void)_relinquishSectionContainerOwnership
+{
+    _ownerID = INTUMutableGroupedArrayNextOwnerID();
+}
+
+/**
+ Gives up ownership of only the section containers in the range, by marking them as not owned by any grouped array, so that each one will
+ be copied before it is modified again (copy-on-write) while the other section containers can still be modified in place.
+ Performance: O(k), where k is the number of section containers in the range
+ */
+- (void)_relinquishOwnershipOfSectionContainersInRange:(NSRange)range
+{
+    NSArray *sectionContainers = self.sectionContainers;
+    for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+        INTUGroupedArraySectionContainer *sectionContainer = sectionContainers[index];
+        if (sectionContainer.ownerID == _ownerID) {
+            sectionContainer.ownerID = 0;
+        }
+    }
+}
+
+/**
+ Discards and rebuilds the object index, and recomputes the registered aggregates, from scratch. If there is an object index, rebuilding it
+ adds every object to the registered aggregates (through -[_addObjects:toObjectIndexInSection:]), so they are only recomputed separately
+ when there isn't one.
+ Performance: O(k*n), where k is the number of registered aggregates, and n is the total number of objects across all sections
+ */
+- (void)_rebuildObjectIndex
+{
+    if ((self.options & INTUGroupedArrayOptionHashedObjectIndex) == 0) {
+        [super _rebuildObjectIndex];
+        [self _recomputeAggregates:[_aggregates allValues]];
+        return;
+    }
+    for (INTUGroupedArrayAggregate *aggregate in [_aggregates objectEnumerator]) {
+        [aggregate removeAllSections];
+    }
+    [super _rebuildObjectIndex];
+}
+
+/**
+ Records one more instance of the object in the section in the object index, and includes it in the registered aggregates of the section.
+ Performance: O(k), where k is the number of registered aggregates
+ */
+- (void)_addObject:(id)object toObjectIndexInSection:(id)section
+{
+    [super _addObject:object toObjectIndexInSection:section];
+    for (INTUGroupedArrayAggregate *aggregate in [_aggregates objectEnumerator]) {
+        [aggregate addObject:object toSection:section];
+    }
+}
+
+/**
+ Records one less instance of the object in the section in the object index, and removes it from the registered aggregates of the section.
+ Performance: O(k), where k is the number of registered aggregates
+ */
+- (void)_removeObject:(id)object fromObjectIndexInSection:(id)section
+{
+    [super _removeObject:object fromObjectIndexInSection:section];
+    for (INTUGroupedArrayAggregate *aggregate in [_aggregates objectEnumerator]) {
+        [aggregate removeObject:object fromSection:section];
+    }
+}
+
+/**
+ Records every object in the array as added to the section in the object index and the registered aggregates.
+ Performance: O(k*m), where k is the number of registered aggregates, and m is the number of objects in the array
+ */
+- (void)_addObjects:(NSArray *)objects toObjectIndexInSection:(id)section
+{
+    [super _addObjects:objects toObjectIndexInSection:section];
+    for (INTUGroupedArrayAggregate *aggregate in [_aggregates objectEnumerator]) {
+        for (id object in objects) {
+            [aggregate addObject:object toSection:section];
+        }
+    }
+}
+
+/**
+ Records every object in the array as removed from the section in the object index and the registered aggregates.
+ Performance: O(k*m), where k is the number of registered aggregates, and m is the number of objects in the array
+ */
+- (void)_removeObjects:(NSArray *)objects fromObjectIndexInSection:(id)section
+{
+    [super _removeObjects:objects fromObjectIndexInSection:section];
+    for (INTUGroupedArrayAggregate *aggregate in [_aggregates objectEnumerator]) {
+        for (id object in objects) {
+            [aggregate removeObject:object fromSection:section];
+        }
+    }
+}
+
+/**
+ Returns the index for the section, using a binary search if the sections are kept sorted.
+ Performance: O(log n) if the sections are kept sorted; otherwise see -[INTUGroupedArray indexOfSection:]
+ */
+- (NSUInteger)indexOfSection:(id)section
+{
+    if (_sectionComparator && section) {
+        return INTUIndexOfSectionInSortedSectionContainers(self.sectionContainers, section, _sectionComparator, NULL);
+    }
+    return [super indexOfSection:section];
+}
+
+/**
+ Returns the index of the first instance of the object in the section, using a binary search if the objects are kept sorted (unless objects
+ have been added during the current batch of updates, which are only sorted when it ends).
+ Performance: O(log m) plus the time to locate the section if the objects are kept sorted, where m is the number of objects in the section;
+              otherwise see -[INTUGroupedArray indexOfObject:inSection:]
+ */
+- (NSUInteger)indexOfObject:(id)object inSection:(id)section
+{
+    if (!_objectComparator || _batchUpdatesLeftUnsortedObjects || !object || !section) {
+        return [super indexOfObject:object inSection:section];
+    }
+    NSUInteger sectionIndex = [self indexOfSection:section];
+    if (sectionIndex == NSNotFound) {
+        return NSNotFound;
+    }
+    NSComparator objectCmptr = INTU_INSTRUMENT_COMPARATOR(_objectComparator);
+    NSArray *objectsArray = ((INTUGroupedArraySectionContainer *)self.sectionContainers[sectionIndex]).objects;
+    NSUInteger objectCount = [objectsArray count];
+    NSUInteger objectIndex = [objectsArray indexOfObject:object inSortedRange:NSMakeRange(0, objectCount) options:NSBinarySearchingFirstEqual | NSBinarySearchingInsertionIndex usingComparator:objectCmptr];
+    // The comparator may consider objects that are not equal to be the same, so check all of them
+    for (; objectIndex < objectCount && objectCmptr(objectsArray[objectIndex], object) == NSOrderedSame; objectIndex++) {
+        if ([objectsArray[objectIndex] isEqual:object]) {
+            return objectIndex;
+        }
+    }
+    return NSNotFound;
+}
+
 - (NSMutableArray *)mutableSectionContainers
 {
     return (NSMutableArray *)[super sectionContainers];
@@ -94,7 +352,7 @@
 
 /**
  Adds an object to the section. If the section does not exist, it will be created.
- Performance: O(n), where n is the number of sections
+ Performance: O(1) if the INTUGroupedArrayOptionHashedSectionIndex option is set; otherwise O(n), where n is the number of sections
  
  @param object The object to add to the grouped array.
  @param section The section to add the object to.
@@ -116,6 +374,7 @@
  */
 - (void)addObject:(id)object toSection:(id)section withSectionIndexHint:(NSUInteger)sectionIndexHint
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object || !section) {
         NSAssert(object, @"Object should not be nil.");
         NSAssert(section, @"Section should not be nil.");
@@ -125,13 +384,12 @@
     NSMutableArray *objectsArray = [self _objectsArrayForSection:section withSectionIndexHint:sectionIndexHint];
     if (objectsArray == nil) {
         // Section does not exist yet, we need to create it
-        INTUMutableGroupedArraySectionContainer *sectionContainer = [INTUMutableGroupedArraySectionContainer sectionContainerWithSection:section];
-        [self.mutableSectionContainers addObject:sectionContainer];
-        objectsArray = sectionContainer.mutableObjects;
+        objectsArray = [self _addSectionContainerForSection:section].mutableObjects;
     }
     
-    [objectsArray addObject:object];
-    _mutations++;
+    [objectsArray insertObject:object atIndex:[self _insertionIndexForObject:object inObjectsArray:objectsArray]];
+    [self _addObject:object toObjectIndexInSection:section];
+    [self _didMutate];
 }
 
 /**
@@ -149,10 +407,11 @@
         return;
     }
     
-    INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[index];
+    INTUMutableGroupedArraySectionContainer *sectionContainer = [self _mutableSectionContainerAtIndex:index];
     NSMutableArray *objectsArray = sectionContainer.mutableObjects;
-    [objectsArray addObject:object];
-    _mutations++;
+    [objectsArray insertObject:object atIndex:[self _insertionIndexForObject:object inObjectsArray:objectsArray]];
+    [self _addObject:object toObjectIndexInSection:sectionContainer.section];
+    [self _didMutate];
 }
 
 /**
@@ -175,6 +434,7 @@
 
 /**
  Inserts the object at the index in the section. If the section does not exist, it will be created.
+ If the objects are kept sorted, the object is inserted at its sorted position instead, and the index is ignored.
  Performance: O(n+m), where n is the number of sections, and m is the number of objects in the section
  
  @param object The object to add to the grouped array.
@@ -184,6 +444,7 @@
  */
 - (void)insertObject:(id)object atIndex:(NSUInteger)index inSection:(id)section
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object || !section) {
         NSAssert(object, @"Object should not be nil.");
         NSAssert(section, @"Section should not be nil.");
@@ -193,22 +454,26 @@
     NSMutableArray *objectsArray = [self _objectsArrayForSection:section withSectionIndexHint:NSNotFound];
     if (objectsArray == nil) {
         // Section does not exist yet, we need to create it
-        INTUMutableGroupedArraySectionContainer *sectionContainer = [INTUMutableGroupedArraySectionContainer sectionContainerWithSection:section];
-        [self.mutableSectionContainers addObject:sectionContainer];
-        objectsArray = sectionContainer.mutableObjects;
+        objectsArray = [self _addSectionContainerForSection:section].mutableObjects;
     }
     
+    if (_objectComparator) {
+        // The objects are kept sorted, so the object must be inserted at its sorted position
+        index = [self _insertionIndexForObject:object inObjectsArray:objectsArray];
+    }
     if (index > [objectsArray count]) {
         NSAssert(index <= [objectsArray count], @"Index out of bounds!");
         return;
     }
     
     [objectsArray insertObject:object atIndex:index];
-    _mutations++;
+    [self _addObject:object toObjectIndexInSection:section];
+    [self _didMutate];
 }
 
 /**
  Inserts the object at the index path. The index path must correspond to an existing section.
+ If the objects are kept sorted, the object is inserted at its sorted position in the section instead, and the row is ignored.
  Performance: O(n), where n is the number of objects in the section
  
  @param object The object to add to the grouped array.
@@ -217,6 +482,7 @@
  */
 - (void)insertObject:(id)object atIndexPath:(NSIndexPath *)indexPath
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object || !indexPath) {
         NSAssert(object, @"Object should not be nil.");
         NSAssert(indexPath, @"Index path should not be nil.");
@@ -231,23 +497,28 @@
         return;
     }
     
-    INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[sectionIndex];
+    INTUMutableGroupedArraySectionContainer *sectionContainer = [self _mutableSectionContainerAtIndex:sectionIndex];
     NSMutableArray *objectsArray = sectionContainer.mutableObjects;
     
+    if (_objectComparator) {
+        // The objects are kept sorted, so the object must be inserted at its sorted position
+        objectIndex = [self _insertionIndexForObject:object inObjectsArray:objectsArray];
+    }
     if (objectIndex > [objectsArray count]) {
         NSAssert(objectIndex <= [objectsArray count], @"Object index out of bounds!");
         return;
     }
     
     [objectsArray insertObject:object atIndex:objectIndex];
-    _mutations++;
+    [self _addObject:object toObjectIndexInSection:sectionContainer.section];
+    [self _didMutate];
 }
 
 #pragma mark Replacing
 
 /**
- Replaces the section at the index with another section.
- Performance: O(1)
+ Replaces the section at the index with another section. If the sections are kept sorted, the section is moved to its sorted position.
+ Performance: O(1) if the sections are not kept sorted; otherwise O(n), where n is the number of sections
  
  @param index The index of the section to replace.
  @param section The section with which to replace the existing section at the given index.
@@ -265,20 +536,34 @@
         return;
     }
     
-    INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[index];
+    INTUGroupedArraySectionContainer *sectionContainer = [self _mutableSectionContainerAtIndex:index];
+    [self _removeSectionFromSectionIndex:sectionContainer.section];
+    [self _removeObjects:sectionContainer.objects fromObjectIndexInSection:sectionContainer.section];
     sectionContainer.section = section;
-    _mutations++;
+    [self _addObjects:sectionContainer.objects toObjectIndexInSection:section];
+    if (_sectionComparator) {
+        // The sections are kept sorted, so move the section to its sorted position
+        [self.mutableSectionContainers removeObjectAtIndex:index];
+        NSUInteger newIndex = 0;
+        INTUIndexOfSectionInSortedSectionContainers(self.sectionContainers, section, _sectionComparator, &newIndex);
+        [self.mutableSectionContainers insertObject:sectionContainer atIndex:newIndex];
+        [self _updateSectionIndexInRange:NSMakeRange(MIN(index, newIndex), MAX(index, newIndex) - MIN(index, newIndex) + 1)];
+    } else {
+        [self _updateSectionIndexInRange:NSMakeRange(index, 1)];
+    }
+    [self _didMutate];
 }
 
 /**
- Replaces the object at the index path with another object.
- Performance: O(1)
+ Replaces the object at the index path with another object. If the objects are kept sorted, the object is moved to its sorted position.
+ Performance: O(1) if the objects are not kept sorted; otherwise O(m), where m is the number of objects in the section
  
  @param indexPath The index path of the object to replace.
  @param object The object with which to replace the existing object at the given index path.
  */
 - (void)replaceObjectAtIndexPath:(NSIndexPath *)indexPath withObject:(id)object
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object || !indexPath) {
         NSAssert(object, @"Object should not be nil.");
         NSAssert(indexPath, @"Index path should not be nil.");
@@ -293,7 +578,7 @@
         return;
     }
     
-    INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[sectionIndex];
+    INTUMutableGroupedArraySectionContainer *sectionContainer = [self _mutableSectionContainerAtIndex:sectionIndex];
     NSMutableArray *objectsArray = sectionContainer.mutableObjects;
     
     if (objectIndex >= [objectsArray count]) {
@@ -301,8 +586,16 @@
         return;
     }
     
-    [objectsArray replaceObjectAtIndex:objectIndex withObject:object];
-    _mutations++;
+    [self _removeObject:objectsArray[objectIndex] fromObjectIndexInSection:sectionContainer.section];
+    [self _addObject:object toObjectIndexInSection:sectionContainer.section];
+    if (_objectComparator) {
+        // The objects are kept sorted, so move the object to its sorted position
+        [objectsArray removeObjectAtIndex:objectIndex];
+        [objectsArray insertObject:object atIndex:[self _insertionIndexForObject:object inObjectsArray:objectsArray]];
+    } else {
+        [objectsArray replaceObjectAtIndex:objectIndex withObject:object];
+    }
+    [self _didMutate];
 }
 
 #pragma mark Moving
@@ -316,6 +609,10 @@
  */
 - (void)moveSectionAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex
 {
+    if (_sectionComparator) {
+        NSAssert(_sectionComparator == nil, @"Sections cannot be moved while they are kept sorted.");
+        return;
+    }
     NSUInteger sectionCount = [self countAllSections];
     if (fromIndex >= sectionCount || toIndex >= sectionCount) {
         NSAssert(fromIndex < sectionCount, @"From index out of bounds!");
@@ -326,7 +623,8 @@
     INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[fromIndex];
     [self.mutableSectionContainers removeObjectAtIndex:fromIndex];
     [self.mutableSectionContainers insertObject:sectionContainer atIndex:toIndex];
-    _mutations++;
+    [self _updateSectionIndexInRange:NSMakeRange(MIN(fromIndex, toIndex), MAX(fromIndex, toIndex) - MIN(fromIndex, toIndex) + 1)];
+    [self _didMutate];
 }
 
 /**
@@ -338,6 +636,11 @@
  */
 - (void)moveObjectAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)toIndexPath
 {
+    INTU_INSTRUMENT_TIMING();
+    if (_objectComparator) {
+        NSAssert(_objectComparator == nil, @"Objects cannot be moved while they are kept sorted.");
+        return;
+    }
     if (!fromIndexPath || !toIndexPath) {
         NSAssert(fromIndexPath, @"From index path should not be nil!");
         NSAssert(toIndexPath, @"To index path should not be nil!");
@@ -370,16 +673,21 @@
     }
     
     id object = [self objectAtIndexPath:fromIndexPath];
-    // Don't use [self removeObjectAtIndexPath:] here because we need to finish the insert before checking if the from section is empty
-    INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[fromSectionIndex];
+    // Don't use [self removeObjectAtIndexPath:] or [self insertObject:atIndexPath:] here because we need to finish the insert before
+    // checking if the from section is empty, and the move should only be recorded as a single mutation
+    INTUMutableGroupedArraySectionContainer *sectionContainer = [self _mutableSectionContainerAtIndex:fromSectionIndex];
     NSMutableArray *objectsArray = sectionContainer.mutableObjects;
     [objectsArray removeObjectAtIndex:fromObjectIndex];
-    [self insertObject:object atIndexPath:toIndexPath];
-    // Check if moving this object left its section empty; if so, remove it
-    if ([objectsArray count] == 0) {
+    [self _removeObject:object fromObjectIndexInSection:sectionContainer.section];
+    INTUMutableGroupedArraySectionContainer *toSectionContainer = [self _mutableSectionContainerAtIndex:toSectionIndex];
+    [toSectionContainer.mutableObjects insertObject:object atIndex:toObjectIndex];
+    [self _addObject:object toObjectIndexInSection:toSectionContainer.section];
+    // Check if moving this object left its section empty; if so, remove it (which records the mutation)
+    if ([objectsArray count] == 0 && [self _shouldRemoveEmptySectionNow]) {
         [self removeSectionAtIndex:fromSectionIndex];
+    } else {
+        [self _didMutate];
     }
-    _mutations++;
 }
 
 #pragma mark Exchanging
@@ -393,6 +701,10 @@
  */
 - (void)exchangeSectionAtIndex:(NSUInteger)index1 withSectionAtIndex:(NSUInteger)index2
 {
+    if (_sectionComparator) {
+        NSAssert(_sectionComparator == nil, @"Sections cannot be exchanged while they are kept sorted.");
+        return;
+    }
     NSUInteger sectionCount = [self countAllSections];
     if (index1 >= sectionCount || index2 >= sectionCount) {
         NSAssert(index1 < sectionCount, @"Index 1 out of bounds!");
@@ -400,7 +712,9 @@
         return;
     }
     [self.mutableSectionContainers exchangeObjectAtIndex:index1 withObjectAtIndex:index2];
-    _mutations++;
+    [self _updateSectionIndexInRange:NSMakeRange(index1, 1)];
+    [self _updateSectionIndexInRange:NSMakeRange(index2, 1)];
+    [self _didMutate];
 }
 
 /**
@@ -412,6 +726,10 @@
  */
 - (void)exchangeObjectAtIndexPath:(NSIndexPath *)indexPath1 withObjectAtIndexPath:(NSIndexPath *)indexPath2
 {
+    if (_objectComparator) {
+        NSAssert(_objectComparator == nil, @"Objects cannot be exchanged while they are kept sorted.");
+        return;
+    }
     if (!indexPath1 || !indexPath2) {
         NSAssert(indexPath1, @"Index path 1 should not be nil!");
         NSAssert(indexPath2, @"Index path 2 should not be nil!");
@@ -438,12 +756,19 @@
         return;
     }
     
-    INTUMutableGroupedArraySectionContainer *sectionContainer1 = self.sectionContainers[sectionIndex1];
-    INTUMutableGroupedArraySectionContainer *sectionContainer2 = self.sectionContainers[sectionIndex2];
+    INTUMutableGroupedArraySectionContainer *sectionContainer1 = [self _mutableSectionContainerAtIndex:sectionIndex1];
+    INTUMutableGroupedArraySectionContainer *sectionContainer2 = [self _mutableSectionContainerAtIndex:sectionIndex2];
     id object1 = sectionContainer1.objects[objectIndex1];
-    sectionContainer1.mutableObjects[objectIndex1] = sectionContainer2.objects[objectIndex2];
+    id object2 = sectionContainer2.objects[objectIndex2];
+    sectionContainer1.mutableObjects[objectIndex1] = object2;
     sectionContainer2.mutableObjects[objectIndex2] = object1;
-    _mutations++;
+    if (sectionContainer1 != sectionContainer2) {
+        [self _removeObject:object1 fromObjectIndexInSection:sectionContainer1.section];
+        [self _removeObject:object2 fromObjectIndexInSection:sectionContainer2.section];
+        [self _addObject:object2 toObjectIndexInSection:sectionContainer1.section];
+        [self _addObject:object1 toObjectIndexInSection:sectionContainer2.section];
+    }
+    [self _didMutate];
 }
 
 #pragma mark Removing
@@ -454,13 +779,16 @@
  */
 - (void)removeAllObjects
 {
+    [self _keepSectionContainersForReuseAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [self countAllSections])]];
     [self.mutableSectionContainers removeAllObjects];
-    _mutations++;
+    [self _rebuildSectionIndex];
+    [self _rebuildObjectIndex];
+    [self _didMutate];
 }
 
 /**
  Removes the section and all objects in it.
- Performance: O(n), where n is the number of sections
+ Performance: O(n), where n is the number of sections (to shift the sections after it)
  
  @param section The section to remove.
  */
@@ -485,38 +813,79 @@
  */
 - (void)removeSectionAtIndex:(NSUInteger)index
 {
+    INTU_INSTRUMENT_TIMING();
     if (index >= [self countAllSections]) {
         NSAssert(index < [self countAllSections], @"Index out of bounds!");
         return;
     }
+    INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[index];
+    [self _removeSectionFromSectionIndex:sectionContainer.section];
+    [self _removeObjects:sectionContainer.objects fromObjectIndexInSection:sectionContainer.section];
     [self.mutableSectionContainers removeObjectAtIndex:index];
-    _mutations++;
+    [self _updateSectionIndexInRange:NSMakeRange(index, [self countAllSections] - index)];
+    [self _keepSectionContainerForReuse:sectionContainer];
+    [self _didMutate];
 }
 
 /**
  Removes all occurrences of the object across all sections. Empty sections will be removed.
- Performance: O(n), where n is the total number of objects across all sections
+ Performance: O(n), where n is the total number of objects across all sections. If the INTUGroupedArrayOptionHashedObjectIndex option is set,
+              only the sections containing the object are searched: O(s+k*m), where s is the number of sections (to find the indexes of the
+              sections containing the object), k is the number of sections containing the object, and m is the number of objects in each
+              of them. If the INTUGroupedArrayOptionHashedSectionIndex option is also set (or during a batch of updates), this is O(k*m)
  
  @param object The object to remove.
  */
 - (void)removeObject:(id)object
 {
+    INTU_INSTRUMENT_TIMING();
     if (!object) {
         NSAssert(object, @"Object should not be nil.");
         return;
     }
-    NSMutableArray *arraySectionsToRemove = [NSMutableArray new];
-    for (INTUMutableGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-        NSMutableArray *objectsArray = sectionContainer.mutableObjects;
-        [objectsArray removeObject:object];
-        if ([objectsArray count] == 0) {
-            [arraySectionsToRemove addObject:sectionContainer];
+    NSIndexSet *sectionIndexesToSearch = nil;
+    if (self.options & INTUGroupedArrayOptionHashedObjectIndex) {
+        // Only search the sections that contain the object
+        NSCountedSet *sectionsContainingObject = [self _sectionsContainingObjectInObjectIndex:object];
+        NSMutableIndexSet *sectionIndexesContainingObject = [NSMutableIndexSet new];
+        if ((self.options & INTUGroupedArrayOptionHashedSectionIndex) || _batchUpdateDepth > 0 || [sectionsContainingObject count] <= 1) {
+            // Each section is located in O(1) time using the section index (or there is at most one to locate)
+            for (id section in sectionsContainingObject) {
+                [sectionIndexesContainingObject addIndex:[self indexOfSection:section]];
+            }
+        } else {
+            // Locate all of the sections in a single pass, instead of searching for each one
+            NSUInteger sectionCount = [self countAllSections];
+            for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+                if ([sectionsContainingObject member:[self sectionAtIndex:sectionIndex]]) {
+                    [sectionIndexesContainingObject addIndex:sectionIndex];
+                }
+            }
+        }
+        sectionIndexesToSearch = sectionIndexesContainingObject;
+    } else {
+        sectionIndexesToSearch = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [self countAllSections])];
+    }
+    NSMutableIndexSet *sectionIndexesToRemove = [NSMutableIndexSet new];
+    for (NSUInteger sectionIndex = [sectionIndexesToSearch firstIndex]; sectionIndex != NSNotFound; sectionIndex = [sectionIndexesToSearch indexGreaterThanIndex:sectionIndex]) {
+        INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[sectionIndex];
+        if ([sectionContainer.objects indexOfObject:object] == NSNotFound) {
+            // Skip sections that don't contain the object, so that they aren't copied if they are shared
+            continue;
+        }
+        INTUMutableGroupedArraySectionContainer *mutableSectionContainer = [self _mutableSectionContainerAtIndex:sectionIndex];
+        NSMutableArray *objectsArray = mutableSectionContainer.mutableObjects;
+        [self _removeAllInstancesOfObject:object fromObjectsArray:objectsArray inSection:mutableSectionContainer.section];
+        if ([objectsArray count] == 0 && [self _shouldRemoveEmptySectionNow]) {
+            [sectionIndexesToRemove addIndex:sectionIndex];
         }
     }
-    for (INTUGroupedArraySectionContainer *sectionContainer in arraySectionsToRemove) {
-        [self.mutableSectionContainers removeObject:sectionContainer];
+    if ([sectionIndexesToRemove count] > 0) {
+        [self _keepSectionContainersForReuseAtIndexes:sectionIndexesToRemove];
+        [self.mutableSectionContainers removeObjectsAtIndexes:sectionIndexesToRemove];
+        [self _rebuildSectionIndex];
     }
-    _mutations++;
+    [self _didMutate];
 }
 
 /**
@@ -538,11 +907,11 @@
         // Section does not exist
         return;
     }
-    [objectsArray removeObject:object];
-    if ([objectsArray count] == 0) {
+    [self _removeAllInstancesOfObject:object fromObjectsArray:objectsArray inSection:section];
+    if ([objectsArray count] == 0 && [self _shouldRemoveEmptySectionNow]) {
         [self removeSection:section];
     }
-    _mutations++;
+    [self _didMutate];
 }
 
 /**
@@ -568,11 +937,12 @@
         NSAssert(index < [objectsArray count], @"Index out of bounds!");
         return;
     }
+    [self _removeObject:objectsArray[index] fromObjectIndexInSection:section];
     [objectsArray removeObjectAtIndex:index];
-    if ([objectsArray count] == 0) {
+    if ([objectsArray count] == 0 && [self _shouldRemoveEmptySectionNow]) {
         [self removeSection:section];
     }
-    _mutations++;
+    [self _didMutate];
 }
 
 /**
@@ -584,6 +954,7 @@
  */
 - (void)removeObjectAtIndexPath:(NSIndexPath *)indexPath
 {
+    INTU_INSTRUMENT_TIMING();
     if (!indexPath) {
         NSAssert(indexPath, @"Index path should not be nil.");
         return;
@@ -594,17 +965,20 @@
         NSAssert(sectionIndex < [self countAllSections], @"Section index out of bounds!");
         return;
     }
-    INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[sectionIndex];
+    INTUMutableGroupedArraySectionContainer *sectionContainer = [self _mutableSectionContainerAtIndex:sectionIndex];
     NSMutableArray *objectsArray = sectionContainer.mutableObjects;
     if (objectIndex >= [objectsArray count]) {
         NSAssert(objectIndex < [objectsArray count], @"Row index out of bounds!");
         return;
     }
+    [self _removeObject:objectsArray[objectIndex] fromObjectIndexInSection:sectionContainer.section];
     [objectsArray removeObjectAtIndex:objectIndex];
-    if ([objectsArray count] == 0) {
+    if ([objectsArray count] == 0 && [self _shouldRemoveEmptySectionNow]) {
+        // Removing the section records the mutation
         [self removeSectionAtIndex:sectionIndex];
+    } else {
+        [self _didMutate];
     }
-    _mutations++;
 }
 
 #pragma mark Filtering
@@ -617,24 +991,71 @@
  */
 - (void)filterUsingSectionPredicate:(NSPredicate *)sectionPredicate objectPredicate:(NSPredicate *)objectPredicate
 {
+    [self filterWithOptions:0 usingSectionPredicate:sectionPredicate objectPredicate:objectPredicate];
+}
+
+/**
+ Evaluates the section & object predicates against all sections & objects and removes those that do not match, using the specified enumeration options.
+ Empty sections will be removed.
+ 
+ @param options The enumeration options to use. When NSEnumerationConcurrent is set, sections are filtered in parallel, so the predicates must be safe
+                to evaluate concurrently. The result is identical either way.
+ @param sectionPredicate A predicate used to filter sections, or nil if no section filtering is desired.
+ @param objectPredicate A predicate used to filter objects in each section, or nil if no object filtering is desired.
+ */
+- (void)filterWithOptions:(NSEnumerationOptions)options usingSectionPredicate:(NSPredicate *)sectionPredicate objectPredicate:(NSPredicate *)objectPredicate
+{
+    INTU_INSTRUMENT_TIMING();
     if (sectionPredicate || objectPredicate) {
-        NSMutableArray *sectionContainersToRemove = [NSMutableArray new];
-        for (INTUMutableGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-            if (sectionPredicate && [sectionPredicate evaluateWithObject:sectionContainer.section] == NO) {
-                [sectionContainersToRemove addObject:sectionContainer];
-            } else if (objectPredicate) {
-                NSMutableArray *objectsArray = sectionContainer.mutableObjects;
-                [objectsArray filterUsingPredicate:objectPredicate];
-                if ([objectsArray count] == 0) {
-                    [sectionContainersToRemove addObject:sectionContainer];
+        // Each section records whether it should be removed, and any copy of its section container that had to be made (copy-on-write),
+        // in its own slot, so the sections can be filtered in parallel without sharing any state
+        NSUInteger sectionCount = [self countAllSections];
+        // Freed automatically, including if an exception is raised
+        NSMutableData *shouldRemoveSectionData = [NSMutableData dataWithLength:MAX(sectionCount, (NSUInteger)1) * sizeof(BOOL)];
+        BOOL *shouldRemoveSection = [shouldRemoveSectionData mutableBytes];
+        BOOL removeEmptySections = (_batchUpdateDepth == 0);
+        if (!shouldRemoveSection) {
+            [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu filtered sections.", (unsigned long)sectionCount];
+        }
+        void **sectionContainerCopies = calloc(MAX(sectionCount, (NSUInteger)1), sizeof(void *));
+        if (!sectionContainerCopies) {
+            [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu filtered sections.", (unsigned long)sectionCount];
+        }
+        @try {
+            [self _enumerateSectionContainersWithOptions:options usingBlock:^(INTUGroupedArraySectionContainer *sectionContainer, NSUInteger index) {
+                if (sectionPredicate && [sectionPredicate evaluateWithObject:sectionContainer.section] == NO) {
+                    shouldRemoveSection[index] = YES;
+                } else if (objectPredicate) {
+                    NSMutableArray *objectsArray = [self _ownedSectionContainerForSectionContainer:sectionContainer atIndex:index copies:sectionContainerCopies].mutableObjects;
+                    [objectsArray filterUsingPredicate:objectPredicate];
+                    if ([objectsArray count] == 0) {
+                        shouldRemoveSection[index] = removeEmptySections;
+                    }
                 }
+            }];
+        } @finally {
+            // Install (and release) any copies that were made even if a predicate raised an exception, so that they are not leaked
+            [self _installSectionContainerCopies:sectionContainerCopies count:sectionCount];
+        }
+        if (!removeEmptySections && objectPredicate) {
+            // Any sections the object predicate left empty will be removed when the batch of updates ends
+            _batchUpdatesLeftEmptySections = YES;
+        }
+        
+        NSMutableIndexSet *sectionIndexesToRemove = [NSMutableIndexSet new];
+        for (NSUInteger i = 0; i < sectionCount; i++) {
+            if (shouldRemoveSection[i]) {
+                [sectionIndexesToRemove addIndex:i];
             }
         }
-        for (INTUGroupedArraySectionContainer *sectionContainer in sectionContainersToRemove) {
-            [self.mutableSectionContainers removeObject:sectionContainer];
+        if ([sectionIndexesToRemove count] > 0) {
+            [self _keepSectionContainersForReuseAtIndexes:sectionIndexesToRemove];
+            [self.mutableSectionContainers removeObjectsAtIndexes:sectionIndexesToRemove];
+            [self _rebuildSectionIndex];
         }
+        [self _rebuildObjectIndex];
     }
-    _mutations++;
+    [self _didMutate];
 }
 
 #pragma mark Sorting
@@ -647,26 +1068,551 @@
  */
 - (void)sortUsingSectionComparator:(NSComparator)sectionCmptr objectComparator:(NSComparator)objectCmptr
 {
+    [self sortWithOptions:0 usingSectionComparator:sectionCmptr objectComparator:objectCmptr];
+}
+
+/**
+ Sorts the sections using the section comparator, and the objects in each section using the object comparator, using the specified sort options.
+ 
+ @param options The sort options to use. When NSSortConcurrent is set, the objects in different sections are sorted in parallel, so the object comparator
+                must be safe to call concurrently. Each section is still sorted on a single thread, so the result is identical either way.
+ @param sectionCmptr A comparator block used to sort sections, or nil if no section sorting is desired.
+ @param objectCmptr A comparator block used to sort objects in each section, or nil if no object sorting is desired.
+ */
+- (void)sortWithOptions:(NSSortOptions)options usingSectionComparator:(NSComparator)sectionCmptr objectComparator:(NSComparator)objectCmptr
+{
+    INTU_INSTRUMENT_TIMING();
+    if ((sectionCmptr && _sectionComparator) || (objectCmptr && _objectComparator)) {
+        NSAssert(!(sectionCmptr && _sectionComparator), @"Sections cannot be re-sorted while they are kept sorted. Use -[maintainSortOrderUsingSectionComparator:objectComparator:] to change the order.");
+        NSAssert(!(objectCmptr && _objectComparator), @"Objects cannot be re-sorted while they are kept sorted. Use -[maintainSortOrderUsingSectionComparator:objectComparator:] to change the order.");
+        return;
+    }
+    sectionCmptr = INTU_INSTRUMENT_COMPARATOR(sectionCmptr);
+    objectCmptr = INTU_INSTRUMENT_COMPARATOR(objectCmptr);
+    NSSortOptions sortOptions = options & NSSortStable;
     if (sectionCmptr) {
-        [self.mutableSectionContainers sortUsingComparator:^NSComparisonResult(INTUGroupedArraySectionContainer *arraySection1, INTUGroupedArraySectionContainer *arraySection2) {
+        [self.mutableSectionContainers sortWithOptions:sortOptions usingComparator:^NSComparisonResult(INTUGroupedArraySectionContainer *arraySection1, INTUGroupedArraySectionContainer *arraySection2) {
             return sectionCmptr(arraySection1.section, arraySection2.section);
         }];
+        [self _rebuildSectionIndex];
     }
     if (objectCmptr) {
-        for (INTUMutableGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
-            [sectionContainer.mutableObjects sortUsingComparator:objectCmptr];
+        // Any copies of section containers that have to be made (copy-on-write) are stored in per-section slots while sorting in parallel
+        NSUInteger sectionCount = [self countAllSections];
+        void **sectionContainerCopies = calloc(MAX(sectionCount, (NSUInteger)1), sizeof(void *));
+        if (!sectionContainerCopies) {
+            [NSException raise:NSMallocException format:@"Failed to allocate memory for %lu sorted sections.", (unsigned long)sectionCount];
         }
+        NSEnumerationOptions enumerationOptions = (options & NSSortConcurrent) ? NSEnumerationConcurrent : 0;
+        @try {
+            [self _enumerateSectionContainersWithOptions:enumerationOptions usingBlock:^(INTUGroupedArraySectionContainer *sectionContainer, NSUInteger index) {
+                INTUMutableGroupedArraySectionContainer *ownedSectionContainer = [self _ownedSectionContainerForSectionContainer:sectionContainer atIndex:index copies:sectionContainerCopies];
+                [ownedSectionContainer.mutableObjects sortWithOptions:sortOptions usingComparator:objectCmptr];
+            }];
+        } @finally {
+            // Install (and release) any copies that were made even if the comparator raised an exception, so that they are not leaked
+            [self _installSectionContainerCopies:sectionContainerCopies count:sectionCount];
+        }
+    }
+    [self _didMutate];
+}
+
+#pragma mark Sorted Mode
+
+/**
+ Sorts the sections using the section comparator and the objects in each section using the object comparator (keeping the existing order of
+ sections & objects that compare the same), and from then on keeps them in that order:
+    - Objects added or inserted into a section, and new sections, are inserted at their sorted positions (after any that compare the same).
+      Replaced sections & objects are moved to their sorted positions.
+    - Sections are located by binary search in O(log n) time, and objects in a section in O(log m) time.
+    - Sections & objects that are kept sorted cannot be moved, exchanged, or re-sorted with another comparator.
+ The order is maintained by mutable copies of the grouped array, but not by immutable copies or archives.
+ Performance: O(n*log(n) + m*log(m)), where n is the number of sections, and m is the number of objects in each section
+ 
+ @param sectionCmptr The comparator to keep the sections sorted by, or nil to stop maintaining the order of the sections.
+ @param objectCmptr The comparator to keep the objects in each section sorted by, or nil to stop maintaining the order of the objects.
+ */
+- (void)maintainSortOrderUsingSectionComparator:(NSComparator)sectionCmptr objectComparator:(NSComparator)objectCmptr
+{
+    _sectionComparator = nil;
+    _objectComparator = nil;
+    [self sortWithOptions:NSSortStable usingSectionComparator:sectionCmptr objectComparator:objectCmptr];
+    _sectionComparator = [sectionCmptr copy];
+    _objectComparator = [objectCmptr copy];
+}
+
+#pragma mark Aggregates
+
+/**
+ Registers an aggregate of the values of the objects in each section, which is computed for every section once and from then on kept
+ up to date by every mutation (including moves, replacements, filtering & batch updates) instead of being recomputed, so that reading
+ it is O(1). Replaces any aggregate already registered with the name.
+ Performance: O(n), where n is the total number of objects across all sections. Each registered aggregate adds O(1) to every mutation
+              of a single object.
+ 
+ @param name The name to read the aggregate with.
+ @param function The function that combines the values of the objects in each section.
+ @param keyPath The key path of the value of each object, or nil to use the objects themselves. Objects whose value is nil are ignored.
+ */
+- (void)registerAggregateWithName:(NSString *)name function:(INTUGroupedArrayAggregateFunction)function keyPath:(NSString *)keyPath
+{
+    if (!name) {
+        NSAssert(name, @"Name should not be nil.");
+        return;
+    }
+    INTUGroupedArrayAggregate *aggregate = [[INTUGroupedArrayAggregate alloc] initWithFunction:function keyPath:keyPath];
+    [self _recomputeAggregates:@[aggregate]];
+    if (!_aggregates) {
+        _aggregates = [NSMutableDictionary new];
+    }
+    _aggregates[name] = aggregate;
+}
+
+/**
+ Stops maintaining the aggregate registered with the name. Does nothing if no aggregate is registered with the name.
+ Performance: O(1)
+ 
+ @param name The name of the aggregate.
+ */
+- (void)unregisterAggregateWithName:(NSString *)name
+{
+    if (!name) {
+        NSAssert(name, @"Name should not be nil.");
+        return;
+    }
+    [_aggregates removeObjectForKey:name];
+}
+
+/**
+ Discards the registered aggregates and computes them again from the current values of all objects. Aggregates are kept up to date using
+ the value of each object when it is added & removed, so this must be called after the value at the key path of an aggregate changes
+ for any object in the grouped array.
+ Performance: O(k*n), where k is the number of registered aggregates, and n is the total number of objects across all sections
+ */
+- (void)recomputeAggregates
+{
+    [self _recomputeAggregates:[_aggregates allValues]];
+}
+
+/**
+ Returns the names of the registered aggregates, in no particular order.
+ Performance: O(k), where k is the number of registered aggregates
+ */
+- (NSArray *)registeredAggregateNames
+{
+    return _aggregates ? [_aggregates allKeys] : @[];
+}
+
+/**
+ Returns the value of the aggregate registered with the name for the section at the index.
+ An exception will be raised if the index is out of bounds, or no aggregate is registered with the name.
+ Performance: O(1), except for the first read of a minimum or maximum after the previous one was removed from the section, which is O(m),
+              where m is the number of objects in the section
+ 
+ @param name The name of the aggregate.
+ @param index The index of the section.
+ @return The count or sum of the values in the section as an NSNumber, or the minimum or maximum value (nil if the section has no values).
+ */
+- (id)aggregateWithName:(NSString *)name inSectionAtIndex:(NSUInteger)index
+{
+    INTUGroupedArrayAggregate *aggregate = name ? _aggregates[name] : nil;
+    if (!aggregate || index >= [self countAllSections]) {
+        NSAssert(aggregate, @"No aggregate is registered with the name %@.", name);
+        NSAssert(index < [self countAllSections], @"Index out of bounds!");
+        return nil;
+    }
+    INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[index];
+    return [aggregate valueInSection:sectionContainer.section withObjects:sectionContainer.objects];
+}
+
+/**
+ Returns the value of the aggregate registered with the name for the section. If the section does not exist, returns the value for an
+ empty section (@0 for a count or sum, nil for a minimum or maximum).
+ An exception will be raised if no aggregate is registered with the name.
+ Performance: O(1) if the INTUGroupedArrayOptionHashedSectionIndex option is set; otherwise O(n), where n is the number of sections
+ 
+ @param name The name of the aggregate.
+ @param section The section.
+ @return The count or sum of the values in the section as an NSNumber, or the minimum or maximum value (nil if the section has no values).
+ */
+- (id)aggregateWithName:(NSString *)name inSection:(id)section
+{
+    if (!section) {
+        NSAssert(section, @"Section should not be nil.");
+        return nil;
+    }
+    NSUInteger sectionIndex = [self indexOfSection:section];
+    if (sectionIndex == NSNotFound) {
+        INTUGroupedArrayAggregate *aggregate = name ? _aggregates[name] : nil;
+        NSAssert(aggregate, @"No aggregate is registered with the name %@.", name);
+        return [aggregate valueInSection:section withObjects:@[]];
+    }
+    return [self aggregateWithName:name inSectionAtIndex:sectionIndex];
+}
+
+#pragma mark Batch Updates
+
+/**
+ Performs the mutations in the block as a single batch of updates, which is much faster than performing the same mutations individually
+ when there are many of them. During the batch:
+    - Sections are located in O(1) time, even if the INTUGroupedArrayOptionHashedSectionIndex option is not set.
+    - Sections that become empty are NOT removed right away, so the indices of the other sections do not change during the batch.
+      (Adding an object to an empty section will keep it.) All sections that are still empty are removed at once when the batch ends.
+    - If the objects are kept sorted, objects that are added, inserted or replaced are added at the end of their section, and each section
+      that is no longer sorted is sorted once when the batch ends, with the same result as inserting each object at its sorted position.
+      (New sections are still inserted at their sorted positions right away.)
+    - The grouped array counts as mutated only once, when the batch ends.
+    - Copies made during the batch have the contents that the batch would leave if it ended then (sorted, without empty sections).
+ Calls to this method may be nested; the batch ends when the outermost block returns. If the block raises an exception, the batch still
+ ends (keeping the mutations made before the exception) and the exception is raised again. The grouped array must not be enumerated
+ while a batch of updates is in progress.
+ Performance: O(n) in addition to the mutations, where n is the number of sections
+ 
+ @param updates A block that mutates the grouped array.
+ */
+- (void)performBatchUpdates:(void (^)(void))updates
+{
+    INTU_INSTRUMENT_TIMING();
+    if (!updates) {
+        NSAssert(updates, @"Updates block should not be nil.");
+        return;
+    }
+    
+    if (_batchUpdateDepth == 0) {
+        _batchUpdatesDidMutate = NO;
+        _batchUpdatesLeftEmptySections = NO;
+        _batchUpdatesLeftUnsortedObjects = NO;
+        if ((self.options & INTUGroupedArrayOptionHashedSectionIndex) == 0) {
+            // Resolve sections using a temporary section index for the duration of the batch
+            [self _setUsesTemporarySectionIndex:YES];
+        }
+    }
+    _batchUpdateDepth++;
+    @try {
+        updates();
+    } @finally {
+        // End the batch even if the block raised an exception, so that the grouped array does not stay in the middle of a batch forever
+        _batchUpdateDepth--;
+        if (_batchUpdateDepth == 0) {
+            [self _endBatchUpdates];
+        }
+    }
+}
+
+/**
+ Finishes the outermost batch of updates: stops using the temporary section index, removes the sections left empty during the batch,
+ and counts the batch as a single mutation if it mutated the grouped array.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)_endBatchUpdates
+{
+    if ((self.options & INTUGroupedArrayOptionHashedSectionIndex) == 0) {
+        [self _setUsesTemporarySectionIndex:NO];
+    }
+    if (_batchUpdatesLeftUnsortedObjects) {
+        [self _sortUnsortedObjects];
+        _batchUpdatesLeftUnsortedObjects = NO;
+    }
+    if (_batchUpdatesLeftEmptySections) {
+        [self _removeEmptySections];
+        _batchUpdatesLeftEmptySections = NO;
+    }
+    if (_batchUpdatesDidMutate) {
+        _mutations++;
     }
-    _mutations++;
 }
 
 #pragma mark Internal Helper Methods
 
+/**
+ Removes all sections that are empty, after sections were left empty during a batch of updates.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)_removeEmptySections
+{
+    NSIndexSet *emptySectionIndexes = [self.sectionContainers indexesOfObjectsPassingTest:^BOOL(INTUGroupedArraySectionContainer *sectionContainer, NSUInteger idx, BOOL *stop) {
+        return [sectionContainer.objects count] == 0;
+    }];
+    if ([emptySectionIndexes count] > 0) {
+        [self _keepSectionContainersForReuseAtIndexes:emptySectionIndexes];
+        [self.mutableSectionContainers removeObjectsAtIndexes:emptySectionIndexes];
+        [self _rebuildSectionIndex];
+        [self _invalidateSectionOffsetTable];
+    }
+}
+
+/**
+ Sorts the objects in each section that is no longer sorted by the object comparator, after objects were added at the end of their section
+ during a batch of updates. The sort is stable, so the result is the same as if each object had been inserted at its sorted position (after
+ any objects that compare the same) when it was added.
+ Performance: O(n), where n is the total number of objects across all sections, plus O(m*log(m)) for each section that is sorted, where m is
+              the number of objects in the section
+ */
+- (void)_sortUnsortedObjects
+{
+    if (!_objectComparator) {
+        return;
+    }
+    NSComparator objectCmptr = INTU_INSTRUMENT_COMPARATOR(_objectComparator);
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        BOOL isSorted = YES;
+        id previousObject = nil;
+        for (id object in ((INTUGroupedArraySectionContainer *)self.sectionContainers[sectionIndex]).objects) {
+            if (previousObject && objectCmptr(previousObject, object) == NSOrderedDescending) {
+                isSorted = NO;
+                break;
+            }
+            previousObject = object;
+        }
+        if (!isSorted) {
+            [[self _mutableSectionContainerAtIndex:sectionIndex].mutableObjects sortWithOptions:NSSortStable usingComparator:objectCmptr];
+        }
+    }
+}
+
+/**
+ Discards the aggregates and computes them again from all of the sections & objects.
+ Performance: O(k*n), where k is the number of aggregates, and n is the total number of objects across all sections
+ */
+- (void)_recomputeAggregates:(NSArray *)aggregates
+{
+    for (INTUGroupedArrayAggregate *aggregate in aggregates) {
+        [aggregate removeAllSections];
+        for (INTUGroupedArraySectionContainer *sectionContainer in self.sectionContainers) {
+            for (id object in sectionContainer.objects) {
+                [aggregate addObject:object toSection:sectionContainer.section];
+            }
+        }
+    }
+}
+
+/**
+ Records that the grouped array was mutated. Inside a batch of updates, this only marks the cumulative object counts as out of date,
+ and _mutations is incremented once when the batch ends.
+ Performance: O(1)
+ */
+- (void)_didMutate
+{
+    INTU_INSTRUMENT_COUNT(Mutations, 1);
+    if (_batchUpdateDepth > 0) {
+        _batchUpdatesDidMutate = YES;
+        [self _invalidateSectionOffsetTable];
+    } else {
+        _mutations++;
+    }
+}
+
+/**
+ Returns whether a section that was just left empty should be removed right away. Inside a batch of updates, empty sections are
+ left in place and removed when the batch ends, so this records that there are empty sections to remove and returns NO.
+ Performance: O(1)
+ */
+- (BOOL)_shouldRemoveEmptySectionNow
+{
+    if (_batchUpdateDepth > 0) {
+        _batchUpdatesLeftEmptySections = YES;
+        return NO;
+    }
+    return YES;
+}
+
+/**
+ Adds an empty section container for the section after the last section, or at its sorted position if the sections are kept sorted.
+ The section container of a previously removed section is reused if one is available; otherwise a new one is created.
+ Performance: O(1) if the sections are not kept sorted; otherwise O(n), where n is the number of sections (to shift the sections after it)
+ 
+ @param section The section to add a section container for. Must not already exist in the grouped array.
+ @return The new section container.
+ */
+- (INTUMutableGroupedArraySectionContainer *)_addSectionContainerForSection:(id)section
+{
+    INTUMutableGroupedArraySectionContainer *sectionContainer = [_reusableSectionContainers lastObject];
+    if (sectionContainer) {
+        INTU_INSTRUMENT_COUNT(SectionContainersReused, 1);
+        [_reusableSectionContainers removeLastObject];
+        sectionContainer.section = section;
+    } else {
+        INTU_INSTRUMENT_COUNT(SectionContainersCreated, 1);
+        sectionContainer = [INTUMutableGroupedArraySectionContainer sectionContainerWithSection:section];
+    }
+    sectionContainer.ownerID = _ownerID;
+    [self _useChunkedStorageIfNeededForSectionContainer:sectionContainer];
+    NSUInteger sectionCount = [self.mutableSectionContainers count];
+    NSUInteger index = sectionCount;
+    if (_sectionComparator) {
+        INTUIndexOfSectionInSortedSectionContainers(self.sectionContainers, section, _sectionComparator, &index);
+    }
+    [self.mutableSectionContainers insertObject:sectionContainer atIndex:index];
+    [self _updateSectionIndexInRange:NSMakeRange(index, sectionCount + 1 - index)];
+    return sectionContainer;
+}
+
+/**
+ Keeps the section container of a section that was just removed for reuse by a section added later, emptying it right away so that it
+ does not keep its section & objects alive. Section containers that may be shared with another grouped array (which are not owned by
+ this grouped array), that hold many objects, that use chunked storage that a new section would not use, or that do not fit in the pool
+ are left to be deallocated as usual.
+ Performance: O(m), where m is the number of objects in the section
+ */
+- (void)_keepSectionContainerForReuse:(INTUGroupedArraySectionContainer *)sectionContainer
+{
+    if (sectionContainer.ownerID != _ownerID || ![sectionContainer isKindOfClass:[INTUMutableGroupedArraySectionContainer class]]) {
+        return;
+    }
+    INTUMutableGroupedArraySectionContainer *mutableSectionContainer = (INTUMutableGroupedArraySectionContainer *)sectionContainer;
+    BOOL newSectionsUseChunkedStorage = (self.options & INTUGroupedArrayOptionChunkedSectionStorage) != 0;
+    if ((mutableSectionContainer.usesChunkedStorage && !newSectionsUseChunkedStorage) || [mutableSectionContainer countObjects] > INTUMutableGroupedArrayMaxReusableSectionContainerObjects) {
+        return;
+    }
+    if ([_reusableSectionContainers count] >= INTUMutableGroupedArrayMaxReusableSectionContainers) {
+        return;
+    }
+    if (!_reusableSectionContainers) {
+        _reusableSectionContainers = [[NSMutableArray alloc] initWithCapacity:INTUMutableGroupedArrayMaxReusableSectionContainers];
+    }
+    [mutableSectionContainer prepareForReuse];
+    [_reusableSectionContainers addObject:mutableSectionContainer];
+}
+
+/**
+ Keeps the section containers at the indexes for reuse (see -_keepSectionContainerForReuse:). Call this right before they are removed.
+ Performance: O(k*m), where k is the number of section containers, and m is the number of objects in each of them
+ */
+- (void)_keepSectionContainersForReuseAtIndexes:(NSIndexSet *)indexes
+{
+    NSArray *sectionContainers = self.sectionContainers;
+    for (NSUInteger index = [indexes firstIndex]; index != NSNotFound && [_reusableSectionContainers count] < INTUMutableGroupedArrayMaxReusableSectionContainers; index = [indexes indexGreaterThanIndex:index]) {
+        [self _keepSectionContainerForReuse:sectionContainers[index]];
+    }
+}
+
+/**
+ Moves the objects in the section container into chunked storage if the INTUGroupedArrayOptionChunkedSectionStorage option is set, or if
+ the section has grown past the threshold, unless they are stored in chunks already. Sections never move back to contiguous storage,
+ so that a section whose size hovers around the threshold is not converted back and forth.
+ Performance: O(1), or O(m) when the objects are moved, where m is the number of objects in the section
+ */
+- (void)_useChunkedStorageIfNeededForSectionContainer:(INTUMutableGroupedArraySectionContainer *)sectionContainer
+{
+    if (sectionContainer.usesChunkedStorage) {
+        return;
+    }
+    if ((self.options & INTUGroupedArrayOptionChunkedSectionStorage) || [sectionContainer countObjects] >= INTUMutableGroupedArrayChunkedStorageThreshold) {
+        [sectionContainer useChunkedStorage];
+    }
+}
+
+/**
+ Removes all instances of the object from the objects array of the section, and from the object index.
+ Performance: O(m), where m is the number of objects in the array
+ */
+- (void)_removeAllInstancesOfObject:(id)object fromObjectsArray:(NSMutableArray *)objectsArray inSection:(id)section
+{
+    NSUInteger objectCount = [objectsArray count];
+    [objectsArray removeObject:object];
+    for (NSUInteger removedCount = objectCount - [objectsArray count]; removedCount > 0; removedCount--) {
+        [self _removeObject:object fromObjectIndexInSection:section];
+    }
+}
+
+/**
+ Returns the index at which the object should be inserted into the objects array: at the end, or at its sorted position (after any objects
+ that compare the same) if the objects are kept sorted. During a batch of updates, objects are always added at the end, and the sections
+ are sorted once when the batch ends (see -[_sortUnsortedObjects]).
+ Performance: O(1) if the objects are not kept sorted or a batch of updates is in progress; otherwise O(log m), where m is the number of
+              objects in the array
+ */
+- (NSUInteger)_insertionIndexForObject:(id)object inObjectsArray:(NSArray *)objectsArray
+{
+    NSUInteger objectCount = [objectsArray count];
+    if (!_objectComparator) {
+        return objectCount;
+    }
+    if (_batchUpdateDepth > 0) {
+        _batchUpdatesLeftUnsortedObjects = YES;
+        return objectCount;
+    }
+    return [objectsArray indexOfObject:object inSortedRange:NSMakeRange(0, objectCount) options:NSBinarySearchingLastEqual | NSBinarySearchingInsertionIndex usingComparator:INTU_INSTRUMENT_COMPARATOR(_objectComparator)];
+}
+
+/**
+ Returns the section container at the index, first replacing it with a copy owned by this grouped array if it may be shared with another
+ grouped array (copy-on-write). This must be used to get any section container that is about to be modified. A section that has grown
+ past the chunked storage threshold is moved to chunked storage first, so any array of objects previously returned for the section
+ must not be used after calling this.
+ Performance: O(1) if the section container is already owned by this grouped array; otherwise O(m), where m is the number of objects in the section
+ 
+ @param index The index of the section container. Must be in bounds.
+ @return The section container at the index, which this grouped array may modify in place.
+ */
+- (INTUMutableGroupedArraySectionContainer *)_mutableSectionContainerAtIndex:(NSUInteger)index
+{
+    INTUGroupedArraySectionContainer *sectionContainer = self.sectionContainers[index];
+    if (sectionContainer.ownerID == _ownerID) {
+        [self _useChunkedStorageIfNeededForSectionContainer:(INTUMutableGroupedArraySectionContainer *)sectionContainer];
+        return (INTUMutableGroupedArraySectionContainer *)sectionContainer;
+    }
+    INTUMutableGroupedArraySectionContainer *ownedSectionContainer = [self _ownedCopyOfSectionContainer:sectionContainer];
+    self.mutableSectionContainers[index] = ownedSectionContainer;
+    return ownedSectionContainer;
+}
+
+/**
+ Returns a new section container owned by this grouped array with the same section and objects as the section container.
+ Performance: O(m), where m is the number of objects in the section
+ */
+- (INTUMutableGroupedArraySectionContainer *)_ownedCopyOfSectionContainer:(INTUGroupedArraySectionContainer *)sectionContainer
+{
+    INTUMutableGroupedArraySectionContainer *ownedSectionContainer = [INTUMutableGroupedArraySectionContainer sectionContainerWithSection:sectionContainer.section];
+    if ((self.options & INTUGroupedArrayOptionChunkedSectionStorage) || [sectionContainer countObjects] >= INTUMutableGroupedArrayChunkedStorageThreshold) {
+        // Copy the objects straight into chunked storage, instead of into a contiguous array first
+        ownedSectionContainer.mutableObjects = [[INTUGroupedArrayChunkedArray alloc] initWithArray:sectionContainer.objects];
+    } else {
+        ownedSectionContainer.mutableObjects = [sectionContainer.objects mutableCopy];
+    }
+    ownedSectionContainer.ownerID = _ownerID;
+    INTU_INSTRUMENT_COUNT(SectionContainersCopied, 1);
+    INTU_INSTRUMENT_COUNT(ObjectsCopied, [ownedSectionContainer.objects count]);
+    return ownedSectionContainer;
+}
+
+/**
+ A variant of -_mutableSectionContainerAtIndex: that is safe to call concurrently for different indices: instead of replacing a shared section
+ container right away, the copy is stored (retained) in the slot for the index in the copies array, to be installed afterwards by calling
+ -_installSectionContainerCopies:count:.
+ */
+- (INTUMutableGroupedArraySectionContainer *)_ownedSectionContainerForSectionContainer:(INTUGroupedArraySectionContainer *)sectionContainer atIndex:(NSUInteger)index copies:(void **)sectionContainerCopies
+{
+    if (sectionContainer.ownerID == _ownerID) {
+        return (INTUMutableGroupedArraySectionContainer *)sectionContainer;
+    }
+    INTUMutableGroupedArraySectionContainer *ownedSectionContainer = [self _ownedCopyOfSectionContainer:sectionContainer];
+    sectionContainerCopies[index] = (__bridge_retained void *)ownedSectionContainer;
+    return ownedSectionContainer;
+}
+
+/**
+ Replaces the section containers at each index that has a copy stored in the copies array (see -_ownedSectionContainerForSectionContainer:atIndex:copies:),
+ releasing the copies and freeing the copies array.
+ */
+- (void)_installSectionContainerCopies:(void **)sectionContainerCopies count:(NSUInteger)count
+{
+    for (NSUInteger index = 0; index < count; index++) {
+        if (sectionContainerCopies[index]) {
+            self.mutableSectionContainers[index] = (__bridge_transfer INTUMutableGroupedArraySectionContainer *)sectionContainerCopies[index];
+        }
+    }
+    free(sectionContainerCopies);
+}
+
 /**
  Returns the objects in the section, without copying the array. Passing an accurate hint for the section index
  will dramatically accelerate performance when there are a large number of sections, as it will avoid having to
- call -[self indexOfSection:] to find the section.
- Performance: O(1) assuming an accurate section index hint; otherwise O(n), where n is the number of sections
+ call -[self indexOfSection:] to find the section. The section container is copied first if it is shared (copy-on-write),
+ so the returned array may be modified.
+ Performance: O(1) assuming an accurate section index hint or the INTUGroupedArrayOptionHashedSectionIndex option is set;
+              otherwise O(n), where n is the number of sections
  
  @param section The section to get the objects of.
  @param sectionIndexHint An optional hint to the index of the section. (Pass NSNotFound to ignore the hint.)
@@ -679,18 +1625,20 @@
         id sectionAtHint = [self sectionAtIndex:sectionIndexHint];
         if ([sectionAtHint isEqual:section]) {
             // The hint worked!
-            INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[sectionIndexHint];
-            return sectionContainer.mutableObjects;
+            INTU_INSTRUMENT_COUNT(SectionIndexHintHits, 1);
+            return [self _mutableSectionContainerAtIndex:sectionIndexHint].mutableObjects;
         }
     }
+    if (sectionIndexHint != NSNotFound) {
+        INTU_INSTRUMENT_COUNT(SectionIndexHintMisses, 1);
+    }
     
     // Don't have a hint to use, or the hint was out of bounds, or the hint was wrong
     NSUInteger sectionIndex = [self indexOfSection:section];
     if (sectionIndex == NSNotFound) {
         return nil;
     } else {
-        INTUMutableGroupedArraySectionContainer *sectionContainer = self.sectionContainers[sectionIndex];
-        return sectionContainer.mutableObjects;
+        return [self _mutableSectionContainerAtIndex:sectionIndex].mutableObjects;
     }
 }
 
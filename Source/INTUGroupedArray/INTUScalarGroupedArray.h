@@ -0,0 +1,185 @@
+//
+//  INTUScalarGroupedArray.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+#import "INTUIndexPair.h"
+
+@class INTUGroupedArray;
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+
+#pragma mark - INTUScalarGroupedArray
+
+/**
+ The abstract base class of grouped arrays that store numeric values unboxed, instead of as objects: INTUDoubleGroupedArray and
+ INTUInt64GroupedArray. Sections are objects (as in INTUGroupedArray), while the values in each section are stored in a contiguous
+ buffer of the scalar type, so storing a value does not allocate an object, and accessing one does not send a message.
+ 
+ This class provides the methods that do not depend on the type of the values: accessing sections, counting values, converting
+ between flat indices and index pairs, and removing values & sections. Do not create instances of this class directly.
+ 
+ Like INTUGroupedArray, a scalar grouped array never has empty sections - removing the last value in a section removes the section.
+ Scalar grouped arrays are mutable, and are NOT thread safe. Sections are looked up using their hash, so they must implement -hash and
+ -isEqual: consistently, and the hash of a section must not change while the section is in the grouped array.
+ */
+@interface GA__INTU_GENERICS(INTUScalarGroupedArray, SectionType) : NSObject <NSCopying>
+
+/** Creates and returns a new empty scalar grouped array. */
+- (instancetype)init;
+
+#pragma mark Access Methods
+
+/** Returns the section at the index. */
+- (GA__INTU_GENERICS_TYPE(SectionType))sectionAtIndex:(NSUInteger)index;
+/** Returns the number of sections. */
+- (NSUInteger)countAllSections;
+/** Returns an array of all the sections. */
+- (GA__INTU_GENERICS(NSArray, SectionType) *)allSections;
+/** Returns whether the section exists. */
+- (BOOL)containsSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Returns the index for the section. */
+- (NSUInteger)indexOfSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+/** Returns the number of values in the section. */
+- (NSUInteger)countValuesInSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Returns the number of values in the section at the index. */
+- (NSUInteger)countValuesInSectionAtIndex:(NSUInteger)index;
+/** Returns the total number of values in all sections. */
+- (NSUInteger)countAllValues;
+
+/** Returns the index pair of the value at the flat index, which counts values across all sections in order. */
+- (INTUIndexPair)indexPairForFlatIndex:(NSUInteger)flatIndex;
+/** Returns the flat index of the value at the index pair. */
+- (NSUInteger)flatIndexForIndexPair:(INTUIndexPair)indexPair;
+
+#pragma mark Mutation Methods
+
+/** Removes the section at the index, along with all of its values. */
+- (void)removeSectionAtIndex:(NSUInteger)index;
+/** Removes the section, along with all of its values. */
+- (void)removeSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Removes the value at the index pair. The section is removed if it has no more values. */
+- (void)removeValueAtIndexPair:(INTUIndexPair)indexPair;
+/** Removes all sections & values. */
+- (void)removeAllValues;
+
+@end
+
+
+#pragma mark - INTUDoubleGroupedArray
+
+/**
+ A grouped array of double values, stored unboxed in a contiguous buffer for each section. The sums, minimums and maximums of the values
+ are computed several values at a time using SIMD instructions.
+ */
+@interface GA__INTU_GENERICS(INTUDoubleGroupedArray, SectionType) : INTUScalarGroupedArray
+
+/** Creates and returns a new grouped array with the -doubleValue of each object in the grouped array, which must all be NSNumbers. */
++ (instancetype)groupedArrayWithGroupedArray:(INTUGroupedArray *)groupedArray;
+/** Returns a new immutable grouped array with each value boxed in an NSNumber. */
+- (INTUGroupedArray *)boxedGroupedArray;
+
+/** Returns the value at the index pair. */
+- (double)valueAtIndexPair:(INTUIndexPair)indexPair;
+/** Returns the buffer of values in the section at the index, which remains valid until the grouped array is mutated. */
+- (const double *)valuesInSectionAtIndex:(NSUInteger)index;
+
+/** Adds the value to the end of the section, adding the section to the end of the grouped array if it does not exist. */
+- (void)addValue:(double)value toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Adds the values in the buffer to the end of the section, adding the section to the end of the grouped array if it does not exist. */
+- (void)addValues:(const double *)values count:(NSUInteger)count toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Replaces the value at the index pair. */
+- (void)replaceValueAtIndexPair:(INTUIndexPair)indexPair withValue:(double)value;
+
+/** Executes the block for each value in the grouped array. */
+- (void)enumerateValuesUsingBlock:(void (^)(double value, INTUIndexPair indexPair, BOOL *stop))block;
+/** Executes the block for each value in the grouped array with the specified enumeration options. */
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(double value, INTUIndexPair indexPair, BOOL *stop))block;
+
+/** Returns the sum of the values in the section at the index. */
+- (double)sumOfValuesInSectionAtIndex:(NSUInteger)index;
+/** Returns the smallest value in the section at the index. */
+- (double)minimumValueInSectionAtIndex:(NSUInteger)index;
+/** Returns the largest value in the section at the index. */
+- (double)maximumValueInSectionAtIndex:(NSUInteger)index;
+/** Returns the sum of all values, or 0 if there are none. */
+- (double)sumOfAllValues;
+/** Returns the smallest of all values, or +INFINITY if there are none. */
+- (double)minimumOfAllValues;
+/** Returns the largest of all values, or -INFINITY if there are none. */
+- (double)maximumOfAllValues;
+
+@end
+
+
+#pragma mark - INTUInt64GroupedArray
+
+/**
+ A grouped array of int64_t values, stored unboxed in a contiguous buffer for each section. The sums, minimums and maximums of the values
+ are computed several values at a time using SIMD instructions. Sums wrap around on overflow.
+ */
+@interface GA__INTU_GENERICS(INTUInt64GroupedArray, SectionType) : INTUScalarGroupedArray
+
+/** Creates and returns a new grouped array with the -longLongValue of each object in the grouped array, which must all be NSNumbers. */
++ (instancetype)groupedArrayWithGroupedArray:(INTUGroupedArray *)groupedArray;
+/** Returns a new immutable grouped array with each value boxed in an NSNumber. */
+- (INTUGroupedArray *)boxedGroupedArray;
+
+/** Returns the value at the index pair. */
+- (int64_t)valueAtIndexPair:(INTUIndexPair)indexPair;
+/** Returns the buffer of values in the section at the index, which remains valid until the grouped array is mutated. */
+- (const int64_t *)valuesInSectionAtIndex:(NSUInteger)index;
+
+/** Adds the value to the end of the section, adding the section to the end of the grouped array if it does not exist. */
+- (void)addValue:(int64_t)value toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Adds the values in the buffer to the end of the section, adding the section to the end of the grouped array if it does not exist. */
+- (void)addValues:(const int64_t *)values count:(NSUInteger)count toSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+/** Replaces the value at the index pair. */
+- (void)replaceValueAtIndexPair:(INTUIndexPair)indexPair withValue:(int64_t)value;
+
+/** Executes the block for each value in the grouped array. */
+- (void)enumerateValuesUsingBlock:(void (^)(int64_t value, INTUIndexPair indexPair, BOOL *stop))block;
+/** Executes the block for each value in the grouped array with the specified enumeration options. */
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(int64_t value, INTUIndexPair indexPair, BOOL *stop))block;
+
+/** Returns the sum of the values in the section at the index. */
+- (int64_t)sumOfValuesInSectionAtIndex:(NSUInteger)index;
+/** Returns the smallest value in the section at the index. */
+- (int64_t)minimumValueInSectionAtIndex:(NSUInteger)index;
+/** Returns the largest value in the section at the index. */
+- (int64_t)maximumValueInSectionAtIndex:(NSUInteger)index;
+/** Returns the sum of all values, or 0 if there are none. */
+- (int64_t)sumOfAllValues;
+/** Returns the smallest of all values, or INT64_MAX if there are none. */
+- (int64_t)minimumOfAllValues;
+/** Returns the largest of all values, or INT64_MIN if there are none. */
+- (int64_t)maximumOfAllValues;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
@@ -0,0 +1,1074 @@
+//
+//  INTUScalarGroupedArray.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUScalarGroupedArray.h"
+#import "INTUGroupedArray.h"
+#import "INTUGroupedArrayBuilder.h"
+#import "INTUGroupedArrayInternal.h"
+
+// The values are stored as raw 8 byte slots by the base class, which the subclasses read & write as doubles or int64_ts
+_Static_assert(sizeof(double) == sizeof(int64_t), "Doubles and int64_ts must be the same size.");
+static const size_t kINTUScalarValueSize = sizeof(int64_t);
+
+// The reductions process this many values at a time. Clang vector extensions compile to the SIMD instructions of the target architecture
+// (e.g. SSE/AVX or NEON), and to scalar instructions where there are none.
+#define INTU_SCALAR_VECTOR_LENGTH 4
+typedef double INTUDoubleVector __attribute__((ext_vector_type(INTU_SCALAR_VECTOR_LENGTH)));
+typedef int64_t INTUInt64Vector __attribute__((ext_vector_type(INTU_SCALAR_VECTOR_LENGTH)));
+typedef uint64_t INTUUInt64Vector __attribute__((ext_vector_type(INTU_SCALAR_VECTOR_LENGTH)));
+
+/** The values in one section. */
+typedef struct {
+    /** The buffer of values, each of which is kINTUScalarValueSize bytes. */
+    void *values;
+    /** The number of values in the buffer. */
+    NSUInteger count;
+    /** The number of values that fit in the buffer. */
+    NSUInteger capacity;
+} INTUScalarSectionBuffer;
+
+#pragma mark - INTUScalarGroupedArray
+
+@interface INTUScalarGroupedArray ()
+{
+@private
+    /** The sections, in order. */
+    NSMutableArray *_sections;
+    /** The buffer of values for each section, in the same order as _sections. */
+    INTUScalarSectionBuffer *_sectionBuffers;
+    /** The number of section buffers that fit in _sectionBuffers. */
+    NSUInteger _sectionBuffersCapacity;
+    /** A map from each section to its index in _sections. Values are stored as index + 1, since NULL means that there is no value. */
+    CFMutableDictionaryRef _sectionIndexes;
+    /** The total number of values in all sections. */
+    NSUInteger _valueCount;
+    /** A token that is incremented on every mutation. */
+    unsigned long _mutations;
+    /** The table of cumulative value counts, with one more entry than there are sections. Rebuilt on demand after a mutation. */
+    NSUInteger *_sectionOffsets;
+    /** The value of _mutations when _sectionOffsets was last rebuilt. */
+    unsigned long _sectionOffsetsMutations;
+}
+
+/** Returns the buffer of values for the section at the index, or NULL if the index is out of bounds. */
+- (const INTUScalarSectionBuffer *)_sectionBufferAtIndex:(NSUInteger)index;
+/** Returns the slot of the value at the index pair, or NULL if the index pair is out of bounds. */
+- (void *)_valueSlotAtIndexPair:(INTUIndexPair)indexPair;
+/** Appends the number of uninitialized slots to the section (adding the section if it does not exist), and returns the first new slot. */
+- (void *)_appendValueSlots:(NSUInteger)count toSection:(id)section;
+/** Executes the block with the slot of each value in the grouped array with the specified enumeration options. */
+- (void)_enumerateValueSlotsWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(const void *valueSlot, INTUIndexPair indexPair, BOOL *stop))block;
+
+@end
+
+@implementation INTUScalarGroupedArray
+
+/**
+ Creates and returns a new empty scalar grouped array.
+ */
+- (instancetype)init
+{
+    NSAssert([self class] != [INTUScalarGroupedArray class], @"INTUScalarGroupedArray is an abstract class; use INTUDoubleGroupedArray or INTUInt64GroupedArray.");
+    self = [super init];
+    if (self) {
+        _sections = [NSMutableArray array];
+        _sectionIndexes = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    NSUInteger sectionCount = [_sections count];
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        free(_sectionBuffers[i].values);
+    }
+    free(_sectionBuffers);
+    free(_sectionOffsets);
+    if (_sectionIndexes) {
+        CFRelease(_sectionIndexes);
+    }
+}
+
+/**
+ Returns a copy of this grouped array, with its own copy of the values in each section.
+ The sections are not copied.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (id)copyWithZone:(NSZone *)zone
+{
+    INTUScalarGroupedArray *copy = [[[self class] allocWithZone:zone] init];
+    NSUInteger sectionCount = [_sections count];
+    INTUScalarSectionBuffer *sectionBuffers = malloc(MAX(sectionCount, (NSUInteger)1) * sizeof(INTUScalarSectionBuffer));
+    if (!sectionBuffers) {
+        [NSException raise:NSMallocException format:@"Failed to allocate the section buffers for <%@: %p>.", NSStringFromClass([copy class]), copy];
+    }
+    copy->_sectionBuffers = sectionBuffers;
+    copy->_sectionBuffersCapacity = MAX(sectionCount, (NSUInteger)1);
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        NSUInteger count = _sectionBuffers[i].count;
+        void *values = malloc(count * kINTUScalarValueSize);
+        if (!values) {
+            [NSException raise:NSMallocException format:@"Failed to allocate %lu values for <%@: %p>.", (unsigned long)count, NSStringFromClass([copy class]), copy];
+        }
+        memcpy(values, _sectionBuffers[i].values, count * kINTUScalarValueSize);
+        sectionBuffers[i] = (INTUScalarSectionBuffer){ .values = values, .count = count, .capacity = count };
+        // Add each section as soon as its buffer is filled in, so that the copy frees the buffers if an allocation fails
+        [copy->_sections addObject:_sections[i]];
+        CFDictionarySetValue(copy->_sectionIndexes, (__bridge const void *)_sections[i], (const void *)(i + 1));
+    }
+    copy->_valueCount = _valueCount;
+    return copy;
+}
+
+#pragma mark Access Methods
+
+/**
+ Returns the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(1)
+ 
+ @param index The index of the section.
+ @return The section at the index, or nil if the index is out of bounds.
+ */
+- (id)sectionAtIndex:(NSUInteger)index
+{
+    if (index >= [_sections count]) {
+        NSAssert(index < [_sections count], @"Index out of bounds!");
+        return nil;
+    }
+    return _sections[index];
+}
+
+/**
+ Returns the number of sections.
+ Performance: O(1)
+ */
+- (NSUInteger)countAllSections
+{
+    return [_sections count];
+}
+
+/**
+ Returns an array of all the sections.
+ Performance: O(n), where n is the number of sections
+ */
+- (NSArray *)allSections
+{
+    return [_sections copy];
+}
+
+/**
+ Returns whether the section exists.
+ Performance: O(1)
+ */
+- (BOOL)containsSection:(id)section
+{
+    return [self indexOfSection:section] != NSNotFound;
+}
+
+/**
+ Returns the index for the section, using the section's hash.
+ Performance: O(1)
+ 
+ @param section The section to find the index of.
+ @return The index of the section, or NSNotFound if the section does not exist.
+ */
+- (NSUInteger)indexOfSection:(id)section
+{
+    if (!section) {
+        NSAssert(section, @"Section should not be nil.");
+        return NSNotFound;
+    }
+    NSUInteger sectionIndex = (NSUInteger)CFDictionaryGetValue(_sectionIndexes, (__bridge const void *)section);
+    return (sectionIndex > 0) ? sectionIndex - 1 : NSNotFound;
+}
+
+/**
+ Returns the number of values in the section.
+ Performance: O(1)
+ */
+- (NSUInteger)countValuesInSection:(id)section
+{
+    NSUInteger sectionIndex = [self indexOfSection:section];
+    return (sectionIndex != NSNotFound) ? _sectionBuffers[sectionIndex].count : 0;
+}
+
+/**
+ Returns the number of values in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(1)
+ */
+- (NSUInteger)countValuesInSectionAtIndex:(NSUInteger)index
+{
+    const INTUScalarSectionBuffer *sectionBuffer = [self _sectionBufferAtIndex:index];
+    return sectionBuffer ? sectionBuffer->count : 0;
+}
+
+/**
+ Returns the total number of values in all sections.
+ Performance: O(1)
+ */
+- (NSUInteger)countAllValues
+{
+    return _valueCount;
+}
+
+/**
+ Returns the table of cumulative value counts, first rebuilding it if the grouped array has been mutated since it was last built.
+ Performance: O(1), except for the first call after the grouped array is mutated, which is O(n), where n is the number of sections
+ */
+- (const NSUInteger *)_sectionOffsetTable
+{
+    if (_sectionOffsets && _sectionOffsetsMutations == _mutations) {
+        return _sectionOffsets;
+    }
+    NSUInteger sectionCount = [_sections count];
+    NSUInteger *sectionOffsets = realloc(_sectionOffsets, (sectionCount + 1) * sizeof(NSUInteger));
+    if (!sectionOffsets) {
+        [NSException raise:NSMallocException format:@"Failed to allocate the section offsets for <%@: %p>.", NSStringFromClass([self class]), self];
+    }
+    NSUInteger offset = 0;
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        sectionOffsets[i] = offset;
+        offset += _sectionBuffers[i].count;
+    }
+    sectionOffsets[sectionCount] = offset;
+    _sectionOffsets = sectionOffsets;
+    _sectionOffsetsMutations = _mutations;
+    return sectionOffsets;
+}
+
+/**
+ Returns the index pair of the value at the flat index, which counts values across all sections in order.
+ An exception will be raised if the flat index is out of bounds.
+ Performance: O(log n), where n is the number of sections
+ 
+ @param flatIndex The flat index of the value.
+ @return The index pair of the value at the flat index, or an index pair with both indices set to NSNotFound if the flat index is out of bounds.
+ */
+- (INTUIndexPair)indexPairForFlatIndex:(NSUInteger)flatIndex
+{
+    if (flatIndex >= _valueCount) {
+        NSAssert(flatIndex < _valueCount, @"Index out of bounds!");
+        return INTUIndexPairMake(NSNotFound, NSNotFound);
+    }
+    // Binary search for the last section that starts at or before the flat index
+    const NSUInteger *sectionOffsets = [self _sectionOffsetTable];
+    NSUInteger low = 0;
+    NSUInteger high = [_sections count];
+    while (high - low > 1) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (sectionOffsets[mid] <= flatIndex) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return INTUIndexPairMake(low, flatIndex - sectionOffsets[low]);
+}
+
+/**
+ Returns the flat index of the value at the index pair, which counts values across all sections in order.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(1), except for the first call after the grouped array is mutated, which is O(n), where n is the number of sections
+ 
+ @param indexPair The index pair of the value.
+ @return The flat index of the value at the index pair, or NSNotFound if the index pair is out of bounds.
+ */
+- (NSUInteger)flatIndexForIndexPair:(INTUIndexPair)indexPair
+{
+    if (![self _valueSlotAtIndexPair:indexPair]) {
+        return NSNotFound;
+    }
+    return [self _sectionOffsetTable][indexPair.sectionIndex] + indexPair.objectIndex;
+}
+
+/**
+ Returns the buffer of values for the section at the index.
+ An exception will be raised if the index is out of bounds.
+ */
+- (const INTUScalarSectionBuffer *)_sectionBufferAtIndex:(NSUInteger)index
+{
+    if (index >= [_sections count]) {
+        NSAssert(index < [_sections count], @"Index out of bounds!");
+        return NULL;
+    }
+    return &_sectionBuffers[index];
+}
+
+/**
+ Returns the slot of the value at the index pair.
+ An exception will be raised if the index pair is out of bounds.
+ */
+- (void *)_valueSlotAtIndexPair:(INTUIndexPair)indexPair
+{
+    if (indexPair.sectionIndex >= [_sections count]) {
+        NSAssert(indexPair.sectionIndex < [_sections count], @"Section index out of bounds!");
+        return NULL;
+    }
+    INTUScalarSectionBuffer *sectionBuffer = &_sectionBuffers[indexPair.sectionIndex];
+    if (indexPair.objectIndex >= sectionBuffer->count) {
+        NSAssert(indexPair.objectIndex < sectionBuffer->count, @"Value index out of bounds!");
+        return NULL;
+    }
+    return (char *)sectionBuffer->values + indexPair.objectIndex * kINTUScalarValueSize;
+}
+
+#pragma mark Mutation Methods
+
+/**
+ Appends the number of uninitialized slots to the end of the section, adding the section to the end of the grouped array if it does not
+ exist, and returns the first new slot. The caller must fill in every new slot. The buffer of values grows geometrically.
+ Performance: O(1) amortized per value
+ 
+ @param count The number of slots to append, which must be at least 1.
+ @param section The section to append the slots to.
+ @return The first new slot, or NULL if the section is nil.
+ */
+- (void *)_appendValueSlots:(NSUInteger)count toSection:(id)section
+{
+    if (!section) {
+        NSAssert(section, @"Section should not be nil.");
+        return NULL;
+    }
+    NSUInteger sectionIndex = [self indexOfSection:section];
+    if (sectionIndex == NSNotFound) {
+        sectionIndex = [_sections count];
+        if (sectionIndex == _sectionBuffersCapacity) {
+            NSUInteger sectionBuffersCapacity = MAX(_sectionBuffersCapacity * 2, (NSUInteger)4);
+            INTUScalarSectionBuffer *sectionBuffers = realloc(_sectionBuffers, sectionBuffersCapacity * sizeof(INTUScalarSectionBuffer));
+            if (!sectionBuffers) {
+                [NSException raise:NSMallocException format:@"Failed to allocate the section buffers for <%@: %p>.", NSStringFromClass([self class]), self];
+            }
+            _sectionBuffers = sectionBuffers;
+            _sectionBuffersCapacity = sectionBuffersCapacity;
+        }
+        _sectionBuffers[sectionIndex] = (INTUScalarSectionBuffer){ .values = NULL, .count = 0, .capacity = 0 };
+        [_sections addObject:section];
+        CFDictionarySetValue(_sectionIndexes, (__bridge const void *)section, (const void *)(sectionIndex + 1));
+    }
+    
+    INTUScalarSectionBuffer *sectionBuffer = &_sectionBuffers[sectionIndex];
+    if (sectionBuffer->count + count > sectionBuffer->capacity) {
+        NSUInteger capacity = MAX(MAX(sectionBuffer->capacity * 2, sectionBuffer->count + count), (NSUInteger)8);
+        void *values = realloc(sectionBuffer->values, capacity * kINTUScalarValueSize);
+        if (!values) {
+            [NSException raise:NSMallocException format:@"Failed to allocate %lu values for <%@: %p>.", (unsigned long)capacity, NSStringFromClass([self class]), self];
+        }
+        sectionBuffer->values = values;
+        sectionBuffer->capacity = capacity;
+    }
+    void *firstSlot = (char *)sectionBuffer->values + sectionBuffer->count * kINTUScalarValueSize;
+    sectionBuffer->count += count;
+    _valueCount += count;
+    _mutations++;
+    return firstSlot;
+}
+
+/**
+ Removes the section at the index, along with all of its values.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)removeSectionAtIndex:(NSUInteger)index
+{
+    NSUInteger sectionCount = [_sections count];
+    if (index >= sectionCount) {
+        NSAssert(index < sectionCount, @"Index out of bounds!");
+        return;
+    }
+    _valueCount -= _sectionBuffers[index].count;
+    free(_sectionBuffers[index].values);
+    memmove(&_sectionBuffers[index], &_sectionBuffers[index + 1], (sectionCount - index - 1) * sizeof(INTUScalarSectionBuffer));
+    CFDictionaryRemoveValue(_sectionIndexes, (__bridge const void *)_sections[index]);
+    [_sections removeObjectAtIndex:index];
+    // The sections after the removed one each move down by one index
+    for (NSUInteger i = index; i < sectionCount - 1; i++) {
+        CFDictionarySetValue(_sectionIndexes, (__bridge const void *)_sections[i], (const void *)(i + 1));
+    }
+    _mutations++;
+}
+
+/**
+ Removes the section, along with all of its values. Does nothing if the section does not exist.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)removeSection:(id)section
+{
+    NSUInteger sectionIndex = [self indexOfSection:section];
+    if (sectionIndex != NSNotFound) {
+        [self removeSectionAtIndex:sectionIndex];
+    }
+}
+
+/**
+ Removes the value at the index pair. The section is removed if it has no more values.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(m), where m is the number of values in the section (O(n) if the section is removed, where n is the number of sections)
+ */
+- (void)removeValueAtIndexPair:(INTUIndexPair)indexPair
+{
+    void *valueSlot = [self _valueSlotAtIndexPair:indexPair];
+    if (!valueSlot) {
+        return;
+    }
+    INTUScalarSectionBuffer *sectionBuffer = &_sectionBuffers[indexPair.sectionIndex];
+    if (sectionBuffer->count == 1) {
+        [self removeSectionAtIndex:indexPair.sectionIndex];
+        return;
+    }
+    memmove(valueSlot, (char *)valueSlot + kINTUScalarValueSize, (sectionBuffer->count - indexPair.objectIndex - 1) * kINTUScalarValueSize);
+    sectionBuffer->count--;
+    _valueCount--;
+    _mutations++;
+}
+
+/**
+ Removes all sections & values.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)removeAllValues
+{
+    NSUInteger sectionCount = [_sections count];
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        free(_sectionBuffers[i].values);
+    }
+    [_sections removeAllObjects];
+    CFDictionaryRemoveAllValues(_sectionIndexes);
+    _valueCount = 0;
+    _mutations++;
+}
+
+#pragma mark Enumeration Methods
+
+/**
+ Executes the block with the slot of each value in the grouped array with the specified enumeration options. When the
+ NSEnumerationConcurrent option is set, the values are treated as one flat range which is split into chunks, so the work is balanced
+ across workers regardless of how values are distributed between sections.
+ */
+- (void)_enumerateValueSlotsWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(const void *valueSlot, INTUIndexPair indexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    BOOL reverse = (options & NSEnumerationReverse);
+    unsigned long mutationValue = _mutations;
+    NSUInteger sectionCount = [_sections count];
+    
+    if (options & NSEnumerationConcurrent) {
+        const NSUInteger *sectionOffsets = [self _sectionOffsetTable];
+        __block volatile BOOL mutated = NO;
+        [INTUGroupedArray _concurrentlyEnumerateChunksOfCount:_valueCount reverse:reverse usingBlock:^(NSRange chunkRange, volatile BOOL *stop) {
+            INTUIndexPair indexPair = [self indexPairForFlatIndex:chunkRange.location];
+            NSUInteger sectionIndex = indexPair.sectionIndex;
+            for (NSUInteger flatIndex = chunkRange.location; flatIndex < NSMaxRange(chunkRange); flatIndex++) {
+                if (*stop) {
+                    return;
+                }
+                if (mutationValue != _mutations) {
+                    mutated = YES;
+                    *stop = YES;
+                    return;
+                }
+                while (flatIndex >= sectionOffsets[sectionIndex + 1]) {
+                    sectionIndex++;
+                }
+                NSUInteger valueIndex = flatIndex - sectionOffsets[sectionIndex];
+                BOOL valueStop = NO;
+                block((const char *)_sectionBuffers[sectionIndex].values + valueIndex * kINTUScalarValueSize, INTUIndexPairMake(sectionIndex, valueIndex), &valueStop);
+                if (valueStop) {
+                    *stop = YES;
+                    return;
+                }
+            }
+        }];
+        NSAssert(!mutated, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
+        return;
+    }
+    
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        NSUInteger sectionIndex = reverse ? sectionCount - 1 - i : i;
+        NSUInteger valueCount = _sectionBuffers[sectionIndex].count;
+        for (NSUInteger j = 0; j < valueCount; j++) {
+            if (mutationValue != _mutations) {
+                NSAssert(mutationValue == _mutations, @"Collection <%@: %p> was mutated while being enumerated.", NSStringFromClass([self class]), self);
+                return;
+            }
+            NSUInteger valueIndex = reverse ? valueCount - 1 - j : j;
+            BOOL stop = NO;
+            block((const char *)_sectionBuffers[sectionIndex].values + valueIndex * kINTUScalarValueSize, INTUIndexPairMake(sectionIndex, valueIndex), &stop);
+            if (stop) {
+                return;
+            }
+        }
+    }
+}
+
+@end
+
+#pragma mark - Vectorized Reductions
+
+/**
+ Returns the sum of the doubles, adding INTU_SCALAR_VECTOR_LENGTH values at a time into separate partial sums.
+ Since the values are added in a different order than a simple loop would, the result may differ from one in the last bits.
+ */
+static double INTUSumOfDoubles(const double *values, NSUInteger count)
+{
+    INTUDoubleVector sums = 0.0;
+    NSUInteger i = 0;
+    for (; i + INTU_SCALAR_VECTOR_LENGTH <= count; i += INTU_SCALAR_VECTOR_LENGTH) {
+        INTUDoubleVector vector;
+        memcpy(&vector, values + i, sizeof(vector));
+        sums += vector;
+    }
+    double sum = 0.0;
+    for (NSUInteger lane = 0; lane < INTU_SCALAR_VECTOR_LENGTH; lane++) {
+        sum += sums[lane];
+    }
+    for (; i < count; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+/**
+ Returns the smallest (or largest, if maximum is YES) of the doubles, comparing INTU_SCALAR_VECTOR_LENGTH values at a time.
+ Returns +INFINITY (or -INFINITY) if there are no values. The result is undefined if any of the values is NaN.
+ */
+static double INTUExtremeOfDoubles(const double *values, NSUInteger count, BOOL maximum)
+{
+    double extreme = maximum ? -INFINITY : INFINITY;
+    INTUDoubleVector extremes = extreme;
+    NSUInteger i = 0;
+    for (; i + INTU_SCALAR_VECTOR_LENGTH <= count; i += INTU_SCALAR_VECTOR_LENGTH) {
+        INTUDoubleVector vector;
+        memcpy(&vector, values + i, sizeof(vector));
+        // Comparing vectors produces a mask with all bits set in each lane where the comparison is true, which selects between the lanes
+        __typeof__(vector < extremes) mask = maximum ? (vector > extremes) : (vector < extremes);
+        extremes = (INTUDoubleVector)((mask & (__typeof__(mask))vector) | (~mask & (__typeof__(mask))extremes));
+    }
+    for (NSUInteger lane = 0; lane < INTU_SCALAR_VECTOR_LENGTH; lane++) {
+        extreme = maximum ? MAX(extreme, extremes[lane]) : MIN(extreme, extremes[lane]);
+    }
+    for (; i < count; i++) {
+        extreme = maximum ? MAX(extreme, values[i]) : MIN(extreme, values[i]);
+    }
+    return extreme;
+}
+
+/**
+ Returns the sum of the int64_ts, adding INTU_SCALAR_VECTOR_LENGTH values at a time into separate partial sums. The sum wraps around on overflow.
+ */
+static int64_t INTUSumOfInt64s(const int64_t *values, NSUInteger count)
+{
+    // Add as unsigned integers, whose overflow wraps around instead of being undefined
+    INTUUInt64Vector sums = 0;
+    NSUInteger i = 0;
+    for (; i + INTU_SCALAR_VECTOR_LENGTH <= count; i += INTU_SCALAR_VECTOR_LENGTH) {
+        INTUUInt64Vector vector;
+        memcpy(&vector, values + i, sizeof(vector));
+        sums += vector;
+    }
+    uint64_t sum = 0;
+    for (NSUInteger lane = 0; lane < INTU_SCALAR_VECTOR_LENGTH; lane++) {
+        sum += sums[lane];
+    }
+    for (; i < count; i++) {
+        sum += (uint64_t)values[i];
+    }
+    return (int64_t)sum;
+}
+
+/**
+ Returns the smallest (or largest, if maximum is YES) of the int64_ts, comparing INTU_SCALAR_VECTOR_LENGTH values at a time.
+ Returns INT64_MAX (or INT64_MIN) if there are no values.
+ */
+static int64_t INTUExtremeOfInt64s(const int64_t *values, NSUInteger count, BOOL maximum)
+{
+    int64_t extreme = maximum ? INT64_MIN : INT64_MAX;
+    INTUInt64Vector extremes = extreme;
+    NSUInteger i = 0;
+    for (; i + INTU_SCALAR_VECTOR_LENGTH <= count; i += INTU_SCALAR_VECTOR_LENGTH) {
+        INTUInt64Vector vector;
+        memcpy(&vector, values + i, sizeof(vector));
+        __typeof__(vector < extremes) mask = maximum ? (vector > extremes) : (vector < extremes);
+        extremes = (INTUInt64Vector)((mask & (__typeof__(mask))vector) | (~mask & (__typeof__(mask))extremes));
+    }
+    for (NSUInteger lane = 0; lane < INTU_SCALAR_VECTOR_LENGTH; lane++) {
+        extreme = maximum ? MAX(extreme, extremes[lane]) : MIN(extreme, extremes[lane]);
+    }
+    for (; i < count; i++) {
+        extreme = maximum ? MAX(extreme, values[i]) : MIN(extreme, values[i]);
+    }
+    return extreme;
+}
+
+#pragma mark - INTUDoubleGroupedArray
+
+@implementation INTUDoubleGroupedArray
+
+/**
+ Creates and returns a new grouped array with the -doubleValue of each object in the grouped array, which must all be NSNumbers.
+ Performance: O(n), where n is the total number of objects in all sections
+ 
+ @param groupedArray A grouped array of NSNumbers.
+ @return A new grouped array with the same sections, and the unboxed value of each object.
+ */
++ (instancetype)groupedArrayWithGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    INTUDoubleGroupedArray *doubleGroupedArray = [self new];
+    NSUInteger sectionCount = [groupedArray countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        NSArray *objects = [groupedArray objectsViewInSectionAtIndex:sectionIndex];
+        NSUInteger objectCount = [objects count];
+        double *values = [doubleGroupedArray _appendValueSlots:objectCount toSection:[groupedArray sectionAtIndex:sectionIndex]];
+        for (NSUInteger objectIndex = 0; objectIndex < objectCount; objectIndex++) {
+            values[objectIndex] = [objects[objectIndex] doubleValue];
+        }
+    }
+    return doubleGroupedArray;
+}
+
+/**
+ Returns a new immutable grouped array with the same sections, and each value boxed in an NSNumber.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (INTUGroupedArray *)boxedGroupedArray
+{
+    INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        const double *values = [self valuesInSectionAtIndex:sectionIndex];
+        NSUInteger valueCount = [self countValuesInSectionAtIndex:sectionIndex];
+        NSMutableArray *objects = [NSMutableArray arrayWithCapacity:valueCount];
+        for (NSUInteger valueIndex = 0; valueIndex < valueCount; valueIndex++) {
+            [objects addObject:@(values[valueIndex])];
+        }
+        [builder addObjectsFromArray:objects toSection:[self sectionAtIndex:sectionIndex]];
+    }
+    return [builder build];
+}
+
+/**
+ Returns the value at the index pair.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(1)
+ 
+ @param indexPair The index pair of the value.
+ @return The value at the index pair, or 0 if the index pair is out of bounds.
+ */
+- (double)valueAtIndexPair:(INTUIndexPair)indexPair
+{
+    const double *valueSlot = [self _valueSlotAtIndexPair:indexPair];
+    return valueSlot ? *valueSlot : 0.0;
+}
+
+/**
+ Returns the buffer of values in the section at the index, which remains valid until the grouped array is mutated.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(1)
+ 
+ @param index The index of the section.
+ @return The buffer of values, which has -countValuesInSectionAtIndex: entries, or NULL if the index is out of bounds.
+ */
+- (const double *)valuesInSectionAtIndex:(NSUInteger)index
+{
+    const INTUScalarSectionBuffer *sectionBuffer = [self _sectionBufferAtIndex:index];
+    return sectionBuffer ? sectionBuffer->values : NULL;
+}
+
+/**
+ Adds the value to the end of the section, adding the section to the end of the grouped array if it does not exist.
+ Performance: O(1) amortized
+ */
+- (void)addValue:(double)value toSection:(id)section
+{
+    [self addValues:&value count:1 toSection:section];
+}
+
+/**
+ Adds the values in the buffer to the end of the section, adding the section to the end of the grouped array if it does not exist.
+ Performance: O(n), where n is the number of values added
+ 
+ @param values A buffer of values.
+ @param count The number of values in the buffer. Does nothing if this is 0.
+ @param section The section to add the values to.
+ */
+- (void)addValues:(const double *)values count:(NSUInteger)count toSection:(id)section
+{
+    if (count == 0) {
+        return;
+    }
+    double *valueSlots = [self _appendValueSlots:count toSection:section];
+    if (valueSlots) {
+        memcpy(valueSlots, values, count * sizeof(double));
+    }
+}
+
+/**
+ Replaces the value at the index pair.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(1)
+ */
+- (void)replaceValueAtIndexPair:(INTUIndexPair)indexPair withValue:(double)value
+{
+    double *valueSlot = [self _valueSlotAtIndexPair:indexPair];
+    if (valueSlot) {
+        *valueSlot = value;
+    }
+}
+
+/**
+ Executes the block for each value in the grouped array.
+ 
+ @param block A block taking three parameters:
+                double value: The value
+                INTUIndexPair indexPair: The index pair of the value
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ */
+- (void)enumerateValuesUsingBlock:(void (^)(double value, INTUIndexPair indexPair, BOOL *stop))block
+{
+    [self enumerateValuesWithOptions:0 usingBlock:block];
+}
+
+/**
+ Executes the block for each value in the grouped array with the specified enumeration options.
+ 
+ @param options A bitmask of NSEnumerationOptions (NSEnumerationConcurrent and/or NSEnumerationReverse).
+ @param block A block taking three parameters:
+                double value: The value
+                INTUIndexPair indexPair: The index pair of the value
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ */
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(double value, INTUIndexPair indexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    [self _enumerateValueSlotsWithOptions:options usingBlock:^(const void *valueSlot, INTUIndexPair indexPair, BOOL *stop) {
+        block(*(const double *)valueSlot, indexPair, stop);
+    }];
+}
+
+/**
+ Returns the sum of the values in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(m), where m is the number of values in the section
+ */
+- (double)sumOfValuesInSectionAtIndex:(NSUInteger)index
+{
+    return INTUSumOfDoubles([self valuesInSectionAtIndex:index], [self countValuesInSectionAtIndex:index]);
+}
+
+/**
+ Returns the smallest value in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(m), where m is the number of values in the section
+ */
+- (double)minimumValueInSectionAtIndex:(NSUInteger)index
+{
+    return INTUExtremeOfDoubles([self valuesInSectionAtIndex:index], [self countValuesInSectionAtIndex:index], NO);
+}
+
+/**
+ Returns the largest value in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(m), where m is the number of values in the section
+ */
+- (double)maximumValueInSectionAtIndex:(NSUInteger)index
+{
+    return INTUExtremeOfDoubles([self valuesInSectionAtIndex:index], [self countValuesInSectionAtIndex:index], YES);
+}
+
+/**
+ Returns the sum of all values, or 0 if there are none.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (double)sumOfAllValues
+{
+    double sum = 0.0;
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        sum += [self sumOfValuesInSectionAtIndex:sectionIndex];
+    }
+    return sum;
+}
+
+/**
+ Returns the smallest of all values, or +INFINITY if there are none.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (double)minimumOfAllValues
+{
+    double minimum = INFINITY;
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        minimum = MIN(minimum, [self minimumValueInSectionAtIndex:sectionIndex]);
+    }
+    return minimum;
+}
+
+/**
+ Returns the largest of all values, or -INFINITY if there are none.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (double)maximumOfAllValues
+{
+    double maximum = -INFINITY;
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        maximum = MAX(maximum, [self maximumValueInSectionAtIndex:sectionIndex]);
+    }
+    return maximum;
+}
+
+@end
+
+#pragma mark - INTUInt64GroupedArray
+
+@implementation INTUInt64GroupedArray
+
+/**
+ Creates and returns a new grouped array with the -longLongValue of each object in the grouped array, which must all be NSNumbers.
+ Performance: O(n), where n is the total number of objects in all sections
+ 
+ @param groupedArray A grouped array of NSNumbers.
+ @return A new grouped array with the same sections, and the unboxed value of each object.
+ */
++ (instancetype)groupedArrayWithGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    INTUInt64GroupedArray *int64GroupedArray = [self new];
+    NSUInteger sectionCount = [groupedArray countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        NSArray *objects = [groupedArray objectsViewInSectionAtIndex:sectionIndex];
+        NSUInteger objectCount = [objects count];
+        int64_t *values = [int64GroupedArray _appendValueSlots:objectCount toSection:[groupedArray sectionAtIndex:sectionIndex]];
+        for (NSUInteger objectIndex = 0; objectIndex < objectCount; objectIndex++) {
+            values[objectIndex] = [objects[objectIndex] longLongValue];
+        }
+    }
+    return int64GroupedArray;
+}
+
+/**
+ Returns a new immutable grouped array with the same sections, and each value boxed in an NSNumber.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (INTUGroupedArray *)boxedGroupedArray
+{
+    INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        const int64_t *values = [self valuesInSectionAtIndex:sectionIndex];
+        NSUInteger valueCount = [self countValuesInSectionAtIndex:sectionIndex];
+        NSMutableArray *objects = [NSMutableArray arrayWithCapacity:valueCount];
+        for (NSUInteger valueIndex = 0; valueIndex < valueCount; valueIndex++) {
+            [objects addObject:@(values[valueIndex])];
+        }
+        [builder addObjectsFromArray:objects toSection:[self sectionAtIndex:sectionIndex]];
+    }
+    return [builder build];
+}
+
+/**
+ Returns the value at the index pair.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(1)
+ 
+ @param indexPair The index pair of the value.
+ @return The value at the index pair, or 0 if the index pair is out of bounds.
+ */
+- (int64_t)valueAtIndexPair:(INTUIndexPair)indexPair
+{
+    const int64_t *valueSlot = [self _valueSlotAtIndexPair:indexPair];
+    return valueSlot ? *valueSlot : 0;
+}
+
+/**
+ Returns the buffer of values in the section at the index, which remains valid until the grouped array is mutated.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(1)
+ 
+ @param index The index of the section.
+ @return The buffer of values, which has -countValuesInSectionAtIndex: entries, or NULL if the index is out of bounds.
+ */
+- (const int64_t *)valuesInSectionAtIndex:(NSUInteger)index
+{
+    const INTUScalarSectionBuffer *sectionBuffer = [self _sectionBufferAtIndex:index];
+    return sectionBuffer ? sectionBuffer->values : NULL;
+}
+
+/**
+ Adds the value to the end of the section, adding the section to the end of the grouped array if it does not exist.
+ Performance: O(1) amortized
+ */
+- (void)addValue:(int64_t)value toSection:(id)section
+{
+    [self addValues:&value count:1 toSection:section];
+}
+
+/**
+ Adds the values in the buffer to the end of the section, adding the section to the end of the grouped array if it does not exist.
+ Performance: O(n), where n is the number of values added
+ 
+ @param values A buffer of values.
+ @param count The number of values in the buffer. Does nothing if this is 0.
+ @param section The section to add the values to.
+ */
+- (void)addValues:(const int64_t *)values count:(NSUInteger)count toSection:(id)section
+{
+    if (count == 0) {
+        return;
+    }
+    int64_t *valueSlots = [self _appendValueSlots:count toSection:section];
+    if (valueSlots) {
+        memcpy(valueSlots, values, count * sizeof(int64_t));
+    }
+}
+
+/**
+ Replaces the value at the index pair.
+ An exception will be raised if the index pair is out of bounds.
+ Performance: O(1)
+ */
+- (void)replaceValueAtIndexPair:(INTUIndexPair)indexPair withValue:(int64_t)value
+{
+    int64_t *valueSlot = [self _valueSlotAtIndexPair:indexPair];
+    if (valueSlot) {
+        *valueSlot = value;
+    }
+}
+
+/**
+ Executes the block for each value in the grouped array.
+ 
+ @param block A block taking three parameters:
+                int64_t value: The value
+                INTUIndexPair indexPair: The index pair of the value
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ */
+- (void)enumerateValuesUsingBlock:(void (^)(int64_t value, INTUIndexPair indexPair, BOOL *stop))block
+{
+    [self enumerateValuesWithOptions:0 usingBlock:block];
+}
+
+/**
+ Executes the block for each value in the grouped array with the specified enumeration options.
+ 
+ @param options A bitmask of NSEnumerationOptions (NSEnumerationConcurrent and/or NSEnumerationReverse).
+ @param block A block taking three parameters:
+                int64_t value: The value
+                INTUIndexPair indexPair: The index pair of the value
+                BOOL *stop: a pointer to a BOOL which will stop the enumeration if set to YES
+ */
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(int64_t value, INTUIndexPair indexPair, BOOL *stop))block
+{
+    if (!block) {
+        NSAssert(block, @"Block should not be nil.");
+        return;
+    }
+    [self _enumerateValueSlotsWithOptions:options usingBlock:^(const void *valueSlot, INTUIndexPair indexPair, BOOL *stop) {
+        block(*(const int64_t *)valueSlot, indexPair, stop);
+    }];
+}
+
+/**
+ Returns the sum of the values in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(m), where m is the number of values in the section
+ */
+- (int64_t)sumOfValuesInSectionAtIndex:(NSUInteger)index
+{
+    return INTUSumOfInt64s([self valuesInSectionAtIndex:index], [self countValuesInSectionAtIndex:index]);
+}
+
+/**
+ Returns the smallest value in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(m), where m is the number of values in the section
+ */
+- (int64_t)minimumValueInSectionAtIndex:(NSUInteger)index
+{
+    return INTUExtremeOfInt64s([self valuesInSectionAtIndex:index], [self countValuesInSectionAtIndex:index], NO);
+}
+
+/**
+ Returns the largest value in the section at the index.
+ An exception will be raised if the index is out of bounds.
+ Performance: O(m), where m is the number of values in the section
+ */
+- (int64_t)maximumValueInSectionAtIndex:(NSUInteger)index
+{
+    return INTUExtremeOfInt64s([self valuesInSectionAtIndex:index], [self countValuesInSectionAtIndex:index], YES);
+}
+
+/**
+ Returns the sum of all values, or 0 if there are none. The sum wraps around on overflow.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (int64_t)sumOfAllValues
+{
+    // Add as unsigned integers, whose overflow wraps around instead of being undefined
+    uint64_t sum = 0;
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        sum += (uint64_t)[self sumOfValuesInSectionAtIndex:sectionIndex];
+    }
+    return (int64_t)sum;
+}
+
+/**
+ Returns the smallest of all values, or INT64_MAX if there are none.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (int64_t)minimumOfAllValues
+{
+    int64_t minimum = INT64_MAX;
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        minimum = MIN(minimum, [self minimumValueInSectionAtIndex:sectionIndex]);
+    }
+    return minimum;
+}
+
+/**
+ Returns the largest of all values, or INT64_MIN if there are none.
+ Performance: O(n), where n is the total number of values in all sections
+ */
+- (int64_t)maximumOfAllValues
+{
+    int64_t maximum = INT64_MIN;
+    NSUInteger sectionCount = [self countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        maximum = MAX(maximum, [self maximumValueInSectionAtIndex:sectionIndex]);
+    }
+    return maximum;
+}
+
+@end
@@ -0,0 +1,73 @@
+//
+//  INTUGroupedArrayAggregate.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUGroupedArrayAggregate_h
+#define INTUGroupedArrayAggregate_h
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+#import "INTUMutableGroupedArray.h"
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+/**
+ An aggregate registered on a mutable grouped array, which keeps its value for each section up to date as objects are added to and
+ removed from the section, so that reading it does not require visiting the objects in the section.
+ 
+ The value of each object is the value at the key path of the object, or the object itself if there is no key path. Nil values are ignored.
+ Sections are identified by -isEqual: & -hash (like keys in a dictionary), so a section that is replaced must be removed with all of its
+ objects and added back under the new section.
+ */
+@interface INTUGroupedArrayAggregate : NSObject <NSCopying>
+
+/** The function that combines the values of the objects in each section. */
+@property (nonatomic, readonly) INTUGroupedArrayAggregateFunction function;
+/** The key path of the value of each object, or nil to use the objects themselves. */
+@property (nonatomic, readonly, copy, GA__INTU_NULLABLE) NSString *keyPath;
+
+/** Creates an aggregate with no sections. */
+- (instancetype)initWithFunction:(INTUGroupedArrayAggregateFunction)function keyPath:(GA__INTU_NULLABLE NSString *)keyPath;
+
+/** Includes the object in the aggregate of the section. */
+- (void)addObject:(id)object toSection:(id)section;
+/** Removes the object from the aggregate of the section. The object must have been added to the section before, and its value must not
+    have changed since then. */
+- (void)removeObject:(id)object fromSection:(id)section;
+/** Discards the aggregates of all sections. */
+- (void)removeAllSections;
+
+/**
+ Returns the aggregate of the section, which contains the objects in the array. The objects are only visited if the minimum or maximum
+ of the section was removed since the aggregate was last read. Returns @0 for the count or sum of a section without any values, and nil
+ for its minimum or maximum.
+ */
+- (GA__INTU_NULLABLE id)valueInSection:(id)section withObjects:(NSArray *)objects;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
+
+#endif /* INTUGroupedArrayAggregate_h */
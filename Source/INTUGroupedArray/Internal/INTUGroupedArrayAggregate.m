@@ -0,0 +1,233 @@
+//
+//  INTUGroupedArrayAggregate.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArrayAggregate.h"
+
+/**
+ The state of an aggregate for one section.
+ */
+@interface INTUGroupedArrayAggregateSection : NSObject <NSCopying>
+
+// The number of objects in the section, including those whose value is nil
+@property (nonatomic, assign) NSUInteger objectCount;
+// The number of objects in the section whose value is not nil
+@property (nonatomic, assign) NSUInteger valueCount;
+// The sum of the values (only maintained for INTUGroupedArrayAggregateFunctionSum)
+@property (nonatomic, assign) double sum;
+// The minimum or maximum value (only maintained for INTUGroupedArrayAggregateFunctionMinimum & INTUGroupedArrayAggregateFunctionMaximum)
+@property (nonatomic, strong) id extremeValue;
+// Whether the minimum or maximum value was removed, so the extreme value must be found again by visiting the objects in the section
+@property (nonatomic, assign) BOOL extremeValueIsStale;
+
+@end
+
+@implementation INTUGroupedArrayAggregateSection
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    INTUGroupedArrayAggregateSection *copy = [[[self class] allocWithZone:zone] init];
+    copy.objectCount = self.objectCount;
+    copy.valueCount = self.valueCount;
+    copy.sum = self.sum;
+    copy.extremeValue = self.extremeValue;
+    copy.extremeValueIsStale = self.extremeValueIsStale;
+    return copy;
+}
+
+@end
+
+
+@interface INTUGroupedArrayAggregate ()
+{
+@private
+    /** A map table from each section that contains objects to its INTUGroupedArrayAggregateSection. */
+    NSMapTable *_sectionMap;
+}
+
+@end
+
+@implementation INTUGroupedArrayAggregate
+
+- (instancetype)initWithFunction:(INTUGroupedArrayAggregateFunction)function keyPath:(NSString *)keyPath
+{
+    self = [super init];
+    if (self) {
+        _function = function;
+        _keyPath = [keyPath copy];
+        _sectionMap = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory valueOptions:NSPointerFunctionsStrongMemory capacity:0];
+    }
+    return self;
+}
+
+/**
+ Returns a copy of the aggregate and the aggregates of all its sections.
+ Performance: O(n), where n is the number of sections
+ */
+- (id)copyWithZone:(NSZone *)zone
+{
+    INTUGroupedArrayAggregate *copy = [[[self class] allocWithZone:zone] initWithFunction:_function keyPath:_keyPath];
+    for (id section in _sectionMap) {
+        [copy->_sectionMap setObject:[[_sectionMap objectForKey:section] copy] forKey:section];
+    }
+    return copy;
+}
+
+/**
+ Returns the value of the object that is aggregated: the value at the key path, or the object itself if there is no key path.
+ */
+- (id)_valueOfObject:(id)object
+{
+    return _keyPath ? [object valueForKeyPath:_keyPath] : object;
+}
+
+/**
+ Returns whether the value should replace the current extreme value, which is the minimum or maximum depending on the function.
+ */
+- (BOOL)_value:(id)value isMoreExtremeThanValue:(id)extremeValue
+{
+    if (!extremeValue) {
+        return YES;
+    }
+    NSComparisonResult result = [value compare:extremeValue];
+    return (_function == INTUGroupedArrayAggregateFunctionMinimum) ? (result == NSOrderedAscending) : (result == NSOrderedDescending);
+}
+
+/**
+ Includes the object in the aggregate of the section.
+ Performance: O(1)
+ */
+- (void)addObject:(id)object toSection:(id)section
+{
+    INTUGroupedArrayAggregateSection *aggregateSection = [_sectionMap objectForKey:section];
+    if (!aggregateSection) {
+        aggregateSection = [INTUGroupedArrayAggregateSection new];
+        [_sectionMap setObject:aggregateSection forKey:section];
+    }
+    aggregateSection.objectCount++;
+    id value = [self _valueOfObject:object];
+    if (!value) {
+        return;
+    }
+    aggregateSection.valueCount++;
+    switch (_function) {
+        case INTUGroupedArrayAggregateFunctionCount:
+            break;
+        case INTUGroupedArrayAggregateFunctionSum:
+            aggregateSection.sum += [value doubleValue];
+            break;
+        case INTUGroupedArrayAggregateFunctionMinimum:
+        case INTUGroupedArrayAggregateFunctionMaximum:
+            // A stale extreme value is found again from all of the objects when it is next read, including this one
+            if (!aggregateSection.extremeValueIsStale && [self _value:value isMoreExtremeThanValue:aggregateSection.extremeValue]) {
+                aggregateSection.extremeValue = value;
+            }
+            break;
+    }
+}
+
+/**
+ Removes the object from the aggregate of the section. Removing the minimum or maximum value marks it as stale, so that it is found
+ again the next time the aggregate of the section is read.
+ Performance: O(1)
+ */
+- (void)removeObject:(id)object fromSection:(id)section
+{
+    INTUGroupedArrayAggregateSection *aggregateSection = [_sectionMap objectForKey:section];
+    if (!aggregateSection) {
+        NSAssert(aggregateSection, @"The object should have been added to the section.");
+        return;
+    }
+    aggregateSection.objectCount--;
+    if (aggregateSection.objectCount == 0) {
+        [_sectionMap removeObjectForKey:section];
+        return;
+    }
+    id value = [self _valueOfObject:object];
+    if (!value) {
+        return;
+    }
+    aggregateSection.valueCount--;
+    switch (_function) {
+        case INTUGroupedArrayAggregateFunctionCount:
+            break;
+        case INTUGroupedArrayAggregateFunctionSum:
+            // Start again from exactly 0 once there are no values, so that floating point rounding errors don't accumulate forever
+            aggregateSection.sum = (aggregateSection.valueCount > 0) ? aggregateSection.sum - [value doubleValue] : 0.0;
+            break;
+        case INTUGroupedArrayAggregateFunctionMinimum:
+        case INTUGroupedArrayAggregateFunctionMaximum:
+            if (aggregateSection.valueCount == 0) {
+                aggregateSection.extremeValue = nil;
+                aggregateSection.extremeValueIsStale = NO;
+            } else if (!aggregateSection.extremeValueIsStale && [value compare:aggregateSection.extremeValue] == NSOrderedSame) {
+                aggregateSection.extremeValue = nil;
+                aggregateSection.extremeValueIsStale = YES;
+            }
+            break;
+    }
+}
+
+/**
+ Discards the aggregates of all sections.
+ Performance: O(n), where n is the number of sections
+ */
+- (void)removeAllSections
+{
+    [_sectionMap removeAllObjects];
+}
+
+/**
+ Returns the aggregate of the section, which contains the objects in the array.
+ Performance: O(1), except for the first read of a minimum or maximum after the previous one was removed from the section, which is O(m),
+              where m is the number of objects in the section
+ */
+- (id)valueInSection:(id)section withObjects:(NSArray *)objects
+{
+    INTUGroupedArrayAggregateSection *aggregateSection = [_sectionMap objectForKey:section];
+    switch (_function) {
+        case INTUGroupedArrayAggregateFunctionCount:
+            return @(aggregateSection.valueCount);
+        case INTUGroupedArrayAggregateFunctionSum:
+            return @(aggregateSection.sum);
+        case INTUGroupedArrayAggregateFunctionMinimum:
+        case INTUGroupedArrayAggregateFunctionMaximum:
+            if (aggregateSection.extremeValueIsStale) {
+                id extremeValue = nil;
+                for (id object in objects) {
+                    id value = [self _valueOfObject:object];
+                    if (value && [self _value:value isMoreExtremeThanValue:extremeValue]) {
+                        extremeValue = value;
+                    }
+                }
+                aggregateSection.extremeValue = extremeValue;
+                aggregateSection.extremeValueIsStale = NO;
+            }
+            return aggregateSection.extremeValue;
+    }
+    return nil;
+}
+
+@end
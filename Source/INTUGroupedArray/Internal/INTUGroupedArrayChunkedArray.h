@@ -0,0 +1,55 @@
+//
+//  INTUGroupedArrayChunkedArray.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUGroupedArrayChunkedArray_h
+#define INTUGroupedArrayChunkedArray_h
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+/** The maximum number of objects in each chunk of an INTUGroupedArrayChunkedArray. */
+extern const NSUInteger INTUGroupedArrayChunkedArrayChunkCapacity;
+
+/**
+ A mutable array that stores its objects in a sequence of fixed-size chunks instead of one buffer, so that inserting or removing an object
+ only shifts the objects in its chunk. A Fenwick tree (binary indexed tree) of the chunk sizes locates the chunk containing an index in
+ O(log c) time, where c is the number of chunks, so positional inserts, removals & lookups are O(log m) instead of O(m), where m is the
+ number of objects (splitting or merging a chunk rebuilds the tree, which is amortized over the many operations between splits & merges).
+ Sequential access is as fast as with a plain array: fast enumeration returns each chunk directly, and consecutive mutations in the same
+ chunk locate it in O(1) time. Lookups never modify the array, so like NSArray, it can be read on several threads at once while it is
+ not being mutated.
+ 
+ This is only worthwhile for very large arrays, since each lookup costs more than with NSMutableArray.
+ */
+@interface INTUGroupedArrayChunkedArray : NSMutableArray
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
+
+#endif /* INTUGroupedArrayChunkedArray_h */
@@ -0,0 +1,549 @@
+//
+//  INTUGroupedArrayChunkedArray.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArrayChunkedArray.h"
+
+/** The maximum number of objects in each chunk. Each chunk of object pointers fills a 4 KB page on 64-bit platforms. */
+#define INTU_CHUNKED_ARRAY_CHUNK_CAPACITY 512
+
+const NSUInteger INTUGroupedArrayChunkedArrayChunkCapacity = INTU_CHUNKED_ARRAY_CHUNK_CAPACITY;
+
+/**
+ A chunk of consecutive objects in the array, which holds a strong reference (+1 retain count) to each of its objects.
+ */
+typedef struct {
+    /** The number of objects in the chunk, which is never 0 (empty chunks are removed). */
+    NSUInteger count;
+    /** The objects in the chunk. Only the first count entries are valid. */
+    __unsafe_unretained id objects[INTU_CHUNKED_ARRAY_CHUNK_CAPACITY];
+} INTUChunkedArrayChunk;
+
+@interface INTUGroupedArrayChunkedArray ()
+{
+@private
+    /** The chunks of objects, in order. */
+    INTUChunkedArrayChunk **_chunks;
+    /** The number of chunks. */
+    NSUInteger _chunkCount;
+    /** The number of chunks that the _chunks buffer (and the _chunkTree buffer, which has one more entry) has room for. */
+    NSUInteger _chunksCapacity;
+    /** A Fenwick tree of the number of objects in each chunk, indexed from 1: entry i is the total number of objects in the chunks
+        (i - (i & -i), i], so both the number of objects before a chunk and the chunk containing an index can be found in O(log c) time. */
+    NSUInteger *_chunkTree;
+    /** The largest power of 2 that is not greater than the number of chunks (or 0 if there are none), where a search of the tree starts. */
+    NSUInteger _chunkTreeStep;
+    /** The total number of objects in all chunks. */
+    NSUInteger _count;
+    /** Incremented on every mutation, so that fast enumeration can detect mutations. */
+    unsigned long _mutations;
+    /** Whether the chunk that was last mutated is cached, which it is not after chunks are split, merged or removed. */
+    BOOL _hasCachedChunk;
+    /** The chunk that was last mutated, and the index of its first object, so that consecutive mutations in the same chunk locate it
+        in O(1) time. Only valid if _hasCachedChunk is YES. Only mutations (which require exclusive access) read or write the cache, so
+        that lookups never write to the array and can safely run on several threads at once. */
+    NSUInteger _cachedChunkIndex;
+    NSUInteger _cachedChunkStart;
+}
+
+@end
+
+@implementation INTUGroupedArrayChunkedArray
+
+/**
+ Returns the index of the chunk containing the object at the index, which must be in bounds, and sets offset to the index of the object in
+ that chunk. This does not modify the array, so it may be called on several threads at once.
+ Performance: O(log c), where c is the number of chunks
+ */
+static inline NSUInteger INTUChunkedArrayLocateIndex(INTUGroupedArrayChunkedArray *array, NSUInteger index, NSUInteger *offset)
+{
+    // Descend the tree to find the last chunk that starts at or before the index
+    NSUInteger position = 0;
+    NSUInteger remaining = index;
+    for (NSUInteger step = array->_chunkTreeStep; step > 0; step >>= 1) {
+        NSUInteger next = position + step;
+        if (next <= array->_chunkCount && array->_chunkTree[next] <= remaining) {
+            position = next;
+            remaining -= array->_chunkTree[next];
+        }
+    }
+    *offset = remaining;
+    return position;
+}
+
+/**
+ Returns the index of the chunk containing the object at the index, which must be in bounds, and sets offset to the index of the object in
+ that chunk, using and then updating the cached chunk. Must only be called to mutate the array.
+ Performance: O(1) if the object is in the same chunk as the last object mutated; otherwise O(log c), where c is the number of chunks
+ */
+static inline NSUInteger INTUChunkedArrayLocateIndexForMutation(INTUGroupedArrayChunkedArray *array, NSUInteger index, NSUInteger *offset)
+{
+    NSUInteger cachedChunkIndex = array->_cachedChunkIndex;
+    if (array->_hasCachedChunk && index >= array->_cachedChunkStart && index - array->_cachedChunkStart < array->_chunks[cachedChunkIndex]->count) {
+        *offset = index - array->_cachedChunkStart;
+        return cachedChunkIndex;
+    }
+    NSUInteger chunkIndex = INTUChunkedArrayLocateIndex(array, index, offset);
+    array->_hasCachedChunk = YES;
+    array->_cachedChunkIndex = chunkIndex;
+    array->_cachedChunkStart = index - *offset;
+    return chunkIndex;
+}
+
+/**
+ Adds the delta to the number of objects in the chunk at the index in the tree.
+ Performance: O(log c), where c is the number of chunks
+ */
+static inline void INTUChunkedArrayAddToChunkCount(INTUGroupedArrayChunkedArray *array, NSUInteger chunkIndex, NSInteger delta)
+{
+    for (NSUInteger i = chunkIndex + 1; i <= array->_chunkCount; i += i & (~i + 1)) {
+        // Unsigned arithmetic wraps around, so adding a negative delta subtracts it
+        array->_chunkTree[i] += (NSUInteger)delta;
+    }
+}
+
+/**
+ Returns the total number of objects in the first chunkCount chunks.
+ Performance: O(log c), where c is the number of chunks
+ */
+static inline NSUInteger INTUChunkedArrayCountObjectsInChunks(INTUGroupedArrayChunkedArray *array, NSUInteger chunkCount)
+{
+    NSUInteger count = 0;
+    for (NSUInteger i = chunkCount; i > 0; i -= i & (~i + 1)) {
+        count += array->_chunkTree[i];
+    }
+    return count;
+}
+
+// Each initializer calls [super init] rather than another initializer of this class, since the NSArray & NSMutableArray initializers may
+// call each other
+
+- (instancetype)init
+{
+    return [super init];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)numItems
+{
+    self = [super init];
+    if (self) {
+        [self _reserveChunkCapacity:numItems / INTU_CHUNKED_ARRAY_CHUNK_CAPACITY + 1];
+    }
+    return self;
+}
+
+/**
+ Creates an array with the objects, filling each chunk in turn.
+ Performance: O(m), where m is the number of objects
+ */
+- (instancetype)initWithObjects:(const id [])objects count:(NSUInteger)cnt
+{
+    self = [super init];
+    if (self) {
+        [self _reserveChunkCapacity:cnt / INTU_CHUNKED_ARRAY_CHUNK_CAPACITY + 1];
+        for (NSUInteger i = 0; i < cnt; ) {
+            if (!objects[i]) {
+                [NSException raise:NSInvalidArgumentException format:@"Attempt to insert nil object at index %lu.", (unsigned long)i];
+            }
+            if (_chunkCount == 0 || _chunks[_chunkCount - 1]->count == INTU_CHUNKED_ARRAY_CHUNK_CAPACITY) {
+                [self _insertChunkAtIndex:_chunkCount];
+            }
+            INTUChunkedArrayChunk *chunk = _chunks[_chunkCount - 1];
+            chunk->objects[chunk->count] = objects[i];
+            CFRetain((__bridge CFTypeRef)objects[i]);
+            chunk->count++;
+            _count++;
+            i++;
+        }
+        [self _rebuildChunkTree];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (NSUInteger chunkIndex = 0; chunkIndex < _chunkCount; chunkIndex++) {
+        INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+        for (NSUInteger i = 0; i < chunk->count; i++) {
+            CFRelease((__bridge CFTypeRef)chunk->objects[i]);
+        }
+        free(chunk);
+    }
+    free(_chunks);
+    free(_chunkTree);
+}
+
+#pragma mark Primitive Methods
+
+- (NSUInteger)count
+{
+    return _count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+    }
+    NSUInteger offset;
+    NSUInteger chunkIndex = INTUChunkedArrayLocateIndex(self, index, &offset);
+    return _chunks[chunkIndex]->objects[offset];
+}
+
+/**
+ Inserts the object at the index, shifting only the objects after it in the same chunk. A full chunk is split in half first.
+ Performance: O(log c + k), where c is the number of chunks and k is the chunk capacity, plus O(c) whenever a chunk is split
+ */
+- (void)insertObject:(id)anObject atIndex:(NSUInteger)index
+{
+    if (!anObject || index > _count) {
+        if (!anObject) {
+            [NSException raise:NSInvalidArgumentException format:@"Attempt to insert nil object at index %lu.", (unsigned long)index];
+        }
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu].", (unsigned long)index, (unsigned long)_count];
+    }
+    
+    NSUInteger chunkIndex;
+    NSUInteger offset;
+    if (index == _count) {
+        // Append to the last chunk, or to a new chunk if it is full (instead of splitting it, so that appending fills every chunk)
+        if (_chunkCount == 0 || _chunks[_chunkCount - 1]->count == INTU_CHUNKED_ARRAY_CHUNK_CAPACITY) {
+            [self _appendEmptyChunk];
+        }
+        chunkIndex = _chunkCount - 1;
+        offset = _chunks[chunkIndex]->count;
+    } else {
+        chunkIndex = INTUChunkedArrayLocateIndexForMutation(self, index, &offset);
+        if (offset == 0 && chunkIndex > 0 && _chunks[chunkIndex - 1]->count < INTU_CHUNKED_ARRAY_CHUNK_CAPACITY) {
+            // Add the object to the end of the previous chunk instead, which does not shift any objects
+            chunkIndex--;
+            offset = _chunks[chunkIndex]->count;
+        }
+    }
+    if (_chunks[chunkIndex]->count == INTU_CHUNKED_ARRAY_CHUNK_CAPACITY) {
+        [self _splitChunkAtIndex:chunkIndex];
+        NSUInteger firstHalfCount = _chunks[chunkIndex]->count;
+        if (offset > firstHalfCount) {
+            chunkIndex++;
+            offset -= firstHalfCount;
+        }
+    }
+    
+    INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+    memmove((void *)&chunk->objects[offset + 1], (const void *)&chunk->objects[offset], (chunk->count - offset) * sizeof(id));
+    chunk->objects[offset] = anObject;
+    CFRetain((__bridge CFTypeRef)anObject);
+    chunk->count++;
+    _count++;
+    _mutations++;
+    INTUChunkedArrayAddToChunkCount(self, chunkIndex, 1);
+    _hasCachedChunk = YES;
+    _cachedChunkIndex = chunkIndex;
+    _cachedChunkStart = index - offset;
+}
+
+/**
+ Removes the object at the index, shifting only the objects after it in the same chunk. A chunk that becomes empty is removed, and a chunk
+ that becomes small enough is merged with a neighbor, so that the chunks stay dense for fast enumeration.
+ Performance: O(log c + k), where c is the number of chunks and k is the chunk capacity, plus O(c) whenever a chunk is removed or merged
+ */
+- (void)removeObjectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+    }
+    NSUInteger offset;
+    NSUInteger chunkIndex = INTUChunkedArrayLocateIndexForMutation(self, index, &offset);
+    INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+    // Release the object last, since its deallocation may run arbitrary code
+    __unsafe_unretained id object = chunk->objects[offset];
+    memmove((void *)&chunk->objects[offset], (const void *)&chunk->objects[offset + 1], (chunk->count - offset - 1) * sizeof(id));
+    chunk->count--;
+    _count--;
+    _mutations++;
+    INTUChunkedArrayAddToChunkCount(self, chunkIndex, -1);
+    
+    if (chunk->count == 0) {
+        [self _removeChunkAtIndex:chunkIndex];
+    } else if (chunkIndex + 1 < _chunkCount && chunk->count + _chunks[chunkIndex + 1]->count <= INTU_CHUNKED_ARRAY_CHUNK_CAPACITY / 2) {
+        [self _mergeChunkAtIndexWithNextChunk:chunkIndex];
+    } else if (chunkIndex > 0 && chunk->count + _chunks[chunkIndex - 1]->count <= INTU_CHUNKED_ARRAY_CHUNK_CAPACITY / 2) {
+        [self _mergeChunkAtIndexWithNextChunk:chunkIndex - 1];
+    }
+    CFRelease((__bridge CFTypeRef)object);
+}
+
+- (void)addObject:(id)anObject
+{
+    [self insertObject:anObject atIndex:_count];
+}
+
+- (void)removeLastObject
+{
+    if (_count == 0) {
+        [NSException raise:NSRangeException format:@"Cannot remove an object from an empty array."];
+    }
+    [self removeObjectAtIndex:_count - 1];
+}
+
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)anObject
+{
+    if (!anObject || index >= _count) {
+        if (!anObject) {
+            [NSException raise:NSInvalidArgumentException format:@"Attempt to insert nil object at index %lu.", (unsigned long)index];
+        }
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+    }
+    NSUInteger offset;
+    NSUInteger chunkIndex = INTUChunkedArrayLocateIndexForMutation(self, index, &offset);
+    INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+    __unsafe_unretained id object = chunk->objects[offset];
+    chunk->objects[offset] = anObject;
+    CFRetain((__bridge CFTypeRef)anObject);
+    _mutations++;
+    CFRelease((__bridge CFTypeRef)object);
+}
+
+#pragma mark Overrides
+
+/**
+ Removes all objects and chunks.
+ Performance: O(m), where m is the number of objects
+ */
+- (void)removeAllObjects
+{
+    INTUChunkedArrayChunk **chunks = _chunks;
+    NSUInteger chunkCount = _chunkCount;
+    _chunks = NULL;
+    _chunkCount = 0;
+    _chunksCapacity = 0;
+    free(_chunkTree);
+    _chunkTree = NULL;
+    _count = 0;
+    _mutations++;
+    [self _rebuildChunkTree];
+    for (NSUInteger chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+        INTUChunkedArrayChunk *chunk = chunks[chunkIndex];
+        for (NSUInteger i = 0; i < chunk->count; i++) {
+            CFRelease((__bridge CFTypeRef)chunk->objects[i]);
+        }
+        free(chunk);
+    }
+    free(chunks);
+}
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+    if (NSMaxRange(range) > _count) {
+        [NSException raise:NSRangeException format:@"Range %@ is out of bounds [0 .. %lu).", NSStringFromRange(range), (unsigned long)_count];
+    }
+    if (range.length == 0) {
+        return;
+    }
+    NSUInteger offset;
+    NSUInteger chunkIndex = INTUChunkedArrayLocateIndex(self, range.location, &offset);
+    for (NSUInteger copied = 0; copied < range.length; chunkIndex++, offset = 0) {
+        INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+        NSUInteger length = MIN(chunk->count - offset, range.length - copied);
+        memcpy((void *)(objects + copied), (const void *)&chunk->objects[offset], length * sizeof(id));
+        copied += length;
+    }
+}
+
+/**
+ Returns the objects one chunk at a time, pointing directly into each chunk.
+ Performance: O(1) per chunk
+ */
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+    // state->state is the index of the next chunk to return
+    NSUInteger chunkIndex = state->state;
+    state->mutationsPtr = &_mutations;
+    if (chunkIndex >= _chunkCount) {
+        return 0;
+    }
+    state->state = chunkIndex + 1;
+    state->itemsPtr = (__unsafe_unretained id *)(void *)_chunks[chunkIndex]->objects;
+    return _chunks[chunkIndex]->count;
+}
+
+/**
+ Sorts the objects by copying them out, sorting the copy, and writing them back into the same chunks.
+ Performance: O(m*log(m)), where m is the number of objects
+ */
+- (void)sortWithOptions:(NSSortOptions)opts usingComparator:(NSComparator)cmptr
+{
+    NSArray *sortedObjects = [[[NSArray alloc] initWithArray:self] sortedArrayWithOptions:opts usingComparator:cmptr];
+    // The sorted objects are the same objects in a different order, so each chunk keeps the same number of strong references to each one
+    NSUInteger location = 0;
+    for (NSUInteger chunkIndex = 0; chunkIndex < _chunkCount; chunkIndex++) {
+        INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+        [sortedObjects getObjects:chunk->objects range:NSMakeRange(location, chunk->count)];
+        location += chunk->count;
+    }
+    _mutations++;
+}
+
+- (void)sortUsingComparator:(NSComparator)cmptr
+{
+    [self sortWithOptions:0 usingComparator:cmptr];
+}
+
+/**
+ Returns a new chunked array with the same objects, so that mutable copies keep the chunked storage.
+ */
+- (id)mutableCopyWithZone:(NSZone *)zone
+{
+    return [[INTUGroupedArrayChunkedArray allocWithZone:zone] initWithArray:self];
+}
+
+/**
+ Archive as a regular mutable array, since the chunks are an implementation detail.
+ */
+- (Class)classForCoder
+{
+    return [NSMutableArray class];
+}
+
+#pragma mark Chunks
+
+/**
+ Makes sure that the chunk buffers have room for at least the number of chunks.
+ */
+- (void)_reserveChunkCapacity:(NSUInteger)chunksCapacity
+{
+    if (chunksCapacity <= _chunksCapacity) {
+        return;
+    }
+    chunksCapacity = MAX(chunksCapacity, _chunksCapacity * 2);
+    INTUChunkedArrayChunk **chunks = realloc(_chunks, chunksCapacity * sizeof(INTUChunkedArrayChunk *));
+    if (chunks) {
+        _chunks = chunks;
+    }
+    NSUInteger *chunkTree = chunks ? realloc(_chunkTree, (chunksCapacity + 1) * sizeof(NSUInteger)) : NULL;
+    if (!chunks || !chunkTree) {
+        [NSException raise:NSMallocException format:@"Failed to allocate room for %lu chunks.", (unsigned long)chunksCapacity];
+    }
+    _chunkTree = chunkTree;
+    _chunksCapacity = chunksCapacity;
+}
+
+/**
+ Inserts a new empty chunk at the index, without updating the tree.
+ */
+- (INTUChunkedArrayChunk *)_insertChunkAtIndex:(NSUInteger)chunkIndex
+{
+    [self _reserveChunkCapacity:_chunkCount + 1];
+    INTUChunkedArrayChunk *chunk = malloc(sizeof(INTUChunkedArrayChunk));
+    if (!chunk) {
+        [NSException raise:NSMallocException format:@"Failed to allocate a chunk of %d objects.", INTU_CHUNKED_ARRAY_CHUNK_CAPACITY];
+    }
+    chunk->count = 0;
+    memmove(&_chunks[chunkIndex + 1], &_chunks[chunkIndex], (_chunkCount - chunkIndex) * sizeof(INTUChunkedArrayChunk *));
+    _chunks[chunkIndex] = chunk;
+    _chunkCount++;
+    return chunk;
+}
+
+/**
+ Appends a new empty chunk, and adds its entry to the tree.
+ Performance: O(log c), where c is the number of chunks
+ */
+- (void)_appendEmptyChunk
+{
+    [self _insertChunkAtIndex:_chunkCount];
+    // The new entry covers the chunks (i - (i & -i), i], the last of which is the new empty chunk
+    NSUInteger i = _chunkCount;
+    _chunkTree[i] = INTUChunkedArrayCountObjectsInChunks(self, i - 1) - INTUChunkedArrayCountObjectsInChunks(self, i - (i & (~i + 1)));
+    if (_chunkTreeStep * 2 <= _chunkCount) {
+        _chunkTreeStep = MAX(_chunkTreeStep * 2, (NSUInteger)1);
+    }
+}
+
+/**
+ Moves the second half of the objects in the chunk at the index to a new chunk after it, and rebuilds the tree.
+ Performance: O(c + k), where c is the number of chunks and k is the chunk capacity
+ */
+- (void)_splitChunkAtIndex:(NSUInteger)chunkIndex
+{
+    INTUChunkedArrayChunk *newChunk = [self _insertChunkAtIndex:chunkIndex + 1];
+    INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+    NSUInteger firstHalfCount = chunk->count / 2;
+    newChunk->count = chunk->count - firstHalfCount;
+    memcpy((void *)newChunk->objects, (const void *)&chunk->objects[firstHalfCount], newChunk->count * sizeof(id));
+    chunk->count = firstHalfCount;
+    [self _rebuildChunkTree];
+}
+
+/**
+ Moves the objects in the chunk after the index to the end of the chunk at the index, removes the chunk after it, and rebuilds the tree.
+ Performance: O(c + k), where c is the number of chunks and k is the chunk capacity
+ */
+- (void)_mergeChunkAtIndexWithNextChunk:(NSUInteger)chunkIndex
+{
+    INTUChunkedArrayChunk *chunk = _chunks[chunkIndex];
+    INTUChunkedArrayChunk *nextChunk = _chunks[chunkIndex + 1];
+    memcpy((void *)&chunk->objects[chunk->count], (const void *)nextChunk->objects, nextChunk->count * sizeof(id));
+    chunk->count += nextChunk->count;
+    nextChunk->count = 0;
+    [self _removeChunkAtIndex:chunkIndex + 1];
+}
+
+/**
+ Frees the chunk at the index, which must be empty, and rebuilds the tree.
+ Performance: O(c), where c is the number of chunks
+ */
+- (void)_removeChunkAtIndex:(NSUInteger)chunkIndex
+{
+    NSAssert(_chunks[chunkIndex]->count == 0, @"Only empty chunks can be removed.");
+    free(_chunks[chunkIndex]);
+    memmove(&_chunks[chunkIndex], &_chunks[chunkIndex + 1], (_chunkCount - chunkIndex - 1) * sizeof(INTUChunkedArrayChunk *));
+    _chunkCount--;
+    [self _rebuildChunkTree];
+}
+
+/**
+ Rebuilds the tree of the number of objects in each chunk from scratch, and forgets the cached chunk.
+ Performance: O(c), where c is the number of chunks
+ */
+- (void)_rebuildChunkTree
+{
+    for (NSUInteger i = 1; i <= _chunkCount; i++) {
+        _chunkTree[i] = _chunks[i - 1]->count;
+    }
+    for (NSUInteger i = 1; i <= _chunkCount; i++) {
+        NSUInteger parent = i + (i & (~i + 1));
+        if (parent <= _chunkCount) {
+            _chunkTree[parent] += _chunkTree[i];
+        }
+    }
+    _chunkTreeStep = 0;
+    for (NSUInteger step = 1; step <= _chunkCount; step *= 2) {
+        _chunkTreeStep = step;
+    }
+    _hasCachedChunk = NO;
+}
+
+@end
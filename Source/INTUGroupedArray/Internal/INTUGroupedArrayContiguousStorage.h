@@ -0,0 +1,81 @@
+//
+//  INTUGroupedArrayContiguousStorage.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUGroupedArrayContiguousStorage_h
+#define INTUGroupedArrayContiguousStorage_h
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+/**
+ Immutable storage for the sections & objects of a grouped array, laid out contiguously: all objects in a single buffer (the objects of
+ each section follow the objects of the section before it), all sections in another buffer, and a table of where each section starts.
+ This avoids allocating a section container and an array for every section, and makes walking the objects a linear scan through memory.
+ 
+ Contiguous storage is never modified once it has been created, so it is thread safe, and may be shared by any number of grouped arrays.
+ */
+@interface INTUGroupedArrayContiguousStorage : NSObject
+
+/** The number of sections. */
+@property (nonatomic, readonly) NSUInteger sectionCount;
+/** The total number of objects in all sections. */
+@property (nonatomic, readonly) NSUInteger objectCount;
+/** The buffer of sections, with sectionCount entries. */
+@property (nonatomic, readonly) __unsafe_unretained id const *sections;
+/** The buffer of all objects, with objectCount entries. */
+@property (nonatomic, readonly) __unsafe_unretained id const *objects;
+/** The table of cumulative object counts, with sectionCount + 1 entries. Entry i is the index in the buffer of objects of the first object in
+    section i (which is also the total number of objects in all sections before section i), and the last entry is objectCount. */
+@property (nonatomic, readonly) const NSUInteger *sectionOffsets;
+
+/** Creates contiguous storage containing the sections & objects of the section containers, optionally copying the sections & objects. */
+- (instancetype)initWithSectionContainers:(NSArray *)sectionContainers copyItems:(BOOL)copyItems;
+
+/** Creates contiguous storage containing the sections, each with the objects in the array at the same index, optionally copying the sections
+    & objects. The objects are read straight into the buffer of objects. */
+- (instancetype)initWithSections:(NSArray *)sections objectArrays:(NSArray *)objectArrays copyItems:(BOOL)copyItems;
+
+/** Creates contiguous storage that takes ownership of the buffers, which must have been allocated with malloc and must hold a strong reference
+    (+1 retain count) to each section & object. The buffers are freed (and the references released) when the storage is deallocated. */
+- (instancetype)initByAdoptingSections:(void **)sections
+                                 count:(NSUInteger)sectionCount
+                               objects:(void **)objects
+                                 count:(NSUInteger)objectCount
+                        sectionOffsets:(NSUInteger *)sectionOffsets;
+
+/** Returns an immutable array of the objects in the range of the buffer of objects, which reads them directly from this storage without copying. */
+- (NSArray *)objectsInRange:(NSRange)range;
+
+/** Returns new section containers for the sections in this storage, each of which reads its objects directly from this storage. */
+- (NSArray *)sectionContainers;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
+
+#endif /* INTUGroupedArrayContiguousStorage_h */
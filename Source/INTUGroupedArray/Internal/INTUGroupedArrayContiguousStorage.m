@@ -0,0 +1,269 @@
+//
+//  INTUGroupedArrayContiguousStorage.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArrayContiguousStorage.h"
+#import "INTUGroupedArraySectionContainer.h"
+
+#pragma mark - INTUGroupedArrayContiguousArray
+
+/**
+ An immutable array of a range of the objects in contiguous storage, which reads the objects directly from the storage instead of
+ copying them. The array keeps the storage alive, so it remains valid after the grouped array that created it is deallocated.
+ */
+@interface INTUGroupedArrayContiguousArray : NSArray
+{
+@private
+    /** The storage containing the objects. */
+    INTUGroupedArrayContiguousStorage *_storage;
+    /** The first object of the array in the storage's buffer of objects. */
+    __unsafe_unretained id const *_objects;
+    /** The number of objects in the array. */
+    NSUInteger _count;
+}
+
+/** Creates an array of the objects in the range of the storage's buffer of objects. */
+- (instancetype)initWithStorage:(INTUGroupedArrayContiguousStorage *)storage range:(NSRange)range;
+
+@end
+
+@implementation INTUGroupedArrayContiguousArray
+
+- (instancetype)initWithStorage:(INTUGroupedArrayContiguousStorage *)storage range:(NSRange)range
+{
+    self = [super init];
+    if (self) {
+        _storage = storage;
+        _objects = storage.objects + range.location;
+        _count = range.length;
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return _count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+    }
+    return _objects[index];
+}
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+    if (NSMaxRange(range) > _count) {
+        [NSException raise:NSRangeException format:@"Range %@ is out of bounds [0 .. %lu).", NSStringFromRange(range), (unsigned long)_count];
+    }
+    memcpy((void *)objects, (const void *)(_objects + range.location), range.length * sizeof(id));
+}
+
+/**
+ Returns all objects at once, pointing directly into the storage, since they never change.
+ */
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+    if (state->state != 0) {
+        return 0;
+    }
+    state->state = 1;
+    // The objects are never mutated, so point the mutationsPtr to a value that never changes
+    state->mutationsPtr = &state->extra[0];
+    state->itemsPtr = (__unsafe_unretained id *)(void *)_objects;
+    return _count;
+}
+
+/**
+ Returns a reference to the same instance, which is a valid copy since this class is immutable.
+ */
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+/**
+ Archive as a regular array, since the storage is not archived.
+ */
+- (Class)classForCoder
+{
+    return [NSArray class];
+}
+
+@end
+
+#pragma mark - INTUGroupedArrayContiguousStorage
+
+@implementation INTUGroupedArrayContiguousStorage
+
+/**
+ Creates contiguous storage containing the sections & objects of the section containers, optionally copying the sections & objects.
+ Performance: O(n), where n is the total number of sections & objects
+ 
+ @param sectionContainers The section containers, in order.
+ @param copyItems Whether the sections & objects should be copied (with -copy), instead of retained.
+ @return New contiguous storage for the sections & objects.
+ */
+- (instancetype)initWithSectionContainers:(NSArray *)sectionContainers copyItems:(BOOL)copyItems
+{
+    NSUInteger sectionCount = [sectionContainers count];
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:sectionCount];
+    NSMutableArray *objectArrays = [NSMutableArray arrayWithCapacity:sectionCount];
+    for (INTUGroupedArraySectionContainer *sectionContainer in sectionContainers) {
+        [sections addObject:sectionContainer.section];
+        [objectArrays addObject:sectionContainer.objects];
+    }
+    return [self initWithSections:sections objectArrays:objectArrays copyItems:copyItems];
+}
+
+/**
+ Creates contiguous storage containing the sections, each with the objects in the array at the same index, reading the objects from
+ the arrays straight into the buffer of objects (without creating section containers first).
+ Performance: O(n), where n is the total number of sections & objects
+ 
+ @param sections The sections, in order.
+ @param objectArrays The array of objects in each section, with as many entries as sections.
+ @param copyItems Whether the sections & objects should be copied (with -copy), instead of retained.
+ @return New contiguous storage for the sections & objects.
+ */
+- (instancetype)initWithSections:(NSArray *)sections objectArrays:(NSArray *)objectArrays copyItems:(BOOL)copyItems
+{
+    NSAssert([sections count] == [objectArrays count], @"There should be an array of objects for every section.");
+    self = [super init];
+    if (self) {
+        NSUInteger sectionCount = [sections count];
+        NSUInteger *sectionOffsets = malloc((sectionCount + 1) * sizeof(NSUInteger));
+        NSUInteger objectCount = 0;
+        for (NSUInteger i = 0; sectionOffsets && i < sectionCount; i++) {
+            sectionOffsets[i] = objectCount;
+            objectCount += [(NSArray *)objectArrays[i] count];
+        }
+        // Allocate at least one entry for each buffer, so that a failed allocation can be told apart from an empty one
+        void **sectionsBuffer = malloc(MAX(sectionCount, (NSUInteger)1) * sizeof(id));
+        void **objects = malloc(MAX(objectCount, (NSUInteger)1) * sizeof(id));
+        if (!sectionOffsets || !sectionsBuffer || !objects) {
+            free(sectionOffsets);
+            free(sectionsBuffer);
+            free(objects);
+            [NSException raise:NSMallocException format:@"Failed to allocate contiguous storage for %lu sections and %lu objects.", (unsigned long)sectionCount, (unsigned long)objectCount];
+        }
+        sectionOffsets[sectionCount] = objectCount;
+        
+        // Fill the buffers, which hold a strong reference (+1 retain count) to each section & object until the storage is deallocated
+        for (NSUInteger i = 0; i < sectionCount; i++) {
+            id section = sections[i];
+            sectionsBuffer[i] = (__bridge_retained void *)(copyItems ? [section copy] : section);
+            NSArray *objectsInSection = objectArrays[i];
+            NSUInteger objectCountInSection = sectionOffsets[i + 1] - sectionOffsets[i];
+            __unsafe_unretained id *objectsBuffer = (__unsafe_unretained id *)(void *)(objects + sectionOffsets[i]);
+            [objectsInSection getObjects:objectsBuffer range:NSMakeRange(0, objectCountInSection)];
+            for (NSUInteger j = 0; j < objectCountInSection; j++) {
+                objects[sectionOffsets[i] + j] = (__bridge_retained void *)(copyItems ? [objectsBuffer[j] copy] : objectsBuffer[j]);
+            }
+        }
+        
+        _sectionCount = sectionCount;
+        _objectCount = objectCount;
+        _sectionOffsets = sectionOffsets;
+        _sections = (__unsafe_unretained id const *)(void *)sectionsBuffer;
+        _objects = (__unsafe_unretained id const *)(void *)objects;
+    }
+    return self;
+}
+
+/**
+ Creates contiguous storage that takes ownership of the buffers without copying them, so that storage filled elsewhere (e.g. by a builder)
+ doesn't need to be copied again.
+ Performance: O(1)
+ 
+ @param sections A buffer allocated with malloc of sectionCount sections, each with a strong reference (+1 retain count).
+ @param sectionCount The number of sections.
+ @param objects A buffer allocated with malloc of objectCount objects, each with a strong reference (+1 retain count).
+ @param objectCount The number of objects.
+ @param sectionOffsets A buffer allocated with malloc of sectionCount + 1 cumulative object counts (see the sectionOffsets property).
+ */
+- (instancetype)initByAdoptingSections:(void **)sections
+                                 count:(NSUInteger)sectionCount
+                               objects:(void **)objects
+                                 count:(NSUInteger)objectCount
+                        sectionOffsets:(NSUInteger *)sectionOffsets
+{
+    NSAssert(sectionOffsets[sectionCount] == objectCount, @"The last section offset should be the number of objects.");
+    self = [super init];
+    if (self) {
+        _sectionCount = sectionCount;
+        _objectCount = objectCount;
+        _sectionOffsets = sectionOffsets;
+        _sections = (__unsafe_unretained id const *)(void *)sections;
+        _objects = (__unsafe_unretained id const *)(void *)objects;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    void **sections = (void **)(void *)_sections;
+    for (NSUInteger i = 0; i < _sectionCount; i++) {
+        CFRelease(sections[i]);
+    }
+    void **objects = (void **)(void *)_objects;
+    for (NSUInteger i = 0; i < _objectCount; i++) {
+        CFRelease(objects[i]);
+    }
+    free(sections);
+    free(objects);
+    free((void *)_sectionOffsets);
+}
+
+/**
+ Returns an immutable array of the objects in the range of the buffer of objects, which reads them directly from this storage.
+ Performance: O(1)
+ */
+- (NSArray *)objectsInRange:(NSRange)range
+{
+    NSAssert(NSMaxRange(range) <= _objectCount, @"Range out of bounds!");
+    return [[INTUGroupedArrayContiguousArray alloc] initWithStorage:self range:range];
+}
+
+/**
+ Returns new section containers for the sections in this storage, each of which reads its objects directly from this storage.
+ The section containers are not owned by any grouped array, so mutable grouped arrays will copy them before modifying them (copy-on-write).
+ Performance: O(n), where n is the number of sections
+ */
+- (NSArray *)sectionContainers
+{
+    NSMutableArray *sectionContainers = [NSMutableArray arrayWithCapacity:_sectionCount];
+    for (NSUInteger i = 0; i < _sectionCount; i++) {
+        INTUGroupedArraySectionContainer *sectionContainer = [INTUGroupedArraySectionContainer new];
+        sectionContainer.section = _sections[i];
+        sectionContainer.objects = [self objectsInRange:NSMakeRange(_sectionOffsets[i], _sectionOffsets[i + 1] - _sectionOffsets[i])];
+        [sectionContainers addObject:sectionContainer];
+    }
+    return sectionContainers;
+}
+
+@end
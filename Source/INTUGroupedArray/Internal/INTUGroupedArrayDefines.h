@@ -45,4 +45,10 @@
 #   define GA__INTU_GENERICS_TYPE(type)       id
 #endif
 
+// Define INTU_GROUPED_ARRAY_INSTRUMENTATION=1 (e.g. in the preprocessor macros of the build settings) to compile in the operation counters
+// and timings reported by INTUGroupedArrayInstrumentation. They are compiled out by default, so that they cost nothing.
+#ifndef INTU_GROUPED_ARRAY_INSTRUMENTATION
+#   define INTU_GROUPED_ARRAY_INSTRUMENTATION 0
+#endif
+
 #endif /* INTUGroupedArrayDefines_h */
@@ -0,0 +1,93 @@
+//
+//  INTUGroupedArrayInstrumentationInternal.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUGroupedArrayInstrumentationInternal_h
+#define INTUGroupedArrayInstrumentationInternal_h
+
+#import "INTUGroupedArrayInstrumentation.h"
+
+/**
+ Macros used by the grouped array classes to record operations for INTUGroupedArrayInstrumentation. Unless the library is built with
+ INTU_GROUPED_ARRAY_INSTRUMENTATION=1, they compile to nothing (and INTU_INSTRUMENT_COMPARATOR returns the comparator unchanged).
+ 
+    INTU_INSTRUMENT_COUNT(Counter, n)       Adds n to the counter, e.g. INTU_INSTRUMENT_COUNT(SectionLookups, 1). Thread safe.
+    INTU_INSTRUMENT_TIMING()                Records a call to the current method, and the time spent in it. Must be the first statement. Lock free.
+    INTU_INSTRUMENT_COMPARATOR(cmptr)       Returns a comparator that counts the comparisons made with the comparator (or nil if it is nil).
+ */
+
+#if INTU_GROUPED_ARRAY_INSTRUMENTATION
+
+/** The counters, in the same order as their names in INTUGroupedArrayInstrumentation. */
+typedef NS_ENUM(NSUInteger, INTUGroupedArrayInstrumentationCounter) {
+    INTUGroupedArrayInstrumentationCounterSectionLookups,
+    INTUGroupedArrayInstrumentationCounterSectionLookupScans,
+    INTUGroupedArrayInstrumentationCounterSectionsScanned,
+    INTUGroupedArrayInstrumentationCounterSectionIndexHintHits,
+    INTUGroupedArrayInstrumentationCounterSectionIndexHintMisses,
+    INTUGroupedArrayInstrumentationCounterComparisons,
+    INTUGroupedArrayInstrumentationCounterIndexPathsCreated,
+    INTUGroupedArrayInstrumentationCounterSectionContainersCopied,
+    INTUGroupedArrayInstrumentationCounterObjectsCopied,
+    INTUGroupedArrayInstrumentationCounterSectionContainersCreated,
+    INTUGroupedArrayInstrumentationCounterSectionContainersReused,
+    INTUGroupedArrayInstrumentationCounterMutations,
+    INTUGroupedArrayInstrumentationCounterCount
+};
+
+/** The value of each counter, which must only be modified atomically. */
+extern uint64_t INTUGroupedArrayInstrumentationCounters[INTUGroupedArrayInstrumentationCounterCount];
+
+/** The number of calls to a method measured in one place, and the time spent in them. */
+typedef struct INTUGroupedArrayInstrumentationMethodTiming INTUGroupedArrayInstrumentationMethodTiming;
+
+/** The state of the timing of a single call to a method. */
+typedef struct {
+    INTUGroupedArrayInstrumentationMethodTiming *methodTiming;
+    uint64_t startTime;
+} INTUGroupedArrayInstrumentationTiming;
+
+/** Starts timing a call to the method. The cache holds the method timing for the place the method is measured, which is created the first
+    time that it is needed. */
+extern INTUGroupedArrayInstrumentationTiming INTUGroupedArrayInstrumentationTimingStart(SEL selector, INTUGroupedArrayInstrumentationMethodTiming **cache);
+/** Stops timing a call to a method, and records it. Called automatically when the timing goes out of scope. */
+extern void INTUGroupedArrayInstrumentationTimingStop(INTUGroupedArrayInstrumentationTiming *timing);
+/** Returns a comparator that counts each comparison and then calls the comparator, or nil if the comparator is nil. */
+extern NSComparator INTUGroupedArrayInstrumentationCountingComparator(NSComparator cmptr);
+
+#   define INTU_INSTRUMENT_COUNT(counter, n)    __atomic_fetch_add(&INTUGroupedArrayInstrumentationCounters[INTUGroupedArrayInstrumentationCounter##counter], (uint64_t)(n), __ATOMIC_RELAXED)
+#   define INTU_INSTRUMENT_TIMING()             static INTUGroupedArrayInstrumentationMethodTiming *__intuInstrumentationMethodTiming; \
+                                                INTUGroupedArrayInstrumentationTiming __intuInstrumentationTiming __attribute__((cleanup(INTUGroupedArrayInstrumentationTimingStop), unused)) = INTUGroupedArrayInstrumentationTimingStart(_cmd, &__intuInstrumentationMethodTiming)
+#   define INTU_INSTRUMENT_COMPARATOR(cmptr)    INTUGroupedArrayInstrumentationCountingComparator(cmptr)
+
+#else
+
+#   define INTU_INSTRUMENT_COUNT(counter, n)    do {} while (0)
+#   define INTU_INSTRUMENT_TIMING()             do {} while (0)
+#   define INTU_INSTRUMENT_COMPARATOR(cmptr)    (cmptr)
+
+#endif /* INTU_GROUPED_ARRAY_INSTRUMENTATION */
+
+#endif /* INTUGroupedArrayInstrumentationInternal_h */
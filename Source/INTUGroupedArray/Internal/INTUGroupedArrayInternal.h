@@ -31,6 +31,8 @@
 #import "INTUIndexPair.h"
 #import "INTUGroupedArraySectionContainer.h"
 
+@class INTUGroupedArrayContiguousStorage;
+
 GA__INTU_ASSUME_NONNULL_BEGIN
 
 /**
@@ -42,6 +44,12 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 // An array of INTUGroupedArraySectionContainer objects.
 @property (nonatomic, strong) GA__INTU_GENERICS(NSArray, GA__INTU_GENERICS(INTUGroupedArraySectionContainer, SectionType, ObjectType) *) *sectionContainers;
 
+/**
+ Groups the objects in the array into new section containers of the class, each with a mutable array of objects, by the section key
+ of each object (see +[groupedArrayByGroupingArray:withOptions:sectionKeyBlock:sectionComparator:]).
+ */
++ (NSMutableArray *)_sectionContainersOfClass:(Class)sectionContainerClass byGroupingArray:(GA__INTU_NULLABLE NSArray *)array withOptions:(NSEnumerationOptions)options sectionKeyBlock:(id (^)(id object))sectionKeyBlock sectionComparator:(GA__INTU_NULLABLE NSComparator)sectionCmptr;
+
 /**
  Returns the memory address of the _mutations instance variable.
  */
@@ -59,6 +67,123 @@ GA__INTU_ASSUME_NONNULL_BEGIN
  */
 - (GA__INTU_GENERICS_TYPE(ObjectType))_objectAtIndexPair:(INTUIndexPair)indexPair;
 
+/**
+ Returns the array of objects in the section at the index without copying it, which must not be modified. If the grouped array has
+ contiguous storage, the array reads the objects directly from it. The index must be in bounds.
+ */
+- (GA__INTU_GENERICS(NSArray, ObjectType) *)_objectsArrayInSectionAtIndex:(NSUInteger)index;
+
+/**
+ Sets the sections & objects of a newly created grouped array, where each section has the objects in the array at the same index. Instances
+ of the immutable INTUGroupedArray class read the objects straight into contiguous storage, without creating section containers.
+ */
+- (void)_setInitialSections:(GA__INTU_GENERICS(NSArray, SectionType) *)sections objectArrays:(GA__INTU_GENERICS(NSArray, GA__INTU_GENERICS(NSArray, ObjectType) *) *)objectArrays;
+
+/**
+ Sets the section containers of a newly created immutable grouped array without accessing their objects (e.g. when they are decoded
+ lazily). The object index, if any, is built the first time it is used instead. Must only be called on instances of the immutable
+ INTUGroupedArray class.
+ */
+- (void)_setSectionContainersDeferringObjectIndex:(GA__INTU_GENERICS(NSArray, GA__INTU_GENERICS(INTUGroupedArraySectionContainer, SectionType, ObjectType) *) *)sectionContainers;
+
+/**
+ Replaces the contents of a newly created immutable grouped array with the contiguous storage, which is used as is (without copying it).
+ Must only be called on instances of the immutable INTUGroupedArray class.
+ */
+- (void)_setContiguousStorage:(INTUGroupedArrayContiguousStorage *)contiguousStorage;
+
+/**
+ Returns the table of cumulative object counts, first rebuilding it if the grouped array has been mutated since it was last built.
+ The table has one more entry than there are sections: entry i is the total number of objects in all sections before section i,
+ and the last entry is the total number of objects in the grouped array.
+ */
+- (const NSUInteger *)_sectionOffsetTable;
+
+/**
+ Marks the table of cumulative object counts as out of date. Call this after a mutation that does not increment _mutations right away.
+ */
+- (void)_invalidateSectionOffsetTable;
+
+/**
+ Gives up the right to modify the current section containers in place, so that they can safely be shared with another grouped array.
+ Call this whenever the section containers are shared with another grouped array. Immutable grouped arrays never modify their section
+ containers, so this does nothing; mutable grouped arrays will copy each shared section container before modifying it (copy-on-write).
+ */
+- (void)_relinquishSectionContainerOwnership;
+
+/**
+ Gives up the right to modify the section containers in the range in place, like -[_relinquishSectionContainerOwnership], but keeps the
+ right to modify all other section containers in place. Call this when only the section containers in the range are shared (e.g. by a view).
+ */
+- (void)_relinquishOwnershipOfSectionContainersInRange:(NSRange)range;
+
+/**
+ Splits the range [0, count) into chunks and executes the block once for each chunk, concurrently on the global concurrent dispatch queue,
+ returning once all chunks have finished. A chunk should set stop to YES to stop the enumeration, and check it before each element.
+ */
++ (void)_concurrentlyEnumerateChunksOfCount:(NSUInteger)count reverse:(BOOL)reverse usingBlock:(void (^)(NSRange chunkRange, volatile BOOL *stop))block;
+
+/**
+ Executes the block once for each section container, concurrently across sections if the NSEnumerationConcurrent option is set.
+ Since the block may run on several threads at once, it must only modify state that belongs to the section container or its index.
+ */
+- (void)_enumerateSectionContainersWithOptions:(NSEnumerationOptions)options usingBlock:(void (^)(GA__INTU_GENERICS(INTUGroupedArraySectionContainer, SectionType, ObjectType) *sectionContainer, NSUInteger index))block;
+
+/**
+ Discards and rebuilds the section index from scratch. Must be called after any change to the section containers that
+ cannot be described as a range of section indices that changed. Does nothing unless INTUGroupedArrayOptionHashedSectionIndex is set.
+ */
+- (void)_rebuildSectionIndex;
+
+/**
+ Updates the section index for the sections currently located in the range of section indices.
+ Does nothing unless INTUGroupedArrayOptionHashedSectionIndex is set.
+ */
+- (void)_updateSectionIndexInRange:(NSRange)range;
+
+/**
+ Starts or stops maintaining the section index even though INTUGroupedArrayOptionHashedSectionIndex is not set, so that sections can be
+ located in O(1) time for a while (e.g. during a batch of updates). Stopping discards the section index unless the option is set.
+ */
+- (void)_setUsesTemporarySectionIndex:(BOOL)usesTemporarySectionIndex;
+
+/**
+ Removes the section from the section index. Call this before the section is removed or replaced.
+ Does nothing unless INTUGroupedArrayOptionHashedSectionIndex is set.
+ */
+- (void)_removeSectionFromSectionIndex:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+/**
+ Discards and rebuilds the object index from scratch. Must be called after any change to the objects that is not recorded by calling
+ the methods below. Does nothing unless INTUGroupedArrayOptionHashedObjectIndex is set.
+ */
+- (void)_rebuildObjectIndex;
+
+/**
+ Records one more instance of the object in the section in the object index. Call this after the object is added to the section.
+ Does nothing unless INTUGroupedArrayOptionHashedObjectIndex is set.
+ */
+- (void)_addObject:(GA__INTU_GENERICS_TYPE(ObjectType))object toObjectIndexInSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+/**
+ Records one less instance of the object in the section in the object index. Call this after the object is removed from the section.
+ Does nothing unless INTUGroupedArrayOptionHashedObjectIndex is set.
+ */
+- (void)_removeObject:(GA__INTU_GENERICS_TYPE(ObjectType))object fromObjectIndexInSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+/**
+ Records every object in the array as added to (or removed from) the section in the object index.
+ Does nothing unless INTUGroupedArrayOptionHashedObjectIndex is set.
+ */
+- (void)_addObjects:(GA__INTU_GENERICS(NSArray, ObjectType) *)objects toObjectIndexInSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+- (void)_removeObjects:(GA__INTU_GENERICS(NSArray, ObjectType) *)objects fromObjectIndexInSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
+
+/**
+ Returns the sections that contain the object, counted by the number of instances of the object in each section, or nil if the object
+ does not exist in the grouped array. Must only be called when INTUGroupedArrayOptionHashedObjectIndex is set.
+ */
+- (GA__INTU_NULLABLE NSCountedSet *)_sectionsContainingObjectInObjectIndex:(GA__INTU_GENERICS_TYPE(ObjectType))object;
+
 @end
 
 GA__INTU_ASSUME_NONNULL_END
@@ -36,10 +36,17 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, strong) GA__INTU_GENERICS_TYPE(SectionType) section;
 @property (nonatomic, strong) GA__INTU_GENERICS(NSArray, ObjectType) *objects;
+/** The owner ID of the mutable grouped array that is allowed to modify this section container in place, or 0 if no grouped array owns it.
+    A section container that is not owned by a mutable grouped array may be shared with other grouped arrays, so it must be copied
+    before being modified (copy-on-write). This is not archived, and is not carried over to copies of the section container. */
+@property (nonatomic, assign) NSUInteger ownerID;
 
 /** Returns a new section container with the given section. */
 + (instancetype)sectionContainerWithSection:(GA__INTU_GENERICS_TYPE(SectionType))section;
 
+/** Returns the number of objects in the section. Unlike [self.objects count], this does not require the objects to be materialized. */
+- (NSUInteger)countObjects;
+
 /** Returns a new section container that is a deep copy of the section container, copying the section and objects. */
 - (instancetype)initWithSectionContainer:(GA__INTU_GENERICS(INTUGroupedArraySectionContainer, SectionType, ObjectType) *)sectionContainer copyItems:(BOOL)copyItems;
 
@@ -54,6 +61,17 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 /** Exposes the superclass objects instance variable typecast to NSMutableArray. */
 @property (nonatomic, strong) GA__INTU_GENERICS(NSMutableArray, ObjectType) *mutableObjects;
 
+/** Whether the objects are stored in an INTUGroupedArrayChunkedArray. */
+@property (nonatomic, readonly) BOOL usesChunkedStorage;
+
+/** Moves the objects into an INTUGroupedArrayChunkedArray, if they are not stored in one already. Any references to the previous
+    mutable array of objects must not be used afterwards. */
+- (void)useChunkedStorage;
+
+/** Removes all of the objects and the section, keeping the mutable array of objects (and the storage it retains), so that the section
+    container can be reused for another section. The section must be set again before the section container is used. */
+- (void)prepareForReuse;
+
 GA__INTU_ASSUME_NONNULL_END
 
 @end
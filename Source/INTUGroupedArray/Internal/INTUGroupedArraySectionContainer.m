@@ -25,6 +25,14 @@
 //
 
 #import "INTUGroupedArraySectionContainer.h"
+#import "INTUGroupedArrayChunkedArray.h"
+
+@interface INTUGroupedArraySectionContainer ()
+
+/** Releases the section, which is nil until it is set again. */
+- (void)_discardSection;
+
+@end
 
 @implementation INTUGroupedArraySectionContainer
 
@@ -72,6 +80,19 @@
     return newSectionContainer;
 }
 
+- (void)_discardSection
+{
+    _section = nil;
+}
+
+/**
+ Returns the number of objects. Subclasses that provide the objects on demand may override this to avoid materializing them.
+ */
+- (NSUInteger)countObjects
+{
+    return [self.objects count];
+}
+
 - (id)initWithCoder:(NSCoder *)aDecoder
 {
     self = [self init];
@@ -87,8 +108,10 @@
     if (_section) {
         [aCoder encodeObject:_section forKey:@"section"];
     }
-    if (_objects) {
-        [aCoder encodeObject:_objects forKey:@"objects"];
+    // Use the accessor, since subclasses may provide the objects on demand
+    NSArray *objects = self.objects;
+    if (objects) {
+        [aCoder encodeObject:objects forKey:@"objects"];
     }
 }
 
@@ -128,4 +151,31 @@
     [super setObjects:mutableObjects];
 }
 
+- (BOOL)usesChunkedStorage
+{
+    return [self.objects isKindOfClass:[INTUGroupedArrayChunkedArray class]];
+}
+
+/**
+ Moves the objects into an INTUGroupedArrayChunkedArray, if they are not stored in one already.
+ Performance: O(m), where m is the number of objects (O(1) if they are already stored in a chunked array)
+ */
+- (void)useChunkedStorage
+{
+    if (![self usesChunkedStorage]) {
+        self.mutableObjects = [[INTUGroupedArrayChunkedArray alloc] initWithArray:self.objects];
+    }
+}
+
+/**
+ Removes all of the objects and the section, but keeps the mutable array of objects, so that the section container can be reused.
+ Performance: O(m), where m is the number of objects
+ */
+- (void)prepareForReuse
+{
+    [self.mutableObjects removeAllObjects];
+    [self _discardSection];
+    self.ownerID = 0;
+}
+
 @end
@@ -0,0 +1,61 @@
+//
+//  INTUGroupedArrayViews.h
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef INTUGroupedArrayViews_h
+#define INTUGroupedArrayViews_h
+
+#import <Foundation/Foundation.h>
+#import "INTUGroupedArrayDefines.h"
+
+@class INTUGroupedArray;
+
+GA__INTU_ASSUME_NONNULL_BEGIN
+
+/**
+ An immutable array of a range of the objects in another array, which reads the objects from that array instead of copying them.
+ The other array must never be modified while this array exists.
+ */
+@interface INTUGroupedArraySubarray : NSArray
+
+/** Creates an array of the objects in the range of the other array, which must never be modified while this array exists. */
+- (instancetype)initWithArray:(NSArray *)array range:(NSRange)range;
+
+@end
+
+/**
+ An immutable array of all objects in an immutable grouped array, in order (as if the sections were concatenated), which reads the
+ objects from the grouped array instead of copying them. Accessing an object by index is O(log n), where n is the number of sections.
+ */
+@interface INTUGroupedArrayFlattenedArray : NSArray
+
+/** Creates an array of all objects in the grouped array, which must be an instance of the immutable INTUGroupedArray class. */
+- (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray;
+
+@end
+
+GA__INTU_ASSUME_NONNULL_END
+
+#endif /* INTUGroupedArrayViews_h */
@@ -0,0 +1,216 @@
+//
+//  INTUGroupedArrayViews.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "INTUGroupedArrayViews.h"
+#import "INTUGroupedArrayInternal.h"
+
+#pragma mark - INTUGroupedArraySubarray
+
+@interface INTUGroupedArraySubarray ()
+{
+@private
+    /** The array containing the objects. */
+    NSArray *_array;
+    /** The range of the objects in the other array. */
+    NSRange _range;
+}
+
+@end
+
+@implementation INTUGroupedArraySubarray
+
+- (instancetype)initWithArray:(NSArray *)array range:(NSRange)range
+{
+    self = [super init];
+    if (self) {
+        NSAssert(NSMaxRange(range) <= [array count], @"Range out of bounds!");
+        _array = array;
+        _range = range;
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return _range.length;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _range.length) {
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_range.length];
+    }
+    return [_array objectAtIndex:_range.location + index];
+}
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+    if (NSMaxRange(range) > _range.length) {
+        [NSException raise:NSRangeException format:@"Range %@ is out of bounds [0 .. %lu).", NSStringFromRange(range), (unsigned long)_range.length];
+    }
+    [_array getObjects:objects range:NSMakeRange(_range.location + range.location, range.length)];
+}
+
+/**
+ Returns the objects in batches, copying the references to each batch of objects into the buffer in one call.
+ */
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+    // The objects are never mutated, so point the mutationsPtr to a value that never changes
+    state->mutationsPtr = &state->extra[0];
+    NSUInteger index = state->state;
+    if (index >= _range.length || len == 0) {
+        return 0;
+    }
+    NSUInteger count = MIN(len, _range.length - index);
+    [_array getObjects:buffer range:NSMakeRange(_range.location + index, count)];
+    state->itemsPtr = buffer;
+    state->state = index + count;
+    return count;
+}
+
+/**
+ Returns a reference to the same instance, which is a valid copy since this class is immutable.
+ */
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+/**
+ Archive as a regular array, since the other array is not archived.
+ */
+- (Class)classForCoder
+{
+    return [NSArray class];
+}
+
+@end
+
+#pragma mark - INTUGroupedArrayFlattenedArray
+
+@interface INTUGroupedArrayFlattenedArray ()
+{
+@private
+    /** The immutable grouped array containing the objects. */
+    INTUGroupedArray *_groupedArray;
+    /** The total number of objects in the grouped array. */
+    NSUInteger _count;
+}
+
+@end
+
+@implementation INTUGroupedArrayFlattenedArray
+
+- (instancetype)initWithGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    self = [super init];
+    if (self) {
+        NSAssert([groupedArray isMemberOfClass:[INTUGroupedArray class]], @"Only immutable grouped arrays can be flattened without copying.");
+        _groupedArray = groupedArray;
+        _count = [groupedArray countAllObjects];
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return _count;
+}
+
+/**
+ Returns the object at the index, finding its section with a binary search.
+ Performance: O(log n), where n is the number of sections
+ */
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu is out of bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+    }
+    return [_groupedArray objectAtFlatIndex:index];
+}
+
+/**
+ Copies the references to the objects in the range into the buffer, one section at a time.
+ Performance: O(log n + m), where n is the number of sections, and m is the length of the range
+ */
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+    if (NSMaxRange(range) > _count) {
+        [NSException raise:NSRangeException format:@"Range %@ is out of bounds [0 .. %lu).", NSStringFromRange(range), (unsigned long)_count];
+    }
+    if (range.length == 0) {
+        return;
+    }
+    INTUIndexPair indexPair = [_groupedArray indexPairForFlatIndex:range.location];
+    NSUInteger sectionIndex = indexPair.sectionIndex;
+    NSUInteger objectIndex = indexPair.objectIndex;
+    NSUInteger copiedCount = 0;
+    while (copiedCount < range.length) {
+        NSArray *objectsInSection = [_groupedArray _objectsArrayInSectionAtIndex:sectionIndex];
+        NSUInteger count = MIN([objectsInSection count] - objectIndex, range.length - copiedCount);
+        [objectsInSection getObjects:objects + copiedCount range:NSMakeRange(objectIndex, count)];
+        copiedCount += count;
+        sectionIndex++;
+        objectIndex = 0;
+    }
+}
+
+/**
+ Returns the objects in batches, copying the references to each batch of objects into the buffer in one call.
+ */
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)len
+{
+    // The objects are never mutated, so point the mutationsPtr to a value that never changes
+    state->mutationsPtr = &state->extra[0];
+    NSUInteger index = state->state;
+    if (index >= _count || len == 0) {
+        return 0;
+    }
+    NSUInteger count = MIN(len, _count - index);
+    [self getObjects:buffer range:NSMakeRange(index, count)];
+    state->itemsPtr = buffer;
+    state->state = index + count;
+    return count;
+}
+
+/**
+ Returns a reference to the same instance, which is a valid copy since this class is immutable.
+ */
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+/**
+ Archive as a regular array, since the grouped array is not archived.
+ */
+- (Class)classForCoder
+{
+    return [NSArray class];
+}
+
+@end
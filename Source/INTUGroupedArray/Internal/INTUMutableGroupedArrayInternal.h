@@ -40,6 +40,12 @@ GA__INTU_ASSUME_NONNULL_BEGIN
 // A mutable array of INTUMutableGroupedArraySectionContainer objects.
 @property (nonatomic) GA__INTU_GENERICS(NSMutableArray, GA__INTU_GENERICS(INTUMutableGroupedArraySectionContainer, SectionType, ObjectType) *) *mutableSectionContainers;
 
+/**
+ Returns the section container at the index, first replacing it with a copy owned by this grouped array if it may be shared with another
+ grouped array (copy-on-write). This must be used to get any section container that is about to be modified.
+ */
+- (GA__INTU_GENERICS(INTUMutableGroupedArraySectionContainer, SectionType, ObjectType) *)_mutableSectionContainerAtIndex:(NSUInteger)index;
+
 - (GA__INTU_GENERICS(NSMutableArray, ObjectType) *)_objectsArrayForSection:(GA__INTU_GENERICS_TYPE(SectionType))section withSectionIndexHint:(NSUInteger)sectionIndexHint;
 
 @end
@@ -44,6 +44,11 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
         intuGroupedArray = INTUGroupedArray()
     }
     
+    public init(options: INTUGroupedArrayOptions)
+    {
+        intuGroupedArray = INTUGroupedArray(options: options)
+    }
+    
     public init(groupedArray: GroupedArray<S, O>)
     {
         intuGroupedArray = INTUGroupedArray(groupedArray: groupedArray.intuGroupedArray)
@@ -59,6 +64,16 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
         intuGroupedArray = INTUGroupedArray(array: array)
     }
     
+    public init(groupingArray array: [O], sectionKey: (O) -> S)
+    {
+        intuGroupedArray = INTUGroupedArray(byGroupingArray: array, sectionKeyBlock: { sectionKey($0 as! O) })
+    }
+    
+    public init(groupingArray array: [O], options: NSEnumerationOptions, sectionKey: (O) -> S, sectionComparator: NSComparator?)
+    {
+        intuGroupedArray = INTUGroupedArray(byGroupingArray: array, withOptions: options, sectionKeyBlock: { sectionKey($0 as! O) }, sectionComparator: sectionComparator)
+    }
+    
     public required init(arrayLiteral elements: AnyObject...)
     {
         intuGroupedArray = INTUGroupedArray.literal(elements)
@@ -80,6 +95,11 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
     }
     
     
+    public var options: INTUGroupedArrayOptions {
+        return intuGroupedArray.options
+    }
+    
+    
     public var description: String {
         return intuGroupedArray.description
     }
@@ -200,6 +220,57 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
         return intuGroupedArray.allObjects() as! [O]
     }
     
+    public func objectAtFlatIndex(flatIndex: Int) -> O!
+    {
+        return intuGroupedArray.objectAtFlatIndex(UInt(flatIndex)) as? O
+    }
+    
+    public func indexPairForFlatIndex(flatIndex: Int) -> (section: Int, item: Int)?
+    {
+        let indexPair = intuGroupedArray.indexPairForFlatIndex(UInt(flatIndex))
+        return (Int(indexPair.sectionIndex) == NSNotFound) ? nil : (Int(indexPair.sectionIndex), Int(indexPair.objectIndex))
+    }
+    
+    public func flatIndexForIndexPair(section section: Int, item: Int) -> Int?
+    {
+        let flatIndex = Int(intuGroupedArray.flatIndexForIndexPair(INTUIndexPair(sectionIndex: UInt(section), objectIndex: UInt(item))))
+        return (flatIndex == NSNotFound) ? nil : flatIndex
+    }
+    
+    public func objectsViewInSection(section: S) -> [O]
+    {
+        return intuGroupedArray.objectsViewInSection(section) as! [O]
+    }
+    
+    public func objectsViewInSectionAtIndex(sectionIndex: Int) -> [O]
+    {
+        return intuGroupedArray.objectsViewInSectionAtIndex(UInt(sectionIndex)) as! [O]
+    }
+    
+    public func allObjectsView() -> [O]
+    {
+        return intuGroupedArray.allObjectsView() as! [O]
+    }
+    
+    public func groupedArrayView(from from: (section: Int, item: Int), to: (section: Int, item: Int)) -> GroupedArray<S, O>
+    {
+        let newGroupedArray: GroupedArray<S, O> = GroupedArray()
+        newGroupedArray.intuGroupedArray = intuGroupedArray.groupedArrayViewFromIndexPair(INTUIndexPair(sectionIndex: UInt(from.section), objectIndex: UInt(from.item)), toIndexPair: INTUIndexPair(sectionIndex: UInt(to.section), objectIndex: UInt(to.item)))
+        return newGroupedArray
+    }
+    
+    public func allSectionsWithObjects() -> [(section: S, objects: [O])]
+    {
+        let groupedArray = intuGroupedArray.copy() as! INTUGroupedArray
+        let sectionCount = Int(groupedArray.countAllSections())
+        var sectionsWithObjects = [(section: S, objects: [O])]()
+        sectionsWithObjects.reserveCapacity(sectionCount)
+        for sectionIndex in 0..<sectionCount {
+            sectionsWithObjects.append((groupedArray.sectionAtIndex(UInt(sectionIndex)) as! S, groupedArray.objectsViewInSectionAtIndex(UInt(sectionIndex)) as! [O]))
+        }
+        return sectionsWithObjects
+    }
+    
     
     public func enumerateSections(block: (section: S, index: Int, stop: UnsafeMutablePointer<ObjCBool>) -> Void)
     {
@@ -243,29 +314,40 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
         }
     }
     
-    
-    public func generate() -> AnyGenerator<(section: S, object: O)>
-    {
-        let groupedArray = self
-        var sectionIndex = 0
-        var objectIndex = 0
-        return AnyGenerator {
-            let sectionCount = groupedArray.countAllSections()
-            if sectionIndex < sectionCount {
-                let section = groupedArray.sectionAtIndex(sectionIndex)
-                let objectCount = groupedArray.countObjectsInSectionAtIndex(sectionIndex)
-                if objectIndex < objectCount {
-                    let object = groupedArray.objectAtIndexPath(INTUGroupedArray.indexPathForRow(UInt(objectIndex), inSection: UInt(sectionIndex)))
-                    objectIndex += 1
-                    return (section, object)
-                }
-                objectIndex = 0
-                sectionIndex += 1
-            }
-            return nil
+    public func enumerateObjectsWithIndexPairs(block: (object: O, indexPair: (section: Int, item: Int), stop: UnsafeMutablePointer<ObjCBool>) -> Void)
+    {
+        intuGroupedArray.enumerateObjectsUsingIndexPairBlock { (object: AnyObject!, indexPair: INTUIndexPair, stop: UnsafeMutablePointer<ObjCBool>) -> Void in
+            block(object: object as! O, indexPair: (Int(indexPair.sectionIndex), Int(indexPair.objectIndex)), stop: stop)
         }
     }
     
+    public func enumerateObjectsWithIndexPairs(options: NSEnumerationOptions, block: (object: O, indexPair: (section: Int, item: Int), stop: UnsafeMutablePointer<ObjCBool>) -> Void)
+    {
+        intuGroupedArray.enumerateObjectsWithOptions(options, usingIndexPairBlock: { (object: AnyObject!, indexPair: INTUIndexPair, stop: UnsafeMutablePointer<ObjCBool>) -> Void in
+            block(object: object as! O, indexPair: (Int(indexPair.sectionIndex), Int(indexPair.objectIndex)), stop: stop)
+        })
+    }
+    
+    public func enumerateObjectsWithIndexPairsInSectionAtIndex(sectionIndex: Int, block: (object: O, indexPair: (section: Int, item: Int), stop: UnsafeMutablePointer<ObjCBool>) -> Void)
+    {
+        intuGroupedArray.enumerateObjectsInSectionAtIndex(UInt(sectionIndex), usingIndexPairBlock: { (object: AnyObject!, indexPair: INTUIndexPair, stop: UnsafeMutablePointer<ObjCBool>) -> Void in
+            block(object: object as! O, indexPair: (Int(indexPair.sectionIndex), Int(indexPair.objectIndex)), stop: stop)
+        })
+    }
+    
+    public func enumerateObjectsWithIndexPairsInSectionAtIndex(sectionIndex: Int, withOptions options: NSEnumerationOptions, block: (object: O, indexPair: (section: Int, item: Int), stop: UnsafeMutablePointer<ObjCBool>) -> Void)
+    {
+        intuGroupedArray.enumerateObjectsInSectionAtIndex(UInt(sectionIndex), withOptions: options, usingIndexPairBlock: { (object: AnyObject!, indexPair: INTUIndexPair, stop: UnsafeMutablePointer<ObjCBool>) -> Void in
+            block(object: object as! O, indexPair: (Int(indexPair.sectionIndex), Int(indexPair.objectIndex)), stop: stop)
+        })
+    }
+    
+    
+    public func generate() -> GroupedArrayGenerator<S, O>
+    {
+        return GroupedArrayGenerator(intuGroupedArray)
+    }
+    
     public func sectionEnumerator() -> GroupedArraySectionEnumerator<S>
     {
         return GroupedArraySectionEnumerator(intuGroupedArray.sectionEnumerator())
@@ -302,6 +384,14 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
         }
     }
     
+    public func indexPairOfObjectPassingTest(predicate: (object: O, indexPair: (section: Int, item: Int), stop: UnsafeMutablePointer<ObjCBool>) -> Bool) -> (section: Int, item: Int)?
+    {
+        let indexPair = intuGroupedArray.indexPairOfObjectPassingTest { (object: AnyObject!, indexPair: INTUIndexPair, stop: UnsafeMutablePointer<ObjCBool>) -> Bool in
+            return predicate(object: object as! O, indexPair: (Int(indexPair.sectionIndex), Int(indexPair.objectIndex)), stop: stop)
+        }
+        return (Int(indexPair.sectionIndex) == NSNotFound) ? nil : (Int(indexPair.sectionIndex), Int(indexPair.objectIndex))
+    }
+    
     
     public func filtered(sectionPredicate sectionPredicate: NSPredicate, objectPredicate: NSPredicate) -> GroupedArray<S, O>
     {
@@ -310,12 +400,32 @@ public class GroupedArray<S: AnyObject, O: AnyObject>: SequenceType, Equatable,
         return newGroupedArray
     }
     
+    public func filtered(options options: NSEnumerationOptions, sectionPredicate: NSPredicate, objectPredicate: NSPredicate) -> GroupedArray<S, O>
+    {
+        let newGroupedArray: GroupedArray<S, O> = GroupedArray()
+        newGroupedArray.intuGroupedArray = intuGroupedArray.filteredGroupedArrayWithOptions(options, usingSectionPredicate: sectionPredicate, objectPredicate: objectPredicate)
+        return newGroupedArray
+    }
+    
     public func sorted(sectionComparator sectionComparator: NSComparator, objectComparator: NSComparator) -> GroupedArray<S, O>
     {
         let newGroupedArray: GroupedArray<S, O> = GroupedArray()
         newGroupedArray.intuGroupedArray = intuGroupedArray.sortedGroupedArrayUsingSectionComparator(sectionComparator, objectComparator: objectComparator)
         return newGroupedArray
     }
+    
+    public func sorted(options options: NSSortOptions, sectionComparator: NSComparator, objectComparator: NSComparator) -> GroupedArray<S, O>
+    {
+        let newGroupedArray: GroupedArray<S, O> = GroupedArray()
+        newGroupedArray.intuGroupedArray = intuGroupedArray.sortedGroupedArrayWithOptions(options, usingSectionComparator: sectionComparator, objectComparator: objectComparator)
+        return newGroupedArray
+    }
+    
+    
+    public func diff(to groupedArray: GroupedArray<S, O>) -> INTUGroupedArrayDiff
+    {
+        return INTUGroupedArrayDiff(fromGroupedArray: intuGroupedArray, toGroupedArray: groupedArray.intuGroupedArray)
+    }
 }
 
 
@@ -334,6 +444,12 @@ public class MutableGroupedArray<S: AnyObject, O: AnyObject>: GroupedArray<S, O>
         intuGroupedArray = INTUMutableGroupedArray()
     }
     
+    override public init(options: INTUGroupedArrayOptions)
+    {
+        super.init()
+        intuGroupedArray = INTUMutableGroupedArray(options: options)
+    }
+    
     override public init(groupedArray: GroupedArray<S, O>)
     {
         super.init()
@@ -352,6 +468,18 @@ public class MutableGroupedArray<S: AnyObject, O: AnyObject>: GroupedArray<S, O>
         intuGroupedArray = INTUMutableGroupedArray(array: array)
     }
     
+    override public init(groupingArray array: [O], sectionKey: (O) -> S)
+    {
+        super.init()
+        intuGroupedArray = INTUMutableGroupedArray(byGroupingArray: array, sectionKeyBlock: { sectionKey($0 as! O) })
+    }
+    
+    override public init(groupingArray array: [O], options: NSEnumerationOptions, sectionKey: (O) -> S, sectionComparator: NSComparator?)
+    {
+        super.init()
+        intuGroupedArray = INTUMutableGroupedArray(byGroupingArray: array, withOptions: options, sectionKeyBlock: { sectionKey($0 as! O) }, sectionComparator: sectionComparator)
+    }
+    
     public required init(arrayLiteral elements: AnyObject...)
     {
         super.init()
@@ -493,10 +621,76 @@ public class MutableGroupedArray<S: AnyObject, O: AnyObject>: GroupedArray<S, O>
         intuMutableGroupedArray.filterUsingSectionPredicate(sectionPredicate, objectPredicate: objectPredicate)
     }
     
+    public func filter(options options: NSEnumerationOptions, sectionPredicate: NSPredicate, objectPredicate: NSPredicate)
+    {
+        intuMutableGroupedArray.filterWithOptions(options, usingSectionPredicate: sectionPredicate, objectPredicate: objectPredicate)
+    }
+    
     public func sort(sectionComparator sectionComparator: NSComparator, objectComparator: NSComparator)
     {
         intuMutableGroupedArray.sortUsingSectionComparator(sectionComparator, objectComparator: objectComparator)
     }
+    
+    public func sort(options options: NSSortOptions, sectionComparator: NSComparator, objectComparator: NSComparator)
+    {
+        intuMutableGroupedArray.sortWithOptions(options, usingSectionComparator: sectionComparator, objectComparator: objectComparator)
+    }
+    
+    
+    public var sectionComparator: NSComparator? {
+        return intuMutableGroupedArray.sectionComparator
+    }
+    
+    public var objectComparator: NSComparator? {
+        return intuMutableGroupedArray.objectComparator
+    }
+    
+    public func maintainSortOrder(sectionComparator sectionComparator: NSComparator?, objectComparator: NSComparator?)
+    {
+        intuMutableGroupedArray.maintainSortOrderUsingSectionComparator(sectionComparator, objectComparator: objectComparator)
+    }
+    
+    
+    public func performBatchUpdates(updates: () -> Void)
+    {
+        intuMutableGroupedArray.performBatchUpdates(updates)
+    }
+}
+
+
+// MARK: GroupedArrayGenerator
+
+public struct GroupedArrayGenerator<S: AnyObject, O: AnyObject>: GeneratorType
+{
+    private let intuGroupedArray: INTUGroupedArray
+    private let sectionCount: Int
+    private var sectionIndex = -1
+    private var section: S?
+    private var objectsInSection = [O]() // Bridged once per section, so that no Objective-C calls are made for each object
+    private var objectIndex = 0
+    
+    public init(_ groupedArray: INTUGroupedArray)
+    {
+        // Iterate over an immutable copy, which is free for immutable grouped arrays, so that the sections & objects cannot change
+        intuGroupedArray = groupedArray.copy() as! INTUGroupedArray
+        sectionCount = Int(intuGroupedArray.countAllSections())
+    }
+    
+    public mutating func next() -> (section: S, object: O)?
+    {
+        while objectIndex >= objectsInSection.count {
+            sectionIndex += 1
+            if sectionIndex >= sectionCount {
+                return nil
+            }
+            section = intuGroupedArray.sectionAtIndex(UInt(sectionIndex)) as? S
+            objectsInSection = intuGroupedArray.objectsViewInSectionAtIndex(UInt(sectionIndex)) as! [O]
+            objectIndex = 0
+        }
+        let object = objectsInSection[objectIndex]
+        objectIndex += 1
+        return (section!, object)
+    }
 }
 
 
@@ -26,6 +26,7 @@
 
 import UIKit
 import XCTest
+import SwiftGroupedArray
 
 class SwiftGroupedArrayTests: XCTestCase {
     
@@ -51,4 +52,100 @@ class SwiftGroupedArrayTests: XCTestCase {
         }
     }
     
+    let sectionCount = 100
+    let objectCountPerSection = 1000
+    
+    func nestedArrayForPerformanceTests() -> [(section: NSString, objects: [NSNumber])] {
+        return (0..<sectionCount).map { sectionIndex in
+            (NSString(string: "Section \(sectionIndex)"), (0..<objectCountPerSection).map { NSNumber(integer: $0) })
+        }
+    }
+    
+    func groupedArrayForPerformanceTests() -> GroupedArray<NSString, NSNumber> {
+        let groupedArray = MutableGroupedArray<NSString, NSNumber>()
+        for (section, objects) in nestedArrayForPerformanceTests() {
+            groupedArray.addObjectsFromArray(objects, toSection: section)
+        }
+        return groupedArray.copy()
+    }
+    
+    func testGenerator() {
+        let groupedArray = MutableGroupedArray<NSString, NSNumber>()
+        groupedArray.addObject(1, toSection: "Section 1")
+        groupedArray.addObject(2, toSection: "Section 1")
+        groupedArray.addObject(3, toSection: "Section 2")
+        
+        var pairs = [(NSString, NSNumber)]()
+        for (section, object) in groupedArray {
+            pairs.append((section, object))
+            // Changes made while iterating should not affect the iteration
+            groupedArray.addObject(4, toSection: "Section 3")
+        }
+        XCTAssert(pairs.map { $0.0 } == ["Section 1", "Section 1", "Section 2"])
+        XCTAssert(pairs.map { $0.1 } == [1, 2, 3])
+        
+        var emptyGenerator = GroupedArray<NSString, NSNumber>().generate()
+        XCTAssert(emptyGenerator.next() == nil)
+    }
+    
+    func testBulkSectionAccess() {
+        let groupedArray = groupedArrayForPerformanceTests()
+        let sectionsWithObjects = groupedArray.allSectionsWithObjects()
+        XCTAssert(sectionsWithObjects.count == sectionCount)
+        for (sectionIndex, sectionWithObjects) in sectionsWithObjects.enumerate() {
+            XCTAssert(sectionWithObjects.section == groupedArray.sectionAtIndex(sectionIndex))
+            XCTAssert(sectionWithObjects.objects == groupedArray.objectsInSectionAtIndex(sectionIndex))
+            XCTAssert(groupedArray.objectsViewInSectionAtIndex(sectionIndex) == sectionWithObjects.objects)
+        }
+        XCTAssert(groupedArray.allObjectsView() == groupedArray.allObjects())
+        
+        let view = groupedArray.groupedArrayView(from: (section: 1, item: 10), to: (section: 2, item: 4))
+        XCTAssert(view.countAllSections() == 2)
+        XCTAssert(view.countAllObjects() == objectCountPerSection - 10 + 5)
+    }
+    
+    // Compare against testNestedArrayIterationPerformance, which iterates over the same objects in native Swift arrays
+    func testGeneratorPerformance() {
+        let groupedArray = groupedArrayForPerformanceTests()
+        let expectedSum = sectionCount * (objectCountPerSection * (objectCountPerSection - 1) / 2)
+        
+        self.measureBlock() {
+            var sum = 0
+            for (_, object) in groupedArray {
+                sum += object.integerValue
+            }
+            XCTAssert(sum == expectedSum)
+        }
+    }
+    
+    func testNestedArrayIterationPerformance() {
+        let nestedArray = nestedArrayForPerformanceTests()
+        let expectedSum = sectionCount * (objectCountPerSection * (objectCountPerSection - 1) / 2)
+        
+        self.measureBlock() {
+            var sum = 0
+            for (_, objects) in nestedArray {
+                for object in objects {
+                    sum += object.integerValue
+                }
+            }
+            XCTAssert(sum == expectedSum)
+        }
+    }
+    
+    func testBulkSectionIterationPerformance() {
+        let groupedArray = groupedArrayForPerformanceTests()
+        let expectedSum = sectionCount * (objectCountPerSection * (objectCountPerSection - 1) / 2)
+        
+        self.measureBlock() {
+            var sum = 0
+            for (_, objects) in groupedArray.allSectionsWithObjects() {
+                for object in objects {
+                    sum += object.integerValue
+                }
+            }
+            XCTAssert(sum == expectedSum)
+        }
+    }
+    
 }
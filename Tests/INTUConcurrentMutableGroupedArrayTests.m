@@ -0,0 +1,256 @@
+//
+//  INTUConcurrentMutableGroupedArrayTests.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "INTUGroupedArrayImports.h"
+
+@interface INTUConcurrentMutableGroupedArrayTests : XCTestCase
+
+@end
+
+/**
+ Unit tests for the INTUConcurrentMutableGroupedArray class.
+ */
+@implementation INTUConcurrentMutableGroupedArrayTests
+
+/**
+ Test reading and writing from a single thread, and that snapshots are never affected by later updates.
+ */
+- (void)testReadAndWrite
+{
+    INTUConcurrentMutableGroupedArray *concurrentGroupedArray = [INTUConcurrentMutableGroupedArray new];
+    XCTAssert([concurrentGroupedArray countAllSections] == 0);
+    XCTAssert([concurrentGroupedArray countAllObjects] == 0);
+    INTUGroupedArray *emptySnapshot = concurrentGroupedArray.snapshot;
+    XCTAssert([emptySnapshot isMemberOfClass:[INTUGroupedArray class]]);
+    
+    [concurrentGroupedArray addObject:@"Alfa" toSection:@"Section 1"];
+    [concurrentGroupedArray addObject:@"Bravo" toSection:@"Section 2"];
+    [concurrentGroupedArray insertObject:@"Charlie" atIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0]];
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Charlie", @"Alfa"],
+                                                                                         @"Section 2", @[@"Bravo"]]]));
+    XCTAssert([concurrentGroupedArray countAllSections] == 2);
+    XCTAssert([concurrentGroupedArray countAllObjects] == 3);
+    XCTAssertEqualObjects([concurrentGroupedArray sectionAtIndex:1], @"Section 2");
+    XCTAssert([concurrentGroupedArray containsSection:@"Section 2"]);
+    XCTAssert([concurrentGroupedArray indexOfSection:@"Section 3"] == NSNotFound);
+    XCTAssert([concurrentGroupedArray countObjectsInSectionAtIndex:0] == 2);
+    XCTAssertEqualObjects([concurrentGroupedArray objectsInSectionAtIndex:0], (@[@"Charlie", @"Alfa"]));
+    XCTAssertEqualObjects([concurrentGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:0]], @"Alfa");
+    XCTAssert([concurrentGroupedArray containsObject:@"Bravo"]);
+    XCTAssertEqualObjects([concurrentGroupedArray indexPathOfObject:@"Bravo"], [INTUGroupedArray indexPathForRow:0 inSection:1]);
+    XCTAssertNil([concurrentGroupedArray indexPathOfObject:@"Delta"]);
+    
+    // Snapshots are immutable, and are not affected by later updates
+    INTUGroupedArray *snapshot = concurrentGroupedArray.snapshot;
+    [concurrentGroupedArray replaceObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0] withObject:@"Delta"];
+    [concurrentGroupedArray removeObject:@"Bravo"];
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Delta", @"Alfa"]]]));
+    XCTAssertEqualObjects(snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Charlie", @"Alfa"],
+                                                                 @"Section 2", @[@"Bravo"]]]));
+    XCTAssert([emptySnapshot countAllObjects] == 0);
+    
+    [concurrentGroupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0]];
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa"]]]));
+    [concurrentGroupedArray removeSection:@"Section 1"];
+    XCTAssert([concurrentGroupedArray countAllSections] == 0);
+    [concurrentGroupedArray addObject:@"Echo" toSection:@"Section 1"];
+    [concurrentGroupedArray removeAllObjects];
+    XCTAssert([concurrentGroupedArray countAllObjects] == 0);
+    
+    // Creating a concurrent grouped array from a grouped array copies its contents & options, and later changes to either do not affect the other
+    INTUMutableGroupedArray *mutableGroupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [mutableGroupedArray addObject:@"Foxtrot" toSection:@"Section 1"];
+    concurrentGroupedArray = [[INTUConcurrentMutableGroupedArray alloc] initWithGroupedArray:mutableGroupedArray];
+    XCTAssert(concurrentGroupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    XCTAssert(concurrentGroupedArray.snapshot.options == INTUGroupedArrayOptionHashedSectionIndex);
+    [mutableGroupedArray addObject:@"Golf" toSection:@"Section 1"];
+    [concurrentGroupedArray addObject:@"Hotel" toSection:@"Section 2"];
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Foxtrot"], @"Section 2", @[@"Hotel"]]]));
+    XCTAssertEqualObjects(mutableGroupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Foxtrot", @"Golf"]]]));
+}
+
+/**
+ Test that a batch of updates publishes a single snapshot once it ends, without any empty sections, and only if it mutated the grouped array.
+ */
+- (void)testPerformUpdates
+{
+    INTUConcurrentMutableGroupedArray *concurrentGroupedArray = [INTUConcurrentMutableGroupedArray new];
+    [concurrentGroupedArray addObject:@"Alfa" toSection:@"Section 1"];
+    
+    INTUGroupedArray *snapshot = concurrentGroupedArray.snapshot;
+    [concurrentGroupedArray performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray removeObject:@"Zulu"];
+    }];
+    XCTAssert(concurrentGroupedArray.snapshot == snapshot, @"A snapshot should not be published if nothing changed.");
+    
+    [concurrentGroupedArray performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray addObject:@"Bravo" toSection:@"Section 2"];
+        // Nested writes are published along with the batch they are made in
+        [concurrentGroupedArray addObject:@"Charlie" toSection:@"Section 2"];
+        XCTAssert(concurrentGroupedArray.snapshot == snapshot, @"A snapshot should not be published until the outermost batch ends.");
+        [groupedArray removeObjectAtIndex:0 fromSection:@"Section 1"];
+        XCTAssert([concurrentGroupedArray countAllObjects] == 1);
+    }];
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 2", @[@"Bravo", @"Charlie"]]]));
+    XCTAssertEqualObjects(snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa"]]]));
+}
+
+/**
+ Test that updates that raise an exception still publish the mutations they made, and that later updates are still published.
+ */
+- (void)testPerformUpdatesException
+{
+    INTUConcurrentMutableGroupedArray *concurrentGroupedArray = [INTUConcurrentMutableGroupedArray new];
+    [concurrentGroupedArray addObject:@"Alfa" toSection:@"Section 1"];
+    XCTAssertThrowsSpecificNamed([concurrentGroupedArray performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        [groupedArray addObject:@"Bravo" toSection:@"Section 2"];
+        [NSException raise:NSInternalInconsistencyException format:@"Failed in the middle of the updates."];
+    }], NSException, NSInternalInconsistencyException);
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa"], @"Section 2", @[@"Bravo"]]]));
+    
+    [concurrentGroupedArray addObject:@"Charlie" toSection:@"Section 1"];
+    XCTAssertEqualObjects(concurrentGroupedArray.snapshot, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Charlie"], @"Section 2", @[@"Bravo"]]]),
+                          @"Updates after an exception should still be published.");
+}
+
+/**
+ Test that fast enumeration enumerates the snapshot that was current when it began, even if the grouped array is updated during the enumeration.
+ */
+- (void)testFastEnumeration
+{
+    INTUConcurrentMutableGroupedArray *concurrentGroupedArray = [INTUConcurrentMutableGroupedArray new];
+    NSUInteger count = 0;
+    for (id object in concurrentGroupedArray) {
+        XCTAssertNotNil(object);
+        count++;
+    }
+    XCTAssert(count == 0);
+    
+    NSMutableArray *expectedObjects = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [concurrentGroupedArray addObject:@(i) toSection:@(i % 7)];
+    }
+    [concurrentGroupedArray.snapshot enumerateObjectsUsingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+        [expectedObjects addObject:object];
+    }];
+    
+    NSMutableArray *enumeratedObjects = [NSMutableArray array];
+    for (id object in concurrentGroupedArray) {
+        [enumeratedObjects addObject:object];
+        // Updating the grouped array during enumeration does not affect the enumeration
+        [concurrentGroupedArray removeObject:object];
+    }
+    XCTAssertEqualObjects(enumeratedObjects, expectedObjects);
+    XCTAssert([concurrentGroupedArray countAllObjects] == 0);
+    
+    [concurrentGroupedArray addObject:@"Alfa" toSection:@"Section 1"];
+    [concurrentGroupedArray enumerateObjectsUsingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+        XCTAssertEqualObjects(object, @"Alfa");
+        [concurrentGroupedArray addObject:@"Bravo" toSection:@"Section 1"];
+    }];
+    XCTAssert([concurrentGroupedArray countAllObjects] == 2);
+}
+
+/**
+ Test reading from many threads while writing from several others. Every read must observe a consistent snapshot, and no writes may be lost.
+ */
+- (void)testConcurrentReadsAndWrites
+{
+    INTUConcurrentMutableGroupedArray *concurrentGroupedArray = [INTUConcurrentMutableGroupedArray new];
+    const NSUInteger writerCount = 4;
+    const NSUInteger objectsPerWriter = 1000;
+    __block volatile int32_t inconsistentReads = 0;
+    
+    dispatch_apply(writerCount * 4, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        if (iteration < writerCount) {
+            // Each writer adds its own objects to its own section, and removes every other one
+            for (NSUInteger i = 0; i < objectsPerWriter; i++) {
+                [concurrentGroupedArray addObject:@(iteration * objectsPerWriter + i) toSection:@(iteration)];
+                if (i % 2 == 1) {
+                    [concurrentGroupedArray removeObject:@(iteration * objectsPerWriter + i - 1)];
+                }
+            }
+        } else {
+            // Each reader checks that every snapshot it reads is internally consistent
+            for (NSUInteger i = 0; i < objectsPerWriter; i++) {
+                INTUGroupedArray *snapshot = concurrentGroupedArray.snapshot;
+                NSUInteger objectCount = 0;
+                for (id object in concurrentGroupedArray) {
+                    if (object) {
+                        objectCount++;
+                    }
+                }
+                NSUInteger countedObjects = 0;
+                for (NSUInteger sectionIndex = 0; sectionIndex < [snapshot countAllSections]; sectionIndex++) {
+                    countedObjects += [snapshot countObjectsInSectionAtIndex:sectionIndex];
+                }
+                if (countedObjects != [snapshot countAllObjects] || objectCount > writerCount * objectsPerWriter) {
+                    __sync_fetch_and_add(&inconsistentReads, 1);
+                }
+            }
+        }
+    });
+    
+    XCTAssert(inconsistentReads == 0);
+    XCTAssert([concurrentGroupedArray countAllSections] == writerCount);
+    XCTAssert([concurrentGroupedArray countAllObjects] == writerCount * objectsPerWriter / 2);
+    for (NSUInteger writer = 0; writer < writerCount; writer++) {
+        NSUInteger sectionIndex = [concurrentGroupedArray indexOfSection:@(writer)];
+        XCTAssert([concurrentGroupedArray countObjectsInSectionAtIndex:sectionIndex] == objectsPerWriter / 2);
+        XCTAssert([[concurrentGroupedArray objectsInSectionAtIndex:sectionIndex] containsObject:@(writer * objectsPerWriter + 1)]);
+    }
+}
+
+/**
+ Measure reading from many threads at once while another thread writes.
+ */
+- (void)testConcurrentReadPerformance
+{
+    INTUConcurrentMutableGroupedArray *concurrentGroupedArray = [INTUConcurrentMutableGroupedArray new];
+    [concurrentGroupedArray performUpdates:^(INTUMutableGroupedArray *groupedArray) {
+        for (NSUInteger i = 0; i < 10000; i++) {
+            [groupedArray addObject:@(i) toSection:@(i / 100)];
+        }
+    }];
+    
+    [self measureBlock:^{
+        dispatch_apply(16, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+            if (iteration == 0) {
+                for (NSUInteger i = 0; i < 100; i++) {
+                    [concurrentGroupedArray replaceObjectAtIndexPath:[INTUGroupedArray indexPathForRow:i inSection:i % 100] withObject:@(i)];
+                }
+            } else {
+                NSIndexPath *indexPath = [INTUGroupedArray indexPathForRow:50 inSection:50];
+                for (NSUInteger i = 0; i < 100000; i++) {
+                    [concurrentGroupedArray objectAtIndexPath:indexPath];
+                }
+            }
+        });
+    }];
+}
+
+@end
@@ -0,0 +1,215 @@
+//
+//  INTUGroupedArrayBuilderTests.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "INTUGroupedArrayImports.h"
+
+// We still want to test APIs annotated as non-null for the proper behavior, so disable warnings for nullability annotations.
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnonnull"
+
+@interface INTUGroupedArrayBuilderTests : XCTestCase
+
+@end
+
+/**
+ Unit tests for the INTUGroupedArrayBuilder class.
+ */
+@implementation INTUGroupedArrayBuilderTests
+
+/**
+ Test building grouped arrays from individual objects, arrays of objects, and C arrays of objects.
+ */
+- (void)testBuild
+{
+    INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+    XCTAssert([[builder build] countAllSections] == 0);
+    
+    [builder addObject:@"Alfa" toSection:@"Section 1"];
+    [builder addObject:@"Bravo" toSection:@"Section 1"];
+    [builder addObject:@"Charlie" toSection:@"Section 2"];
+    [builder addObject:@"Delta" toSection:[@"Section 1" mutableCopy]];
+    [builder addObjectsFromArray:@[@"Echo", @"Foxtrot"] toSection:@"Section 3"];
+    [builder addObjectsFromArray:@[] toSection:@"Section 4"];
+    [builder addObjectsFromArray:nil toSection:@"Section 4"];
+    id objects[] = {@"Golf", @"Hotel"};
+    [builder addObjects:objects count:2 toSection:@"Section 2"];
+    [builder addObjects:NULL count:0 toSection:@"Section 5"];
+    XCTAssert([builder countAllSections] == 3);
+    XCTAssert([builder countAllObjects] == 8);
+    
+    INTUGroupedArray *groupedArray = [builder build];
+    XCTAssert([groupedArray isMemberOfClass:[INTUGroupedArray class]]);
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo", @"Delta"],
+                                                                     @"Section 2", @[@"Charlie", @"Golf", @"Hotel"],
+                                                                     @"Section 3", @[@"Echo", @"Foxtrot"]]]));
+    XCTAssert([groupedArray countAllObjects] == 8);
+    
+    // The builder is reset after building, and does not affect grouped arrays it has already built
+    XCTAssert([builder countAllSections] == 0);
+    XCTAssert([builder countAllObjects] == 0);
+    [builder addObject:@"India" toSection:@"Section 1"];
+    XCTAssertEqualObjects([builder build], [INTUGroupedArray literal:@[@"Section 1", @[@"India"]]]);
+    XCTAssert([groupedArray countObjectsInSection:@"Section 1"] == 3);
+    
+    // Mutable copies of a built grouped array do not affect it
+    INTUMutableGroupedArray *mutableGroupedArray = [groupedArray mutableCopy];
+    [mutableGroupedArray addObject:@"Juliett" toSection:@"Section 3"];
+    XCTAssert([groupedArray countObjectsInSection:@"Section 3"] == 2);
+    
+    XCTAssertThrows([builder addObject:nil toSection:@"Section 1"]);
+    XCTAssertThrows([builder addObject:@"Kilo" toSection:nil]);
+    XCTAssertThrows([builder addObjectsFromArray:@[@"Kilo"] toSection:nil]);
+    XCTAssert([builder countAllObjects] == 0);
+}
+
+/**
+ Test building grouped arrays when the objects of each section are added together, and then when an object is added to an earlier
+ section after that, which changes how the builder stores the objects.
+ */
+- (void)testBuildSortedBySection
+{
+    INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+    for (NSUInteger i = 0; i < 3; i++) {
+        [builder addObject:@"Alfa" toSection:@"Section 1"];
+        [builder addObjectsFromArray:@[@"Bravo", @"Charlie"] toSection:@"Section 1"];
+        id objects[] = {@"Delta", @"Echo"};
+        [builder addObjects:objects count:2 toSection:@"Section 2"];
+        [builder addObject:@"Foxtrot" toSection:@"Section 3"];
+        XCTAssert([builder countAllSections] == 3);
+        XCTAssert([builder countAllObjects] == 6);
+        if (i == 1) {
+            [builder addObject:@"Golf" toSection:@"Section 2"];
+            [builder addObject:@"Hotel" toSection:@"Section 4"];
+            [builder addObject:@"India" toSection:@"Section 1"];
+        }
+        
+        INTUGroupedArray *groupedArray = [builder build];
+        INTUGroupedArray *expectedGroupedArray = (i == 1) ? [INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo", @"Charlie", @"India"],
+                                                                                       @"Section 2", @[@"Delta", @"Echo", @"Golf"],
+                                                                                       @"Section 3", @[@"Foxtrot"],
+                                                                                       @"Section 4", @[@"Hotel"]]]
+                                                          : [INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo", @"Charlie"],
+                                                                                       @"Section 2", @[@"Delta", @"Echo"],
+                                                                                       @"Section 3", @[@"Foxtrot"]]];
+        XCTAssertEqualObjects(groupedArray, expectedGroupedArray);
+        XCTAssertEqualObjects([groupedArray objectsInSection:@"Section 2"], [expectedGroupedArray objectsInSection:@"Section 2"]);
+        XCTAssertEqualObjects([groupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:2]], @"Foxtrot");
+        XCTAssertEqualObjects([groupedArray indexPathOfObject:@"Echo"], [INTUGroupedArray indexPathForRow:1 inSection:1]);
+        
+        // Mutable copies of a built grouped array do not affect it, whichever way it was stored
+        INTUMutableGroupedArray *mutableGroupedArray = [groupedArray mutableCopy];
+        [mutableGroupedArray addObject:@"Juliett" toSection:@"Section 1"];
+        [mutableGroupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1]];
+        XCTAssertEqualObjects(groupedArray, expectedGroupedArray);
+        
+        // The builder is reset after building, so each pass starts over
+        XCTAssert([builder countAllSections] == 0);
+        XCTAssert([builder countAllObjects] == 0);
+    }
+}
+
+/**
+ Test building a grouped array by appending a whole run of objects to each of many sections, which must not grow the storage faster than
+ the number of objects added.
+ */
+- (void)testBuildManySections
+{
+    INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+    INTUMutableGroupedArray *expectedGroupedArray = [INTUMutableGroupedArray new];
+    NSUInteger sectionCount = 500;
+    for (NSUInteger section = 0; section < sectionCount; section++) {
+        NSArray *objects = @[@(section * 3), @(section * 3 + 1), @(section * 3 + 2)];
+        if (section % 2 == 0) {
+            [builder addObjectsFromArray:objects toSection:@(section)];
+        } else {
+            id objectsBuffer[] = {objects[0], objects[1], objects[2]};
+            [builder addObjects:objectsBuffer count:3 toSection:@(section)];
+        }
+        [expectedGroupedArray addObjectsFromArray:objects toSection:@(section)];
+    }
+    XCTAssert([builder countAllSections] == sectionCount);
+    XCTAssert([builder countAllObjects] == sectionCount * 3);
+
+    INTUGroupedArray *groupedArray = [builder build];
+    XCTAssertEqualObjects(groupedArray, expectedGroupedArray);
+    XCTAssertEqualObjects([groupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:2 inSection:sectionCount - 1]], @(sectionCount * 3 - 1));
+}
+
+/**
+ Test that reserving capacity does not change the sections & objects that have already been added, and that options are applied.
+ */
+- (void)testReserveCapacityAndOptions
+{
+    INTUGroupedArrayBuilder *builder = [[INTUGroupedArrayBuilder alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [builder addObject:@"Alfa" toSection:@"Section 1"];
+    [builder addObject:@"Bravo" toSection:@"Section 2"];
+    [builder reserveCapacityForSections:100 objectsPerSection:10];
+    [builder addObject:@"Charlie" toSection:@"Section 1"];
+    [builder addObject:@"Delta" toSection:@"Section 3"];
+    [builder reserveCapacityForSections:1 objectsPerSection:0];
+    [builder addObject:@"Echo" toSection:@"Section 2"];
+    
+    INTUGroupedArray *groupedArray = [builder build];
+    XCTAssert(groupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Charlie"],
+                                                                     @"Section 2", @[@"Bravo", @"Echo"],
+                                                                     @"Section 3", @[@"Delta"]]]));
+    XCTAssert([groupedArray indexOfSection:@"Section 3"] == 2);
+}
+
+/**
+ Test the performance of building a large grouped array with the builder.
+ */
+- (void)testBuilderPerformance
+{
+    [self measureBlock:^{
+        INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+        [builder reserveCapacityForSections:100 objectsPerSection:10000];
+        for (NSUInteger object = 0; object < 1000000; object++) {
+            [builder addObject:@(object) toSection:@(object / 10000)];
+        }
+        XCTAssert([[builder build] countAllObjects] == 1000000);
+    }];
+}
+
+/**
+ Test the performance of building the same grouped array as -[testBuilderPerformance] by copying a mutable grouped array, for comparison.
+ */
+- (void)testMutableCopyPerformance
+{
+    [self measureBlock:^{
+        INTUMutableGroupedArray *mutableGroupedArray = [INTUMutableGroupedArray new];
+        for (NSUInteger object = 0; object < 1000000; object++) {
+            [mutableGroupedArray addObject:@(object) toSection:@(object / 10000) withSectionIndexHint:object / 10000];
+        }
+        XCTAssert([[mutableGroupedArray copy] countAllObjects] == 1000000);
+    }];
+}
+
+@end
+
+#pragma clang diagnostic pop
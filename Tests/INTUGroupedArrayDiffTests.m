@@ -0,0 +1,248 @@
+//
+//  INTUGroupedArrayDiffTests.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "INTUGroupedArrayImports.h"
+
+// We still want to test APIs annotated as non-null for the proper behavior, so disable warnings for nullability annotations.
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnonnull"
+
+@interface INTUGroupedArrayDiffTests : XCTestCase
+
+@end
+
+/**
+ Unit tests for the INTUGroupedArrayDiff class.
+ */
+@implementation INTUGroupedArrayDiffTests
+
+// Some objects used across multiple unit test methods
+static const NSString *objectA = @"Alfa";
+static const NSString *objectB = @"Bravo";
+static const NSString *objectC = @"Charlie";
+static const NSString *objectD = @"Delta";
+static const NSString *objectE = @"Echo";
+
+// Some sections used across multiple unit test methods
+static const NSString *sectionW = @"Whiskey";
+static const NSString *sectionX = @"Xray";
+static const NSString *sectionY = @"Yankee";
+static const NSString *sectionZ = @"Zulu";
+
+/**
+ Helper method that applies the diff to the old grouped array the same way a UITableView applies batch updates, and returns the result.
+ Sections & objects that were inserted or moved are placed at their new indices, and the remaining sections & objects from the old
+ grouped array that were not deleted or moved fill in the other indices in their original order.
+ */
+- (INTUGroupedArray *)groupedArrayByApplyingDiff:(INTUGroupedArrayDiff *)diff toGroupedArray:(INTUGroupedArray *)oldGroupedArray newGroupedArray:(INTUGroupedArray *)newGroupedArray
+{
+    // Place each section at its new index
+    NSUInteger newSectionCount = [newGroupedArray countAllSections];
+    NSMutableArray *oldSectionIndexes = [NSMutableArray arrayWithCapacity:newSectionCount];
+    for (NSUInteger i = 0; i < newSectionCount; i++) {
+        [oldSectionIndexes addObject:[NSNull null]];
+    }
+    [diff.insertedSections enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        oldSectionIndexes[idx] = @(NSNotFound);
+    }];
+    NSMutableIndexSet *unchangedSections = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [oldGroupedArray countAllSections])];
+    [unchangedSections removeIndexes:diff.deletedSections];
+    [diff enumerateMovedSectionsUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex, BOOL *stop) {
+        oldSectionIndexes[toIndex] = @(fromIndex);
+        [unchangedSections removeIndex:fromIndex];
+    }];
+    __block NSUInteger unchangedSection = [unchangedSections firstIndex];
+    for (NSUInteger i = 0; i < newSectionCount; i++) {
+        if (oldSectionIndexes[i] == [NSNull null]) {
+            XCTAssert(unchangedSection != NSNotFound, @"There should be an old section left to fill each remaining index.");
+            oldSectionIndexes[i] = @(unchangedSection);
+            unchangedSection = [unchangedSections indexGreaterThanIndex:unchangedSection];
+        }
+    }
+    XCTAssert(unchangedSection == NSNotFound, @"All the unchanged old sections should have been used.");
+    
+    // Place each object at its new index path
+    NSMutableSet *removedIndexPaths = [NSMutableSet setWithArray:diff.deletedIndexPaths];
+    NSMutableDictionary *placedObjects = [NSMutableDictionary dictionary];
+    for (NSIndexPath *indexPath in diff.insertedIndexPaths) {
+        placedObjects[indexPath] = [newGroupedArray objectAtIndexPath:indexPath];
+    }
+    [diff enumerateMovedObjectsUsingBlock:^(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop) {
+        placedObjects[toIndexPath] = [oldGroupedArray objectAtIndexPath:fromIndexPath];
+        [removedIndexPaths addObject:fromIndexPath];
+    }];
+    INTUMutableGroupedArray *result = [INTUMutableGroupedArray new];
+    for (NSUInteger newSectionIndex = 0; newSectionIndex < newSectionCount; newSectionIndex++) {
+        NSUInteger oldSectionIndex = [oldSectionIndexes[newSectionIndex] unsignedIntegerValue];
+        if (oldSectionIndex == NSNotFound) {
+            [result addObjectsFromArray:[newGroupedArray objectsInSectionAtIndex:newSectionIndex] toSection:[newGroupedArray sectionAtIndex:newSectionIndex]];
+            continue;
+        }
+        id section = [oldGroupedArray sectionAtIndex:oldSectionIndex];
+        NSMutableArray *unchangedObjects = [NSMutableArray array];
+        for (NSUInteger objectIndex = 0; objectIndex < [oldGroupedArray countObjectsInSectionAtIndex:oldSectionIndex]; objectIndex++) {
+            NSIndexPath *indexPath = [INTUGroupedArray indexPathForRow:objectIndex inSection:oldSectionIndex];
+            if (![removedIndexPaths containsObject:indexPath]) {
+                [unchangedObjects addObject:[oldGroupedArray objectAtIndexPath:indexPath]];
+            }
+        }
+        NSUInteger objectCount = [newGroupedArray countObjectsInSectionAtIndex:newSectionIndex];
+        for (NSUInteger objectIndex = 0; objectIndex < objectCount; objectIndex++) {
+            id object = placedObjects[[INTUGroupedArray indexPathForRow:objectIndex inSection:newSectionIndex]];
+            if (!object) {
+                XCTAssert([unchangedObjects count] > 0, @"There should be an old object left to fill each remaining index.");
+                object = [unchangedObjects firstObject];
+                [unchangedObjects removeObjectAtIndex:0];
+            }
+            [result addObject:object toSection:section];
+        }
+        XCTAssert([unchangedObjects count] == 0, @"All the unchanged old objects should have been used.");
+    }
+    return result;
+}
+
+/**
+ Helper method that diffs the two grouped arrays, and verifies that applying the diff to the old grouped array results in the new grouped array.
+ */
+- (INTUGroupedArrayDiff *)verifiedDiffFromGroupedArray:(INTUGroupedArray *)oldGroupedArray toGroupedArray:(INTUGroupedArray *)newGroupedArray
+{
+    INTUGroupedArrayDiff *diff = [INTUGroupedArrayDiff diffFromGroupedArray:oldGroupedArray toGroupedArray:newGroupedArray];
+    XCTAssertNotNil(diff);
+    INTUGroupedArray *result = [self groupedArrayByApplyingDiff:diff toGroupedArray:oldGroupedArray newGroupedArray:newGroupedArray];
+    XCTAssert([result isEqualToGroupedArray:newGroupedArray], @"Applying the diff %@ to %@ should result in %@, not %@.", diff, oldGroupedArray, newGroupedArray, result);
+    return diff;
+}
+
+/**
+ Test that there are no changes between equal grouped arrays, including those with duplicate objects.
+ */
+- (void)testDiffOfEqualGroupedArrays
+{
+    INTUGroupedArray *groupedArray = [INTUGroupedArray literal:@[sectionW, @[objectA, objectB, objectA],
+                                                                sectionX, @[objectB, objectB, objectC]]];
+    INTUGroupedArrayDiff *diff = [self verifiedDiffFromGroupedArray:groupedArray toGroupedArray:[groupedArray mutableCopy]];
+    XCTAssertFalse([diff hasChanges]);
+    
+    diff = [self verifiedDiffFromGroupedArray:[INTUGroupedArray new] toGroupedArray:[INTUGroupedArray new]];
+    XCTAssertFalse([diff hasChanges]);
+    
+    XCTAssertNil([INTUGroupedArrayDiff diffFromGroupedArray:groupedArray toGroupedArray:nil]);
+}
+
+/**
+ Test diffing sections that are deleted, inserted, and moved.
+ */
+- (void)testDiffOfSections
+{
+    INTUGroupedArray *oldGroupedArray = [INTUGroupedArray literal:@[sectionW, @[objectA], sectionX, @[objectB], sectionY, @[objectC]]];
+    INTUGroupedArray *newGroupedArray = [INTUGroupedArray literal:@[sectionY, @[objectC], sectionZ, @[objectD], sectionX, @[objectB]]];
+    INTUGroupedArrayDiff *diff = [self verifiedDiffFromGroupedArray:oldGroupedArray toGroupedArray:newGroupedArray];
+    XCTAssertTrue([diff hasChanges]);
+    XCTAssertEqualObjects(diff.deletedSections, [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqualObjects(diff.insertedSections, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssert([diff countMovedSections] >= 1);
+    XCTAssert([diff countDeletedObjects] == 0, @"Objects in deleted sections should not be reported as deleted.");
+    XCTAssert([diff countInsertedObjects] == 0, @"Objects in inserted sections should not be reported as inserted.");
+    XCTAssert([diff countMovedObjects] == 0);
+}
+
+/**
+ Test diffing objects that are deleted, inserted, and moved, including between sections.
+ */
+- (void)testDiffOfObjects
+{
+    INTUGroupedArray *oldGroupedArray = [INTUGroupedArray literal:@[sectionW, @[objectA, objectB, objectC], sectionX, @[objectD]]];
+    INTUGroupedArray *newGroupedArray = [INTUGroupedArray literal:@[sectionW, @[objectC, objectA, objectE], sectionX, @[objectD, objectB]]];
+    INTUGroupedArrayDiff *diff = [self verifiedDiffFromGroupedArray:oldGroupedArray toGroupedArray:newGroupedArray];
+    XCTAssert([diff.deletedSections count] == 0);
+    XCTAssert([diff.insertedSections count] == 0);
+    XCTAssert([diff countMovedSections] == 0);
+    XCTAssert([diff countDeletedObjects] == 0);
+    XCTAssertEqualObjects(diff.insertedIndexPaths, @[[INTUGroupedArray indexPathForRow:2 inSection:0]]);
+    
+    __block BOOL movedBetweenSections = NO;
+    [diff enumerateMovedObjectsUsingIndexPairBlock:^(INTUIndexPair fromIndexPair, INTUIndexPair toIndexPair, BOOL *stop) {
+        if (fromIndexPair.sectionIndex == 0 && fromIndexPair.objectIndex == 1) {
+            XCTAssert(toIndexPair.sectionIndex == 1 && toIndexPair.objectIndex == 1);
+            movedBetweenSections = YES;
+        }
+    }];
+    XCTAssertTrue(movedBetweenSections, @"Object B should be moved from section W to section X.");
+    
+    diff = [self verifiedDiffFromGroupedArray:newGroupedArray toGroupedArray:oldGroupedArray];
+    XCTAssertEqualObjects(diff.deletedIndexPaths, @[[INTUGroupedArray indexPathForRow:2 inSection:0]]);
+}
+
+/**
+ Test that randomly generated pairs of grouped arrays are diffed correctly.
+ */
+- (void)testDiffOfRandomGroupedArrays
+{
+    srand48(42);
+    for (NSUInteger trial = 0; trial < 500; trial++) {
+        INTUMutableGroupedArray *oldGroupedArray = [INTUMutableGroupedArray new];
+        INTUMutableGroupedArray *newGroupedArray = [INTUMutableGroupedArray new];
+        for (INTUMutableGroupedArray *groupedArray in @[oldGroupedArray, newGroupedArray]) {
+            NSUInteger objectCount = (NSUInteger)(drand48() * 30);
+            for (NSUInteger i = 0; i < objectCount; i++) {
+                // Use few distinct sections & objects so that there are plenty of matches and duplicates
+                [groupedArray addObject:@((NSUInteger)(drand48() * 8)) toSection:@((NSUInteger)(drand48() * 6))];
+            }
+        }
+        [self verifiedDiffFromGroupedArray:oldGroupedArray toGroupedArray:newGroupedArray];
+    }
+}
+
+/**
+ Test the performance of diffing two large grouped arrays with a small number of changes.
+ */
+- (void)testDiffPerformance
+{
+    INTUMutableGroupedArray *mutableGroupedArray = [INTUMutableGroupedArray new];
+    for (NSUInteger section = 0; section < 100; section++) {
+        for (NSUInteger object = 0; object < 1000; object++) {
+            [mutableGroupedArray addObject:@(section * 1000 + object) toSection:@(section) withSectionIndexHint:section];
+        }
+    }
+    INTUGroupedArray *oldGroupedArray = [mutableGroupedArray copy];
+    for (NSUInteger section = 0; section < 100; section += 10) {
+        [mutableGroupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:500 inSection:section]];
+        [mutableGroupedArray moveObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:section] toIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:section + 1]];
+        [mutableGroupedArray addObject:@(-1) toSectionAtIndex:section];
+    }
+    [mutableGroupedArray moveSectionAtIndex:0 toIndex:99];
+    INTUGroupedArray *newGroupedArray = [mutableGroupedArray copy];
+    
+    [self measureBlock:^{
+        INTUGroupedArrayDiff *diff = [INTUGroupedArrayDiff diffFromGroupedArray:oldGroupedArray toGroupedArray:newGroupedArray];
+        XCTAssert([diff countDeletedObjects] == 10);
+    }];
+}
+
+@end
+
+#pragma clang diagnostic pop
@@ -0,0 +1,223 @@
+//
+//  INTUGroupedArrayInstrumentationTests.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "INTUGroupedArrayImports.h"
+
+@interface INTUGroupedArrayInstrumentationTests : XCTestCase
+
+@end
+
+/**
+ Unit tests for the INTUGroupedArrayInstrumentation class. Most of these only verify the counters when the library is built with
+ INTU_GROUPED_ARRAY_INSTRUMENTATION=1; otherwise they verify that the snapshots are empty.
+ */
+@implementation INTUGroupedArrayInstrumentationTests
+
+- (void)setUp
+{
+    [super setUp];
+    [INTUGroupedArrayInstrumentation reset];
+}
+
+/**
+ Helper method that returns the current value of the counter.
+ */
+- (uint64_t)valueOfCounter:(NSString *)counter
+{
+    return [[INTUGroupedArrayInstrumentation snapshot][INTUGroupedArrayInstrumentationCountersKey][counter] unsignedLongLongValue];
+}
+
+/**
+ Test that snapshots are empty when the instrumentation is compiled out.
+ */
+- (void)testSnapshotWhenDisabled
+{
+    if ([INTUGroupedArrayInstrumentation isEnabled]) {
+        return;
+    }
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+    [groupedArray addObject:@"Alfa" toSection:@"Section 1"];
+    NSDictionary *snapshot = [INTUGroupedArrayInstrumentation snapshot];
+    XCTAssertEqualObjects(snapshot[INTUGroupedArrayInstrumentationCountersKey], @{});
+    XCTAssertEqualObjects(snapshot[INTUGroupedArrayInstrumentationTimingsKey], @{});
+}
+
+/**
+ Test the counters of section lookups and section index hints.
+ */
+- (void)testSectionLookupCounters
+{
+    if (![INTUGroupedArrayInstrumentation isEnabled]) {
+        return;
+    }
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Alfa"], @"Section 2", @[@"Bravo"], @"Section 3", @[@"Charlie"]]];
+    [INTUGroupedArrayInstrumentation reset];
+    
+    XCTAssert([groupedArray indexOfSection:@"Section 3"] == 2);
+    XCTAssert([groupedArray indexOfSection:@"Nonexistent Section"] == NSNotFound);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionLookupsCounter] == 2);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionLookupScansCounter] == 2);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionsScannedCounter] == 6);
+    
+    [INTUGroupedArrayInstrumentation reset];
+    [groupedArray addObject:@"Delta" toSection:@"Section 2" withSectionIndexHint:1];
+    [groupedArray addObject:@"Echo" toSection:@"Section 2" withSectionIndexHint:0];
+    [groupedArray addObject:@"Foxtrot" toSection:@"Section 2" withSectionIndexHint:NSNotFound];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionIndexHintHitsCounter] == 1);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionIndexHintMissesCounter] == 1);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionLookupsCounter] == 2, @"A section should be looked up for each missing or wrong hint.");
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationMutationsCounter] == 3);
+    
+    // With the hashed section index, lookups should not scan the sections
+    INTUGroupedArrayBuilder *builder = [[INTUGroupedArrayBuilder alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [builder addObject:@"Alfa" toSection:@"Section 1"];
+    INTUGroupedArray *hashedGroupedArray = [builder build];
+    [INTUGroupedArrayInstrumentation reset];
+    XCTAssert([hashedGroupedArray indexOfSection:@"Section 1"] == 0);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionLookupsCounter] == 1);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionLookupScansCounter] == 0);
+}
+
+/**
+ Test the counters of index paths created, objects copied, and comparisons performed.
+ */
+- (void)testOperationCounters
+{
+    if (![INTUGroupedArrayInstrumentation isEnabled]) {
+        return;
+    }
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo"], @"Section 2", @[@"Charlie"]]];
+    [INTUGroupedArrayInstrumentation reset];
+    
+    [groupedArray enumerateObjectsUsingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {}];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationIndexPathsCreatedCounter] == 3, @"An index path should be created for each object.");
+    
+    // Mutating a copy should copy the section container that is modified, and only that one
+    INTUMutableGroupedArray *copy = [groupedArray mutableCopy];
+    [INTUGroupedArrayInstrumentation reset];
+    [copy addObject:@"Delta" toSection:@"Section 1"];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCopiedCounter] == 1);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationObjectsCopiedCounter] == 2);
+    
+    [INTUGroupedArrayInstrumentation reset];
+    [copy sortUsingSectionComparator:nil objectComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) {
+        return [obj2 compare:obj1];
+    }];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationComparisonsCounter] > 0);
+    
+    [INTUGroupedArrayInstrumentation reset];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationComparisonsCounter] == 0, @"Resetting should set the counters to zero.");
+}
+
+/**
+ Test that views of a mutable grouped array only cause the sections in the view to be copied when they are modified.
+ */
+- (void)testViewCopyOnWriteCounters
+{
+    if (![INTUGroupedArrayInstrumentation isEnabled]) {
+        return;
+    }
+    // Add the objects directly (instead of using a literal), so that the grouped array owns all of its section containers
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+    [groupedArray addObjectsFromArray:@[@"Alfa", @"Bravo"] toSection:@"Section 1"];
+    [groupedArray addObject:@"Charlie" toSection:@"Section 2"];
+    [groupedArray addObject:@"Delta" toSection:@"Section 3"];
+    NSArray *objectsView = [groupedArray objectsViewInSectionAtIndex:0];
+    INTUGroupedArray *groupedArrayView = [groupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(0, 1) toIndexPair:INTUIndexPairMake(1, 0)];
+    
+    [INTUGroupedArrayInstrumentation reset];
+    [groupedArray addObject:@"Echo" toSection:@"Section 3"];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCopiedCounter] == 0, @"Sections outside the views should not be copied.");
+    [groupedArray addObject:@"Foxtrot" toSection:@"Section 1"];
+    [groupedArray addObject:@"Golf" toSection:@"Section 2"];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCopiedCounter] == 2);
+    [groupedArray addObject:@"Hotel" toSection:@"Section 1"];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCopiedCounter] == 2, @"A section should only be copied once.");
+    
+    XCTAssertEqualObjects(objectsView, (@[@"Alfa", @"Bravo"]));
+    XCTAssertEqualObjects([groupedArrayView allObjects], (@[@"Bravo", @"Charlie"]));
+}
+
+/**
+ Test that sections added after others were removed reuse their section containers instead of allocating new ones.
+ */
+- (void)testSectionContainerReuseCounters
+{
+    if (![INTUGroupedArrayInstrumentation isEnabled]) {
+        return;
+    }
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+    [INTUGroupedArrayInstrumentation reset];
+    [groupedArray addObject:@"Alfa" toSection:@"Section 1"];
+    [groupedArray addObject:@"Bravo" toSection:@"Section 2"];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCreatedCounter] == 2);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersReusedCounter] == 0);
+    
+    // Steady churn of sections should not allocate any section containers
+    [INTUGroupedArrayInstrumentation reset];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [groupedArray removeObject:@"Bravo" fromSection:@"Section 2"];
+        [groupedArray addObject:@"Bravo" toSection:@"Section 2"];
+    }
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCreatedCounter] == 0);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersReusedCounter] == 100);
+    
+    // A removed section that is shared with a copy must not be reused
+    INTUGroupedArray *copy = [groupedArray copy];
+    [INTUGroupedArrayInstrumentation reset];
+    [groupedArray removeSection:@"Section 2"];
+    [groupedArray addObject:@"Charlie" toSection:@"Section 3"];
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersCreatedCounter] == 1);
+    XCTAssert([self valueOfCounter:INTUGroupedArrayInstrumentationSectionContainersReusedCounter] == 0);
+    XCTAssertEqualObjects([copy objectsInSection:@"Section 2"], @[@"Bravo"]);
+}
+
+/**
+ Test the timings of the measured methods.
+ */
+- (void)testTimings
+{
+    if (![INTUGroupedArrayInstrumentation isEnabled]) {
+        return;
+    }
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo"], @"Section 2", @[@"Charlie"]]];
+    [INTUGroupedArrayInstrumentation reset];
+    
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertNotNil([groupedArray indexPathOfObject:@"Charlie"]);
+    }
+    NSDictionary *timings = [INTUGroupedArrayInstrumentation snapshot][INTUGroupedArrayInstrumentationTimingsKey];
+    NSDictionary *timing = timings[@"indexPathOfObject:"];
+    XCTAssertEqualObjects(timing[INTUGroupedArrayInstrumentationCallsKey], @3);
+    XCTAssertNotNil(timing[INTUGroupedArrayInstrumentationNanosecondsKey]);
+    XCTAssertNil(timings[@"removeObject:"], @"Methods that were not called should not have a timing.");
+    
+    [INTUGroupedArrayInstrumentation reset];
+    XCTAssert([[INTUGroupedArrayInstrumentation snapshot][INTUGroupedArrayInstrumentationTimingsKey] count] == 0);
+}
+
+@end
@@ -0,0 +1,313 @@
+//
+//  INTUGroupedArraySerializationTests.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import "INTUGroupedArrayImports.h"
+
+// We still want to test APIs annotated as non-null for the proper behavior, so disable warnings for nullability annotations.
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnonnull"
+
+@interface INTUGroupedArraySerializationTests : XCTestCase
+
+@end
+
+/**
+ Unit tests for the INTUGroupedArraySerialization class.
+ */
+@implementation INTUGroupedArraySerializationTests
+
+/**
+ Helper method that returns a grouped array containing every supported type of section & object.
+ */
+- (INTUGroupedArray *)groupedArrayWithAllSupportedTypes
+{
+    uint8_t bytes[] = {0x00, 0x01, 0xFE, 0xFF};
+    return [INTUGroupedArray literal:@[@"Strings", @[@"", @"Alfa", @"Ünïcödé ✓", [NSMutableString stringWithString:@"Mutable"]],
+                                       @42, @[@0, @-1, @(INT64_MIN), @(INT64_MAX), @(UINT64_MAX), @((short)7)],
+                                       @3.5, @[@0.0, @-2.25, @1e300, @((float)1.5)],
+                                       @YES, @[@YES, @NO],
+                                       [NSData dataWithBytes:bytes length:sizeof(bytes)], @[[NSData data], [NSData dataWithBytes:bytes length:sizeof(bytes)]]]];
+}
+
+/**
+ Test that grouped arrays are unchanged after serializing and deserializing them.
+ */
+- (void)testRoundTrip
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayWithAllSupportedTypes];
+    XCTAssertTrue([INTUGroupedArraySerialization isValidGroupedArray:groupedArray]);
+    NSError *error = nil;
+    NSData *data = [INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:&error];
+    XCTAssertNotNil(data);
+    XCTAssertNil(error);
+    INTUGroupedArray *decodedGroupedArray = [INTUGroupedArraySerialization groupedArrayWithData:data error:&error];
+    XCTAssertNotNil(decodedGroupedArray);
+    XCTAssertNil(error);
+    XCTAssert([decodedGroupedArray isMemberOfClass:[INTUGroupedArray class]]);
+    XCTAssertEqualObjects(groupedArray, decodedGroupedArray);
+    XCTAssertEqualObjects([decodedGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:4 inSection:1]], @(UINT64_MAX));
+    id decodedBoolean = [decodedGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:3]];
+    XCTAssert(CFGetTypeID((__bridge CFTypeRef)decodedBoolean) == CFBooleanGetTypeID() && [decodedBoolean boolValue], @"Booleans should be decoded as booleans.");
+    
+    // Test an empty grouped array with options
+    INTUGroupedArray *emptyGroupedArray = [[INTUGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    decodedGroupedArray = [INTUGroupedArraySerialization groupedArrayWithData:[INTUGroupedArraySerialization dataWithGroupedArray:emptyGroupedArray error:NULL] error:NULL];
+    XCTAssertNotNil(decodedGroupedArray);
+    XCTAssert([decodedGroupedArray countAllSections] == 0);
+    XCTAssert(decodedGroupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    
+    // Test that the options and section index are restored
+    INTUMutableGroupedArray *hashedGroupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [hashedGroupedArray addObject:@"Alfa" toSection:@"Whiskey"];
+    [hashedGroupedArray addObject:@"Bravo" toSection:@"Xray"];
+    decodedGroupedArray = [INTUGroupedArraySerialization groupedArrayWithData:[INTUGroupedArraySerialization dataWithGroupedArray:hashedGroupedArray error:NULL] error:NULL];
+    XCTAssertEqualObjects(hashedGroupedArray, decodedGroupedArray);
+    XCTAssert(decodedGroupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    XCTAssert([decodedGroupedArray indexOfSection:@"Xray"] == 1);
+}
+
+/**
+ Test that grouped arrays containing unsupported types of objects are not serialized.
+ */
+- (void)testUnsupportedTypes
+{
+    NSArray *unsupportedValues = @[[NSObject new], [NSDate date], @[@"Array"], [NSNull null]];
+    for (id value in unsupportedValues) {
+        for (INTUGroupedArray *groupedArray in @[[INTUGroupedArray literal:@[@"Section", @[@"Alfa", value]]], [INTUGroupedArray literal:@[value, @[@"Alfa"]]]]) {
+            XCTAssertFalse([INTUGroupedArraySerialization isValidGroupedArray:groupedArray]);
+            NSError *error = nil;
+            XCTAssertNil([INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:&error]);
+            XCTAssertEqualObjects(error.domain, INTUGroupedArraySerializationErrorDomain);
+            XCTAssert(error.code == INTUGroupedArraySerializationErrorUnsupportedType);
+        }
+    }
+    XCTAssertFalse([INTUGroupedArraySerialization isValidGroupedArray:[INTUGroupedArray groupedArrayWithArray:@[@"Alfa"]]], @"The default section ([NSObject new]) is not supported.");
+}
+
+/**
+ Test that truncated, corrupted, and invalid data is rejected.
+ */
+- (void)testInvalidData
+{
+    NSData *data = [INTUGroupedArraySerialization dataWithGroupedArray:[self groupedArrayWithAllSupportedTypes] error:NULL];
+    NSError *error = nil;
+    XCTAssertNil([INTUGroupedArraySerialization groupedArrayWithData:[NSData data] error:&error]);
+    XCTAssert(error.code == INTUGroupedArraySerializationErrorInvalidData);
+    XCTAssertNil([INTUGroupedArraySerialization groupedArrayWithData:[@"Not a grouped array" dataUsingEncoding:NSUTF8StringEncoding] error:NULL]);
+    XCTAssertNil([INTUGroupedArraySerialization groupedArrayWithData:[NSKeyedArchiver archivedDataWithRootObject:[self groupedArrayWithAllSupportedTypes]] error:NULL]);
+    
+    // Every truncated prefix of the data is invalid
+    for (NSUInteger length = 0; length < [data length]; length++) {
+        XCTAssertNil([INTUGroupedArraySerialization groupedArrayWithData:[data subdataWithRange:NSMakeRange(0, length)] error:NULL]);
+    }
+    
+    // Corrupting any byte must not crash (though changing the contents of a value may still produce a valid grouped array)
+    for (NSUInteger index = 0; index < [data length]; index++) {
+        NSMutableData *corruptData = [data mutableCopy];
+        ((uint8_t *)[corruptData mutableBytes])[index] ^= 0xFF;
+        INTUGroupedArray * __unused groupedArray = [INTUGroupedArraySerialization groupedArrayWithData:corruptData error:NULL];
+    }
+}
+
+/**
+ Helper method that writes the data to a new temporary file and returns its path.
+ */
+- (NSString *)temporaryFileWithData:(NSData *)data
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    XCTAssertTrue([data writeToFile:path atomically:YES]);
+    return path;
+}
+
+/**
+ Test that grouped arrays lazily deserialized from a memory mapped file are equal to the original grouped arrays.
+ */
+- (void)testLazyDeserialization
+{
+    INTUGroupedArray *supportedTypesGroupedArray = [self groupedArrayWithAllSupportedTypes];
+    INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    for (NSUInteger index = 0; index < [supportedTypesGroupedArray countAllSections]; index++) {
+        [groupedArray addObjectsFromArray:[supportedTypesGroupedArray objectsInSectionAtIndex:index] toSection:[supportedTypesGroupedArray sectionAtIndex:index]];
+    }
+    NSString *path = [self temporaryFileWithData:[INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:NULL]];
+    NSError *error = nil;
+    INTUGroupedArray *lazyGroupedArray = [INTUGroupedArraySerialization groupedArrayWithContentsOfFile:path error:&error];
+    XCTAssertNotNil(lazyGroupedArray);
+    XCTAssertNil(error);
+    XCTAssert(lazyGroupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    
+    // Counting the objects and locating sections does not require decoding the objects
+    XCTAssert([lazyGroupedArray countAllSections] == 5);
+    XCTAssert([lazyGroupedArray countAllObjects] == 14);
+    XCTAssert([lazyGroupedArray countObjectsInSectionAtIndex:1] == 6);
+    XCTAssert([lazyGroupedArray indexOfSection:@YES] == 3);
+    
+    XCTAssertEqualObjects([lazyGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:4 inSection:1]], @(UINT64_MAX));
+    XCTAssertEqualObjects([lazyGroupedArray objectsInSectionAtIndex:0], [groupedArray objectsInSectionAtIndex:0]);
+    XCTAssertEqualObjects(lazyGroupedArray, groupedArray);
+    XCTAssertEqualObjects([lazyGroupedArray mutableCopy], groupedArray);
+    XCTAssertEqualObjects([NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:lazyGroupedArray]], groupedArray);
+    
+    // Mutating a mutable copy does not affect the lazily deserialized grouped array
+    INTUMutableGroupedArray *mutableCopy = [[INTUGroupedArraySerialization lazyGroupedArrayWithData:[NSData dataWithContentsOfFile:path] error:NULL] mutableCopy];
+    [mutableCopy addObject:@"Bravo" toSection:@"Strings"];
+    XCTAssert([mutableCopy countObjectsInSectionAtIndex:0] == 5);
+    XCTAssert([lazyGroupedArray countObjectsInSectionAtIndex:0] == 4);
+    
+    XCTAssertNil([INTUGroupedArraySerialization groupedArrayWithContentsOfFile:[path stringByAppendingString:@".missing"] error:&error]);
+    XCTAssertNotNil(error);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+/**
+ Test that invalid sections are rejected up front when deserializing lazily, and that invalid objects are detected when they are accessed.
+ */
+- (void)testLazyInvalidData
+{
+    NSData *data = [INTUGroupedArraySerialization dataWithGroupedArray:[self groupedArrayWithAllSupportedTypes] error:NULL];
+    for (NSUInteger length = 0; length < [data length]; length++) {
+        XCTAssertNil([INTUGroupedArraySerialization lazyGroupedArrayWithData:[data subdataWithRange:NSMakeRange(0, length)] error:NULL]);
+    }
+    
+    // Corrupt the type of the first object in the first section, which follows the 40 byte header, the 6 entry section table,
+    // and the 12 byte encoded section (@"Strings")
+    NSMutableData *corruptData = [data mutableCopy];
+    ((uint8_t *)[corruptData mutableBytes])[40 + 6 * 16 + 12] ^= 0xFF;
+    XCTAssertNil([INTUGroupedArraySerialization groupedArrayWithData:corruptData error:NULL]);
+    INTUGroupedArray *lazyGroupedArray = [INTUGroupedArraySerialization lazyGroupedArrayWithData:corruptData error:NULL];
+    XCTAssertNotNil(lazyGroupedArray);
+    XCTAssert([lazyGroupedArray countObjectsInSectionAtIndex:0] == 4);
+    XCTAssertEqualObjects([lazyGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:3]], @NO);
+    XCTAssertThrows([lazyGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0]]);
+}
+
+/**
+ Test that lazily deserializing a grouped array with a hashed object index does not decode any objects until an object is looked up.
+ */
+- (void)testLazyDeserializationWithObjectIndex
+{
+    INTUGroupedArray *supportedTypesGroupedArray = [self groupedArrayWithAllSupportedTypes];
+    INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedObjectIndex];
+    for (NSUInteger index = 0; index < [supportedTypesGroupedArray countAllSections]; index++) {
+        [groupedArray addObjectsFromArray:[supportedTypesGroupedArray objectsInSectionAtIndex:index] toSection:[supportedTypesGroupedArray sectionAtIndex:index]];
+    }
+    NSData *data = [INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:NULL];
+    INTUGroupedArray *lazyGroupedArray = [INTUGroupedArraySerialization lazyGroupedArrayWithData:data error:NULL];
+    XCTAssert(lazyGroupedArray.options == INTUGroupedArrayOptionHashedObjectIndex);
+    XCTAssertTrue([lazyGroupedArray containsObject:@"Alfa"]);
+    XCTAssertEqualObjects([lazyGroupedArray indexPathOfObject:@"Alfa"], [INTUGroupedArray indexPathForRow:1 inSection:0]);
+    XCTAssertFalse([lazyGroupedArray containsObject:@"Bravo"]);
+    XCTAssertEqualObjects(lazyGroupedArray, groupedArray);
+    
+    // Corrupt the first object in the first section (see -[testLazyInvalidData]), which is only detected once that section is decoded
+    NSMutableData *corruptData = [data mutableCopy];
+    ((uint8_t *)[corruptData mutableBytes])[40 + 6 * 16 + 12] ^= 0xFF;
+    lazyGroupedArray = [INTUGroupedArraySerialization lazyGroupedArrayWithData:corruptData error:NULL];
+    XCTAssertNotNil(lazyGroupedArray, @"Loading should not decode the objects to build the object index.");
+    XCTAssert([lazyGroupedArray countAllObjects] == 14);
+    XCTAssertEqualObjects([lazyGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:3]], @NO);
+    XCTAssertThrows([lazyGroupedArray containsObject:@NO], @"Building the object index should decode every section.");
+}
+
+/**
+ Helper method that returns a large grouped array for the performance tests.
+ */
+- (INTUGroupedArray *)groupedArrayForPerformanceTests
+{
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+    for (NSUInteger section = 0; section < 100; section++) {
+        NSString *sectionName = [NSString stringWithFormat:@"Section %lu", (unsigned long)section];
+        for (NSUInteger object = 0; object < 1000; object++) {
+            id value = (object % 2 == 0) ? @(object) : [NSString stringWithFormat:@"Object %lu", (unsigned long)object];
+            [groupedArray addObject:value toSection:sectionName withSectionIndexHint:section];
+        }
+    }
+    return [groupedArray copy];
+}
+
+/**
+ Test the performance of deserializing a large grouped array from the binary format.
+ */
+- (void)testDeserializationPerformance
+{
+    NSData *data = [INTUGroupedArraySerialization dataWithGroupedArray:[self groupedArrayForPerformanceTests] error:NULL];
+    [self measureBlock:^{
+        XCTAssert([[INTUGroupedArraySerialization groupedArrayWithData:data error:NULL] countAllObjects] == 100000);
+    }];
+}
+
+/**
+ Test the performance of lazily deserializing the same grouped array as -[testDeserializationPerformance] from a memory mapped file,
+ and accessing the objects in one of its sections.
+ */
+- (void)testLazyDeserializationPerformance
+{
+    NSString *path = [self temporaryFileWithData:[INTUGroupedArraySerialization dataWithGroupedArray:[self groupedArrayForPerformanceTests] error:NULL]];
+    [self measureBlock:^{
+        INTUGroupedArray *groupedArray = [INTUGroupedArraySerialization groupedArrayWithContentsOfFile:path error:NULL];
+        XCTAssert([groupedArray countAllObjects] == 100000);
+        XCTAssert([[groupedArray objectsInSectionAtIndex:50] count] == 1000);
+    }];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+/**
+ Test the performance of unarchiving the same grouped array as -[testDeserializationPerformance] with NSKeyedUnarchiver, for comparison.
+ */
+- (void)testKeyedUnarchivingPerformance
+{
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:[self groupedArrayForPerformanceTests]];
+    [self measureBlock:^{
+        XCTAssert([[NSKeyedUnarchiver unarchiveObjectWithData:data] countAllObjects] == 100000);
+    }];
+}
+
+/**
+ Test the performance of serializing a large grouped array into the binary format.
+ */
+- (void)testSerializationPerformance
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    [self measureBlock:^{
+        XCTAssertNotNil([INTUGroupedArraySerialization dataWithGroupedArray:groupedArray error:NULL]);
+    }];
+}
+
+/**
+ Test the performance of archiving the same grouped array as -[testSerializationPerformance] with NSKeyedArchiver, for comparison.
+ */
+- (void)testKeyedArchivingPerformance
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    [self measureBlock:^{
+        XCTAssertNotNil([NSKeyedArchiver archivedDataWithRootObject:groupedArray]);
+    }];
+}
+
+@end
+
+#pragma clang diagnostic pop
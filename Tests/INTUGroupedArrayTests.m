@@ -158,6 +158,41 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertNoThrow([INTUGroupedArray literal:literal]);
 }
 
+/**
+ Test creating a grouped array by grouping the objects in an array by their section keys.
+ */
+- (void)testGroupedArrayByGroupingArray
+{
+    NSArray *words = @[@"banana", @"apple", @"cherry", @"avocado", @"blueberry", @"apricot", @"coconut"];
+    id (^firstLetter)(id) = ^id(NSString *word) {
+        return [word substringToIndex:1];
+    };
+    INTUGroupedArray *expectedGroupedArray = [INTUGroupedArray literal:@[@"b", @[@"banana", @"blueberry"],
+                                                                         @"a", @[@"apple", @"avocado", @"apricot"],
+                                                                         @"c", @[@"cherry", @"coconut"]]];
+    INTUGroupedArray *groupedArray = [INTUGroupedArray groupedArrayByGroupingArray:words sectionKeyBlock:firstLetter];
+    XCTAssert([groupedArray isMemberOfClass:[INTUGroupedArray class]]);
+    XCTAssertEqualObjects(groupedArray, expectedGroupedArray, @"Sections should be ordered by their first object, and objects should keep their order.");
+    
+    groupedArray = [INTUGroupedArray groupedArrayByGroupingArray:words withOptions:NSEnumerationConcurrent sectionKeyBlock:firstLetter sectionComparator:nil];
+    XCTAssertEqualObjects(groupedArray, expectedGroupedArray);
+    
+    groupedArray = [INTUGroupedArray groupedArrayByGroupingArray:words withOptions:0 sectionKeyBlock:firstLetter sectionComparator:^NSComparisonResult(NSString *section1, NSString *section2) {
+        return [section1 compare:section2];
+    }];
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"a", @[@"apple", @"avocado", @"apricot"],
+                                                                     @"b", @[@"banana", @"blueberry"],
+                                                                     @"c", @[@"cherry", @"coconut"]]]));
+    XCTAssertEqualObjects([groupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:2 inSection:0]], @"apricot");
+    XCTAssertEqualObjects([groupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:2]], @"coconut");
+    XCTAssertEqualObjects([groupedArray objectsInSection:@"b"], (@[@"banana", @"blueberry"]));
+    
+    XCTAssert([[INTUGroupedArray groupedArrayByGroupingArray:nil sectionKeyBlock:firstLetter] countAllSections] == 0);
+    XCTAssert([[INTUGroupedArray groupedArrayByGroupingArray:@[] sectionKeyBlock:firstLetter] countAllSections] == 0);
+    XCTAssertThrows([INTUGroupedArray groupedArrayByGroupingArray:words sectionKeyBlock:nil]);
+    XCTAssertThrows([INTUGroupedArray groupedArrayByGroupingArray:words sectionKeyBlock:^id(id object) { return nil; }]);
+}
+
 /**
  Test the grouped array's NSCoding methods.
  */
@@ -514,6 +549,115 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssert([self.groupedArray lastObject] == objectD, @"The last object should be Object D.");
 }
 
+/**
+ Test the countAllObjects, objectAtFlatIndex:, indexPairForFlatIndex: and flatIndexForIndexPair: methods.
+ */
+- (void)testFlatIndex
+{
+    XCTAssertTrue([self.groupedArray countAllObjects] == 0, @"The grouped array should be empty.");
+    XCTAssertThrows([self.groupedArray objectAtFlatIndex:0]);
+    
+    [self addUnsortedSectionsAndObjects];
+    
+    XCTAssertTrue([self.groupedArray countAllObjects] == 8, @"There should be 8 objects total.");
+    NSArray *allObjects = [self.groupedArray allObjects];
+    NSUInteger flatIndex = 0;
+    for (NSUInteger sectionIndex = 0; sectionIndex < [self.groupedArray countAllSections]; sectionIndex++) {
+        for (NSUInteger objectIndex = 0; objectIndex < [self.groupedArray countObjectsInSectionAtIndex:sectionIndex]; objectIndex++) {
+            INTUIndexPair indexPair = [self.groupedArray indexPairForFlatIndex:flatIndex];
+            XCTAssertTrue(indexPair.sectionIndex == sectionIndex && indexPair.objectIndex == objectIndex, @"The flat index should convert to the index pair.");
+            XCTAssertTrue([self.groupedArray flatIndexForIndexPair:INTUIndexPairMake(sectionIndex, objectIndex)] == flatIndex, @"The index pair should convert to the flat index.");
+            XCTAssertEqual([self.groupedArray objectAtFlatIndex:flatIndex], allObjects[flatIndex], @"The object at the flat index should match.");
+            flatIndex++;
+        }
+    }
+    XCTAssertThrows([self.groupedArray objectAtFlatIndex:8]);
+    XCTAssertThrows([self.groupedArray indexPairForFlatIndex:8]);
+    XCTAssertThrows([self.groupedArray flatIndexForIndexPair:INTUIndexPairMake(1, 2)]);
+    XCTAssertThrows([self.groupedArray flatIndexForIndexPair:INTUIndexPairMake(4, 0)]);
+    
+    // Make sure the cumulative object counts are updated after the grouped array is mutated
+    INTUMutableGroupedArray *mutableGroupedArray = [self.groupedArray mutableCopy];
+    XCTAssertTrue([mutableGroupedArray countAllObjects] == 8, @"There should be 8 objects total.");
+    [mutableGroupedArray insertObject:objectF atIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1]];
+    XCTAssertTrue([mutableGroupedArray countAllObjects] == 9, @"There should be 9 objects total.");
+    XCTAssertEqual([mutableGroupedArray objectAtFlatIndex:4], objectF, @"The inserted object should be at flat index 4.");
+    XCTAssertTrue([mutableGroupedArray flatIndexForIndexPair:INTUIndexPairMake(3, 0)] == 8, @"The last object should be at flat index 8.");
+    [mutableGroupedArray removeSectionAtIndex:0];
+    XCTAssertTrue([mutableGroupedArray countAllObjects] == 5, @"There should be 5 objects total.");
+    XCTAssertEqual([mutableGroupedArray objectAtFlatIndex:0], objectF, @"The inserted object should now be at flat index 0.");
+    [mutableGroupedArray removeAllObjects];
+    XCTAssertTrue([mutableGroupedArray countAllObjects] == 0, @"The grouped array should be empty.");
+}
+
+/**
+ Test the objectsViewInSectionAtIndex:, objectsViewInSection:, allObjectsView and groupedArrayViewFromIndexPair:toIndexPair: methods,
+ on grouped arrays backed by section containers and by contiguous storage, and that the views do not change when the grouped array is mutated.
+ */
+- (void)testViews
+{
+    [self addUnsortedSectionsAndObjects];
+    INTUGroupedArray *expectedGroupedArray = self.groupedArray;
+    INTUMutableGroupedArray *mutableGroupedArray = [expectedGroupedArray mutableCopy];
+    NSArray *expectedObjects = [expectedGroupedArray allObjects];
+    INTUGroupedArray *contiguousGroupedArray = [[INTUGroupedArray alloc] initWithGroupedArray:expectedGroupedArray];
+    
+    for (INTUGroupedArray *groupedArray in @[mutableGroupedArray, expectedGroupedArray, contiguousGroupedArray]) {
+        NSArray *allObjectsView = [groupedArray allObjectsView];
+        XCTAssertEqualObjects(allObjectsView, expectedObjects, @"The flattened view should contain all objects in order.");
+        XCTAssert([allObjectsView count] == 8);
+        XCTAssertEqual(allObjectsView[5], expectedObjects[5]);
+        XCTAssertThrows(allObjectsView[8]);
+        NSMutableArray *enumeratedObjects = [NSMutableArray array];
+        for (id object in allObjectsView) {
+            [enumeratedObjects addObject:object];
+        }
+        XCTAssertEqualObjects(enumeratedObjects, expectedObjects, @"Fast enumeration of the flattened view should return all objects in order.");
+        XCTAssertEqualObjects([allObjectsView subarrayWithRange:NSMakeRange(2, 4)], [expectedObjects subarrayWithRange:NSMakeRange(2, 4)]);
+        
+        for (NSUInteger sectionIndex = 0; sectionIndex < [groupedArray countAllSections]; sectionIndex++) {
+            XCTAssertEqualObjects([groupedArray objectsViewInSectionAtIndex:sectionIndex], [expectedGroupedArray objectsInSectionAtIndex:sectionIndex]);
+            id section = [groupedArray sectionAtIndex:sectionIndex];
+            XCTAssertEqualObjects([groupedArray objectsViewInSection:section], [expectedGroupedArray objectsInSection:section]);
+        }
+        XCTAssertNil([groupedArray objectsViewInSection:@"Missing Section"]);
+        XCTAssertThrows([groupedArray objectsViewInSectionAtIndex:4]);
+        
+        // A view across sections, starting & ending in the middle of a section
+        INTUGroupedArray *groupedArrayView = [groupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(0, 1) toIndexPair:INTUIndexPairMake(2, 0)];
+        XCTAssert([groupedArrayView countAllSections] == 3);
+        XCTAssertEqualObjects([groupedArrayView allSections], [[expectedGroupedArray allSections] subarrayWithRange:NSMakeRange(0, 3)]);
+        NSUInteger firstFlatIndex = [expectedGroupedArray flatIndexForIndexPair:INTUIndexPairMake(0, 1)];
+        NSUInteger lastFlatIndex = [expectedGroupedArray flatIndexForIndexPair:INTUIndexPairMake(2, 0)];
+        XCTAssertEqualObjects([groupedArrayView allObjects], [expectedObjects subarrayWithRange:NSMakeRange(firstFlatIndex, lastFlatIndex - firstFlatIndex + 1)]);
+        XCTAssertEqualObjects([groupedArrayView objectsInSectionAtIndex:1], [expectedGroupedArray objectsInSectionAtIndex:1], @"Sections entirely in the range should be included in full.");
+        XCTAssertEqualObjects([NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:groupedArrayView]], groupedArrayView);
+        
+        // A view of a single object, and of the whole grouped array
+        INTUGroupedArray *singleObjectView = [groupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(1, 1) toIndexPair:INTUIndexPairMake(1, 1)];
+        XCTAssertEqualObjects([singleObjectView allObjects], @[[expectedGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:1]]]);
+        INTUGroupedArray *wholeView = [groupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(0, 0) toIndexPair:INTUIndexPairMake(3, [expectedGroupedArray countObjectsInSectionAtIndex:3] - 1)];
+        XCTAssertEqualObjects(wholeView, expectedGroupedArray);
+        
+        XCTAssertThrows([groupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(2, 0) toIndexPair:INTUIndexPairMake(0, 1)]);
+        XCTAssertThrows([groupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(0, 0) toIndexPair:INTUIndexPairMake(4, 0)]);
+    }
+    
+    // Views of a mutable grouped array should not change when it is mutated
+    NSArray *objectsView = [mutableGroupedArray objectsViewInSectionAtIndex:0];
+    NSArray *objectsInSection = [mutableGroupedArray objectsInSectionAtIndex:0];
+    NSArray *allObjectsView = [mutableGroupedArray allObjectsView];
+    INTUGroupedArray *groupedArrayView = [mutableGroupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(0, 1) toIndexPair:INTUIndexPairMake(1, 0)];
+    INTUGroupedArray *expectedGroupedArrayView = [groupedArrayView copy];
+    XCTAssertEqualObjects(expectedGroupedArrayView, groupedArrayView);
+    [mutableGroupedArray insertObject:objectF atIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0]];
+    [mutableGroupedArray replaceObjectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:1] withObject:objectE];
+    [mutableGroupedArray removeSectionAtIndex:2];
+    XCTAssertEqualObjects(objectsView, objectsInSection, @"The section view should not change when the grouped array is mutated.");
+    XCTAssertEqualObjects(allObjectsView, expectedObjects, @"The flattened view should not change when the grouped array is mutated.");
+    XCTAssertEqualObjects(groupedArrayView, [expectedGroupedArray groupedArrayViewFromIndexPair:INTUIndexPairMake(0, 1) toIndexPair:INTUIndexPairMake(1, 0)], @"The grouped array view should not change when the grouped array is mutated.");
+}
+
 /**
  Test the indexOfObject:inSection: and indexPathOfObject: methods.
  */
@@ -699,19 +843,20 @@ static const NSString *sectionZ = @"Zulu";
     }];
     XCTAssertTrue(count == [self.groupedArray countAllSections], @"The block should have executed once for each section.");
     
-    // Try dereferencing the pointer to the stop BOOL and setting it to YES - this should have no impact
+    // Try dereferencing the pointer to the stop BOOL and setting it to YES - this should stop further executions from starting (though
+    // executions already in progress on other threads may still finish)
     count = 0;
     [self.groupedArray enumerateSectionsWithOptions:NSEnumerationConcurrent usingBlock:^(id section, NSUInteger index, BOOL *stop) {
         *stop = YES;
         OSAtomicIncrement32(&count);
     }];
-    XCTAssertTrue(count == [self.groupedArray countAllSections], @"The stop request should have been ignored.");
+    XCTAssertTrue(count >= 1 && count <= [self.groupedArray countAllSections], @"The block should have executed at least once, and no more than once for each element.");
     count = 0;
     [self.groupedArray enumerateSectionsWithOptions:NSEnumerationConcurrent | NSEnumerationReverse usingBlock:^(id section, NSUInteger index, BOOL *stop) {
         *stop = YES;
         OSAtomicIncrement32(&count);
     }];
-    XCTAssertTrue(count == [self.groupedArray countAllSections], @"The stop request should have been ignored.");
+    XCTAssertTrue(count >= 1 && count <= [self.groupedArray countAllSections], @"The block should have executed at least once, and no more than once for each element.");
     
     // Test using an empty grouped array
     count = 0;
@@ -887,19 +1032,20 @@ static const NSString *sectionZ = @"Zulu";
     }];
     XCTAssertTrue(count == [self.groupedArray countAllObjects], @"The block should have executed once for each object.");
     
-    // Try dereferencing the pointer to the stop BOOL and setting it to YES - this should have no impact
+    // Try dereferencing the pointer to the stop BOOL and setting it to YES - this should stop further executions from starting (though
+    // executions already in progress on other threads may still finish)
     count = 0;
     [self.groupedArray enumerateObjectsWithOptions:NSEnumerationConcurrent usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
         *stop = YES;
         OSAtomicIncrement32(&count);
     }];
-    XCTAssertTrue(count == [self.groupedArray countAllObjects], @"The stop request should have been ignored.");
+    XCTAssertTrue(count >= 1 && count <= [self.groupedArray countAllObjects], @"The block should have executed at least once, and no more than once for each element.");
     count = 0;
     [self.groupedArray enumerateObjectsWithOptions:NSEnumerationConcurrent | NSEnumerationReverse usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
         *stop = YES;
         OSAtomicIncrement32(&count);
     }];
-    XCTAssertTrue(count == [self.groupedArray countAllObjects], @"The stop request should have been ignored.");
+    XCTAssertTrue(count >= 1 && count <= [self.groupedArray countAllObjects], @"The block should have executed at least once, and no more than once for each element.");
     
     // Test using an empty grouped array
     count = 0;
@@ -1051,19 +1197,20 @@ static const NSString *sectionZ = @"Zulu";
     }];
     XCTAssertTrue(count == [self.groupedArray countObjectsInSectionAtIndex:0], @"The block should have executed once for each object in the first section.");
     
-    // Try dereferencing the pointer to the stop BOOL and setting it to YES - this should have no impact
+    // Try dereferencing the pointer to the stop BOOL and setting it to YES - this should stop further executions from starting (though
+    // executions already in progress on other threads may still finish)
     count = 0;
     [self.groupedArray enumerateObjectsInSectionAtIndex:0 withOptions:NSEnumerationConcurrent usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
         *stop = YES;
         OSAtomicIncrement32(&count);
     }];
-    XCTAssertTrue(count == [self.groupedArray countObjectsInSectionAtIndex:0], @"The stop request should have been ignored.");
+    XCTAssertTrue(count >= 1 && count <= [self.groupedArray countObjectsInSectionAtIndex:0], @"The block should have executed at least once, and no more than once for each element.");
     count = 0;
     [self.groupedArray enumerateObjectsInSectionAtIndex:0 withOptions:NSEnumerationConcurrent | NSEnumerationReverse usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
         *stop = YES;
         OSAtomicIncrement32(&count);
     }];
-    XCTAssertTrue(count == [self.groupedArray countObjectsInSectionAtIndex:0], @"The stop request should have been ignored.");
+    XCTAssertTrue(count >= 1 && count <= [self.groupedArray countObjectsInSectionAtIndex:0], @"The block should have executed at least once, and no more than once for each element.");
     
     // Test using an empty grouped array
     count = 0;
@@ -1230,6 +1377,86 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertTrue(blockExecutionCount == 1, @"The block should only have executed once.");
 }
 
+/**
+ Test the index pair variants of the object enumeration methods.
+ */
+- (void)testEnumerateObjectsUsingIndexPairBlock
+{
+    [self addUnsortedSectionsAndObjects];
+    
+    // The index pair variants should visit the same objects at the same locations as the index path variants
+    for (NSNumber *options in @[@0, @(NSEnumerationReverse)]) {
+        NSMutableArray *indexPathResults = [NSMutableArray new];
+        [self.groupedArray enumerateObjectsWithOptions:[options unsignedIntegerValue] usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+            [indexPathResults addObject:@[object, indexPath]];
+        }];
+        NSMutableArray *indexPairResults = [NSMutableArray new];
+        [self.groupedArray enumerateObjectsWithOptions:[options unsignedIntegerValue] usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            XCTAssertEqualObjects(object, [self.groupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex]]);
+            [indexPairResults addObject:@[object, [INTUGroupedArray indexPathForRow:indexPair.objectIndex inSection:indexPair.sectionIndex]]];
+        }];
+        XCTAssertEqualObjects(indexPathResults, indexPairResults);
+        XCTAssertTrue([indexPairResults count] == [self.groupedArray countAllObjects]);
+        
+        indexPairResults = [NSMutableArray new];
+        [self.groupedArray enumerateObjectsInSectionAtIndex:0 withOptions:[options unsignedIntegerValue] usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            XCTAssertTrue(indexPair.sectionIndex == 0);
+            [indexPairResults addObject:object];
+        }];
+        NSArray *expectedObjects = [self.groupedArray objectsInSectionAtIndex:0];
+        if ([options unsignedIntegerValue] & NSEnumerationReverse) {
+            expectedObjects = [[expectedObjects reverseObjectEnumerator] allObjects];
+        }
+        XCTAssertEqualObjects(indexPairResults, expectedObjects);
+    }
+    
+    // Setting stop to YES should end enumeration immediately
+    __block NSUInteger blockExecutionCount = 0;
+    [self.groupedArray enumerateObjectsUsingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+        blockExecutionCount++;
+        if (indexPair.objectIndex == 1) {
+            *stop = YES;
+        }
+    }];
+    XCTAssertTrue(blockExecutionCount == 2);
+    
+    // Mutating the grouped array during enumeration should throw an exception
+    INTUMutableGroupedArray *mutableGroupedArray = [self.groupedArray mutableCopy];
+    XCTAssertThrows([mutableGroupedArray enumerateObjectsUsingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+        [mutableGroupedArray addObject:objectA toSection:sectionZ];
+    }]);
+    
+    XCTAssertThrows([self.groupedArray enumerateObjectsInSectionAtIndex:[self.groupedArray countAllSections] usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {}]);
+}
+
+/**
+ Test the indexPairOfObjectPassingTest: method.
+ */
+- (void)testIndexPairOfObjectPassingTest
+{
+    [self addUnsortedSectionsAndObjects];
+    
+    INTUIndexPair indexPair = [[INTUGroupedArray groupedArray] indexPairOfObjectPassingTest:^BOOL(id object, INTUIndexPair indexPair, BOOL *stop) {
+        return YES;
+    }];
+    XCTAssertTrue(indexPair.sectionIndex == NSNotFound && indexPair.objectIndex == NSNotFound, @"An empty grouped array should never find an object.");
+    
+    indexPair = [self.groupedArray indexPairOfObjectPassingTest:^BOOL(id object, INTUIndexPair indexPair, BOOL *stop) {
+        return object == objectD;
+    }];
+    NSIndexPath *indexPath = [self.groupedArray indexPathOfObjectPassingTest:^BOOL(id object, NSIndexPath *indexPath, BOOL *stop) {
+        return object == objectD;
+    }];
+    XCTAssertTrue(indexPair.sectionIndex == [indexPath indexAtPosition:0] && indexPair.objectIndex == [indexPath indexAtPosition:1]);
+    XCTAssertEqualObjects([self.groupedArray objectAtIndexPath:indexPath], objectD);
+    
+    indexPair = [self.groupedArray indexPairOfObjectPassingTest:^BOOL(id object, INTUIndexPair indexPair, BOOL *stop) {
+        *stop = YES;
+        return NO;
+    }];
+    XCTAssertTrue(indexPair.sectionIndex == NSNotFound, @"The object should not be found because the test never passed.");
+}
+
 /**
  Test the isEqual: method.
  */
@@ -1542,6 +1769,42 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertEqual(objectE, [sortedResult objectAtIndex:3 inSection:sectionY], @"Objects should be sorted.");
 }
 
+/**
+ Test that filtering and sorting concurrently produces results identical to the serial methods.
+ */
+- (void)testFilteredAndSortedGroupedArrayWithOptionConcurrent
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    
+    NSPredicate *sectionPredicate = [NSPredicate predicateWithBlock:^BOOL(NSNumber *section, NSDictionary *bindings) {
+        return [section unsignedIntegerValue] % 3 != 0;
+    }];
+    NSPredicate *objectPredicate = [NSPredicate predicateWithBlock:^BOOL(NSNumber *object, NSDictionary *bindings) {
+        return [object unsignedIntegerValue] % 2 == 0;
+    }];
+    NSComparator descendingComparator = ^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+        return [obj2 compare:obj1];
+    };
+    
+    INTUGroupedArray *serialResult = [groupedArray filteredGroupedArrayUsingSectionPredicate:sectionPredicate objectPredicate:objectPredicate];
+    INTUGroupedArray *concurrentResult = [groupedArray filteredGroupedArrayWithOptions:NSEnumerationConcurrent usingSectionPredicate:sectionPredicate objectPredicate:objectPredicate];
+    XCTAssert([serialResult countAllSections] == 66);
+    XCTAssert([serialResult isEqualToGroupedArray:concurrentResult]);
+    
+    serialResult = [groupedArray filteredGroupedArrayUsingSectionPredicate:nil objectPredicate:objectPredicate];
+    concurrentResult = [groupedArray filteredGroupedArrayWithOptions:NSEnumerationConcurrent usingSectionPredicate:nil objectPredicate:objectPredicate];
+    XCTAssert([serialResult isEqualToGroupedArray:concurrentResult]);
+    
+    serialResult = [groupedArray sortedGroupedArrayUsingSectionComparator:descendingComparator objectComparator:descendingComparator];
+    concurrentResult = [groupedArray sortedGroupedArrayWithOptions:NSSortConcurrent usingSectionComparator:descendingComparator objectComparator:descendingComparator];
+    XCTAssertEqualObjects([serialResult sectionAtIndex:0], @99);
+    XCTAssertEqualObjects([serialResult objectAtIndex:0 inSection:@99], @999);
+    XCTAssert([serialResult isEqualToGroupedArray:concurrentResult]);
+    
+    concurrentResult = [groupedArray sortedGroupedArrayWithOptions:NSSortConcurrent | NSSortStable usingSectionComparator:nil objectComparator:descendingComparator];
+    XCTAssert([[groupedArray sortedGroupedArrayUsingSectionComparator:nil objectComparator:descendingComparator] isEqualToGroupedArray:concurrentResult]);
+}
+
 - (void)testObjectEnumerator
 {
     [self addUnsortedSectionsAndObjects];
@@ -2030,6 +2293,248 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssert([[e1 nextObject] isEqual:fourthObject]);
 }
 
+/**
+ Returns a grouped array with 100 sections of 1000 objects each, for use in performance tests.
+ */
+- (INTUGroupedArray *)groupedArrayForPerformanceTests
+{
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+    for (NSUInteger sectionIndex = 0; sectionIndex < 100; sectionIndex++) {
+        NSNumber *section = @(sectionIndex);
+        for (NSUInteger objectIndex = 0; objectIndex < 1000; objectIndex++) {
+            [groupedArray addObject:@(objectIndex) toSection:section withSectionIndexHint:sectionIndex];
+        }
+    }
+    return [groupedArray copy];
+}
+
+- (void)testObjectEnumeratorPerformance
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    NSUInteger expectedCount = [groupedArray countAllObjects];
+    
+    [self measureBlock:^{
+        NSUInteger count = 0;
+        for (id __unused obj in [groupedArray objectEnumerator]) {
+            count++;
+        }
+        XCTAssert(count == expectedCount);
+        XCTAssert([[[groupedArray objectEnumerator] allObjects] count] == expectedCount);
+    }];
+}
+
+- (void)testReverseObjectEnumeratorPerformance
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    NSUInteger expectedCount = [groupedArray countAllObjects];
+    
+    [self measureBlock:^{
+        NSUInteger count = 0;
+        for (id __unused obj in [groupedArray reverseObjectEnumerator]) {
+            count++;
+        }
+        XCTAssert(count == expectedCount);
+        XCTAssert([[[groupedArray reverseObjectEnumerator] allObjects] count] == expectedCount);
+    }];
+}
+
+/**
+ Test that concurrent enumeration of a large grouped array executes the block exactly once for each object, and that setting stop to YES
+ prevents the remaining objects from being enumerated.
+ */
+- (void)testConcurrentEnumerationOfLargeGroupedArray
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    NSUInteger objectCount = [groupedArray countAllObjects];
+    int32_t *visitCounts = calloc(objectCount, sizeof(int32_t));
+    
+    for (NSNumber *options in @[@(NSEnumerationConcurrent), @(NSEnumerationConcurrent | NSEnumerationReverse)]) {
+        memset(visitCounts, 0, objectCount * sizeof(int32_t));
+        [groupedArray enumerateObjectsWithOptions:[options unsignedIntegerValue] usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            XCTAssert([object unsignedIntegerValue] == indexPair.objectIndex);
+            OSAtomicIncrement32(&visitCounts[[groupedArray flatIndexForIndexPair:indexPair]]);
+        }];
+        for (NSUInteger i = 0; i < objectCount; i++) {
+            XCTAssert(visitCounts[i] == 1, @"The block should have executed exactly once for each object.");
+        }
+    }
+    free(visitCounts);
+    
+    __block int32_t count = 0;
+    [groupedArray enumerateObjectsWithOptions:NSEnumerationConcurrent usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+        OSAtomicIncrement32(&count);
+        *stop = YES;
+    }];
+    XCTAssert(count >= 1 && (NSUInteger)count < objectCount, @"Setting stop should prevent most objects from being enumerated.");
+}
+
+/**
+ Performs a fixed amount of work for the object, to simulate a block that is expensive enough to be worth enumerating concurrently.
+ */
+static double INTUSimulatedWorkForObject(id object)
+{
+    double result = [object doubleValue];
+    for (NSUInteger i = 0; i < 200; i++) {
+        result = sqrt(result + i);
+    }
+    return result;
+}
+
+- (void)testSerialEnumerationPerformance
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    
+    [self measureBlock:^{
+        [groupedArray enumerateObjectsUsingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            volatile double __unused result = INTUSimulatedWorkForObject(object);
+        }];
+    }];
+}
+
+/**
+ Test the performance of grouping a large array into sections by their section keys.
+ */
+- (void)testGroupedArrayByGroupingArrayPerformance
+{
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:100000];
+    for (NSUInteger object = 0; object < 100000; object++) {
+        [array addObject:@(object)];
+    }
+    
+    [self measureBlock:^{
+        INTUGroupedArray *groupedArray = [INTUGroupedArray groupedArrayByGroupingArray:array sectionKeyBlock:^id(NSNumber *object) {
+            return @([object unsignedIntegerValue] % 1000);
+        }];
+        XCTAssert([groupedArray countAllSections] == 1000);
+    }];
+}
+
+/**
+ Test the performance of grouping the same array as -[testGroupedArrayByGroupingArrayPerformance] by adding each object to a mutable
+ grouped array, for comparison.
+ */
+- (void)testAddObjectToSectionGroupingPerformance
+{
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:100000];
+    for (NSUInteger object = 0; object < 100000; object++) {
+        [array addObject:@(object)];
+    }
+    
+    [self measureBlock:^{
+        INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+        for (NSNumber *object in array) {
+            [groupedArray addObject:object toSection:@([object unsignedIntegerValue] % 1000)];
+        }
+        XCTAssert([groupedArray countAllSections] == 1000);
+    }];
+}
+
+- (void)testConcurrentEnumerationPerformance
+{
+    INTUGroupedArray *groupedArray = [self groupedArrayForPerformanceTests];
+    
+    // Compare against testSerialEnumerationPerformance, which performs the same work serially
+    [self measureBlock:^{
+        [groupedArray enumerateObjectsWithOptions:NSEnumerationConcurrent usingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+            volatile double __unused result = INTUSimulatedWorkForObject(object);
+        }];
+    }];
+}
+
+
+/**
+ Test that immutable grouped arrays stored contiguously (created from a literal, a builder, or another grouped array) behave the same as
+ ones backed by section containers, and that mutable copies of them can be modified without affecting the original.
+ */
+- (void)testContiguousStorage
+{
+    INTUMutableGroupedArray *mutableGroupedArray = [INTUMutableGroupedArray new];
+    [mutableGroupedArray addObject:@"Object 0-0" toSection:@"Section 0"];
+    [mutableGroupedArray addObject:@"Object 0-1" toSection:@"Section 0"];
+    [mutableGroupedArray addObject:@"Object 1-0" toSection:@"Section 1"];
+    [mutableGroupedArray addObject:@"Object 2-0" toSection:@"Section 2"];
+    [mutableGroupedArray addObject:@"Object 2-1" toSection:@"Section 2"];
+    [mutableGroupedArray addObject:@"Object 2-2" toSection:@"Section 2"];
+    INTUGroupedArray *sharedGroupedArray = [mutableGroupedArray copy];
+    
+    INTUGroupedArray *literalGroupedArray = [INTUGroupedArray literal:@[@"Section 0", @[@"Object 0-0", @"Object 0-1"],
+                                                                        @"Section 1", @[@"Object 1-0"],
+                                                                        @"Section 2", @[@"Object 2-0", @"Object 2-1", @"Object 2-2"]]];
+    INTUGroupedArrayBuilder *builder = [INTUGroupedArrayBuilder new];
+    INTUGroupedArrayBuilder *hashedBuilder = [[INTUGroupedArrayBuilder alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex | INTUGroupedArrayOptionHashedObjectIndex];
+    [mutableGroupedArray enumerateObjectsUsingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+        [builder addObject:object toSection:[mutableGroupedArray sectionAtIndex:indexPath.section]];
+        [hashedBuilder addObject:object toSection:[mutableGroupedArray sectionAtIndex:indexPath.section]];
+    }];
+    INTUGroupedArray *builtGroupedArray = [builder build];
+    INTUGroupedArray *hashedGroupedArray = [[INTUGroupedArray alloc] initWithGroupedArray:[hashedBuilder build]];
+    INTUGroupedArray *initializedGroupedArray = [[INTUGroupedArray alloc] initWithGroupedArray:mutableGroupedArray];
+    INTUGroupedArray *reinitializedGroupedArray = [[INTUGroupedArray alloc] initWithGroupedArray:literalGroupedArray];
+    INTUGroupedArray *copiedItemsGroupedArray = [[INTUGroupedArray alloc] initWithGroupedArray:literalGroupedArray copyItems:YES];
+    
+    for (INTUGroupedArray *groupedArray in @[literalGroupedArray, builtGroupedArray, initializedGroupedArray, reinitializedGroupedArray, copiedItemsGroupedArray, hashedGroupedArray]) {
+        XCTAssertEqualObjects(groupedArray, sharedGroupedArray);
+        XCTAssert([groupedArray countAllSections] == 3);
+        XCTAssert([groupedArray countAllObjects] == 6);
+        XCTAssertEqualObjects([groupedArray allSections], (@[@"Section 0", @"Section 1", @"Section 2"]));
+        XCTAssertEqualObjects([groupedArray allObjects], [sharedGroupedArray allObjects]);
+        XCTAssertEqualObjects([groupedArray objectsInSectionAtIndex:2], (@[@"Object 2-0", @"Object 2-1", @"Object 2-2"]));
+        XCTAssert([groupedArray countObjectsInSectionAtIndex:1] == 1);
+        XCTAssertEqualObjects([groupedArray objectAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:2]], @"Object 2-1");
+        XCTAssertEqualObjects([groupedArray indexPathOfObject:@"Object 2-2"], [NSIndexPath indexPathForRow:2 inSection:2]);
+        XCTAssertNil([groupedArray indexPathOfObject:@"Missing Object"]);
+        XCTAssert([groupedArray indexOfSection:@"Section 1"] == 1);
+        XCTAssert([groupedArray containsObject:@"Object 0-1"]);
+        XCTAssert([groupedArray flatIndexForIndexPair:INTUIndexPairMake(2, 1)] == 4);
+        XCTAssertEqualObjects([groupedArray lastObject], @"Object 2-2");
+        
+        NSMutableArray *fastEnumeratedObjects = [NSMutableArray array];
+        for (id object in groupedArray) {
+            [fastEnumeratedObjects addObject:object];
+        }
+        XCTAssertEqualObjects(fastEnumeratedObjects, [sharedGroupedArray allObjects]);
+        
+        for (NSNumber *options in @[@0, @(NSEnumerationReverse), @(NSEnumerationConcurrent)]) {
+            NSMutableArray *enumeratedObjects = [NSMutableArray array];
+            [groupedArray enumerateObjectsWithOptions:[options unsignedIntegerValue] usingBlock:^(id object, NSIndexPath *indexPath, BOOL *stop) {
+                XCTAssertEqualObjects(object, [sharedGroupedArray objectAtIndexPath:indexPath]);
+                @synchronized(enumeratedObjects) {
+                    [enumeratedObjects addObject:object];
+                }
+            }];
+            XCTAssert([enumeratedObjects count] == 6);
+        }
+        XCTAssertEqualObjects([[groupedArray reverseObjectEnumerator] allObjects], [[sharedGroupedArray allObjects] reverseObjectEnumerator].allObjects);
+        XCTAssertEqualObjects([[groupedArray sectionEnumerator] allObjects], [sharedGroupedArray allSections]);
+        
+        XCTAssertEqualObjects([NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:groupedArray]], groupedArray);
+        
+        INTUMutableGroupedArray *mutableCopy = [groupedArray mutableCopy];
+        [mutableCopy addObject:@"Object 1-1" toSection:@"Section 1"];
+        [mutableCopy removeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+        XCTAssert([mutableCopy countAllObjects] == 6);
+        XCTAssertEqualObjects(groupedArray, sharedGroupedArray, @"Modifying a mutable copy should not affect the original grouped array.");
+    }
+}
+
+/**
+ Test the performance of fast enumeration over an immutable grouped array stored contiguously, for comparison with
+ -[testObjectEnumeratorPerformance], which enumerates a grouped array backed by section containers.
+ */
+- (void)testContiguousStorageFastEnumerationPerformance
+{
+    INTUGroupedArray *groupedArray = [[INTUGroupedArray alloc] initWithGroupedArray:[self groupedArrayForPerformanceTests]];
+    NSUInteger expectedCount = [groupedArray countAllObjects];
+    
+    [self measureBlock:^{
+        NSUInteger count = 0;
+        for (id __unused obj in groupedArray) {
+            count++;
+        }
+        XCTAssert(count == expectedCount);
+    }];
+}
+
 @end
 
 #pragma clang diagnostic pop
@@ -156,6 +156,23 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertNoThrow([INTUMutableGroupedArray literal:literal]);
 }
 
+/**
+ Test creating a mutable grouped array by grouping the objects in an array by their section keys, and then mutating it.
+ */
+- (void)testGroupedArrayByGroupingArray
+{
+    NSArray *words = @[@"banana", @"apple", @"cherry", @"avocado"];
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray groupedArrayByGroupingArray:words sectionKeyBlock:^id(NSString *word) {
+        return [word substringToIndex:1];
+    }];
+    XCTAssert([groupedArray isMemberOfClass:[INTUMutableGroupedArray class]]);
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"b", @[@"banana"], @"a", @[@"apple", @"avocado"], @"c", @[@"cherry"]]]));
+    
+    [groupedArray addObject:@"apricot" toSection:@"a"];
+    [groupedArray removeObject:@"banana"];
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"a", @[@"apple", @"avocado", @"apricot"], @"c", @[@"cherry"]]]));
+}
+
 /**
  Test the grouped array's NSCoding methods.
  */
@@ -1288,6 +1305,65 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertTrue([mutableCopy containsSection:section1], @"The copy should have a section 'Section 1 Mutated'.");
 }
 
+/**
+ Test that copies share section containers without being affected by mutations to the original or to each other (copy-on-write).
+ */
+- (void)testCopyOnWrite
+{
+    [self addUnsortedSectionsAndObjects];
+    INTUGroupedArray *snapshot = [self.groupedArray copy];
+    INTUGroupedArray *expected = [[INTUGroupedArray alloc] initWithGroupedArray:snapshot copyItems:YES];
+    
+    // Mutate the original through every in place mutation path
+    [self.groupedArray addObject:objectF toSection:sectionY];
+    [self.groupedArray addObject:objectF toSectionAtIndex:0];
+    [self.groupedArray insertObject:objectA atIndex:0 inSection:sectionX];
+    [self.groupedArray insertObject:objectB atIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    [self.groupedArray replaceObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] withObject:objectD];
+    [self.groupedArray moveObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] toIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    [self.groupedArray exchangeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1] withObjectAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:2]];
+    [self.groupedArray replaceSectionAtIndex:0 withSection:@"Victor"];
+    [self.groupedArray removeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    [self.groupedArray removeObject:objectC];
+    [self.groupedArray filterWithOptions:NSEnumerationConcurrent usingSectionPredicate:nil objectPredicate:[NSPredicate predicateWithFormat:@"SELF != %@", objectE]];
+    [self.groupedArray sortWithOptions:NSSortConcurrent usingSectionComparator:nil objectComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) { return [obj2 compare:obj1]; }];
+    XCTAssertFalse([self.groupedArray isEqualToGroupedArray:snapshot], @"The original should have been mutated.");
+    XCTAssert([snapshot isEqualToGroupedArray:expected], @"The snapshot should not be affected by mutations to the original.");
+    
+    // Mutable copies of the snapshot should be independent of the snapshot and of each other
+    INTUMutableGroupedArray *mutableCopy1 = [snapshot mutableCopy];
+    INTUMutableGroupedArray *mutableCopy2 = [mutableCopy1 mutableCopy];
+    [mutableCopy1 addObject:objectF toSectionAtIndex:0];
+    [mutableCopy2 removeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+    XCTAssert([snapshot isEqualToGroupedArray:expected], @"The snapshot should not be affected by mutations to its mutable copies.");
+    XCTAssert([mutableCopy1 countObjectsInSectionAtIndex:0] == [snapshot countObjectsInSectionAtIndex:0] + 1);
+    XCTAssert([mutableCopy2 countObjectsInSectionAtIndex:0] == [snapshot countObjectsInSectionAtIndex:0] - 1);
+    XCTAssertEqual(objectF, [mutableCopy1 objectAtIndexPath:[NSIndexPath indexPathForRow:[snapshot countObjectsInSectionAtIndex:0] inSection:0]]);
+    
+    // Grouped arrays created from the literal syntax share no state, but also need to copy their section containers before mutating them
+    INTUMutableGroupedArray *literal = [INTUMutableGroupedArray literal:@[sectionX, @[objectA, objectB]]];
+    [literal addObject:objectC toSection:sectionX];
+    XCTAssert([literal isEqualToGroupedArray:[INTUGroupedArray literal:@[sectionX, @[objectA, objectB, objectC]]]]);
+}
+
+/**
+ Test the performance of taking an immutable snapshot of a large grouped array after each mutation.
+ */
+- (void)testSnapshotPerformance
+{
+    for (NSUInteger section = 0; section < 1000; section++) {
+        for (NSUInteger object = 0; object < 100; object++) {
+            [self.groupedArray addObject:@(object) toSection:@(section) withSectionIndexHint:section];
+        }
+    }
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [self.groupedArray addObject:@(i) toSectionAtIndex:i];
+            INTUGroupedArray * __unused snapshot = [self.groupedArray copy];
+        }
+    }];
+}
+
 /**
  Adds some sections and objects to the index array in an unsorted fashion.
  */
@@ -1437,6 +1513,31 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssert([self.groupedArray countAllObjects] == 0);
 }
 
+/**
+ Test that a predicate raising an exception partway through a filter does not affect copies sharing section containers with the
+ grouped array, and leaves the grouped array usable.
+ */
+- (void)testFilterWithPredicateThatThrows
+{
+    [self addUnsortedSectionsAndObjects];
+    INTUGroupedArray *snapshot = [self.groupedArray copy];
+    INTUGroupedArray *expected = [[INTUGroupedArray alloc] initWithGroupedArray:snapshot copyItems:YES];
+    
+    __block NSUInteger evaluationCount = 0;
+    NSPredicate *objectPredicate = [NSPredicate predicateWithBlock:^BOOL(id evaluatedObject, NSDictionary *bindings) {
+        if (++evaluationCount > 2) {
+            [NSException raise:NSInternalInconsistencyException format:@"Predicate failure."];
+        }
+        return YES;
+    }];
+    XCTAssertThrows([self.groupedArray filterUsingSectionPredicate:nil objectPredicate:objectPredicate]);
+    XCTAssert([snapshot isEqualToGroupedArray:expected], @"The snapshot should not be affected by a filter that raised an exception.");
+    XCTAssert([self.groupedArray isEqualToGroupedArray:expected], @"No objects should have been filtered out, as the predicate never returned NO.");
+    
+    [self.groupedArray addObject:objectF toSectionAtIndex:0];
+    XCTAssert([snapshot isEqualToGroupedArray:expected], @"The snapshot should not be affected by later mutations to the original.");
+}
+
 - (void)testSortUsingSectionComparatorObjectComparator
 {
     [self addUnsortedSectionsAndObjects];
@@ -1486,6 +1587,415 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertEqual(objectE, [self.groupedArray objectAtIndex:3 inSection:sectionY], @"Objects should be sorted.");
 }
 
+/**
+ Returns a mutable grouped array with the INTUGroupedArrayOptionHashedSectionIndex option set and the same contents as the grouped array.
+ */
+- (INTUMutableGroupedArray *)mutableCopyWithHashedSectionIndexOfGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    INTUMutableGroupedArray *copy = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [groupedArray enumerateObjectsUsingIndexPairBlock:^(id object, INTUIndexPair indexPair, BOOL *stop) {
+        [copy addObject:object toSection:[groupedArray sectionAtIndex:indexPair.sectionIndex]];
+    }];
+    return copy;
+}
+
+/**
+ Test that filtering and sorting concurrently produces results identical to the serial methods.
+ */
+- (void)testFilterAndSortWithOptionConcurrent
+{
+    [self addUnsortedSectionsAndObjects];
+    
+    INTUGroupedArray *original = [self.groupedArray copy];
+    NSPredicate *sectionPredicate = [NSPredicate predicateWithBlock:^BOOL(id evaluatedObject, NSDictionary *bindings) {
+        return evaluatedObject != sectionX;
+    }];
+    NSPredicate *objectPredicate = [NSPredicate predicateWithBlock:^BOOL(id evaluatedObject, NSDictionary *bindings) {
+        return evaluatedObject != objectA;
+    }];
+    NSComparator comparator = ^NSComparisonResult(NSString *obj1, NSString *obj2) { return [obj1 compare:obj2]; };
+    
+    INTUMutableGroupedArray *serial = [original mutableCopy];
+    INTUMutableGroupedArray *concurrent = [self mutableCopyWithHashedSectionIndexOfGroupedArray:original];
+    [serial filterUsingSectionPredicate:sectionPredicate objectPredicate:objectPredicate];
+    [concurrent filterWithOptions:NSEnumerationConcurrent usingSectionPredicate:sectionPredicate objectPredicate:objectPredicate];
+    XCTAssert([serial countAllSections] == 3);
+    XCTAssertFalse([serial containsObject:objectA]);
+    XCTAssert([serial isEqualToGroupedArray:concurrent]);
+    [self assertSectionIndexIsConsistentForGroupedArray:concurrent];
+    
+    serial = [original mutableCopy];
+    concurrent = [self mutableCopyWithHashedSectionIndexOfGroupedArray:original];
+    [serial sortUsingSectionComparator:comparator objectComparator:comparator];
+    [concurrent sortWithOptions:NSSortConcurrent usingSectionComparator:comparator objectComparator:comparator];
+    XCTAssertEqual(sectionW, [serial sectionAtIndex:0], @"Sections should be sorted.");
+    XCTAssertEqual(objectA, [serial objectAtIndex:0 inSection:sectionY], @"Objects should be sorted.");
+    XCTAssert([serial isEqualToGroupedArray:concurrent]);
+    [self assertSectionIndexIsConsistentForGroupedArray:concurrent];
+}
+
+/**
+ Returns the value that the grouped array uses to detect mutations during fast enumeration, which changes each time it is mutated.
+ */
+- (unsigned long)mutationsValueOfGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    NSFastEnumerationState state = {0};
+    __unsafe_unretained id objects[1];
+    [groupedArray countByEnumeratingWithState:&state objects:objects count:1];
+    return *state.mutationsPtr;
+}
+
+/**
+ Test that batch updates leave emptied sections in place until the batch ends, and count as a single mutation.
+ */
+- (void)testPerformBatchUpdates
+{
+    [self addUnsortedSectionsAndObjects];
+    unsigned long mutationsBefore = [self mutationsValueOfGroupedArray:self.groupedArray];
+    
+    [self.groupedArray performBatchUpdates:^{
+        // Empty section X; it should stay at the same index until the batch ends
+        [self.groupedArray removeObject:objectF fromSection:sectionX];
+        XCTAssertEqual(sectionX, [self.groupedArray sectionAtIndex:2]);
+        XCTAssert([self.groupedArray countObjectsInSectionAtIndex:2] == 0);
+        XCTAssertEqual(sectionZ, [self.groupedArray sectionAtIndex:3], @"Later sections should not move during the batch.");
+        
+        // Empty section Z, then add an object back to it so that it is kept
+        [self.groupedArray removeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:3]];
+        [self.groupedArray performBatchUpdates:^{
+            [self.groupedArray addObject:objectB toSection:sectionZ];
+        }];
+        XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == mutationsBefore, @"Mutations should not be counted until the outermost batch ends.");
+        
+        // Move the only object out of section W, and add a new section
+        [self.groupedArray moveObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1] toIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+        [self.groupedArray removeObjectAtIndex:0 fromSection:sectionW];
+        [self.groupedArray addObject:objectF toSection:@"Victor"];
+        XCTAssert([self.groupedArray countAllObjects] == 7);
+        XCTAssert([self.groupedArray indexOfSection:@"Victor"] == 4);
+    }];
+    
+    XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == mutationsBefore + 1, @"The batch should count as a single mutation.");
+    INTUGroupedArray *expected = [INTUGroupedArray literal:@[sectionY, @[objectA, objectE, objectB, objectA, objectC],
+                                                             sectionZ, @[objectB],
+                                                             @"Victor", @[objectF]]];
+    XCTAssert([self.groupedArray isEqualToGroupedArray:expected], @"Empty sections should be removed when the batch ends.");
+    XCTAssert([self.groupedArray indexOfSection:sectionZ] == 1);
+    XCTAssert([self.groupedArray countAllObjects] == 7);
+    
+    // A batch with no mutations should not count as a mutation
+    [self.groupedArray performBatchUpdates:^{
+        XCTAssert([self.groupedArray containsSection:sectionY]);
+    }];
+    XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == mutationsBefore + 1);
+    
+    INTUMutableGroupedArray *hashed = [self mutableCopyWithHashedSectionIndexOfGroupedArray:self.groupedArray];
+    [hashed performBatchUpdates:^{
+        [hashed removeObject:objectB];
+        [hashed addObject:objectD toSection:sectionX];
+    }];
+    XCTAssert([hashed isEqualToGroupedArray:[INTUGroupedArray literal:@[sectionY, @[objectA, objectE, objectA, objectC], @"Victor", @[objectF], sectionX, @[objectD]]]]);
+    [self assertSectionIndexIsConsistentForGroupedArray:hashed];
+}
+
+/**
+ Test that moving or removing an object counts as a single mutation, including when it leaves its section empty.
+ */
+- (void)testMoveAndRemoveObjectCountAsSingleMutation
+{
+    [self addUnsortedSectionsAndObjects];
+    unsigned long mutations = [self mutationsValueOfGroupedArray:self.groupedArray];
+    
+    // Within a section
+    [self.groupedArray moveObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] toIndexPath:[NSIndexPath indexPathForRow:3 inSection:0]];
+    XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == ++mutations);
+    
+    // Between sections
+    [self.groupedArray moveObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1] toIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+    XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == ++mutations);
+    
+    // Out of a section that is left empty and removed
+    [self.groupedArray moveObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:2] toIndexPath:[NSIndexPath indexPathForRow:1 inSection:3]];
+    XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == ++mutations);
+    [self.groupedArray removeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]];
+    XCTAssert([self mutationsValueOfGroupedArray:self.groupedArray] == ++mutations);
+    
+    INTUGroupedArray *expected = [INTUGroupedArray literal:@[sectionY, @[objectA, objectB, objectA, objectC, objectE],
+                                                             sectionZ, @[objectD, objectF]]];
+    XCTAssert([self.groupedArray isEqualToGroupedArray:expected]);
+}
+
+/**
+ Test that a batch of updates still ends when its block raises an exception, so that the grouped array keeps working afterwards.
+ */
+- (void)testBatchUpdatesException
+{
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Alfa"], @"Section 2", @[@"Bravo"]]];
+    unsigned long mutationsBefore = [self mutationsValueOfGroupedArray:groupedArray];
+    XCTAssertThrowsSpecificNamed([groupedArray performBatchUpdates:^{
+        [groupedArray performBatchUpdates:^{
+            [groupedArray removeObject:@"Alfa" fromSection:@"Section 1"];
+            [groupedArray addObject:@"Charlie" toSection:@"Section 3"];
+            [NSException raise:NSInternalInconsistencyException format:@"Failed in the middle of a batch."];
+        }];
+    }], NSException, NSInternalInconsistencyException);
+    
+    // The mutations made before the exception are kept, and the batch ended as usual
+    XCTAssert([self mutationsValueOfGroupedArray:groupedArray] == mutationsBefore + 1, @"The batch should count as a single mutation.");
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 2", @[@"Bravo"], @"Section 3", @[@"Charlie"]]]), @"Empty sections should be removed when the batch ends.");
+    
+    // Later mutations are no longer part of a batch
+    [groupedArray removeObject:@"Bravo" fromSection:@"Section 2"];
+    XCTAssert([self mutationsValueOfGroupedArray:groupedArray] == mutationsBefore + 2);
+    XCTAssert([groupedArray countAllSections] == 1, @"A section left empty outside of a batch should be removed right away.");
+    XCTAssert([groupedArray indexOfSection:@"Section 3"] == 0);
+}
+
+/**
+ Adds and then removes objects in a large number of sections, one call at a time, and returns the number of sections left.
+ */
+- (NSUInteger)addAndRemoveObjectsInGroupedArray:(INTUMutableGroupedArray *)groupedArray
+{
+    for (NSUInteger object = 0; object < 100; object++) {
+        for (NSUInteger section = 0; section < 1000; section++) {
+            [groupedArray addObject:@(object) toSection:@(section)];
+        }
+    }
+    for (NSUInteger section = 0; section < 1000; section += 2) {
+        for (NSUInteger object = 0; object < 100; object++) {
+            [groupedArray removeObjectAtIndex:0 fromSection:@(section)];
+        }
+    }
+    return [groupedArray countAllSections];
+}
+
+/**
+ Test the performance of many individual mutations, for comparison with -[testBatchUpdatesPerformance].
+ */
+- (void)testIndividualUpdatesPerformance
+{
+    [self measureBlock:^{
+        INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+        XCTAssert([self addAndRemoveObjectsInGroupedArray:groupedArray] == 500);
+    }];
+}
+
+/**
+ Test the performance of the same mutations as -[testIndividualUpdatesPerformance] performed as a batch of updates.
+ */
+- (void)testBatchUpdatesPerformance
+{
+    [self measureBlock:^{
+        INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+        __block NSUInteger sectionCount = 0;
+        [groupedArray performBatchUpdates:^{
+            sectionCount = [self addAndRemoveObjectsInGroupedArray:groupedArray];
+        }];
+        XCTAssert(sectionCount == 1000, @"Empty sections should not be removed until the batch ends.");
+        XCTAssert([groupedArray countAllSections] == 500);
+    }];
+}
+
+/**
+ Returns whether the sections, and the objects in each section, are sorted in ascending order according to -compare:.
+ */
+- (BOOL)isGroupedArraySorted:(INTUGroupedArray *)groupedArray
+{
+    NSUInteger sectionCount = [groupedArray countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        if (sectionIndex > 0 && [[groupedArray sectionAtIndex:sectionIndex - 1] compare:[groupedArray sectionAtIndex:sectionIndex]] == NSOrderedDescending) {
+            return NO;
+        }
+        NSArray *objects = [groupedArray objectsInSectionAtIndex:sectionIndex];
+        for (NSUInteger objectIndex = 1; objectIndex < [objects count]; objectIndex++) {
+            if ([objects[objectIndex - 1] compare:objects[objectIndex]] == NSOrderedDescending) {
+                return NO;
+            }
+        }
+    }
+    return YES;
+}
+
+/**
+ Test that the sort order is maintained by every kind of mutation once it has been requested.
+ */
+- (void)testMaintainSortOrder
+{
+    NSComparator compare = ^NSComparisonResult(id obj1, id obj2) {
+        return [obj1 compare:obj2];
+    };
+    [self addUnsortedSectionsAndObjects];
+    [self.groupedArray maintainSortOrderUsingSectionComparator:compare objectComparator:compare];
+    XCTAssertNotNil(self.groupedArray.sectionComparator);
+    XCTAssertNotNil(self.groupedArray.objectComparator);
+    XCTAssertTrue([self isGroupedArraySorted:self.groupedArray]);
+    
+    [self.groupedArray addObject:@"Aardvark" toSection:@"Mike"];
+    [self.groupedArray addObject:@"Zulu" toSection:@"Alpha"];
+    [self.groupedArray addObject:@"Aardvark" toSection:@"Zulu"];
+    [self.groupedArray addObject:@"Alfa" toSectionAtIndex:1];
+    [self.groupedArray insertObject:@"Zebra" atIndex:0 inSection:@"Mike"];
+    [self.groupedArray insertObject:@"Aaa" atIndexPath:[NSIndexPath indexPathForRow:2 inSection:2]];
+    [self.groupedArray addObjectsFromArray:@[@"Kilo", @"Bravo", @"Yankee"] toSection:@"Lima"];
+    [self.groupedArray replaceSectionAtIndex:0 withSection:@"Victor"];
+    [self.groupedArray replaceObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1] withObject:@"Zzz"];
+    XCTAssertTrue([self isGroupedArraySorted:self.groupedArray]);
+    
+    // Sections & objects are found by binary search
+    for (NSUInteger sectionIndex = 0; sectionIndex < [self.groupedArray countAllSections]; sectionIndex++) {
+        id section = [self.groupedArray sectionAtIndex:sectionIndex];
+        XCTAssert([self.groupedArray indexOfSection:section] == sectionIndex);
+        NSArray *objects = [self.groupedArray objectsInSectionAtIndex:sectionIndex];
+        for (id object in objects) {
+            XCTAssert([self.groupedArray indexOfObject:object inSection:section] == [objects indexOfObject:object]);
+        }
+    }
+    XCTAssert([self.groupedArray indexOfSection:@"Nonexistent"] == NSNotFound);
+    XCTAssert([self.groupedArray indexOfObject:@"Nonexistent" inSection:@"Lima"] == NSNotFound);
+    XCTAssertTrue([self.groupedArray containsObject:@"Kilo" inSection:@"Lima"]);
+    
+    // Sections & objects that are kept sorted cannot be moved, exchanged, or re-sorted
+    XCTAssertThrows([self.groupedArray moveSectionAtIndex:0 toIndex:1]);
+    XCTAssertThrows([self.groupedArray exchangeSectionAtIndex:0 withSectionAtIndex:1]);
+    XCTAssertThrows([self.groupedArray moveObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] toIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]]);
+    XCTAssertThrows([self.groupedArray exchangeObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] withObjectAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:1]]);
+    XCTAssertThrows([self.groupedArray sortUsingSectionComparator:compare objectComparator:nil]);
+    
+    // Mutable copies keep the sort order; immutable copies do not need to
+    INTUMutableGroupedArray *mutableCopy = [self.groupedArray mutableCopy];
+    XCTAssertNotNil(mutableCopy.sectionComparator);
+    [mutableCopy addObject:@"Alfa" toSection:@"Bravo"];
+    XCTAssertTrue([self isGroupedArraySorted:mutableCopy]);
+    
+    // The order of the sections can be maintained without maintaining the order of the objects, and vice versa
+    [self.groupedArray maintainSortOrderUsingSectionComparator:nil objectComparator:compare];
+    XCTAssertNil(self.groupedArray.sectionComparator);
+    [self.groupedArray moveSectionAtIndex:0 toIndex:[self.groupedArray countAllSections] - 1];
+    [self.groupedArray addObject:@"Alfa" toSection:@"Zulu"];
+    XCTAssertEqualObjects([self.groupedArray objectsInSection:sectionZ], (@[@"Aardvark", objectA, objectD]));
+    
+    // Sorted sections also keep the hashed section index consistent
+    INTUMutableGroupedArray *hashed = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    [hashed maintainSortOrderUsingSectionComparator:compare objectComparator:nil];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [hashed addObject:@(i) toSection:@((i * 37) % 50)];
+    }
+    XCTAssertTrue([self isGroupedArraySorted:hashed]);
+    [hashed replaceSectionAtIndex:0 withSection:@1000];
+    XCTAssertTrue([self isGroupedArraySorted:hashed]);
+    XCTAssertEqualObjects([hashed sectionAtIndex:[hashed countAllSections] - 1], @1000);
+    [self assertSectionIndexIsConsistentForGroupedArray:hashed];
+}
+
+/**
+ Test that objects added to sections kept sorted during a batch of updates end up in the same order as when they are added one at a time.
+ */
+- (void)testMaintainSortOrderInBatchUpdates
+{
+    // Only compare the first letter, so that the order of objects that compare the same is tested too
+    NSComparator compareFirstLetter = ^NSComparisonResult(NSString *obj1, NSString *obj2) {
+        return [[obj1 substringToIndex:1] compare:[obj2 substringToIndex:1]];
+    };
+    INTUMutableGroupedArray *expectedGroupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Bravo", @"Delta"], @"Section 2", @[@"Alfa"]]];
+    [expectedGroupedArray maintainSortOrderUsingSectionComparator:nil objectComparator:compareFirstLetter];
+    INTUMutableGroupedArray *groupedArray = [expectedGroupedArray mutableCopy];
+    void (^updates)(INTUMutableGroupedArray *) = ^(INTUMutableGroupedArray *mutableGroupedArray) {
+        [mutableGroupedArray addObject:@"Charlie" toSection:@"Section 1"];
+        [mutableGroupedArray addObject:@"Baker" toSection:@"Section 1"];
+        [mutableGroupedArray insertObject:@"Able" atIndex:2 inSection:@"Section 1"];
+        [mutableGroupedArray addObjectsFromArray:@[@"Zulu", @"Ash", @"Yankee"] toSection:@"Section 2"];
+        [mutableGroupedArray replaceObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0] withObject:@"Dog"];
+        [mutableGroupedArray addObject:@"Easy" toSection:@"Section 3"];
+    };
+    updates(expectedGroupedArray);
+    [groupedArray performBatchUpdates:^{
+        updates(groupedArray);
+        XCTAssert([groupedArray indexOfObject:@"Able" inSection:@"Section 1"] != NSNotFound, @"Objects should be found before they are sorted.");
+    }];
+    XCTAssertEqualObjects([groupedArray objectsInSection:@"Section 1"], [expectedGroupedArray objectsInSection:@"Section 1"]);
+    XCTAssertEqualObjects(groupedArray, expectedGroupedArray);
+    XCTAssert([groupedArray indexOfObject:@"Dog" inSection:@"Section 1"] == [[expectedGroupedArray objectsInSection:@"Section 1"] indexOfObject:@"Dog"]);
+    
+    // The sections are sorted even if the batch is ended by an exception
+    XCTAssertThrows([groupedArray performBatchUpdates:^{
+        [groupedArray addObject:@"Abc" toSection:@"Section 3"];
+        [NSException raise:NSInternalInconsistencyException format:@"Test exception"];
+    }]);
+    XCTAssertEqualObjects([groupedArray objectsInSection:@"Section 3"], (@[@"Abc", @"Easy"]));
+}
+
+/**
+ Test that copies made during a batch of updates have the contents the batch would leave if it ended then, and that the batch carries on.
+ */
+- (void)testCopyDuringBatchUpdates
+{
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Delta"], @"Section 2", @[@"Bravo"]]];
+    [groupedArray maintainSortOrderUsingSectionComparator:nil objectComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) {
+        return [obj1 compare:obj2];
+    }];
+    INTUGroupedArray *expectedGroupedArray = [INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Charlie", @"Delta"]]];
+    __block INTUGroupedArray *copy = nil;
+    __block INTUMutableGroupedArray *mutableCopy = nil;
+    [groupedArray performBatchUpdates:^{
+        [groupedArray addObject:@"Charlie" toSection:@"Section 1"];
+        [groupedArray removeObject:@"Bravo" fromSection:@"Section 2"];
+        copy = [groupedArray copy];
+        mutableCopy = [groupedArray mutableCopy];
+        
+        // The batch is not affected by the copies
+        XCTAssert([groupedArray countAllSections] == 2, @"The empty section should stay in place until the batch ends.");
+        XCTAssertEqualObjects([groupedArray objectsInSection:@"Section 1"], (@[@"Alfa", @"Delta", @"Charlie"]));
+        [groupedArray addObject:@"Bravo" toSection:@"Section 1"];
+    }];
+    XCTAssertEqualObjects(copy, expectedGroupedArray);
+    XCTAssertEqualObjects([copy objectsInSection:@"Section 1"], [expectedGroupedArray objectsInSection:@"Section 1"]);
+    XCTAssertEqualObjects(mutableCopy, expectedGroupedArray);
+    XCTAssert([mutableCopy indexOfObject:@"Charlie" inSection:@"Section 1"] == 1);
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo", @"Charlie", @"Delta"]]]));
+    
+    // The mutable copy keeps maintaining the sort order
+    [mutableCopy addObject:@"Bravo" toSection:@"Section 1"];
+    XCTAssertEqualObjects([mutableCopy objectsInSection:@"Section 1"], (@[@"Alfa", @"Bravo", @"Charlie", @"Delta"]));
+}
+
+/**
+ Test the performance of adding objects to a grouped array that keeps its sections & objects sorted.
+ */
+- (void)testMaintainSortOrderPerformance
+{
+    NSComparator compare = ^NSComparisonResult(id obj1, id obj2) {
+        return [obj1 compare:obj2];
+    };
+    [self measureBlock:^{
+        INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+        [groupedArray maintainSortOrderUsingSectionComparator:compare objectComparator:compare];
+        for (NSUInteger object = 0; object < 20000; object++) {
+            [groupedArray addObject:@((object * 7919) % 20000) toSection:@((object * 31) % 1000)];
+        }
+        XCTAssert([groupedArray countAllSections] == 1000);
+    }];
+}
+
+/**
+ Test the performance of adding the same objects as -[testMaintainSortOrderPerformance] and re-sorting after every 100 objects, for comparison.
+ */
+- (void)testResortingPerformance
+{
+    NSComparator compare = ^NSComparisonResult(id obj1, id obj2) {
+        return [obj1 compare:obj2];
+    };
+    [self measureBlock:^{
+        INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+        for (NSUInteger object = 0; object < 20000; object++) {
+            [groupedArray addObject:@((object * 7919) % 20000) toSection:@((object * 31) % 1000)];
+            if (object % 100 == 99) {
+                [groupedArray sortUsingSectionComparator:compare objectComparator:compare];
+            }
+        }
+        XCTAssert([groupedArray countAllSections] == 1000);
+    }];
+}
+
 - (void)fastEnumerateEnumerator:(NSEnumerator *)e
 {
     NSMutableArray *dummy = [NSMutableArray new];
@@ -1623,6 +2133,583 @@ static const NSString *sectionZ = @"Zulu";
     XCTAssertThrows([e allObjects]);
 }
 
+/**
+ Helper method that asserts every section in the grouped array is located at its actual index by indexOfSection:.
+ */
+- (void)assertSectionIndexIsConsistentForGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    NSUInteger sectionCount = [groupedArray countAllSections];
+    for (NSUInteger i = 0; i < sectionCount; i++) {
+        XCTAssertTrue([groupedArray indexOfSection:[groupedArray sectionAtIndex:i]] == i, @"The section should be found at its index.");
+    }
+    XCTAssertTrue([groupedArray indexOfSection:@"Nonexistent Section"] == NSNotFound, @"A section that does not exist should not be found.");
+}
+
+/**
+ Test that the hashed section index stays consistent through every method that changes the sections.
+ */
+- (void)testHashedSectionIndex
+{
+    self.groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedSectionIndex];
+    XCTAssertTrue(self.groupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self addUnsortedSectionsAndObjects];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    XCTAssertTrue([self.groupedArray indexOfSection:sectionX] == 2);
+    XCTAssertTrue([self.groupedArray containsSection:sectionZ]);
+    XCTAssertTrue([self.groupedArray countObjectsInSection:sectionY] == 4);
+    
+    [self.groupedArray insertObject:objectB atIndex:0 inSection:@"Inserted Section"];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray replaceSectionAtIndex:0 withSection:@"Replacement Section"];
+    XCTAssertTrue([self.groupedArray indexOfSection:sectionY] == NSNotFound);
+    XCTAssertTrue([self.groupedArray indexOfSection:@"Replacement Section"] == 0);
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray moveSectionAtIndex:0 toIndex:3];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray moveSectionAtIndex:4 toIndex:1];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray exchangeSectionAtIndex:0 withSectionAtIndex:2];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray sortUsingSectionComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) { return [obj1 compare:obj2]; } objectComparator:nil];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray removeSection:sectionW];
+    XCTAssertFalse([self.groupedArray containsSection:sectionW]);
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray removeObject:objectF];
+    XCTAssertFalse([self.groupedArray containsSection:sectionX]);
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray moveObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0] toIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1]];
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray filterUsingSectionPredicate:[NSPredicate predicateWithFormat:@"SELF != %@", sectionZ] objectPredicate:nil];
+    XCTAssertFalse([self.groupedArray containsSection:sectionZ]);
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    // Copies should keep the options and have a consistent section index
+    INTUGroupedArray *copy = [self.groupedArray copy];
+    XCTAssertTrue(copy.options == INTUGroupedArrayOptionHashedSectionIndex);
+    [self assertSectionIndexIsConsistentForGroupedArray:copy];
+    INTUMutableGroupedArray *mutableCopy = [copy mutableCopy];
+    XCTAssertTrue(mutableCopy.options == INTUGroupedArrayOptionHashedSectionIndex);
+    [mutableCopy addObject:objectA toSection:@"New Section"];
+    [self assertSectionIndexIsConsistentForGroupedArray:mutableCopy];
+    XCTAssertTrue([copy indexOfSection:@"New Section"] == NSNotFound);
+    
+    // Encoding & decoding should preserve the options
+    INTUMutableGroupedArray *decodedGroupedArray = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:mutableCopy]];
+    XCTAssertTrue(decodedGroupedArray.options == INTUGroupedArrayOptionHashedSectionIndex);
+    [self assertSectionIndexIsConsistentForGroupedArray:decodedGroupedArray];
+    
+    [self.groupedArray removeAllObjects];
+    XCTAssertFalse([self.groupedArray containsSection:sectionY]);
+    [self assertSectionIndexIsConsistentForGroupedArray:self.groupedArray];
+}
+
+
+/**
+ Helper method that asserts every object in the grouped array is found by the methods that locate objects, at the same index path
+ as a scan of the grouped array would find it.
+ */
+- (void)assertObjectIndexIsConsistentForGroupedArray:(INTUGroupedArray *)groupedArray
+{
+    NSUInteger sectionCount = [groupedArray countAllSections];
+    for (NSUInteger sectionIndex = 0; sectionIndex < sectionCount; sectionIndex++) {
+        id section = [groupedArray sectionAtIndex:sectionIndex];
+        NSArray *objects = [groupedArray objectsInSectionAtIndex:sectionIndex];
+        for (id object in objects) {
+            XCTAssertTrue([groupedArray containsObject:object], @"The object should be found.");
+            XCTAssertTrue([groupedArray containsObject:object inSection:section], @"The object should be found in its section.");
+            XCTAssertTrue([groupedArray indexOfObject:object inSection:section] == [objects indexOfObject:object], @"The object should be found at its index.");
+            NSIndexPath *firstIndexPath = nil;
+            for (NSUInteger i = 0; i < sectionCount && !firstIndexPath; i++) {
+                NSUInteger objectIndex = [[groupedArray objectsInSectionAtIndex:i] indexOfObject:object];
+                if (objectIndex != NSNotFound) {
+                    firstIndexPath = [INTUGroupedArray indexPathForRow:objectIndex inSection:i];
+                }
+            }
+            XCTAssertEqualObjects([groupedArray indexPathOfObject:object], firstIndexPath, @"The first instance of the object should be found.");
+        }
+        XCTAssertFalse([groupedArray containsObject:@"Nonexistent Object" inSection:section], @"An object that does not exist should not be found.");
+    }
+    XCTAssertFalse([groupedArray containsObject:@"Nonexistent Object"], @"An object that does not exist should not be found.");
+    XCTAssertNil([groupedArray indexPathOfObject:@"Nonexistent Object"], @"An object that does not exist should not be found.");
+}
+
+/**
+ Test that the hashed object index stays consistent through every method that changes the objects or sections.
+ */
+- (void)testHashedObjectIndex
+{
+    self.groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedObjectIndex];
+    XCTAssertTrue(self.groupedArray.options == INTUGroupedArrayOptionHashedObjectIndex);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self addUnsortedSectionsAndObjects];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    XCTAssertTrue([self.groupedArray containsObject:objectD inSection:sectionW]);
+    XCTAssertFalse([self.groupedArray containsObject:objectD inSection:sectionY]);
+    XCTAssertEqualObjects([self.groupedArray indexPathOfObject:objectA], [INTUGroupedArray indexPathForRow:2 inSection:0]);
+    
+    [self.groupedArray insertObject:objectA atIndex:0 inSection:sectionZ];
+    [self.groupedArray insertObject:objectB atIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:2]];
+    [self.groupedArray addObject:objectC toSectionAtIndex:1];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray replaceSectionAtIndex:0 withSection:@"Replacement Section"];
+    XCTAssertFalse([self.groupedArray containsObject:objectE inSection:sectionY]);
+    XCTAssertTrue([self.groupedArray containsObject:objectE inSection:@"Replacement Section"]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray replaceObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0] withObject:@"Replacement Object"];
+    XCTAssertFalse([self.groupedArray containsObject:objectE]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray moveObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:2] toIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:3]];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray exchangeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0] withObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1]];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray moveSectionAtIndex:0 toIndex:2];
+    [self.groupedArray exchangeSectionAtIndex:0 withSectionAtIndex:1];
+    [self.groupedArray sortUsingSectionComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) { return [obj1 compare:obj2]; }
+                                 objectComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) { return [obj1 compare:obj2]; }];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray removeObject:objectA];
+    XCTAssertFalse([self.groupedArray containsObject:objectA]);
+    XCTAssertNil([self.groupedArray indexPathOfObject:objectA]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray removeObject:objectD fromSection:sectionW];
+    XCTAssertFalse([self.groupedArray containsObject:objectD inSection:sectionW]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0]];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray removeObjectAtIndex:0 fromSection:[self.groupedArray sectionAtIndex:0]];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    [self.groupedArray removeSectionAtIndex:0];
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray performBatchUpdates:^{
+        [self.groupedArray addObject:objectF toSection:sectionY];
+        [self.groupedArray removeObject:objectF];
+    }];
+    XCTAssertFalse([self.groupedArray containsObject:objectF]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    [self.groupedArray addObjectsFromArray:@[objectA, objectB, objectC, objectB] toSection:sectionX];
+    [self.groupedArray filterUsingSectionPredicate:nil objectPredicate:[NSPredicate predicateWithFormat:@"SELF != %@", objectB]];
+    XCTAssertFalse([self.groupedArray containsObject:objectB]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+    
+    // Copies should keep the options and have a consistent object index that is independent of the original
+    INTUGroupedArray *copy = [self.groupedArray copy];
+    XCTAssertTrue(copy.options == INTUGroupedArrayOptionHashedObjectIndex);
+    [self assertObjectIndexIsConsistentForGroupedArray:copy];
+    INTUMutableGroupedArray *mutableCopy = [copy mutableCopy];
+    XCTAssertTrue(mutableCopy.options == INTUGroupedArrayOptionHashedObjectIndex);
+    [mutableCopy addObject:objectE toSection:@"New Section"];
+    [mutableCopy removeObject:objectA];
+    [self assertObjectIndexIsConsistentForGroupedArray:mutableCopy];
+    XCTAssertFalse([copy containsObject:objectE]);
+    XCTAssertTrue([copy containsObject:objectA]);
+    
+    // Encoding & decoding should preserve the options
+    INTUMutableGroupedArray *decodedGroupedArray = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:mutableCopy]];
+    XCTAssertTrue(decodedGroupedArray.options == INTUGroupedArrayOptionHashedObjectIndex);
+    [self assertObjectIndexIsConsistentForGroupedArray:decodedGroupedArray];
+    
+    [self.groupedArray removeAllObjects];
+    XCTAssertFalse([self.groupedArray containsObject:objectC]);
+    [self assertObjectIndexIsConsistentForGroupedArray:self.groupedArray];
+}
+
+/**
+ Helper method that looks up and removes objects by value in a grouped array of 100 sections with 1,000 objects each.
+ */
+- (void)containsAndRemoveObjectsInGroupedArrayWithOptions:(INTUGroupedArrayOptions)options
+{
+    INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:options];
+    for (NSUInteger section = 0; section < 100; section++) {
+        for (NSUInteger object = 0; object < 1000; object++) {
+            [groupedArray addObject:@(section * 1000 + object) toSection:@(section)];
+        }
+    }
+    [self measureBlock:^{
+        INTUMutableGroupedArray *copy = [groupedArray mutableCopy];
+        for (NSUInteger i = 0; i < 1000; i++) {
+            NSNumber *object = @((i * 7919) % 100000);
+            XCTAssertTrue([copy containsObject:object]);
+            [copy removeObject:object];
+            XCTAssertFalse([copy containsObject:object]);
+        }
+    }];
+}
+
+/**
+ Test the performance of inserting & removing objects near the front of a section of 200,000 objects, which only shifts the objects in one
+ chunk since the section uses chunked storage.
+ */
+- (void)testInsertAndRemoveAtFrontOfLargeSectionPerformance
+{
+    INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionChunkedSectionStorage];
+    for (NSUInteger object = 0; object < 200000; object++) {
+        [groupedArray addObject:@(object) toSection:@0];
+    }
+    NSIndexPath *frontIndexPath = [INTUGroupedArray indexPathForRow:1 inSection:0];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; i++) {
+            [groupedArray insertObject:@(i) atIndexPath:frontIndexPath];
+        }
+        for (NSUInteger i = 0; i < 10000; i++) {
+            [groupedArray removeObjectAtIndexPath:frontIndexPath];
+        }
+    }];
+}
+
+/**
+ Test the performance of looking up and removing objects by value without the hashed object index.
+ */
+- (void)testContainsAndRemoveObjectPerformance
+{
+    [self containsAndRemoveObjectsInGroupedArrayWithOptions:INTUGroupedArrayOptionNone];
+}
+
+/**
+ Test the performance of looking up and removing objects by value with the hashed object index, for comparison with
+ -[testContainsAndRemoveObjectPerformance].
+ */
+- (void)testContainsAndRemoveObjectWithHashedObjectIndexPerformance
+{
+    [self containsAndRemoveObjectsInGroupedArrayWithOptions:INTUGroupedArrayOptionHashedObjectIndex];
+}
+
+/**
+ Performs random inserts, removals, moves & replacements at any position in the sections of the grouped array, and checks that its contents
+ always match the same mutations applied to plain arrays.
+ */
+- (void)assertRandomMutationsOfGroupedArray:(INTUMutableGroupedArray *)groupedArray matchArraysOfObjects:(NSMutableArray *)arrays
+{
+    srand48(42);
+    for (NSUInteger i = 0; i < 20000; i++) {
+        NSUInteger sectionIndex = (NSUInteger)(drand48() * [arrays count]);
+        NSMutableArray *objects = arrays[sectionIndex];
+        NSUInteger objectIndex = (NSUInteger)(drand48() * [objects count]);
+        NSIndexPath *indexPath = [INTUGroupedArray indexPathForRow:objectIndex inSection:sectionIndex];
+        double operation = drand48();
+        if (operation < 0.4 || [objects count] < 2) {
+            [groupedArray insertObject:@(i) atIndexPath:indexPath];
+            [objects insertObject:@(i) atIndex:objectIndex];
+        } else if (operation < 0.7) {
+            [groupedArray removeObjectAtIndexPath:indexPath];
+            [objects removeObjectAtIndex:objectIndex];
+        } else if (operation < 0.9) {
+            NSUInteger toSectionIndex = (NSUInteger)(drand48() * [arrays count]);
+            NSMutableArray *toObjects = arrays[toSectionIndex];
+            id object = objects[objectIndex];
+            [objects removeObjectAtIndex:objectIndex];
+            NSUInteger toObjectIndex = (NSUInteger)(drand48() * ([toObjects count] + 1));
+            [toObjects insertObject:object atIndex:toObjectIndex];
+            [groupedArray moveObjectAtIndexPath:indexPath toIndexPath:[INTUGroupedArray indexPathForRow:toObjectIndex inSection:toSectionIndex]];
+        } else {
+            [groupedArray replaceObjectAtIndexPath:indexPath withObject:@(-(NSInteger)i)];
+            objects[objectIndex] = @(-(NSInteger)i);
+        }
+    }
+    XCTAssert([groupedArray countAllSections] == [arrays count]);
+    for (NSUInteger sectionIndex = 0; sectionIndex < [arrays count]; sectionIndex++) {
+        XCTAssertEqualObjects([groupedArray objectsInSectionAtIndex:sectionIndex], arrays[sectionIndex]);
+        NSUInteger objectIndex = 0;
+        for (id object in [groupedArray objectsViewInSectionAtIndex:sectionIndex]) {
+            XCTAssertEqualObjects(object, arrays[sectionIndex][objectIndex], @"Fast enumeration should return the objects in order.");
+            objectIndex++;
+        }
+    }
+}
+
+/**
+ Test that sections with chunked storage behave exactly like sections with contiguous storage.
+ */
+- (void)testChunkedSectionStorage
+{
+    // Every section uses chunked storage when the option is set, however small
+    INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionChunkedSectionStorage];
+    NSMutableArray *arrays = [NSMutableArray new];
+    for (NSUInteger sectionIndex = 0; sectionIndex < 3; sectionIndex++) {
+        NSMutableArray *objects = [NSMutableArray new];
+        for (NSUInteger objectIndex = 0; objectIndex < 2000; objectIndex++) {
+            [objects addObject:@(sectionIndex * 100000 + objectIndex)];
+        }
+        [groupedArray addObjectsFromArray:objects toSection:@(sectionIndex)];
+        [arrays addObject:objects];
+    }
+    INTUGroupedArray *copy = [groupedArray copy];
+    [self assertRandomMutationsOfGroupedArray:groupedArray matchArraysOfObjects:arrays];
+    XCTAssert([copy countObjectsInSectionAtIndex:0] == 2000, @"Copies should not be affected by mutations of the chunked storage.");
+    
+    // Sorting, filtering & removing still work
+    NSComparator comparator = ^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+        return [obj1 compare:obj2];
+    };
+    [groupedArray sortUsingSectionComparator:nil objectComparator:comparator];
+    XCTAssertEqualObjects([groupedArray objectsInSectionAtIndex:1], [arrays[1] sortedArrayUsingComparator:comparator]);
+    [groupedArray filterUsingSectionPredicate:nil objectPredicate:[NSPredicate predicateWithFormat:@"SELF >= 0"]];
+    [groupedArray removeObject:[groupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:2]]];
+    for (NSUInteger sectionIndex = 0; sectionIndex < 3; sectionIndex++) {
+        NSArray *objects = [groupedArray objectsInSectionAtIndex:sectionIndex];
+        XCTAssertEqualObjects(objects, [objects sortedArrayUsingComparator:comparator]);
+        XCTAssert([[objects filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"SELF < 0"]] count] == 0);
+    }
+    
+    // Without the option, a section switches to chunked storage once it grows large enough
+    NSMutableArray *largeObjects = [NSMutableArray new];
+    for (NSUInteger objectIndex = 0; objectIndex < 20000; objectIndex++) {
+        [largeObjects addObject:@(objectIndex)];
+    }
+    INTUMutableGroupedArray *largeGroupedArray = [INTUMutableGroupedArray new];
+    [largeGroupedArray addObjectsFromArray:largeObjects toSection:@"Large"];
+    [largeGroupedArray addObjectsFromArray:@[@1, @2, @3] toSection:@"Small"];
+    [self assertRandomMutationsOfGroupedArray:largeGroupedArray matchArraysOfObjects:[NSMutableArray arrayWithObjects:largeObjects, [@[@1, @2, @3] mutableCopy], nil]];
+    XCTAssertEqualObjects([[largeGroupedArray mutableCopy] objectsInSectionAtIndex:0], [largeGroupedArray objectsInSectionAtIndex:0]);
+}
+
+/**
+ Test that a section with chunked storage can be enumerated on many threads at once, both by the mutable grouped array and by a copy
+ that shares its section containers.
+ */
+- (void)testConcurrentEnumerationOfChunkedSection
+{
+    // Insert at the front as well as the back, so that the chunks are not all full
+    NSUInteger objectCount = 40000;
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray new];
+    for (NSUInteger i = 0; i < objectCount / 2; i++) {
+        [groupedArray addObject:@(objectCount / 2 + i) toSection:@"Section"];
+        [groupedArray insertObject:@(objectCount / 2 - 1 - i) atIndex:0 inSection:@"Section"];
+    }
+    
+    for (INTUGroupedArray *enumeratedGroupedArray in @[groupedArray, [groupedArray copy]]) {
+        for (NSNumber *options in @[@(NSEnumerationConcurrent), @(NSEnumerationConcurrent | NSEnumerationReverse)]) {
+            __block volatile int64_t mismatchCount = 0;
+            __block volatile int64_t visitCount = 0;
+            [enumeratedGroupedArray enumerateObjectsInSectionAtIndex:0 withOptions:[options unsignedIntegerValue] usingIndexPairBlock:^(NSNumber *object, INTUIndexPair indexPair, BOOL *stop) {
+                // Look up a few other objects as well, which are likely to be in different chunks than other threads are reading
+                NSUInteger otherIndex = (indexPair.objectIndex * 7919) % objectCount;
+                NSNumber *otherObject = [enumeratedGroupedArray objectAtIndexPath:[INTUGroupedArray indexPathForRow:otherIndex inSection:0]];
+                if ([object unsignedIntegerValue] != indexPair.objectIndex || [otherObject unsignedIntegerValue] != otherIndex) {
+                    OSAtomicIncrement64(&mismatchCount);
+                }
+                OSAtomicIncrement64(&visitCount);
+            }];
+            XCTAssert(visitCount == (int64_t)objectCount);
+            XCTAssert(mismatchCount == 0, @"Every thread should read the correct objects.");
+        }
+    }
+}
+
+/**
+ Asserts that the aggregates registered by -[testAggregates] match the aggregates computed by visiting every object in each section.
+ */
+- (void)assertAggregatesMatchObjectsInGroupedArray:(INTUMutableGroupedArray *)groupedArray
+{
+    for (NSUInteger sectionIndex = 0; sectionIndex < [groupedArray countAllSections]; sectionIndex++) {
+        NSArray *objects = [groupedArray objectsInSectionAtIndex:sectionIndex];
+        id section = [groupedArray sectionAtIndex:sectionIndex];
+        XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSectionAtIndex:sectionIndex], @([objects count]));
+        XCTAssertEqual([[groupedArray aggregateWithName:@"sum" inSectionAtIndex:sectionIndex] doubleValue], [[objects valueForKeyPath:@"@sum.self"] doubleValue]);
+        XCTAssertEqualObjects([groupedArray aggregateWithName:@"min" inSectionAtIndex:sectionIndex], [objects valueForKeyPath:@"@min.self"]);
+        XCTAssertEqualObjects([groupedArray aggregateWithName:@"max" inSection:section], [objects valueForKeyPath:@"@max.self"]);
+        XCTAssertEqualObjects([groupedArray aggregateWithName:@"maxLength" inSectionAtIndex:sectionIndex], [objects valueForKeyPath:@"@max.stringValue.length"]);
+    }
+}
+
+/**
+ Test that registered aggregates are kept up to date by every kind of mutation.
+ */
+- (void)testAggregates
+{
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@3, @1, @4],
+                                                                               @"Section 2", @[@1, @5]]];
+    [groupedArray registerAggregateWithName:@"count" function:INTUGroupedArrayAggregateFunctionCount keyPath:nil];
+    [groupedArray registerAggregateWithName:@"sum" function:INTUGroupedArrayAggregateFunctionSum keyPath:nil];
+    [groupedArray registerAggregateWithName:@"min" function:INTUGroupedArrayAggregateFunctionMinimum keyPath:nil];
+    [groupedArray registerAggregateWithName:@"max" function:INTUGroupedArrayAggregateFunctionMaximum keyPath:nil];
+    [groupedArray registerAggregateWithName:@"maxLength" function:INTUGroupedArrayAggregateFunctionMaximum keyPath:@"stringValue.length"];
+    XCTAssertEqualObjects([NSSet setWithArray:groupedArray.registeredAggregateNames], ([NSSet setWithObjects:@"count", @"sum", @"min", @"max", @"maxLength", nil]));
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSection:@"Section 1"], @8);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"min" inSectionAtIndex:1], @1);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSection:@"Section 3"], @0, @"A section that does not exist should have an empty aggregate.");
+    XCTAssertNil([groupedArray aggregateWithName:@"max" inSection:@"Section 3"]);
+    XCTAssertThrows([groupedArray aggregateWithName:@"unregistered" inSectionAtIndex:0]);
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    [groupedArray addObject:@9 toSection:@"Section 1"];
+    [groupedArray addObject:@2 toSection:@"Section 3"];
+    [groupedArray insertObject:@6 atIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1]];
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    // Replacing and removing the current maximum
+    [groupedArray replaceObjectAtIndexPath:[INTUGroupedArray indexPathForRow:3 inSection:0] withObject:@2];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"max" inSectionAtIndex:0], @4);
+    [groupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:2 inSection:0]];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"max" inSectionAtIndex:0], @3);
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    // Moving & exchanging objects between sections
+    [groupedArray moveObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1] toIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:0]];
+    [groupedArray exchangeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:1 inSection:0] withObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:2]];
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    // Moving the only object out of a section removes the section
+    [groupedArray moveObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:2] toIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:1]];
+    XCTAssert([groupedArray countAllSections] == 2);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSection:@"Section 3"], @0);
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    // Replacing a section moves its aggregates to the new section
+    [groupedArray replaceSectionAtIndex:1 withSection:@"Section 4"];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSection:@"Section 2"], @0);
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    [groupedArray performBatchUpdates:^{
+        [groupedArray removeObject:@1];
+        [groupedArray addObject:@7 toSection:@"Section 5"];
+        [groupedArray removeSection:@"Section 4"];
+        [groupedArray addObjectsFromArray:@[@8, @10] toSection:@"Section 4"];
+        [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    }];
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    [groupedArray filterUsingSectionPredicate:nil objectPredicate:[NSPredicate predicateWithFormat:@"SELF > 2"]];
+    [groupedArray sortUsingSectionComparator:nil objectComparator:^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+        return [obj2 compare:obj1];
+    }];
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    // Mutable copies keep maintaining the aggregates independently
+    INTUMutableGroupedArray *mutableCopy = [groupedArray mutableCopy];
+    [mutableCopy addObject:@100 toSectionAtIndex:0];
+    XCTAssertEqualObjects([mutableCopy aggregateWithName:@"max" inSectionAtIndex:0], @100);
+    XCTAssertNotEqualObjects([groupedArray aggregateWithName:@"max" inSectionAtIndex:0], @100);
+    [self assertAggregatesMatchObjectsInGroupedArray:mutableCopy];
+    [self assertAggregatesMatchObjectsInGroupedArray:groupedArray];
+    
+    [groupedArray unregisterAggregateWithName:@"maxLength"];
+    XCTAssertFalse([groupedArray.registeredAggregateNames containsObject:@"maxLength"]);
+    XCTAssertTrue([mutableCopy.registeredAggregateNames containsObject:@"maxLength"]);
+    [groupedArray removeAllObjects];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSection:@"Section 1"], @0);
+}
+
+/**
+ Test recomputing aggregates after the values of objects change, and that aggregates are computed exactly once when the object index
+ is rebuilt.
+ */
+- (void)testRecomputeAggregates
+{
+    NSMutableDictionary *alfa = [@{@"amount": @3} mutableCopy];
+    NSMutableDictionary *bravo = [@{@"amount": @5} mutableCopy];
+    NSMutableDictionary *charlie = [@{@"amount": @2} mutableCopy];
+    INTUMutableGroupedArray *groupedArray = [[INTUMutableGroupedArray alloc] initWithOptions:INTUGroupedArrayOptionHashedObjectIndex];
+    [groupedArray addObjectsFromArray:@[alfa, bravo] toSection:@"Section 1"];
+    [groupedArray addObject:charlie toSection:@"Section 2"];
+    [groupedArray registerAggregateWithName:@"count" function:INTUGroupedArrayAggregateFunctionCount keyPath:@"amount"];
+    [groupedArray registerAggregateWithName:@"sum" function:INTUGroupedArrayAggregateFunctionSum keyPath:@"amount"];
+    [groupedArray registerAggregateWithName:@"max" function:INTUGroupedArrayAggregateFunctionMaximum keyPath:@"amount"];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSectionAtIndex:0], @8);
+    
+    alfa[@"amount"] = @10;
+    [groupedArray recomputeAggregates];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSectionAtIndex:0], @15);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"max" inSectionAtIndex:0], @10);
+    [groupedArray removeObject:alfa fromSection:@"Section 1"];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSectionAtIndex:0], @5);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"max" inSectionAtIndex:0], @5);
+    
+    // Filtering rebuilds the object index, which must not count any object twice
+    [groupedArray addObject:alfa toSection:@"Section 2"];
+    [groupedArray filterUsingSectionPredicate:nil objectPredicate:[NSPredicate predicateWithFormat:@"amount > 2"]];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSection:@"Section 1"], @1);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSection:@"Section 2"], @1);
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSection:@"Section 2"], @10);
+    
+    [groupedArray removeAllObjects];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"count" inSection:@"Section 1"], @0);
+    [groupedArray recomputeAggregates];
+    XCTAssertEqualObjects([groupedArray aggregateWithName:@"sum" inSection:@"Section 2"], @0);
+}
+
+/**
+ Test that sections can be removed & added over and over again, reusing the storage of removed sections, without affecting copies
+ or keeping removed sections & objects alive.
+ */
+- (void)testSectionChurn
+{
+    INTUMutableGroupedArray *groupedArray = [INTUMutableGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo"], @"Section 2", @[@"Charlie"]]];
+    INTUGroupedArray *copy = nil;
+    for (NSUInteger i = 0; i < 200; i++) {
+        NSString *section = [NSString stringWithFormat:@"Section %lu", (unsigned long)(i + 3)];
+        NSString *object = [NSString stringWithFormat:@"Object %lu", (unsigned long)i];
+        [groupedArray addObject:object toSection:section];
+        [groupedArray addObject:@"Delta" toSection:section];
+        XCTAssertEqualObjects([groupedArray objectsInSection:section], (@[object, @"Delta"]), @"A section that reuses storage should start out empty.");
+        if (i % 50 == 0) {
+            // Removed sections that are shared with a copy must not be reused
+            copy = [groupedArray copy];
+        }
+        switch (i % 4) {
+            case 0:
+                [groupedArray removeSection:section];
+                break;
+            case 1:
+                [groupedArray removeObjectAtIndexPath:[INTUGroupedArray indexPathForRow:0 inSection:2]];
+                [groupedArray removeObject:@"Delta" fromSection:section];
+                break;
+            case 2:
+                [groupedArray removeObject:@"Delta"];
+                [groupedArray removeObject:object];
+                break;
+            default:
+                [groupedArray filterUsingSectionPredicate:[NSPredicate predicateWithFormat:@"SELF != %@", section] objectPredicate:nil];
+                break;
+        }
+        XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Alfa", @"Bravo"], @"Section 2", @[@"Charlie"]]]));
+        XCTAssert([copy countAllSections] == 3);
+        XCTAssertEqualObjects([copy objectsInSectionAtIndex:2], ([NSArray arrayWithObjects:[NSString stringWithFormat:@"Object %lu", (unsigned long)(i / 50 * 50)], @"Delta", nil]));
+    }
+    
+    // Sections left empty by a batch of updates are reused too
+    [groupedArray performBatchUpdates:^{
+        [groupedArray removeAllObjects];
+        [groupedArray addObject:@"Echo" toSection:@"Section 1"];
+        [groupedArray addObject:@"Foxtrot" toSection:@"Section 3"];
+        [groupedArray removeObject:@"Foxtrot" fromSection:@"Section 3"];
+    }];
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Echo"]]]));
+    
+    // Storage kept for reuse must not keep the removed section & objects alive
+    __weak id weakSection = nil;
+    __weak id weakObject = nil;
+    @autoreleasepool {
+        NSObject *section = [NSObject new];
+        NSObject *object = [NSObject new];
+        weakSection = section;
+        weakObject = object;
+        [groupedArray addObject:object toSection:section];
+        [groupedArray removeSection:section];
+    }
+    XCTAssertNil(weakSection, @"A removed section should be deallocated.");
+    XCTAssertNil(weakObject, @"A removed object should be deallocated.");
+    [groupedArray addObject:@"Golf" toSection:@"Section 2"];
+    XCTAssertEqualObjects(groupedArray, ([INTUGroupedArray literal:@[@"Section 1", @[@"Echo"], @"Section 2", @[@"Golf"]]]));
+}
+
 @end
 
 #pragma clang diagnostic pop
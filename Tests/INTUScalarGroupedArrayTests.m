@@ -0,0 +1,210 @@
+//
+//  INTUScalarGroupedArrayTests.m
+//  https://github.com/intuit/GroupedArray
+//
+//  Copyright (c) 2014-2015 Intuit Inc.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#import <libkern/OSAtomic.h>
+#import "INTUGroupedArrayImports.h"
+
+@interface INTUScalarGroupedArrayTests : XCTestCase
+
+@end
+
+/**
+ Unit tests for the INTUDoubleGroupedArray and INTUInt64GroupedArray classes.
+ */
+@implementation INTUScalarGroupedArrayTests
+
+/**
+ Test adding, accessing, replacing and removing values.
+ */
+- (void)testAddAccessAndRemove
+{
+    INTUDoubleGroupedArray *groupedArray = [INTUDoubleGroupedArray new];
+    XCTAssert([groupedArray countAllSections] == 0);
+    XCTAssert([groupedArray countAllValues] == 0);
+    
+    [groupedArray addValue:1.5 toSection:@"Section 1"];
+    [groupedArray addValue:2.5 toSection:@"Section 2"];
+    double values[] = {3.5, 4.5, 5.5};
+    [groupedArray addValues:values count:3 toSection:@"Section 1"];
+    XCTAssert([groupedArray countAllSections] == 2);
+    XCTAssert([groupedArray countAllValues] == 5);
+    XCTAssertEqualObjects([groupedArray allSections], (@[@"Section 1", @"Section 2"]));
+    XCTAssert([groupedArray indexOfSection:@"Section 2"] == 1);
+    XCTAssert([groupedArray indexOfSection:@"Section 3"] == NSNotFound);
+    XCTAssert([groupedArray containsSection:@"Section 1"]);
+    XCTAssert([groupedArray countValuesInSection:@"Section 1"] == 4);
+    XCTAssert([groupedArray countValuesInSection:@"Section 3"] == 0);
+    XCTAssert([groupedArray valueAtIndexPair:INTUIndexPairMake(0, 2)] == 4.5);
+    XCTAssert([groupedArray valuesInSectionAtIndex:0][3] == 5.5);
+    XCTAssert([groupedArray flatIndexForIndexPair:INTUIndexPairMake(1, 0)] == 4);
+    INTUIndexPair indexPair = [groupedArray indexPairForFlatIndex:3];
+    XCTAssert(indexPair.sectionIndex == 0 && indexPair.objectIndex == 3);
+    XCTAssertThrows([groupedArray valueAtIndexPair:INTUIndexPairMake(1, 1)]);
+    
+    [groupedArray replaceValueAtIndexPair:INTUIndexPairMake(0, 0) withValue:-1.0];
+    XCTAssert([groupedArray valueAtIndexPair:INTUIndexPairMake(0, 0)] == -1.0);
+    [groupedArray removeValueAtIndexPair:INTUIndexPairMake(0, 1)];
+    XCTAssert([groupedArray countValuesInSectionAtIndex:0] == 3);
+    XCTAssert([groupedArray valueAtIndexPair:INTUIndexPairMake(0, 1)] == 4.5);
+    
+    // Removing the last value in a section removes the section
+    [groupedArray removeValueAtIndexPair:INTUIndexPairMake(1, 0)];
+    XCTAssert([groupedArray countAllSections] == 1);
+    XCTAssertFalse([groupedArray containsSection:@"Section 2"]);
+    [groupedArray addValue:6.5 toSection:@"Section 3"];
+    XCTAssert([groupedArray indexOfSection:@"Section 3"] == 1);
+    
+    [groupedArray removeSection:@"Section 1"];
+    XCTAssertEqualObjects([groupedArray allSections], (@[@"Section 3"]));
+    XCTAssert([groupedArray indexOfSection:@"Section 3"] == 0);
+    XCTAssert([groupedArray countAllValues] == 1);
+    [groupedArray removeAllValues];
+    XCTAssert([groupedArray countAllSections] == 0);
+    XCTAssert([groupedArray countAllValues] == 0);
+}
+
+/**
+ Test that the vectorized reductions match a simple loop for every number of values, including counts that are not a multiple of the vector length.
+ */
+- (void)testReductions
+{
+    for (NSUInteger count = 0; count < 40; count++) {
+        INTUDoubleGroupedArray *doubleGroupedArray = [INTUDoubleGroupedArray new];
+        INTUInt64GroupedArray *int64GroupedArray = [INTUInt64GroupedArray new];
+        double doubleSum = 0.0, doubleMinimum = INFINITY, doubleMaximum = -INFINITY;
+        int64_t int64Sum = 0, int64Minimum = INT64_MAX, int64Maximum = INT64_MIN;
+        for (NSUInteger i = 0; i < count; i++) {
+            // A sequence that is not sorted, so that the extremes can be anywhere
+            int64_t value = (int64_t)((i * 7919) % 101) - 50;
+            NSString *section = (i % 3 == 0) ? @"Section A" : @"Section B";
+            [doubleGroupedArray addValue:(double)value toSection:section];
+            [int64GroupedArray addValue:value toSection:section];
+            doubleSum += (double)value;
+            doubleMinimum = MIN(doubleMinimum, (double)value);
+            doubleMaximum = MAX(doubleMaximum, (double)value);
+            int64Sum += value;
+            int64Minimum = MIN(int64Minimum, value);
+            int64Maximum = MAX(int64Maximum, value);
+        }
+        XCTAssert([doubleGroupedArray sumOfAllValues] == doubleSum, @"The sum of %lu values should be correct.", (unsigned long)count);
+        XCTAssert([doubleGroupedArray minimumOfAllValues] == doubleMinimum, @"The minimum of %lu values should be correct.", (unsigned long)count);
+        XCTAssert([doubleGroupedArray maximumOfAllValues] == doubleMaximum, @"The maximum of %lu values should be correct.", (unsigned long)count);
+        XCTAssert([int64GroupedArray sumOfAllValues] == int64Sum, @"The sum of %lu values should be correct.", (unsigned long)count);
+        XCTAssert([int64GroupedArray minimumOfAllValues] == int64Minimum, @"The minimum of %lu values should be correct.", (unsigned long)count);
+        XCTAssert([int64GroupedArray maximumOfAllValues] == int64Maximum, @"The maximum of %lu values should be correct.", (unsigned long)count);
+        
+        for (NSUInteger sectionIndex = 0; sectionIndex < [int64GroupedArray countAllSections]; sectionIndex++) {
+            const int64_t *values = [int64GroupedArray valuesInSectionAtIndex:sectionIndex];
+            int64_t sum = 0, minimum = INT64_MAX, maximum = INT64_MIN;
+            for (NSUInteger i = 0; i < [int64GroupedArray countValuesInSectionAtIndex:sectionIndex]; i++) {
+                sum += values[i];
+                minimum = MIN(minimum, values[i]);
+                maximum = MAX(maximum, values[i]);
+            }
+            XCTAssert([int64GroupedArray sumOfValuesInSectionAtIndex:sectionIndex] == sum);
+            XCTAssert([int64GroupedArray minimumValueInSectionAtIndex:sectionIndex] == minimum);
+            XCTAssert([int64GroupedArray maximumValueInSectionAtIndex:sectionIndex] == maximum);
+            XCTAssert([doubleGroupedArray sumOfValuesInSectionAtIndex:sectionIndex] == (double)sum);
+            XCTAssert([doubleGroupedArray minimumValueInSectionAtIndex:sectionIndex] == (double)minimum);
+            XCTAssert([doubleGroupedArray maximumValueInSectionAtIndex:sectionIndex] == (double)maximum);
+        }
+    }
+    
+    // The sum of 64-bit integers wraps around on overflow instead of being undefined
+    INTUInt64GroupedArray *int64GroupedArray = [INTUInt64GroupedArray new];
+    int64_t values[] = {INT64_MAX, 1, 0, 0, 0};
+    [int64GroupedArray addValues:values count:5 toSection:@"Section"];
+    XCTAssert([int64GroupedArray sumOfAllValues] == INT64_MIN);
+}
+
+/**
+ Test enumerating the values serially, in reverse and concurrently.
+ */
+- (void)testEnumeration
+{
+    INTUInt64GroupedArray *groupedArray = [INTUInt64GroupedArray new];
+    for (int64_t value = 0; value < 1000; value++) {
+        [groupedArray addValue:value toSection:@(value / 100)];
+    }
+    
+    __block int64_t expectedValue = 0;
+    [groupedArray enumerateValuesUsingBlock:^(int64_t value, INTUIndexPair indexPair, BOOL *stop) {
+        XCTAssert(value == expectedValue);
+        XCTAssert(indexPair.sectionIndex == (NSUInteger)value / 100 && indexPair.objectIndex == (NSUInteger)value % 100);
+        expectedValue++;
+    }];
+    XCTAssert(expectedValue == 1000);
+    
+    expectedValue = 999;
+    [groupedArray enumerateValuesWithOptions:NSEnumerationReverse usingBlock:^(int64_t value, INTUIndexPair indexPair, BOOL *stop) {
+        XCTAssert(value == expectedValue);
+        expectedValue--;
+        *stop = (value == 500);
+    }];
+    XCTAssert(expectedValue == 499, @"The enumeration should stop after the value where stop was set.");
+    
+    int64_t *visitCounts = calloc(1000, sizeof(int64_t));
+    [groupedArray enumerateValuesWithOptions:NSEnumerationConcurrent usingBlock:^(int64_t value, INTUIndexPair indexPair, BOOL *stop) {
+        XCTAssert([groupedArray flatIndexForIndexPair:indexPair] == (NSUInteger)value);
+        OSAtomicIncrement64(&visitCounts[value]);
+    }];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        XCTAssert(visitCounts[i] == 1, @"Each value should be visited exactly once.");
+    }
+    free(visitCounts);
+}
+
+/**
+ Test converting to and from a boxed grouped array, and that copies are independent.
+ */
+- (void)testBoxingAndCopying
+{
+    INTUGroupedArray *boxedGroupedArray = [INTUGroupedArray literal:@[@"Section 1", @[@1, @2.5, @3],
+                                                                      @"Section 2", @[@-4]]];
+    INTUDoubleGroupedArray *doubleGroupedArray = [INTUDoubleGroupedArray groupedArrayWithGroupedArray:boxedGroupedArray];
+    XCTAssert([doubleGroupedArray countAllValues] == 4);
+    XCTAssert([doubleGroupedArray valueAtIndexPair:INTUIndexPairMake(0, 1)] == 2.5);
+    XCTAssertEqualObjects([doubleGroupedArray boxedGroupedArray], boxedGroupedArray);
+    
+    INTUInt64GroupedArray *int64GroupedArray = [INTUInt64GroupedArray groupedArrayWithGroupedArray:boxedGroupedArray];
+    XCTAssert([int64GroupedArray valueAtIndexPair:INTUIndexPairMake(0, 1)] == 2, @"Values should be truncated to integers.");
+    XCTAssertEqualObjects([int64GroupedArray boxedGroupedArray], ([INTUGroupedArray literal:@[@"Section 1", @[@1, @2, @3],
+                                                                                               @"Section 2", @[@-4]]]));
+    XCTAssert([[INTUDoubleGroupedArray groupedArrayWithGroupedArray:[INTUGroupedArray new]] countAllSections] == 0);
+    
+    INTUDoubleGroupedArray *copy = [doubleGroupedArray copy];
+    XCTAssert([copy isKindOfClass:[INTUDoubleGroupedArray class]]);
+    [copy replaceValueAtIndexPair:INTUIndexPairMake(0, 0) withValue:10.0];
+    [copy addValue:5.0 toSection:@"Section 3"];
+    [doubleGroupedArray removeSection:@"Section 2"];
+    XCTAssert([doubleGroupedArray valueAtIndexPair:INTUIndexPairMake(0, 0)] == 1.0);
+    XCTAssert([doubleGroupedArray countAllSections] == 1);
+    XCTAssertEqualObjects([copy allSections], (@[@"Section 1", @"Section 2", @"Section 3"]));
+    XCTAssert([copy sumOfAllValues] == 10.0 + 2.5 + 3.0 - 4.0 + 5.0);
+}
+
+@end